@@ -21,6 +21,7 @@
 #include <boost/type_traits/is_void.hpp>
 #include <boost/utility/enable_if.hpp>
 
+#include <memory>
 #include <type_traits>
 
 namespace hpx { namespace detail
@@ -151,6 +152,31 @@ namespace hpx { namespace detail
         }
     };
 
+    // The shared state is allocated using the given allocator
+    template <>
+    struct async_dispatch<std::allocator_arg_t>
+    {
+        template <typename Allocator, typename F, typename ...Ts>
+        HPX_FORCEINLINE static
+        typename boost::enable_if_c<
+            traits::detail::is_deferred_callable<F&&(Ts&&...)>::value,
+            hpx::future<
+                typename util::detail::deferred_result_of<F&&(Ts&&...)>::type
+            >
+        >::type
+        call(std::allocator_arg_t, Allocator const& a, F&& f, Ts&&... ts)
+        {
+            typedef typename util::detail::deferred_result_of<
+                    F(Ts&&...)
+                >::type result_type;
+
+            lcos::local::futures_factory<result_type()> p(std::allocator_arg, a,
+                util::deferred_call(std::forward<F>(f), std::forward<Ts>(ts)...));
+            p.apply();
+            return p.get_future();
+        }
+    };
+
     // threads::executor
     template <typename Executor>
     struct async_dispatch<Executor,
@@ -0,0 +1,309 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hpx/components/containers/access_buffer.hpp
+
+#if !defined(HPX_CONTAINERS_ACCESS_BUFFER_OCT_19_2016_0545PM)
+#define HPX_CONTAINERS_ACCESS_BUFFER_OCT_19_2016_0545PM
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+#include <vector>
+
+namespace hpx
+{
+    namespace traits
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Customization point describing how the keys of a partitioned
+        // container are mapped onto its partitions, it is specialized by
+        // every container which can be used with an access_buffer:
+        //
+        //  typedef ... key_type;           // global key of an element
+        //  typedef ... local_key_type;     // key inside of its partition
+        //  typedef ... value_type;
+        //
+        //  static std::size_t get_partition(Container const&, key_type const&);
+        //  static local_key_type get_local_key(Container const&,
+        //      key_type const&);
+        //
+        // The container has to expose a member function
+        //
+        //  future<std::pair<std::vector<value_type>, std::vector<bool> > >
+        //  access_values(std::size_t part, set_keys, set_values,
+        //      update_keys, updates, get_keys);
+        //
+        // which applies all accesses for one partition using a single action.
+        // It returns the values read and, unless all of the elements to read
+        // were found, whether each of them was found.
+        template <typename Container, typename Enable = void>
+        struct partitioned_container_access;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The access_buffer aggregates element accesses (reads, writes, and
+    /// updates) to a partitioned container (hpx::partitioned_vector or
+    /// hpx::unordered_map). All pending accesses are grouped by partition,
+    /// flushing the buffer sends one action per partition.
+    ///
+    /// For each partition the writes are applied first, then the updates
+    /// are invoked, and then the values are read (each in the order they were
+    /// issued). Updates are applied atomically with respect to all other
+    /// accesses made through access buffers. Reading an element which does
+    /// not exist fails only that read.
+    ///
+    /// The update functions are sent to the partitions, for remote
+    /// partitions the function objects have to be serializable and
+    /// registered using HPX_UTIL_REGISTER_FUNCTION.
+    ///
+    /// All member functions of an access_buffer may be called concurrently.
+    template <typename Container>
+    class access_buffer
+    {
+        HPX_NON_COPYABLE(access_buffer);
+
+        typedef traits::partitioned_container_access<Container> access_traits;
+
+    public:
+        typedef typename access_traits::key_type key_type;
+        typedef typename access_traits::value_type value_type;
+        typedef hpx::util::function<void(value_type&)> update_function_type;
+
+    private:
+        typedef typename access_traits::local_key_type local_key_type;
+        typedef lcos::local::spinlock mutex_type;
+
+        typedef std::pair<std::vector<value_type>, std::vector<bool> >
+            access_result_type;
+
+        // all pending accesses for one partition
+        struct partition_requests
+        {
+            partition_requests()
+              : done_future_(done_.get_future())
+            {}
+
+            void set_results(future<access_result_type> f)
+            {
+                try {
+                    access_result_type result = f.get();
+
+                    std::vector<value_type>& values = result.first;
+                    std::vector<bool> const& found = result.second;
+                    HPX_ASSERT(values.size() == get_promises_.size());
+                    HPX_ASSERT(found.empty() || found.size() == values.size());
+
+                    // a missing element fails only the corresponding read
+                    for (std::size_t i = 0; i != values.size(); ++i)
+                    {
+                        if (found.empty() || found[i])
+                        {
+                            get_promises_[i].set_value(std::move(values[i]));
+                            continue;
+                        }
+
+                        get_promises_[i].set_exception(HPX_GET_EXCEPTION(
+                            hpx::bad_parameter, "hpx::access_buffer::get",
+                            "unable to find the requested element"));
+                    }
+                    done_.set_value();
+                }
+                catch (...) {
+                    boost::exception_ptr e = boost::current_exception();
+                    for (lcos::local::promise<value_type>& p : get_promises_)
+                        p.set_exception(e);
+                    done_.set_exception(e);
+                }
+            }
+
+            std::vector<local_key_type> set_keys_;
+            std::vector<value_type> set_values_;
+            std::vector<local_key_type> update_keys_;
+            std::vector<update_function_type> updates_;
+            std::vector<local_key_type> get_keys_;
+            std::vector<lcos::local::promise<value_type> > get_promises_;
+
+            // becomes ready once all writes and updates were applied
+            lcos::local::promise<void> done_;
+            shared_future<void> done_future_;
+        };
+
+        typedef std::map<std::size_t, std::shared_ptr<partition_requests> >
+            requests_type;
+
+    public:
+        /// Create an access_buffer for the given container. The buffer is
+        /// flushed automatically whenever the number of pending accesses
+        /// reaches \a max_pending (if not zero).
+        explicit access_buffer(Container& c, std::size_t max_pending = 0)
+          : container_(c), max_pending_(max_pending), pending_(0)
+        {}
+
+        /// Destroying the buffer flushes all pending accesses (without
+        /// waiting for them to be applied).
+        ~access_buffer()
+        {
+            flush();
+        }
+
+        /// Return the number of accesses which have not been flushed yet
+        std::size_t pending() const
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+            return pending_;
+        }
+
+        /// Read the element with the given key.
+        ///
+        /// \return This returns the value of the element as an hpx::future
+        ///         which becomes ready once the buffer has been flushed. The
+        ///         future holds an exception if the element does not exist.
+        ///
+        future<value_type> get(key_type const& key)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            partition_requests& r = get_requests(key);
+            r.get_keys_.push_back(
+                access_traits::get_local_key(container_, key));
+            r.get_promises_.emplace_back();
+
+            future<value_type> f = r.get_promises_.back().get_future();
+            added(l);
+            return f;
+        }
+
+        /// Write the given value to the element with the given key.
+        ///
+        /// \return This returns an hpx::shared_future which becomes ready
+        ///         once all writes and updates to the same partition have
+        ///         been applied.
+        ///
+        template <typename T_>
+        shared_future<void> set(key_type const& key, T_ && val)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            partition_requests& r = get_requests(key);
+            r.set_keys_.push_back(
+                access_traits::get_local_key(container_, key));
+            r.set_values_.push_back(std::forward<T_>(val));
+
+            shared_future<void> f = r.done_future_;
+            added(l);
+            return f;
+        }
+
+        /// Invoke the given function for the element with the given key.
+        ///
+        /// \return This returns an hpx::shared_future which becomes ready
+        ///         once all writes and updates to the same partition have
+        ///         been applied.
+        ///
+        template <typename F>
+        shared_future<void> update(key_type const& key, F && f)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            partition_requests& r = get_requests(key);
+            r.update_keys_.push_back(
+                access_traits::get_local_key(container_, key));
+            r.updates_.push_back(update_function_type(std::forward<F>(f)));
+
+            shared_future<void> result = r.done_future_;
+            added(l);
+            return result;
+        }
+
+        /// Send all pending accesses to the partitions.
+        ///
+        /// \return This returns an hpx::future which becomes ready once all
+        ///         flushed accesses have been applied. Errors are reported
+        ///         through the futures returned for the single accesses.
+        ///
+        future<void> flush()
+        {
+            requests_type requests;
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                std::swap(requests, requests_);
+                pending_ = 0;
+            }
+            return send_requests(std::move(requests));
+        }
+
+    private:
+        partition_requests& get_requests(key_type const& key)
+        {
+            std::size_t part = access_traits::get_partition(container_, key);
+
+            std::shared_ptr<partition_requests>& r = requests_[part];
+            if (!r)
+                r = std::make_shared<partition_requests>();
+            return *r;
+        }
+
+        void added(std::unique_lock<mutex_type>& l)
+        {
+            if (++pending_ != max_pending_)
+                return;
+
+            requests_type requests;
+            std::swap(requests, requests_);
+            pending_ = 0;
+
+            l.unlock();
+            send_requests(std::move(requests));
+        }
+
+        future<void> send_requests(requests_type && requests)
+        {
+            std::vector<future<void> > futures;
+            futures.reserve(requests.size());
+
+            for (typename requests_type::value_type& p : requests)
+            {
+                std::shared_ptr<partition_requests> r = std::move(p.second);
+
+                future<access_result_type> f =
+                    container_.access_values(p.first, r->set_keys_,
+                        r->set_values_, r->update_keys_, r->updates_,
+                        r->get_keys_);
+
+                futures.push_back(f.then(
+                    [r](future<access_result_type> f)
+                    {
+                        r->set_results(std::move(f));
+                    }));
+            }
+
+            return when_all(futures);
+        }
+
+    private:
+        Container& container_;
+        std::size_t const max_pending_;
+
+        mutable mutex_type mtx_;
+        std::size_t pending_;
+        requests_type requests_;
+    };
+}
+
+#endif
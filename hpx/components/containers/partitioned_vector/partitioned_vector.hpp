@@ -21,6 +21,7 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
 
+#include <hpx/components/containers/access_buffer.hpp>
 #include <hpx/components/containers/container_distribution_policy.hpp>
 #include <hpx/components/containers/partitioned_vector/partitioned_vector_segmented_iterator.hpp>
 #include <hpx/components/containers/partitioned_vector/partitioned_vector_component.hpp>
@@ -1282,6 +1283,41 @@ namespace hpx
                 partitions_[part].partition_).set_values(pos, val);
         }
 
+        /// Asynchronously apply a batch of element accesses to the given
+        /// partition using a single action. The values are written first,
+        /// then the update functions are invoked, and then the requested
+        /// values are read. This is used by hpx::access_buffer.
+        ///
+        /// \param part        Sequence number of the partition
+        /// \param set_pos     Positions of the elements to write
+        /// \param set_vals    The values to be copied
+        /// \param update_pos  Positions of the elements to update
+        /// \param updates     The functions to invoke for the elements to
+        ///                    update
+        /// \param get_pos     Positions of the elements to read
+        ///
+        /// \return Returns the hpx::future to the values of the elements
+        ///         at the positions represented by \a get_pos.
+        ///
+        future<typename partitioned_vector_partition_server::
+            access_result_type>
+        access_values(size_type part, std::vector<size_type> const& set_pos,
+            std::vector<T> const& set_vals,
+            std::vector<size_type> const& update_pos,
+            std::vector<typename partitioned_vector_partition_server::
+                update_function_type> const& updates,
+            std::vector<size_type> const& get_pos)
+        {
+            HPX_ASSERT(set_pos.size() == set_vals.size());
+            HPX_ASSERT(update_pos.size() == updates.size());
+
+            // always invoke the action, even for local partitions, to apply
+            // the updates atomically
+            return partitioned_vector_partition_client(
+                partitions_[part].partition_).access_values(set_pos, set_vals,
+                    update_pos, updates, get_pos);
+        }
+
         /// Asynchronously set the element at position \a pos
         /// to the given value \a val.
         ///
@@ -1626,6 +1662,30 @@ namespace hpx
             return segment_cend(naming::get_locality_from_id(id));
         }
     };
+
+    namespace traits
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct partitioned_container_access<partitioned_vector<T> >
+        {
+            typedef std::size_t key_type;
+            typedef std::size_t local_key_type;
+            typedef T value_type;
+
+            static std::size_t get_partition(
+                partitioned_vector<T> const& v, std::size_t global_index)
+            {
+                return v.get_partition(global_index);
+            }
+
+            static std::size_t get_local_key(
+                partitioned_vector<T> const& v, std::size_t global_index)
+            {
+                return v.get_local_index(global_index);
+            }
+        };
+    }
 }
 
 #endif // VECTOR_HPP
@@ -21,7 +21,10 @@
 #include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/serialization/map.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
 
 #include <boost/preprocessor/cat.hpp>
 
@@ -29,6 +32,7 @@
 #include <memory>
 #include <string>
 #include <tuple>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace server
@@ -49,6 +53,14 @@ namespace hpx { namespace server
         typedef typename data_type::iterator iterator_type;
         typedef typename data_type::const_iterator const_iterator_type;
 
+        /// The type of the functions used to update single elements
+        typedef hpx::util::function<void(T&)> update_function_type;
+
+        /// The values read by access_values and whether the corresponding
+        /// elements were found (always empty as all elements exist)
+        typedef std::pair<std::vector<T>, std::vector<bool> >
+            access_result_type;
+
         typedef components::locking_hook<
                 components::simple_component_base<partitioned_vector<T> > >
             base_type;
@@ -350,6 +362,38 @@ namespace hpx { namespace server
                 partitioned_vector_partition_[pos[i]] = val[i];
         }
 
+        /// Apply a batch of element accesses to the
+        /// partitioned_vector_partition container. The values are written
+        /// first, then the update functions are invoked, and then the
+        /// requested values are read, each in the given order.
+        ///
+        /// \param set_pos     Positions of the elements to write
+        /// \param set_vals    The values to be copied
+        /// \param update_pos  Positions of the elements to update
+        /// \param updates     The functions to invoke for the elements to
+        ///                    update
+        /// \param get_pos     Positions of the elements to read
+        ///
+        /// \return Return the values of the elements at positions
+        ///         represented by \a get_pos.
+        ///
+        access_result_type access_values(
+            std::vector<size_type> const& set_pos,
+            std::vector<T> const& set_vals,
+            std::vector<size_type> const& update_pos,
+            std::vector<update_function_type> const& updates,
+            std::vector<size_type> const& get_pos)
+        {
+            HPX_ASSERT(update_pos.size() == updates.size());
+
+            set_values(set_pos, set_vals);
+            for (std::size_t i = 0; i != update_pos.size(); ++i)
+                updates[i](partitioned_vector_partition_[update_pos[i]]);
+
+            return access_result_type(get_values(get_pos),
+                std::vector<bool>());
+        }
+
         /// Remove all elements from the vector leaving the
         /// partitioned_vector_partition with size 0.
         ///
@@ -381,6 +425,10 @@ namespace hpx { namespace server
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_value);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_values);
 
+        // updates are applied atomically with respect to all other actions
+        // invoked on this partition (see locking_hook)
+        HPX_DEFINE_COMPONENT_ACTION(partitioned_vector, access_values);
+
 //         HPX_DEFINE_COMPONENT_ACTION(partitioned_vector_partition, clear);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, get_copied_data);
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partitioned_vector, set_data);
@@ -413,6 +461,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         hpx::server::partitioned_vector<type>::set_values_action,             \
         BOOST_PP_CAT(__vector_set_values_action_, name));                     \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::server::partitioned_vector<type>::access_values_action,          \
+        BOOST_PP_CAT(__vector_access_values_action_, name));                  \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         hpx::server::partitioned_vector<type>::size_action,                   \
         BOOST_PP_CAT(__vector_size_action_, name));                           \
@@ -452,6 +503,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION(                                                      \
         ::hpx::server::partitioned_vector<type>::set_values_action,           \
         BOOST_PP_CAT(__vector_set_values_action_, name));                     \
+    HPX_REGISTER_ACTION(                                                      \
+        ::hpx::server::partitioned_vector<type>::access_values_action,        \
+        BOOST_PP_CAT(__vector_access_values_action_, name));                  \
     HPX_REGISTER_ACTION(                                                      \
         hpx::server::partitioned_vector<type>::size_action,                   \
         BOOST_PP_CAT(__vector_size_action_, name));                           \
@@ -747,6 +801,26 @@ namespace hpx
                 this->get_id(), pos, val);
         }
 
+        /// Apply a batch of element accesses to the
+        /// partitioned_vector_partition component, see
+        /// server::partitioned_vector::access_values.
+        ///
+        /// \return This returns the values read as an hpx::future
+        ///
+        future<typename server_type::access_result_type> access_values(
+            std::vector<std::size_t> const& set_pos,
+            std::vector<T> const& set_vals,
+            std::vector<std::size_t> const& update_pos,
+            std::vector<typename server_type::update_function_type> const&
+                updates,
+            std::vector<std::size_t> const& get_pos)
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::access_values_action>(
+                this->get_id(), set_pos, set_vals, update_pos, updates,
+                get_pos);
+        }
+
 //         void clear()
 //         {
 //             HPX_ASSERT(this->get_id());
@@ -0,0 +1,841 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file concurrent_hash_table.hpp
+
+#if !defined(HPX_UNORDERED_CONCURRENT_HASH_TABLE_OCT_19_2016_0330PM)
+#define HPX_UNORDERED_CONCURRENT_HASH_TABLE_OCT_19_2016_0330PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/parallel/algorithms/for_loop.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/iterator/iterator_facade.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <limits>
+#include <memory>
+#include <mutex>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace server { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A concurrent hash table storing the elements of one partition of an
+    // unordered_map.
+    //
+    // The elements are distributed over a fixed number of segments based on
+    // their (mixed) hash value. Every segment is a separate open-addressing
+    // table using Robin Hood linear probing (with backward shift deletion)
+    // which stores the elements and their hash values inline in one flat
+    // array. All operations on a segment are serialized by the segment's
+    // lock, operations on different segments proceed concurrently.
+    //
+    // The bulk operations hash all keys upfront, group them by segment, and
+    // acquire every segment lock only once. Large batches are processed
+    // concurrently for all segments.
+    //
+    // Iterating over the table is not synchronized with concurrent
+    // modifications, snapshot() copies all elements while holding the lock
+    // of each segment.
+    template <typename Key, typename T, typename Hash, typename KeyEqual>
+    class concurrent_hash_table
+    {
+    public:
+        typedef Key key_type;
+        typedef T mapped_type;
+        typedef std::pair<Key, T> value_type;
+        typedef std::size_t size_type;
+        typedef Hash hasher;
+        typedef KeyEqual key_equal;
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        enum
+        {
+            segment_bits = 5,
+            num_segments = 1 << segment_bits,
+            min_segment_capacity = 8,
+            cache_line_size = 64,
+            // batches smaller than this are processed sequentially
+            parallel_threshold = 1024
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct slot
+        {
+            std::size_t hash_;      // 0 marks an empty slot
+            typename std::aligned_storage<
+                    sizeof(value_type), alignof(value_type)
+                >::type storage_;
+
+            value_type& value()
+            {
+                return *reinterpret_cast<value_type*>(&storage_);
+            }
+            value_type const& value() const
+            {
+                return *reinterpret_cast<value_type const*>(&storage_);
+            }
+        };
+
+        // Every segment occupies cache lines of its own, the locks of
+        // neighbouring segments don't cause false sharing.
+        struct alignas(cache_line_size) segment
+        {
+            segment()
+              : size_(0), capacity_(0)
+            {}
+
+            ~segment()
+            {
+                clear();
+            }
+
+            // new expressions don't honor the alignment of over-aligned
+            // types before C++17, allocate the segments at a cache line
+            // boundary explicitly
+            static void* operator new[](std::size_t size)
+            {
+                char* p = static_cast<char*>(
+                    ::operator new(size + cache_line_size));
+                char* aligned = p + cache_line_size -
+                    reinterpret_cast<std::size_t>(p) % cache_line_size;
+                reinterpret_cast<char**>(aligned)[-1] = p;
+                return aligned;
+            }
+            static void operator delete[](void* p)
+            {
+                ::operator delete(reinterpret_cast<char**>(p)[-1]);
+            }
+
+            std::size_t home(std::size_t hash) const
+            {
+                return (hash >> segment_bits) & (capacity_ - 1);
+            }
+
+            std::size_t probe_distance(std::size_t hash, std::size_t pos) const
+            {
+                return (pos - home(hash)) & (capacity_ - 1);
+            }
+
+            // returns capacity_ if the key is not stored in this segment
+            std::size_t find(std::size_t hash, Key const& key,
+                KeyEqual const& equal) const
+            {
+                if (size_ == 0)
+                    return capacity_;
+
+                std::size_t pos = home(hash);
+                for (std::size_t dist = 0; /**/; ++dist)
+                {
+                    slot const& s = slots_[pos];
+
+                    // Robin Hood invariant: the key can't be stored further
+                    // away from its home slot than the current element
+                    if (s.hash_ == 0 || probe_distance(s.hash_, pos) < dist)
+                        return capacity_;
+
+                    if (s.hash_ == hash && equal(s.value().first, key))
+                        return pos;
+
+                    pos = (pos + 1) & (capacity_ - 1);
+                }
+            }
+
+            // the key must not be stored in this segment yet
+            value_type& insert_unique(std::size_t hash, value_type && value)
+            {
+                reserve(size_ + 1);
+
+                value_type* result = nullptr;
+                std::size_t pos = home(hash);
+                for (std::size_t dist = 0; /**/; ++dist)
+                {
+                    slot& s = slots_[pos];
+                    if (s.hash_ == 0)
+                    {
+                        new (&s.storage_) value_type(std::move(value));
+                        s.hash_ = hash;
+                        ++size_;
+                        return result ? *result : s.value();
+                    }
+
+                    // displace elements which are closer to their home slot
+                    std::size_t existing = probe_distance(s.hash_, pos);
+                    if (existing < dist)
+                    {
+                        using std::swap;
+                        swap(hash, s.hash_);
+                        swap(value, s.value());
+                        if (result == nullptr)
+                            result = &s.value();
+                        dist = existing;
+                    }
+
+                    pos = (pos + 1) & (capacity_ - 1);
+                }
+            }
+
+            void erase(std::size_t pos)
+            {
+                slots_[pos].value().~value_type();
+                slots_[pos].hash_ = 0;
+
+                // shift the following elements back towards their home slot
+                std::size_t next = (pos + 1) & (capacity_ - 1);
+                while (slots_[next].hash_ != 0 &&
+                    probe_distance(slots_[next].hash_, next) != 0)
+                {
+                    new (&slots_[pos].storage_)
+                        value_type(std::move(slots_[next].value()));
+                    slots_[pos].hash_ = slots_[next].hash_;
+
+                    slots_[next].value().~value_type();
+                    slots_[next].hash_ = 0;
+
+                    pos = next;
+                    next = (next + 1) & (capacity_ - 1);
+                }
+                --size_;
+            }
+
+            // make sure the given number of elements can be stored without
+            // exceeding the maximal load factor of 7/8
+            void reserve(std::size_t count)
+            {
+                if (count <= capacity_ - capacity_ / 8)
+                    return;
+
+                std::size_t capacity =
+                    (std::max)(capacity_, std::size_t(min_segment_capacity));
+                while (count > capacity - capacity / 8)
+                    capacity *= 2;
+
+                rehash(capacity);
+            }
+
+            void rehash(std::size_t capacity)
+            {
+                std::unique_ptr<slot[]> slots(new slot[capacity]);
+                for (std::size_t i = 0; i != capacity; ++i)
+                    slots[i].hash_ = 0;
+
+                std::unique_ptr<slot[]> old_slots(std::move(slots_));
+                std::size_t old_capacity = capacity_;
+
+                slots_ = std::move(slots);
+                capacity_ = capacity;
+                size_ = 0;
+
+                for (std::size_t i = 0; i != old_capacity; ++i)
+                {
+                    slot& s = old_slots[i];
+                    if (s.hash_ != 0)
+                    {
+                        insert_unique(s.hash_, std::move(s.value()));
+                        s.value().~value_type();
+                    }
+                }
+            }
+
+            void clear()
+            {
+                for (std::size_t i = 0; i != capacity_; ++i)
+                {
+                    if (slots_[i].hash_ != 0)
+                    {
+                        slots_[i].value().~value_type();
+                        slots_[i].hash_ = 0;
+                    }
+                }
+                size_ = 0;
+            }
+
+            void swap(segment& rhs)
+            {
+                std::swap(slots_, rhs.slots_);
+                std::swap(size_, rhs.size_);
+                std::swap(capacity_, rhs.capacity_);
+            }
+
+            mutable mutex_type mtx_;
+            std::unique_ptr<slot[]> slots_;
+            std::size_t size_;
+            std::size_t capacity_;      // always 0 or a power of 2
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Value, typename Segment>
+        class iterator_base
+          : public boost::iterator_facade<
+                iterator_base<Value, Segment>, Value,
+                std::forward_iterator_tag>
+        {
+        public:
+            iterator_base()
+              : segments_(nullptr), segment_(num_segments), pos_(0)
+            {}
+
+            iterator_base(Segment* segments, std::size_t segment,
+                    std::size_t pos)
+              : segments_(segments), segment_(segment), pos_(pos)
+            {
+                satisfy_predicate();
+            }
+
+            template <typename OtherValue, typename OtherSegment>
+            iterator_base(iterator_base<OtherValue, OtherSegment> const& rhs)
+              : segments_(rhs.segments_), segment_(rhs.segment_),
+                pos_(rhs.pos_)
+            {}
+
+        private:
+            friend class boost::iterator_core_access;
+            template <typename, typename> friend class iterator_base;
+
+            // skip empty slots
+            void satisfy_predicate()
+            {
+                while (segment_ != num_segments)
+                {
+                    Segment& s = segments_[segment_];
+                    for (/**/; pos_ != s.capacity_; ++pos_)
+                    {
+                        if (s.slots_[pos_].hash_ != 0)
+                            return;
+                    }
+                    ++segment_;
+                    pos_ = 0;
+                }
+            }
+
+            void increment()
+            {
+                ++pos_;
+                satisfy_predicate();
+            }
+
+            template <typename OtherValue, typename OtherSegment>
+            bool equal(iterator_base<OtherValue, OtherSegment> const& rhs) const
+            {
+                return segment_ == rhs.segment_ && pos_ == rhs.pos_;
+            }
+
+            Value& dereference() const
+            {
+                return segments_[segment_].slots_[pos_].value();
+            }
+
+            Segment* segments_;
+            std::size_t segment_;
+            std::size_t pos_;
+        };
+
+    public:
+        typedef iterator_base<value_type, segment> iterator;
+        typedef iterator_base<value_type const, segment const> const_iterator;
+
+        ///////////////////////////////////////////////////////////////////////
+        concurrent_hash_table()
+          : segments_(new segment[num_segments])
+        {}
+
+        explicit concurrent_hash_table(size_type count,
+                Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual())
+          : segments_(new segment[num_segments]), hash_(hash), equal_(equal)
+        {
+            reserve(count);
+        }
+
+        template <typename InIter>
+        concurrent_hash_table(InIter first, InIter last, size_type count = 0,
+                Hash const& hash = Hash(), KeyEqual const& equal = KeyEqual())
+          : segments_(new segment[num_segments]), hash_(hash), equal_(equal)
+        {
+            reserve(count);
+            insert(first, last);
+        }
+
+        concurrent_hash_table(concurrent_hash_table const& rhs)
+          : segments_(new segment[num_segments]),
+            hash_(rhs.hash_), equal_(rhs.equal_)
+        {
+            std::vector<value_type> values(rhs.snapshot());
+            insert(values.begin(), values.end());
+        }
+
+        concurrent_hash_table(concurrent_hash_table && rhs)
+          : segments_(std::move(rhs.segments_)),
+            hash_(std::move(rhs.hash_)), equal_(std::move(rhs.equal_))
+        {
+            rhs.segments_.reset(new segment[num_segments]);
+        }
+
+        concurrent_hash_table& operator=(concurrent_hash_table const& rhs)
+        {
+            if (this != &rhs)
+            {
+                concurrent_hash_table tmp(rhs);
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        concurrent_hash_table& operator=(concurrent_hash_table && rhs)
+        {
+            if (this != &rhs)
+            {
+                concurrent_hash_table tmp(std::move(rhs));
+                swap(tmp);
+            }
+            return *this;
+        }
+
+        // Exchange the contents of both tables, this is not synchronized
+        // with concurrent operations on rhs.
+        void swap(concurrent_hash_table& rhs)
+        {
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                std::lock_guard<mutex_type> l(segments_[i].mtx_);
+                segments_[i].swap(rhs.segments_[i]);
+            }
+            std::swap(hash_, rhs.hash_);
+            std::swap(equal_, rhs.equal_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        iterator begin()
+        {
+            return iterator(segments_.get(), 0, 0);
+        }
+        const_iterator begin() const
+        {
+            return const_iterator(segments_.get(), 0, 0);
+        }
+        const_iterator cbegin() const
+        {
+            return begin();
+        }
+
+        iterator end()
+        {
+            return iterator(segments_.get(), num_segments, 0);
+        }
+        const_iterator end() const
+        {
+            return const_iterator(segments_.get(), num_segments, 0);
+        }
+        const_iterator cend() const
+        {
+            return end();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        size_type size() const
+        {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                std::lock_guard<mutex_type> l(segments_[i].mtx_);
+                result += segments_[i].size_;
+            }
+            return result;
+        }
+
+        // Return copies of all elements, every segment is copied while
+        // holding its lock (the copy is not atomic as a whole).
+        std::vector<value_type> snapshot() const
+        {
+            std::vector<value_type> result;
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                segment const& s = segments_[i];
+
+                std::lock_guard<mutex_type> l(s.mtx_);
+                result.reserve(result.size() + s.size_);
+                for (std::size_t pos = 0; pos != s.capacity_; ++pos)
+                {
+                    if (s.slots_[pos].hash_ != 0)
+                        result.push_back(s.slots_[pos].value());
+                }
+            }
+            return result;
+        }
+
+        size_type max_size() const
+        {
+            return (std::numeric_limits<size_type>::max)() / sizeof(slot);
+        }
+
+        size_type capacity() const
+        {
+            std::size_t result = 0;
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                std::lock_guard<mutex_type> l(segments_[i].mtx_);
+                result += segments_[i].capacity_ - segments_[i].capacity_ / 8;
+            }
+            return result;
+        }
+
+        bool empty() const
+        {
+            return size() == 0;
+        }
+
+        // Make sure the given number of elements can be stored without
+        // rehashing (assuming an even distribution over the segments).
+        void reserve(size_type count)
+        {
+            if (count == 0)
+                return;
+
+            std::size_t per_segment = (count + num_segments - 1) / num_segments;
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                std::lock_guard<mutex_type> l(segments_[i].mtx_);
+                segments_[i].reserve(per_segment);
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Retrieve a copy of the value stored for the given key. The element
+        // is removed if erase is true. Returns false if the key is not
+        // stored in the table.
+        bool get_value(Key const& key, T& value, bool erase = false)
+        {
+            std::size_t hash = get_hash(key);
+            segment& s = get_segment(hash);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            std::size_t pos = s.find(hash, key, equal_);
+            if (pos == s.capacity_)
+                return false;
+
+            if (!erase)
+            {
+                value = s.slots_[pos].value().second;
+            }
+            else
+            {
+                value = std::move(s.slots_[pos].value().second);
+                s.erase(pos);
+            }
+            return true;
+        }
+
+        bool contains(Key const& key) const
+        {
+            std::size_t hash = get_hash(key);
+            segment& s = get_segment(hash);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return s.find(hash, key, equal_) != s.capacity_;
+        }
+
+        // Insert the given value or assign it to an existing element with
+        // the same key. Returns true if a new element was inserted.
+        template <typename T_>
+        bool insert_or_assign(Key const& key, T_ && value)
+        {
+            std::size_t hash = get_hash(key);
+            segment& s = get_segment(hash);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            return insert_or_assign_locked(s, hash, key,
+                std::forward<T_>(value));
+        }
+
+        // Insert the given value if no element with the same key exists.
+        // Returns true if a new element was inserted.
+        bool insert(value_type const& value)
+        {
+            std::size_t hash = get_hash(value.first);
+            segment& s = get_segment(hash);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            if (s.find(hash, value.first, equal_) != s.capacity_)
+                return false;
+
+            s.insert_unique(hash, value_type(value));
+            return true;
+        }
+
+        // Remove the element with the given key, returns the number of
+        // elements removed.
+        size_type erase(Key const& key)
+        {
+            std::size_t hash = get_hash(key);
+            segment& s = get_segment(hash);
+
+            std::lock_guard<mutex_type> l(s.mtx_);
+            std::size_t pos = s.find(hash, key, equal_);
+            if (pos == s.capacity_)
+                return 0;
+
+            s.erase(pos);
+            return 1;
+        }
+
+        void clear()
+        {
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                std::lock_guard<mutex_type> l(segments_[i].mtx_);
+                segments_[i].clear();
+            }
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Bulk operations
+
+        // Insert all elements of the given sequence for which no element
+        // with the same key exists. Returns the number of inserted elements.
+        template <typename InIter>
+        size_type insert(InIter first, InIter last)
+        {
+            typedef typename std::iterator_traits<InIter>::value_type
+                element_type;
+
+            std::vector<element_type const*> values;
+            for (/**/; first != last; ++first)
+                values.push_back(&*first);
+
+            batch b(*this, values.size(),
+                [&values](std::size_t i) -> Key const&
+                {
+                    return values[i]->first;
+                });
+
+            std::vector<char> inserted(values.size(), 0);
+            b.for_each(*this, true,
+                [&](segment& s, std::size_t i, std::size_t hash)
+                {
+                    if (s.find(hash, values[i]->first, equal_) == s.capacity_)
+                    {
+                        s.insert_unique(hash, value_type(*values[i]));
+                        inserted[i] = 1;
+                    }
+                });
+
+            return static_cast<size_type>(
+                std::count(inserted.begin(), inserted.end(), 1));
+        }
+
+        // Retrieve copies of the values stored for all given keys. Returns
+        // false if any of the keys is not stored in the table.
+        bool get_values(std::vector<Key> const& keys, std::vector<T>& values)
+        {
+            std::vector<char> found;
+            return get_values(keys, values, found);
+        }
+
+        // Retrieve copies of the values stored for all given keys, found[i]
+        // is non-zero if keys[i] is stored in the table (the flags are
+        // written concurrently, which rules out std::vector<bool>). Returns
+        // false if any of the keys is not stored in the table.
+        bool get_values(std::vector<Key> const& keys, std::vector<T>& values,
+            std::vector<char>& found)
+        {
+            values.resize(keys.size());
+
+            batch b(*this, keys.size(),
+                [&keys](std::size_t i) -> Key const&
+                {
+                    return keys[i];
+                });
+
+            found.assign(keys.size(), 0);
+            b.for_each(*this, false,
+                [&](segment& s, std::size_t i, std::size_t hash)
+                {
+                    std::size_t pos = s.find(hash, keys[i], equal_);
+                    if (pos != s.capacity_)
+                    {
+                        values[i] = s.slots_[pos].value().second;
+                        found[i] = 1;
+                    }
+                });
+
+            return std::find(found.begin(), found.end(), 0) == found.end();
+        }
+
+        // Insert the given values or assign them to the existing elements
+        // with the same keys.
+        void set_values(std::vector<Key> const& keys,
+            std::vector<T> const& values)
+        {
+            HPX_ASSERT(keys.size() == values.size());
+
+            batch b(*this, keys.size(),
+                [&keys](std::size_t i) -> Key const&
+                {
+                    return keys[i];
+                });
+
+            b.for_each(*this, true,
+                [&](segment& s, std::size_t i, std::size_t hash)
+                {
+                    insert_or_assign_locked(s, hash, keys[i], values[i]);
+                });
+        }
+
+        // Invoke the given functions for the values stored for the given
+        // keys while holding the lock of the corresponding segment. Missing
+        // elements are inserted (default constructed) before being updated.
+        template <typename F>
+        void update_values(std::vector<Key> const& keys,
+            std::vector<F> const& f)
+        {
+            HPX_ASSERT(keys.size() == f.size());
+
+            batch b(*this, keys.size(),
+                [&keys](std::size_t i) -> Key const&
+                {
+                    return keys[i];
+                });
+
+            b.for_each(*this, true,
+                [&](segment& s, std::size_t i, std::size_t hash)
+                {
+                    std::size_t pos = s.find(hash, keys[i], equal_);
+                    if (pos != s.capacity_)
+                    {
+                        f[i](s.slots_[pos].value().second);
+                    }
+                    else
+                    {
+                        f[i](s.insert_unique(
+                            hash, value_type(keys[i], T())).second);
+                    }
+                });
+        }
+
+    private:
+        ///////////////////////////////////////////////////////////////////////
+        // The keys of a bulk operation, grouped by segment.
+        struct batch
+        {
+            template <typename F>
+            batch(concurrent_hash_table const& t, std::size_t count, F && key)
+              : hashes_(count), indices_(count)
+            {
+                std::size_t counts[num_segments] = { 0 };
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    hashes_[i] = t.get_hash(key(i));
+                    ++counts[hashes_[i] & (num_segments - 1)];
+                }
+
+                offsets_[0] = 0;
+                for (std::size_t s = 0; s != num_segments; ++s)
+                    offsets_[s + 1] = offsets_[s] + counts[s];
+
+                std::size_t next[num_segments];
+                std::copy(offsets_, offsets_ + num_segments, next);
+                for (std::size_t i = 0; i != count; ++i)
+                    indices_[next[hashes_[i] & (num_segments - 1)]++] = i;
+            }
+
+            // Invoke f(segment, index, hash) for all keys while holding the
+            // lock of the corresponding segment. If f may insert elements,
+            // the segments are grown up front to hold all of the keys.
+            template <typename F>
+            void for_each(concurrent_hash_table& t, bool may_insert,
+                F && f) const
+            {
+                auto process_segment =
+                    [&](std::size_t s)
+                    {
+                        std::size_t first = offsets_[s];
+                        std::size_t last = offsets_[s + 1];
+                        if (first == last)
+                            return;
+
+                        segment& seg = t.segments_[s];
+
+                        std::lock_guard<mutex_type> l(seg.mtx_);
+                        if (may_insert)
+                            seg.reserve(seg.size_ + (last - first));
+                        for (/**/; first != last; ++first)
+                        {
+                            std::size_t i = indices_[first];
+                            f(seg, i, hashes_[i]);
+                        }
+                    };
+
+                if (indices_.size() < std::size_t(parallel_threshold))
+                {
+                    for (std::size_t s = 0; s != num_segments; ++s)
+                        process_segment(s);
+                }
+                else
+                {
+                    parallel::for_loop(parallel::par,
+                        std::size_t(0), std::size_t(num_segments),
+                        process_segment);
+                }
+            }
+
+            std::vector<std::size_t> hashes_;
+            std::vector<std::size_t> indices_;
+            std::size_t offsets_[num_segments + 1];
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T_>
+        bool insert_or_assign_locked(segment& s, std::size_t hash,
+            Key const& key, T_ && value)
+        {
+            std::size_t pos = s.find(hash, key, equal_);
+            if (pos != s.capacity_)
+            {
+                s.slots_[pos].value().second = std::forward<T_>(value);
+                return false;
+            }
+
+            s.insert_unique(hash, value_type(key, std::forward<T_>(value)));
+            return true;
+        }
+
+        // The hash values are mixed to make sure that all bits are usable
+        // for selecting the segment and the slot (std::hash is the identity
+        // for integers on many platforms). The highest bit is always set to
+        // distinguish stored hashes from empty slots.
+        std::size_t get_hash(Key const& key) const
+        {
+            boost::uint64_t h = hash_(key);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdULL;
+            h ^= h >> 33;
+            h *= 0xc4ceb9fe1a85ec53ULL;
+            h ^= h >> 33;
+            return static_cast<std::size_t>(h) | ~(~std::size_t(0) >> 1);
+        }
+
+        segment& get_segment(std::size_t hash) const
+        {
+            return segments_[hash & (num_segments - 1)];
+        }
+
+        std::unique_ptr<segment[]> segments_;
+        Hash hash_;
+        KeyEqual equal_;
+    };
+}}}
+
+#endif
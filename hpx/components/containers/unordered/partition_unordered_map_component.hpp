@@ -12,8 +12,8 @@
 ///
 /// \brief The partition_unordered_map as the hpx component is defined here.
 ///
-/// The partition_unordered_map is the wrapper to the stl unordered_map class
-/// except all API'are defined as component action. All the API's in client
+/// The partition_unordered_map stores its elements in a concurrent hash
+/// table, all API's are defined as component actions. All the API's in client
 /// classes are asynchronous API which return the futures.
 
 #include <hpx/config.hpp>
@@ -24,47 +24,65 @@
 #include <hpx/runtime/actions/plain_action.hpp>
 #include <hpx/runtime/components/client_base.hpp>
 #include <hpx/runtime/components/component_factory.hpp>
-#include <hpx/runtime/components/server/locking_hook.hpp>
 #include <hpx/runtime/components/server/simple_component_base.hpp>
 #include <hpx/runtime/get_ptr.hpp>
+#include <hpx/runtime/serialization/map.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
 #include <hpx/util/assert.hpp>
+#include <hpx/util/function.hpp>
+
+#include <hpx/components/containers/unordered/concurrent_hash_table.hpp>
 
 #include <boost/preprocessor/cat.hpp>
 
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
 #include <tuple>
 #include <unordered_map>
+#include <utility>
 #include <vector>
 
 namespace hpx { namespace server
 {
-    /// \brief This is the basic wrapper class for stl unordered_map.
+    /// \brief This is the basic wrapper class for the hash table holding the
+    ///        elements of one partition.
     ///
     /// This contain the implementation of the partition_unordered_map's
-    /// component functionality.
+    /// component functionality. The underlying hash table is thread-safe,
+    /// the actions of one partition may be executed concurrently.
     template <typename Key, typename T, typename Hash = std::hash<Key>,
         typename KeyEqual = std::equal_to<Key> >
     class partition_unordered_map
-      : public components::locking_hook<
-            hpx::components::simple_component_base<
-                partition_unordered_map<Key, T, Hash, KeyEqual> > >
+      : public hpx::components::simple_component_base<
+            partition_unordered_map<Key, T, Hash, KeyEqual> >
     {
     public:
+        /// The type used to transfer all data of a partition
         typedef std::unordered_map<Key, T, Hash, KeyEqual> data_type;
 
-        typedef typename data_type::size_type size_type;
-        typedef typename data_type::iterator iterator_type;
-        typedef typename data_type::const_iterator const_iterator_type;
+        typedef detail::concurrent_hash_table<Key, T, Hash, KeyEqual>
+            table_type;
+
+        typedef typename table_type::size_type size_type;
+        typedef typename table_type::iterator iterator_type;
+        typedef typename table_type::const_iterator const_iterator_type;
+
+        /// The type of the functions used to update single elements
+        typedef hpx::util::function<void(T&)> update_function_type;
+
+        /// The values read by access_values and whether the corresponding
+        /// elements were found (empty if all of them were found)
+        typedef std::pair<std::vector<T>, std::vector<bool> >
+            access_result_type;
 
-        typedef components::locking_hook<
-                hpx::components::simple_component_base<
-                    partition_unordered_map<Key, T, Hash, KeyEqual> > >
+        typedef hpx::components::simple_component_base<
+                partition_unordered_map<Key, T, Hash, KeyEqual> >
             base_type;
 
     private:
-        data_type partition_unordered_map_;
+        table_type partition_unordered_map_;
 
     public:
         ///////////////////////////////////////////////////////////////////////
@@ -120,11 +138,15 @@ namespace hpx { namespace server
         /// Duplicate the copy method for action naming
         data_type get_copied_data() const
         {
-            return partition_unordered_map_;
+            std::vector<typename table_type::value_type> values(
+                partition_unordered_map_.snapshot());
+            return data_type(std::make_move_iterator(values.begin()),
+                std::make_move_iterator(values.end()));
         }
         void set_copied_data(data_type && d)
         {
-            partition_unordered_map_ = std::move(d);
+            table_type t(d.begin(), d.end(), d.size());
+            partition_unordered_map_.swap(t);
         }
 
         ///////////////////////////////////////////////////////////////////////
@@ -196,36 +218,17 @@ namespace hpx { namespace server
         /// \return Return the value of the element at position represented
         ///         by \a pos.
         ///
-        struct erase_on_exit
-        {
-            erase_on_exit(data_type& m, typename data_type::iterator& it)
-              : m_(m), it_(it)
-            {}
-            ~erase_on_exit()
-            {
-                m_.erase(it_);
-            }
-
-            data_type& m_;
-            typename data_type::iterator& it_;
-        };
-
         T get_value(Key const& key, bool erase)
         {
-            typename data_type::iterator it = partition_unordered_map_.find(key);
-            if (it == partition_unordered_map_.end())
+            T result;
+            if (!partition_unordered_map_.get_value(key, result, erase))
             {
                 HPX_THROW_EXCEPTION(bad_parameter,
                     "partition_unordered_map::get_value",
                     "unable to find requested key in this partition of the "
                     "unordered_map");
             }
-
-            if (!erase)
-                return it->second;
-
-            erase_on_exit t(partition_unordered_map_, it);
-            return it->second;
+            return result;
         }
 
         /// Return the element at the position \a pos in the partition_unordered_map
@@ -239,21 +242,12 @@ namespace hpx { namespace server
         std::vector<T> get_values(std::vector<Key> const& keys)
         {
             std::vector<T> result;
-            result.reserve(keys.size());
-
-            for (std::size_t i = 0; i != keys.size(); ++i)
+            if (!partition_unordered_map_.get_values(keys, result))
             {
-                typename data_type::iterator it =
-                    partition_unordered_map_.find(keys[i]);
-                if (it == partition_unordered_map_.end())
-                {
-                    HPX_THROW_EXCEPTION(bad_parameter,
-                        "partition_unordered_map::get_values",
-                        "unable to find requested key in this partition of the "
-                        "unordered_map");
-                    break;
-                }
-                result.push_back(it->second);
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "partition_unordered_map::get_values",
+                    "unable to find requested key in this partition of the "
+                    "unordered_map");
             }
             return result;
         }
@@ -271,7 +265,7 @@ namespace hpx { namespace server
         ///
         void set_value(Key const& pos, T const& val)
         {
-            partition_unordered_map_[pos] = val;
+            partition_unordered_map_.insert_or_assign(pos, val);
         }
 
         /// Copy the value of \a val for the elements at positions \a pos in
@@ -285,10 +279,49 @@ namespace hpx { namespace server
             std::vector<T> const& val)
         {
             HPX_ASSERT(keys.size() == val.size());
-            HPX_ASSERT(keys.size() <= partition_unordered_map_.size());
-
-            for (std::size_t i = 0; i != keys.size(); ++i)
-                partition_unordered_map_[keys[i]] = val[i];
+            partition_unordered_map_.set_values(keys, val);
+        }
+
+        /// Apply a batch of element accesses to the partition_unordered_map
+        /// container. The values are written first, then the update
+        /// functions are invoked (inserting missing elements), and then the
+        /// requested values are read.
+        ///
+        /// \param set_keys     Keys of the elements to write
+        /// \param set_vals     The values to be copied
+        /// \param update_keys  Keys of the elements to update
+        /// \param updates      The functions to invoke for the elements to
+        ///                     update
+        /// \param get_keys     Keys of the elements to read
+        ///
+        /// \return Return the values of the elements with the keys
+        ///         \a get_keys. If some of the keys are not stored in this
+        ///         partition, the second member holds for each key whether
+        ///         it was found (the corresponding value is default
+        ///         constructed otherwise).
+        ///
+        access_result_type access_values(std::vector<Key> const& set_keys,
+            std::vector<T> const& set_vals,
+            std::vector<Key> const& update_keys,
+            std::vector<update_function_type> const& updates,
+            std::vector<Key> const& get_keys)
+        {
+            if (!set_keys.empty())
+                partition_unordered_map_.set_values(set_keys, set_vals);
+            if (!update_keys.empty())
+                partition_unordered_map_.update_values(update_keys, updates);
+
+            access_result_type result;
+            if (get_keys.empty())
+                return result;
+
+            std::vector<char> found;
+            if (!partition_unordered_map_.get_values(get_keys, result.first,
+                    found))
+            {
+                result.second.assign(found.begin(), found.end());
+            }
+            return result;
         }
 
         /// Remove all elements from the vector leaving the
@@ -309,10 +342,11 @@ namespace hpx { namespace server
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, size);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_value);
-        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, get_values);
+        HPX_DEFINE_COMPONENT_ACTION(partition_unordered_map, get_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_value);
-        HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, set_values);
+        HPX_DEFINE_COMPONENT_ACTION(partition_unordered_map, set_values);
+        HPX_DEFINE_COMPONENT_ACTION(partition_unordered_map, access_values);
 
         HPX_DEFINE_COMPONENT_DIRECT_ACTION(partition_unordered_map, erase);
 
@@ -358,6 +392,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         BOOST_PP_CAT(partition_unordered_map, __LINE__)::set_values_action,   \
         BOOST_PP_CAT(__unordered_map_set_values_action_, name));              \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        BOOST_PP_CAT(partition_unordered_map, __LINE__)::access_values_action,\
+        BOOST_PP_CAT(__unordered_map_access_values_action_, name));           \
     HPX_REGISTER_ACTION_DECLARATION(                                          \
         BOOST_PP_CAT(partition_unordered_map, __LINE__)::size_action,         \
         BOOST_PP_CAT(__unordered_map_size_action_, name));                    \
@@ -417,6 +454,9 @@ namespace hpx { namespace server
     HPX_REGISTER_ACTION(                                                      \
         BOOST_PP_CAT(partition_unordered_map, __LINE__)::set_values_action,   \
         BOOST_PP_CAT(__unordered_map_set_values_action_, name));              \
+    HPX_REGISTER_ACTION(                                                      \
+        BOOST_PP_CAT(partition_unordered_map, __LINE__)::access_values_action,\
+        BOOST_PP_CAT(__unordered_map_access_values_action_, name));           \
     HPX_REGISTER_ACTION(                                                      \
         BOOST_PP_CAT(partition_unordered_map, __LINE__)::size_action,         \
         BOOST_PP_CAT(__unordered_map_size_action_, name));                    \
@@ -616,6 +656,24 @@ namespace hpx
                 this->get_id(), keys, vals);
         }
 
+        /// Apply a batch of element accesses to the partition_unordered_map
+        /// component, see server::partition_unordered_map::access_values.
+        ///
+        /// \return This returns the values read as an hpx::future
+        ///
+        future<typename server_type::access_result_type> access_values(
+            std::vector<Key> const& set_keys, std::vector<T> const& set_vals,
+            std::vector<Key> const& update_keys,
+            std::vector<typename server_type::update_function_type> const&
+                updates,
+            std::vector<Key> const& get_keys)
+        {
+            HPX_ASSERT(this->get_id());
+            return hpx::async<typename server_type::access_values_action>(
+                this->get_id(), set_keys, set_vals, update_keys, updates,
+                get_keys);
+        }
+
         /// Erase all values with the given key from the partition_unordered_map
         /// container.
         ///
@@ -22,11 +22,13 @@
 #include <hpx/util/assert.hpp>
 #include <hpx/util/bind.hpp>
 
+#include <hpx/components/containers/access_buffer.hpp>
 #include <hpx/components/containers/container_distribution_policy.hpp>
 #include <hpx/components/containers/unordered/partition_unordered_map_component.hpp>
 #include <hpx/components/containers/unordered/unordered_map_segmented_iterator.hpp>
 
 #include <boost/cstdint.hpp>
+#include <boost/exception_ptr.hpp>
 
 #include <cstdint>
 #include <memory>
@@ -327,11 +329,6 @@ namespace hpx
         }
 
         ///////////////////////////////////////////////////////////////////////
-        std::size_t get_partition(Key const& key) const
-        {
-            return this->hasher_(key) % partitions_.size();
-        }
-
         std::vector<hpx::id_type> get_partition_ids() const
         {
             std::vector<hpx::id_type> ids;
@@ -585,6 +582,12 @@ namespace hpx
             return partitions_.size();
         }
 
+        // Return the sequence number of the partition holding the given key
+        std::size_t get_partition(Key const& key) const
+        {
+            return this->hasher_(key) % partitions_.size();
+        }
+
         /// \brief Array subscript operator. This does not throw any exception.
         ///
         /// \param pos Position of the element in the unordered_map
@@ -826,6 +829,56 @@ namespace hpx
                 part_data.partition_).erase(key);
         }
 
+        /// Asynchronously apply a batch of element accesses to the given
+        /// partition using a single action. The values are written first,
+        /// then the update functions are invoked (inserting missing
+        /// elements), and then the requested values are read. This is used
+        /// by hpx::access_buffer.
+        ///
+        /// \param part         Sequence number of the partition
+        /// \param set_keys     Keys of the elements to write
+        /// \param set_vals     The values to be copied
+        /// \param update_keys  Keys of the elements to update
+        /// \param updates      The functions to invoke for the elements to
+        ///                     update
+        /// \param get_keys     Keys of the elements to read
+        ///
+        /// \return Returns the hpx::future to the values of the elements
+        ///         with the keys \a get_keys and whether they were found
+        ///         (see partition_unordered_map::access_values).
+        ///
+        future<typename partition_unordered_map_server::access_result_type>
+        access_values(size_type part, std::vector<Key> const& set_keys,
+            std::vector<T> const& set_vals,
+            std::vector<Key> const& update_keys,
+            std::vector<
+                typename partition_unordered_map_server::update_function_type
+            > const& updates,
+            std::vector<Key> const& get_keys)
+        {
+            HPX_ASSERT(part < partitions_.size());
+
+            partition_data const& part_data = partitions_[part];
+            if (part_data.local_data_)
+            {
+                try {
+                    return make_ready_future(
+                        part_data.local_data_->access_values(set_keys,
+                            set_vals, update_keys, updates, get_keys));
+                }
+                catch (...) {
+                    return make_exceptional_future<
+                            typename partition_unordered_map_server::
+                                access_result_type
+                        >(boost::current_exception());
+                }
+            }
+
+            return partition_unordered_map_client(part_data.partition_)
+                .access_values(set_keys, set_vals, update_keys, updates,
+                    get_keys);
+        }
+
         ///////////////////////////////////////////////////////////////////////
         typedef segment_unordered_map_iterator<
                 Key, T, Hash, KeyEqual,
@@ -867,6 +920,31 @@ namespace hpx
             return const_segment_iterator(partitions_.cend(), this);
         }
     };
+
+    namespace traits
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Key, typename T, typename Hash, typename KeyEqual>
+        struct partitioned_container_access<
+            unordered_map<Key, T, Hash, KeyEqual> >
+        {
+            typedef Key key_type;
+            typedef Key local_key_type;
+            typedef T value_type;
+
+            static std::size_t get_partition(
+                unordered_map<Key, T, Hash, KeyEqual> const& m, Key const& key)
+            {
+                return m.get_partition(key);
+            }
+
+            static Key const& get_local_key(
+                unordered_map<Key, T, Hash, KeyEqual> const&, Key const& key)
+            {
+                return key;
+            }
+        };
+    }
 }
 
 #endif
@@ -192,6 +192,28 @@
 #  define HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS 4096
 #endif
 
+///////////////////////////////////////////////////////////////////////////////
+// Number of localities the bootstrap locality (and every locality forwarding
+// the startup notifications) sends the startup notifications to directly
+#if !defined(HPX_AGAS_BOOTSTRAP_FANOUT)
+#  define HPX_AGAS_BOOTSTRAP_FANOUT 16
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Maximum time (in milliseconds) buffered AGAS reference counting requests
+// are kept before being sent (zero disables time based flushing)
+#if !defined(HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL)
+#  define HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL 10
+#endif
+
+///////////////////////////////////////////////////////////////////////////////
+// Maximum number of objects which can be given GIDs directly encoding their
+// local address at the same time on a locality (see
+// hpx.agas.use_address_encoding)
+#if !defined(HPX_AGAS_MAX_ENCODED_ADDRESSES)
+#  define HPX_AGAS_MAX_ENCODED_ADDRESSES 16777216
+#endif
+
 ///////////////////////////////////////////////////////////////////////////////
 /// This defines the initial global reference count associated with any created
 /// object.
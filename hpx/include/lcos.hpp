@@ -16,10 +16,18 @@
 #include <hpx/lcos/packaged_action.hpp>
 
 #include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/channel.hpp>
+#include <hpx/lcos/hierarchical_barrier.hpp>
 #include <hpx/lcos/latch.hpp>
 #include <hpx/lcos/queue.hpp>
 #include <hpx/lcos/reduce.hpp>
 #include <hpx/lcos/gather.hpp>
+#include <hpx/lcos/all_gather.hpp>
+#include <hpx/lcos/all_reduce.hpp>
+#include <hpx/lcos/all_to_all.hpp>
+#include <hpx/lcos/broadcast_to.hpp>
+#include <hpx/lcos/reduce_scatter.hpp>
+#include <hpx/lcos/scan.hpp>
 
 #include <hpx/include/local_lcos.hpp>
 #include <hpx/include/async.hpp>
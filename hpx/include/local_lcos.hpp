@@ -8,12 +8,18 @@
 #define HPX_6EB418B5_DC41_45A3_ADF4_C45A068F73D4
 
 #include <hpx/config.hpp>
+#include <hpx/lcos/local/atomic_future.hpp>
 #include <hpx/lcos/local/barrier.hpp>
+#include <hpx/lcos/local/channel.hpp>
+#include <hpx/lcos/local/cohort_lock.hpp>
+#include <hpx/lcos/local/completion_queue.hpp>
 #include <hpx/lcos/local/condition_variable.hpp>
 #include <hpx/lcos/local/counting_semaphore.hpp>
+#include <hpx/lcos/local/distributed_shared_mutex.hpp>
 #include <hpx/dataflow.hpp>
 #include <hpx/lcos/local/event.hpp>
 #include <hpx/lcos/local/latch.hpp>
+#include <hpx/lcos/local/mcs_lock.hpp>
 #include <hpx/lcos/local/mutex.hpp>
 #include <hpx/lcos/local/shared_mutex.hpp>
 #include <hpx/lcos/local/recursive_mutex.hpp>
@@ -0,0 +1,13 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_PIPELINE_OCT_18_2016_0212PM)
+#define HPX_PARALLEL_PIPELINE_OCT_18_2016_0212PM
+
+#include <hpx/config.hpp>
+#include <hpx/parallel/pipeline.hpp>
+
+#endif
+
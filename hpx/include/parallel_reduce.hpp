@@ -9,6 +9,7 @@
 
 #include <hpx/parallel/algorithms/reduce.hpp>
 #include <hpx/parallel/algorithms/reduce_by_key.hpp>
+#include <hpx/parallel/segmented_algorithms/reduce.hpp>
 
 #endif
 
@@ -8,6 +8,7 @@
 
 #include <hpx/config.hpp>
 #include <hpx/parallel/task_block.hpp>
+#include <hpx/parallel/fork_join_block.hpp>
 
 #endif
 
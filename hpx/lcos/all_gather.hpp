@@ -0,0 +1,156 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_gather.hpp
+
+#if !defined(HPX_LCOS_ALL_GATHER_OCT_18_2016_0830PM)
+#define HPX_LCOS_ALL_GATHER_OCT_18_2016_0830PM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// AllGather a set of values from different call sites
+    ///
+    /// This function receives a set of values from all call sites operating
+    /// on the given base name and makes all of them available on each of the
+    /// call sites. The values are exchanged using Bruck's algorithm, which
+    /// requires ceil(log2(num_sites)) rounds of point-to-point exchanges for
+    /// any number of sites.
+    ///
+    /// \param  basename    The base name identifying the all_gather operation
+    /// \param  local_result The value to transmit to all participating sites
+    ///                     from this call site.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_gather operation performed on
+    ///                     the given base name. This is optional and needs to
+    ///                     be supplied only if the all_gather operation on
+    ///                     the given base name has to be performed more than
+    ///                     once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding a vector with all
+    ///             values send by all participating sites (ordered by the
+    ///             sequence number of the sites). It will become ready once
+    ///             the all_gather operation has been completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<typename std::decay<T>::type> >
+    all_gather(char const* basename, T && local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // In round k (with dist = 2^k) each site sends the values it has
+        // collected so far to site (this_site - dist) and receives the values
+        // collected by site (this_site + dist). At the end, site i holds the
+        // values of the sites i, i+1, ..., i+num_sites-1 (modulo num_sites).
+        template <typename T>
+        hpx::future<std::vector<T> >
+        all_gather_round(std::shared_ptr<collective_data> data,
+            std::size_t dist, std::vector<T> && values);
+
+        template <typename T>
+        hpx::future<std::vector<T> >
+        all_gather_step(std::shared_ptr<collective_data> data,
+            std::size_t dist, std::vector<T> const& values,
+            hpx::future<void> sent, hpx::future<std::vector<T> > received)
+        {
+            sent.get();         // propagate any exceptions
+
+            std::vector<T> result(values);
+            std::vector<T> r = received.get();
+            result.insert(result.end(), std::make_move_iterator(r.begin()),
+                std::make_move_iterator(r.end()));
+
+            return all_gather_round(data, dist * 2, std::move(result));
+        }
+
+        template <typename T>
+        hpx::future<std::vector<T> >
+        all_gather_round(std::shared_ptr<collective_data> data,
+            std::size_t dist, std::vector<T> && values)
+        {
+            std::size_t const num_sites = data->num_sites_;
+            std::size_t const this_site = data->this_site_;
+
+            if (dist >= num_sites)
+            {
+                // rotate the values into the order of the sites
+                std::vector<T> result(num_sites);
+                for (std::size_t i = 0; i != num_sites; ++i)
+                {
+                    result[(this_site + i) % num_sites] =
+                        std::move(values[i]);
+                }
+                return hpx::make_ready_future(std::move(result));
+            }
+
+            std::size_t count = (std::min)(dist, num_sites - dist);
+            std::vector<T> to_send(values.begin(), values.begin() + count);
+
+            hpx::future<void> sent = send_value(*data,
+                (this_site + num_sites - dist) % num_sites, dist, to_send);
+
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+            return dataflow(
+                    util::bind(&detail::all_gather_step<T>, data, dist,
+                        std::move(values), _1, _2),
+                    std::move(sent),
+                    receive_value<std::vector<T> >(*data, dist)
+                );
+        }
+
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<std::vector<typename util::decay<T>::type> >
+    all_gather(char const* basename, T && local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        detail::init_collective_sites(num_sites, this_site);
+
+        typedef typename util::decay<T>::type result_type;
+
+        std::shared_ptr<detail::collective_data> data =
+            std::make_shared<detail::collective_data>(
+                detail::get_collective_site<std::vector<result_type> >(
+                    basename, this_site),
+                num_sites, generation);
+
+        return detail::all_gather_round(data, 1,
+            std::vector<result_type>(1, std::forward<T>(local_result)));
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,242 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_reduce.hpp
+
+#if !defined(HPX_LCOS_ALL_REDUCE_OCT_18_2016_0820PM)
+#define HPX_LCOS_ALL_REDUCE_OCT_18_2016_0820PM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// AllReduce a set of values from different call sites
+    ///
+    /// This function combines the values supplied by all call sites
+    /// operating on the given base name and makes the result available on
+    /// each of the call sites. The values are combined using recursive
+    /// doubling, which requires ceil(log2(num_sites)) rounds of pairwise
+    /// exchanges (plus two additional rounds if the number of sites is not
+    /// a power of two). The reduction operation is always applied to whole
+    /// values, bandwidth optimized algorithms (ring, Rabenseifner) which
+    /// reduce slices of the values are not used.
+    ///
+    /// \param  basename    The base name identifying the all_reduce operation
+    /// \param  local_result The value to combine with the values from the
+    ///                     other call sites.
+    /// \param  op          Reduction operation to apply to all values
+    ///                     supplied from all participating sites. The
+    ///                     operation has to be associative and commutative.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_reduce operation performed on
+    ///                     the given base name. This is optional and needs to
+    ///                     be supplied only if the all_reduce operation on
+    ///                     the given base name has to be performed more than
+    ///                     once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \note       Each call site has to invoke this function with the same
+    ///             base name, number of sites, and generation.
+    ///
+    /// \returns    This function returns a future holding the combined value.
+    ///             It will become ready once the all_reduce operation has
+    ///             been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename std::decay<T>::type>
+    all_reduce(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename F>
+        struct all_reduce_data : collective_data
+        {
+            template <typename F_>
+            all_reduce_data(std::shared_ptr<collective_site> site,
+                    std::size_t num_sites, std::size_t generation, F_ && op)
+              : collective_data(std::move(site), num_sites, generation),
+                op_(std::forward<F_>(op)),
+                pow2_(1)
+            {
+                while (pow2_ * 2 <= num_sites)
+                    pow2_ *= 2;
+            }
+
+            F op_;
+            std::size_t pow2_;  // largest power of two <= num_sites
+        };
+
+        // The sites [pow2, num_sites) fold their value into the sites
+        // [0, num_sites - pow2) before, and receive the final result from
+        // those sites after the recursive doubling. The tags used are:
+        //      0:          initial fold
+        //      mask:       recursive doubling rounds (mask < pow2)
+        //      pow2:       distribution of the final result
+        template <typename T>
+        T all_reduce_finish(hpx::future<void> sent, T const& value)
+        {
+            sent.get();         // propagate any exceptions
+            return value;
+        }
+
+        template <typename T>
+        T all_reduce_received(hpx::future<void> sent, hpx::future<T> received)
+        {
+            sent.get();         // propagate any exceptions
+            return received.get();
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        all_reduce_round(std::shared_ptr<all_reduce_data<T, F> > data,
+            std::size_t mask, T && value);
+
+        template <typename T, typename F>
+        hpx::future<T>
+        all_reduce_step(std::shared_ptr<all_reduce_data<T, F> > data,
+            std::size_t mask, T const& value, hpx::future<void> sent,
+            hpx::future<T> received)
+        {
+            sent.get();         // propagate any exceptions
+
+            std::size_t partner = data->this_site_ ^ mask;
+            T result = (partner < data->this_site_) ?
+                data->op_(received.get(), value) :
+                data->op_(value, received.get());
+
+            return all_reduce_round(data, mask << 1, std::move(result));
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        all_reduce_round(std::shared_ptr<all_reduce_data<T, F> > data,
+            std::size_t mask, T && value)
+        {
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+
+            std::size_t const this_site = data->this_site_;
+            std::size_t const pow2 = data->pow2_;
+
+            if (mask >= pow2)
+            {
+                hpx::future<void> sent;
+                if (this_site < data->num_sites_ - pow2)
+                {
+                    // hand the result to the site which has folded its
+                    // value into this one
+                    sent = send_value(*data, this_site + pow2, pow2,
+                        value);
+                }
+                else
+                {
+                    sent = hpx::make_ready_future();
+                }
+
+                return sent.then(util::bind(
+                    &detail::all_reduce_finish<T>, _1, std::move(value)));
+            }
+
+            // exchange the values with the partner site
+            hpx::future<void> sent =
+                send_value(*data, this_site ^ mask, mask, value);
+
+            return dataflow(
+                    util::bind(&detail::all_reduce_step<T, F>, data, mask,
+                        std::move(value), _1, _2),
+                    std::move(sent), receive_value<T>(*data, mask)
+                );
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        all_reduce_fold(std::shared_ptr<all_reduce_data<T, F> > data,
+            T const& value, hpx::future<T> received)
+        {
+            return all_reduce_round(data, 1,
+                data->op_(value, received.get()));
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        all_reduce_start(std::shared_ptr<all_reduce_data<T, F> > data,
+            T const& value)
+        {
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+
+            std::size_t const this_site = data->this_site_;
+            std::size_t const pow2 = data->pow2_;
+
+            if (this_site >= pow2)
+            {
+                // fold the value into the corresponding site and wait for
+                // the final result
+                return dataflow(
+                        util::bind(&detail::all_reduce_received<T>, _1, _2),
+                        send_value(*data, this_site - pow2, 0, value),
+                        receive_value<T>(*data, pow2)
+                    );
+            }
+
+            if (this_site < data->num_sites_ - pow2)
+            {
+                // receive the value of the site folding into this one
+                return receive_value<T>(*data, 0).then(util::bind(
+                    &detail::all_reduce_fold<T, F>, data, value, _1));
+            }
+
+            return all_reduce_round(data, 1, T(value));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    all_reduce(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        detail::init_collective_sites(num_sites, this_site);
+
+        typedef typename util::decay<T>::type result_type;
+        typedef typename util::decay<F>::type reduction_type;
+        typedef detail::all_reduce_data<result_type, reduction_type>
+            data_type;
+
+        std::shared_ptr<data_type> data = std::make_shared<data_type>(
+            detail::get_collective_site<result_type>(basename, this_site),
+            num_sites, generation, std::forward<F>(op));
+
+        return detail::all_reduce_start(data,
+            result_type(std::forward<T>(local_result)));
+    }
+}}
+
+#endif // DOXYGEN
+#endif
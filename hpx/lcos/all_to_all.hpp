@@ -0,0 +1,157 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file all_to_all.hpp
+
+#if !defined(HPX_LCOS_ALL_TO_ALL_OCT_18_2016_0840PM)
+#define HPX_LCOS_ALL_TO_ALL_OCT_18_2016_0840PM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// AllToAll a set of values from different call sites
+    ///
+    /// This function sends the i-th of the given values to the i-th of the
+    /// call sites operating on the given base name and receives one value
+    /// from each of the call sites in exchange. All values are exchanged
+    /// directly between the corresponding sites.
+    ///
+    /// \param  basename    The base name identifying the all_to_all operation
+    /// \param  local_result The values to transmit to the participating
+    ///                     sites. This vector must hold exactly one element
+    ///                     for each of the sites.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the all_to_all operation performed on
+    ///                     the given base name. This is optional and needs to
+    ///                     be supplied only if the all_to_all operation on
+    ///                     the given base name has to be performed more than
+    ///                     once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding a vector with the
+    ///             values sent to this site by all participating sites
+    ///             (ordered by the sequence number of the sites). It will
+    ///             become ready once the all_to_all operation has been
+    ///             completed.
+    ///
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> const& local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/util/bind.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The values sent to a site are tagged with the sequence number of
+        // the sending site.
+        template <typename T>
+        std::vector<T>
+        all_to_all_finish(std::shared_ptr<collective_data> const& data,
+            T const& value, std::vector<hpx::future<void> > sent,
+            std::vector<hpx::future<T> > received)
+        {
+            for (hpx::future<void>& f : sent)
+                f.get();        // propagate any exceptions
+
+            std::vector<T> result;
+            result.reserve(data->num_sites_);
+
+            // there is no value received from this site itself
+            for (std::size_t i = 0; i != data->num_sites_; ++i)
+            {
+                if (i < data->this_site_)
+                    result.push_back(received[i].get());
+                else if (i == data->this_site_)
+                    result.push_back(value);
+                else
+                    result.push_back(received[i - 1].get());
+            }
+
+            return result;
+        }
+
+        template <typename T>
+        hpx::future<std::vector<T> >
+        all_to_all_start(std::shared_ptr<collective_data> const& data,
+            std::vector<T> const& values)
+        {
+            std::size_t const num_sites = data->num_sites_;
+            std::size_t const this_site = data->this_site_;
+
+            std::vector<hpx::future<void> > sent;
+            sent.reserve(num_sites - 1);
+
+            std::vector<hpx::future<T> > received;
+            received.reserve(num_sites - 1);
+
+            for (std::size_t i = 0; i != num_sites; ++i)
+            {
+                if (i == this_site)
+                    continue;
+
+                sent.push_back(
+                    send_value(*data, i, this_site, values[i]));
+                received.push_back(receive_value<T>(*data, i));
+            }
+
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+            return dataflow(
+                    util::bind(&detail::all_to_all_finish<T>, data,
+                        values[this_site], _1, _2),
+                    std::move(sent), std::move(received)
+                );
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<std::vector<T> >
+    all_to_all(char const* basename, std::vector<T> const& local_result,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        detail::init_collective_sites(num_sites, this_site);
+
+        if (local_result.size() != num_sites)
+        {
+            HPX_THROW_EXCEPTION(bad_parameter, "hpx::lcos::all_to_all",
+                "the number of values must be equal to the number of sites");
+        }
+
+        std::shared_ptr<detail::collective_data> data =
+            std::make_shared<detail::collective_data>(
+                detail::get_collective_site<T>(basename, this_site),
+                num_sites, generation);
+
+        return detail::all_to_all_start(data, local_result);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,547 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file broadcast_to.hpp
+
+#if !defined(HPX_LCOS_BROADCAST_TO_OCT_19_2016_1000AM)
+#define HPX_LCOS_BROADCAST_TO_OCT_19_2016_1000AM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Broadcast a value to all other call sites
+    ///
+    /// This function sends the given value to all call sites operating on
+    /// the given base name (where the corresponding \a broadcast_from is
+    /// executed).
+    ///
+    /// The value is distributed along a k-nomial tree. Small values are sent
+    /// using a wide tree (minimizing the latency), larger values use a
+    /// binomial tree. Large values of type std::vector<T> are split into
+    /// segments of HPX_BROADCAST_SEGMENT_SIZE bytes, each of the segments is
+    /// forwarded as soon as it has arrived on a site (pipelining the
+    /// transfers through the tree). If the sites are the localities (i.e.
+    /// neither \a num_sites nor \a this_site have been specified), the tree
+    /// is built such that each host receives the value only once, the
+    /// value is then distributed to all other localities on that host.
+    ///
+    /// \param  basename    The base name identifying the broadcast operation
+    /// \param  value       The value to transmit to all other call sites.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the broadcast operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the broadcast operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future which will become ready once
+    ///             the value has been sent to all of the call sites this site
+    ///             is responsible for.
+    ///
+    template <typename T>
+    hpx::future<void>
+    broadcast_to(char const* basename, T && value,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+
+    /// Receive a value which was broadcast from a given call site
+    ///
+    /// This function receives the value sent by the call site executing
+    /// the corresponding \a broadcast_to.
+    ///
+    /// \param  basename    The base name identifying the broadcast operation
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the broadcast operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the broadcast operation on the
+    ///                     given base name has to be performed more than once.
+    /// \param root_site    The sequence number of the site executing
+    ///                     \a broadcast_to (usually the locality id). This
+    ///                     value is optional and defaults to 0.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding the received value.
+    ///             It will become ready once the value has been received and
+    ///             forwarded to all of the call sites this site is
+    ///             responsible for.
+    ///
+    template <typename T>
+    hpx::future<T>
+    broadcast_from(char const* basename,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/when_all.hpp>
+#include <hpx/runtime/find_localities.hpp>
+#include <hpx/runtime/get_locality_name.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <memory>
+#include <string>
+#include <utility>
+#include <vector>
+
+#if !defined(HPX_BROADCAST_FANOUT)
+#define HPX_BROADCAST_FANOUT 16
+#endif
+
+#if !defined(HPX_BROADCAST_SEGMENT_SIZE)
+#define HPX_BROADCAST_SEGMENT_SIZE (1024 * 1024)
+#endif
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Values of arbitrary types are sent as a whole.
+        template <typename T>
+        struct broadcast_segments
+        {
+            static std::size_t size(T const&)
+            {
+                return sizeof(T);
+            }
+
+            static std::size_t max_segments(T const&)
+            {
+                return 1;
+            }
+
+            static T get(T const& t, std::size_t, std::size_t)
+            {
+                return t;
+            }
+
+            static void append(T& t, T && segment)
+            {
+                t = std::move(segment);
+            }
+        };
+
+        // Vectors are split into segments of (almost) equal size.
+        template <typename T, typename Allocator>
+        struct broadcast_segments<std::vector<T, Allocator> >
+        {
+            typedef std::vector<T, Allocator> vector_type;
+
+            static std::size_t size(vector_type const& v)
+            {
+                return v.size() * sizeof(T);
+            }
+
+            static std::size_t max_segments(vector_type const& v)
+            {
+                return v.empty() ? 1 : v.size();
+            }
+
+            static vector_type get(vector_type const& v, std::size_t i,
+                std::size_t num_segments)
+            {
+                std::size_t first = (v.size() * i) / num_segments;
+                std::size_t last = (v.size() * (i + 1)) / num_segments;
+                return vector_type(v.begin() + first, v.begin() + last);
+            }
+
+            static void append(vector_type& v, vector_type && segment)
+            {
+                if (v.empty())
+                {
+                    v = std::move(segment);
+                    return;
+                }
+                v.insert(v.end(), std::make_move_iterator(segment.begin()),
+                    std::make_move_iterator(segment.end()));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Return the index of the host for each of the localities (in the
+        // order of their locality ids). This is computed only once.
+        inline std::vector<std::size_t> get_locality_hosts_ready(
+            std::vector<hpx::id_type> const& localities,
+            std::vector<hpx::future<std::string> > names)
+        {
+            std::vector<std::size_t> hosts(localities.size(), 0);
+            std::map<std::string, std::size_t> host_indices;
+
+            for (std::size_t i = 0; i != localities.size(); ++i)
+            {
+                std::size_t index = host_indices.insert(
+                    std::make_pair(names[i].get(), host_indices.size())
+                ).first->second;
+
+                hosts[naming::get_locality_id_from_id(localities[i])] = index;
+            }
+            return hosts;
+        }
+
+        inline hpx::shared_future<std::vector<std::size_t> >
+        get_locality_hosts()
+        {
+            static hpx::shared_future<std::vector<std::size_t> > hosts =
+                []() -> hpx::future<std::vector<std::size_t> >
+                {
+                    std::vector<hpx::id_type> localities =
+                        hpx::find_all_localities();
+
+                    std::vector<hpx::future<std::string> > names;
+                    names.reserve(localities.size());
+                    for (hpx::id_type const& id : localities)
+                        names.push_back(hpx::get_locality_name(id));
+
+                    using util::placeholders::_1;
+                    return dataflow(
+                            util::bind(&detail::get_locality_hosts_ready,
+                                localities, _1),
+                            std::move(names)
+                        );
+                }();
+            return hosts;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Append the children of the node 'rank' in a k-nomial tree of the
+        // given size (rooted at rank 0) to 'children', largest subtrees first.
+        template <typename F>
+        void knomial_tree_children(std::size_t rank, std::size_t size,
+            std::size_t radix, F && add_child)
+        {
+            std::size_t mask = 1;
+            while (mask < size && rank % (mask * radix) == 0)
+                mask *= radix;
+
+            for (mask /= radix; mask != 0; mask /= radix)
+            {
+                for (std::size_t j = 1; j != radix; ++j)
+                {
+                    std::size_t child = rank + j * mask;
+                    if (child < size)
+                        add_child(child);
+                }
+            }
+        }
+
+        // The broadcast tree is built from two levels of k-nomial trees: one
+        // spanning the first site on each of the hosts, and one spanning all
+        // sites on a host (rooted at the first site on that host). Without
+        // any host information all sites are considered to be on one host.
+        inline std::vector<std::size_t> broadcast_children(
+            std::vector<std::size_t> const& hosts, std::size_t num_sites,
+            std::size_t root_site, std::size_t this_site, std::size_t radix)
+        {
+            // group the sites by host, starting with the host of the root
+            std::vector<std::vector<std::size_t> > groups;
+            std::map<std::size_t, std::size_t> group_indices;
+
+            std::size_t this_group = 0;
+            std::size_t this_rank = 0;
+            for (std::size_t i = 0; i != num_sites; ++i)
+            {
+                std::size_t site = (root_site + i) % num_sites;
+                std::size_t host = hosts.empty() ? 0 : hosts[site];
+
+                std::size_t group = group_indices.insert(
+                    std::make_pair(host, groups.size())).first->second;
+                if (group == groups.size())
+                    groups.push_back(std::vector<std::size_t>());
+
+                if (site == this_site)
+                {
+                    this_group = group;
+                    this_rank = groups[group].size();
+                }
+                groups[group].push_back(site);
+            }
+
+            std::vector<std::size_t> children;
+
+            // the first site on each host forwards to the other hosts first
+            if (this_rank == 0)
+            {
+                knomial_tree_children(this_group, groups.size(), radix,
+                    [&](std::size_t child)
+                    {
+                        children.push_back(groups[child][0]);
+                    });
+            }
+
+            std::vector<std::size_t> const& group = groups[this_group];
+            knomial_tree_children(this_rank, group.size(), radix,
+                [&](std::size_t child)
+                {
+                    children.push_back(group[child]);
+                });
+
+            return children;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        inline void broadcast_sent(
+            hpx::future<std::vector<hpx::future<void> > > f)
+        {
+            std::vector<hpx::future<void> > sent = f.get();
+            for (hpx::future<void>& s : sent)
+                s.get();        // propagate any exceptions
+        }
+
+        // the mailboxes of the children of this site, the mailbox of each
+        // site is resolved only once for all broadcasts on a base name
+        inline std::vector<hpx::shared_future<hpx::id_type> >
+        broadcast_resolve_children(collective_data const& data,
+            std::vector<std::size_t> const& children)
+        {
+            std::vector<hpx::shared_future<hpx::id_type> > ids;
+            ids.reserve(children.size());
+            for (std::size_t child : children)
+                ids.push_back(data.site_->get_partner(child));
+            return ids;
+        }
+
+        template <typename T>
+        hpx::future<void>
+        broadcast_forward_segment(collective_data const& data,
+            std::vector<hpx::shared_future<hpx::id_type> > const& children,
+            std::size_t tag, broadcast_message<T> const& msg)
+        {
+            std::vector<hpx::future<void> > sent;
+            sent.reserve(children.size());
+            for (hpx::shared_future<hpx::id_type> const& id : children)
+            {
+                if (id.is_ready())
+                {
+                    sent.push_back(set_mailbox_value(id, data.generation_,
+                        tag, msg));
+                    continue;
+                }
+
+                using util::placeholders::_1;
+                sent.push_back(id.then(util::bind(
+                    &detail::set_mailbox_value<broadcast_message<T> >, _1,
+                    data.generation_, tag, msg)));
+            }
+
+            return when_all(std::move(sent)).then(&detail::broadcast_sent);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        hpx::future<void>
+        broadcast_to_start(std::shared_ptr<collective_data> const& data,
+            T const& value,
+            hpx::shared_future<std::vector<std::size_t> > hosts)
+        {
+            std::size_t const num_sites = data->num_sites_;
+            std::size_t const this_site = data->this_site_;
+
+            typedef broadcast_segments<T> segments;
+
+            // split large values into segments to be forwarded
+            // independently, send small values using a wide tree
+            std::size_t const size = segments::size(value);
+            std::size_t num_segments =
+                (size + HPX_BROADCAST_SEGMENT_SIZE - 1) /
+                    HPX_BROADCAST_SEGMENT_SIZE;
+            num_segments = (std::max)(std::size_t(1),
+                (std::min)(num_segments, segments::max_segments(value)));
+
+            std::size_t radix = 2;
+            if (num_segments == 1 &&
+                size * HPX_BROADCAST_FANOUT <= HPX_BROADCAST_SEGMENT_SIZE)
+            {
+                radix = (std::max)(std::size_t(2),
+                    (std::min)(num_sites, std::size_t(HPX_BROADCAST_FANOUT)));
+            }
+
+            std::vector<hpx::shared_future<hpx::id_type> > children =
+                broadcast_resolve_children(*data, broadcast_children(
+                    hosts.get(), num_sites, this_site, this_site, radix));
+
+            std::vector<hpx::future<void> > sent;
+            sent.reserve(num_segments);
+            for (std::size_t i = 0; i != num_segments; ++i)
+            {
+                broadcast_message<T> msg = {
+                    radix, num_segments,
+                    segments::get(value, i, num_segments)
+                };
+                sent.push_back(
+                    broadcast_forward_segment(*data, children, i, msg));
+            }
+
+            return when_all(std::move(sent)).then(&detail::broadcast_sent);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        T broadcast_segment_forwarded(T const& data, hpx::future<void> sent)
+        {
+            sent.get();         // propagate any exceptions
+            return data;
+        }
+
+        template <typename T>
+        hpx::future<T>
+        broadcast_forward(std::shared_ptr<collective_data> const& data,
+            std::vector<hpx::shared_future<hpx::id_type> > const& children,
+            std::size_t tag, hpx::future<broadcast_message<T> > f)
+        {
+            broadcast_message<T> msg = f.get();
+            hpx::future<void> sent =
+                broadcast_forward_segment(*data, children, tag, msg);
+
+            using util::placeholders::_1;
+            return sent.then(
+                util::bind(&detail::broadcast_segment_forwarded<T>,
+                    std::move(msg.data_), _1));
+        }
+
+        template <typename T>
+        T broadcast_from_finish(std::vector<hpx::future<T> > segments)
+        {
+            T result = segments[0].get();
+            for (std::size_t i = 1; i != segments.size(); ++i)
+                broadcast_segments<T>::append(result, segments[i].get());
+            return result;
+        }
+
+        template <typename T>
+        hpx::future<T>
+        broadcast_from_received(std::shared_ptr<collective_data> data,
+            std::size_t root_site, std::vector<std::size_t> const& hosts,
+            hpx::future<broadcast_message<T> > f)
+        {
+            using util::placeholders::_1;
+
+            broadcast_message<T> msg = f.get();
+            std::size_t const num_segments = msg.num_segments_;
+
+            std::vector<hpx::shared_future<hpx::id_type> > children =
+                broadcast_resolve_children(*data, broadcast_children(
+                    hosts, data->num_sites_, root_site, data->this_site_,
+                    msg.radix_));
+
+            // forward each segment as soon as it has arrived
+            std::vector<hpx::future<T> > segments;
+            segments.reserve(num_segments);
+            segments.push_back(broadcast_forward(data, children, 0,
+                hpx::make_ready_future(std::move(msg))));
+
+            for (std::size_t i = 1; i != num_segments; ++i)
+            {
+                segments.push_back(
+                    receive_value<broadcast_message<T> >(*data, i).then(
+                        util::bind(&detail::broadcast_forward<T>, data,
+                            children, i, _1)));
+            }
+
+            return dataflow(&detail::broadcast_from_finish<T>,
+                std::move(segments));
+        }
+
+        template <typename T>
+        hpx::future<T>
+        broadcast_from_start(std::shared_ptr<collective_data> data,
+            std::size_t root_site,
+            hpx::shared_future<std::vector<std::size_t> > hosts)
+        {
+            using util::placeholders::_1;
+            return receive_value<broadcast_message<T> >(*data, 0).then(
+                    util::bind(&detail::broadcast_from_received<T>, data,
+                        root_site, hosts.get(), _1)
+                );
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // group the sites by host only if the sites are the localities
+        inline hpx::shared_future<std::vector<std::size_t> >
+        broadcast_hosts(std::size_t num_sites, std::size_t this_site)
+        {
+            if (num_sites == std::size_t(-1) && this_site == std::size_t(-1))
+                return get_locality_hosts();
+
+            return hpx::make_ready_future(std::vector<std::size_t>());
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<void>
+    broadcast_to(char const* basename, T && value,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        hpx::shared_future<std::vector<std::size_t> > hosts =
+            detail::broadcast_hosts(num_sites, this_site);
+
+        detail::init_collective_sites(num_sites, this_site);
+
+        typedef typename util::decay<T>::type value_type;
+
+        std::shared_ptr<detail::collective_data> data =
+            std::make_shared<detail::collective_data>(
+                detail::get_collective_site<
+                        detail::broadcast_message<value_type>
+                    >(basename, this_site),
+                num_sites, generation);
+
+        using util::placeholders::_1;
+        return hosts.then(
+                util::bind(&detail::broadcast_to_start<value_type>,
+                    data, std::forward<T>(value), _1)
+            );
+    }
+
+    template <typename T>
+    hpx::future<T>
+    broadcast_from(char const* basename,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1), std::size_t root_site = 0,
+        std::size_t this_site = std::size_t(-1))
+    {
+        hpx::shared_future<std::vector<std::size_t> > hosts =
+            detail::broadcast_hosts(num_sites, this_site);
+
+        detail::init_collective_sites(num_sites, this_site);
+
+        std::shared_ptr<detail::collective_data> data =
+            std::make_shared<detail::collective_data>(
+                detail::get_collective_site<detail::broadcast_message<T> >(
+                    basename, this_site),
+                num_sites, generation);
+
+        using util::placeholders::_1;
+        return hosts.then(
+                util::bind(&detail::broadcast_from_start<T>, data, root_site,
+                    _1)
+            );
+    }
+}}
+
+#endif // DOXYGEN
+#endif
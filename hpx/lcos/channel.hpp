@@ -0,0 +1,123 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/channel.hpp
+
+#if !defined(HPX_LCOS_CHANNEL_OCT_19_2016_1150AM)
+#define HPX_LCOS_CHANNEL_OCT_19_2016_1150AM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/server/channel.hpp>
+#include <hpx/runtime/components/client_base.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/preprocessor/cat.hpp>
+
+#include <cstddef>
+#include <utility>
+
+///////////////////////////////////////////////////////////////////////////////
+namespace hpx { namespace lcos
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A channel which can be accessed from any locality. The values sent
+    /// through the channel are buffered on the locality the channel was
+    /// created on. The types used with this channel have to be registered
+    /// using \a HPX_REGISTER_CHANNEL.
+    template <typename T>
+    class channel
+      : public components::client_base<channel<T>, lcos::server::channel<T> >
+    {
+        typedef components::client_base<
+                channel, lcos::server::channel<T>
+            > base_type;
+
+    public:
+        channel()
+        {}
+
+        /// Create a new channel on the given locality. The channel is
+        /// unbounded unless a capacity is given, in which case sending a
+        /// value does not complete while the channel is full.
+        explicit channel(hpx::id_type const& locality,
+                std::size_t capacity = std::size_t(-1))
+          : base_type(hpx::new_<lcos::server::channel<T> >(locality, capacity))
+        {}
+
+        /// Create a client side representation for the existing
+        /// \a server#channel instance with the given global id \a id.
+        channel(hpx::future<hpx::id_type> && id)
+          : base_type(std::move(id))
+        {}
+
+        ///////////////////////////////////////////////////////////////////////
+        // exposed functionality of this component
+
+        /// Send the given value through the channel. The returned future
+        /// becomes ready once the value has been accepted by the channel.
+        hpx::future<void> set(T val)
+        {
+            typedef typename lcos::server::channel<T>::set_action action_type;
+
+            HPX_ASSERT(this->get_gid());
+            return hpx::async<action_type>(this->get_gid(), std::move(val));
+        }
+
+        /// Return a future which becomes ready as soon as a value has been
+        /// received from the channel.
+        hpx::future<T> get() const
+        {
+            typedef typename lcos::server::channel<T>::get_action action_type;
+
+            HPX_ASSERT(this->get_gid());
+            return hpx::async<action_type>(this->get_gid());
+        }
+
+        /// Close the channel, see \a hpx::lcos::local::channel::close.
+        hpx::future<void> close()
+        {
+            typedef typename lcos::server::channel<T>::close_action
+                action_type;
+
+            HPX_ASSERT(this->get_gid());
+            return hpx::async<action_type>(this->get_gid());
+        }
+    };
+}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_CHANNEL_DECLARATION(type, name)                          \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::channel<type>::set_action,                         \
+        BOOST_PP_CAT(channel_set_action_, name));                             \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::channel<type>::get_action,                         \
+        BOOST_PP_CAT(channel_get_action_, name));                             \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::server::channel<type>::close_action,                       \
+        BOOST_PP_CAT(channel_close_action_, name))                            \
+    /**/
+
+#define HPX_REGISTER_CHANNEL(type, name)                                      \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::channel<type>::set_action,                         \
+        BOOST_PP_CAT(channel_set_action_, name));                             \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::channel<type>::get_action,                         \
+        BOOST_PP_CAT(channel_get_action_, name));                             \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::server::channel<type>::close_action,                       \
+        BOOST_PP_CAT(channel_close_action_, name));                           \
+    typedef hpx::components::simple_component<                                \
+        hpx::lcos::server::channel<type>                                      \
+    > BOOST_PP_CAT(channel_component_, name);                                 \
+    HPX_REGISTER_COMPONENT(BOOST_PP_CAT(channel_component_, name))            \
+    /**/
+
+#endif
@@ -199,10 +199,13 @@ namespace hpx { namespace lcos { namespace detail
         {
             if (policy == hpx::launch::sync)
             {
+                count_continuation(continuation_inlined);
                 execute(indices_type(), is_void());
                 return;
             }
 
+            count_continuation(continuation_spawned);
+
             util::thread_description desc(func_, "dataflow_frame::finalize");
 
             // schedule the final function invocation with high priority
@@ -220,6 +223,8 @@ namespace hpx { namespace lcos { namespace detail
         HPX_FORCEINLINE
         void finalize(threads::executor& sched)
         {
+            count_continuation(continuation_spawned);
+
             execute_function_type f = &dataflow_frame::execute;
             boost::intrusive_ptr<dataflow_frame> this_(this);
             hpx::apply(sched, f, std::move(this_), indices_type(), is_void());
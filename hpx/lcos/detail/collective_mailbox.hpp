@@ -0,0 +1,417 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_DETAIL_COLLECTIVE_MAILBOX_OCT_18_2016_0810PM)
+#define HPX_LCOS_DETAIL_COLLECTIVE_MAILBOX_OCT_18_2016_0810PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/action_support.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+#include <hpx/runtime/components/new.hpp>
+#include <hpx/runtime/get_locality_id.hpp>
+#include <hpx/runtime/get_num_localities.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/runtime/naming/unmanaged.hpp>
+#include <hpx/runtime/serialization/vector.hpp>
+#include <hpx/runtime/shutdown_function.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/bind.hpp>
+
+#include <boost/preprocessor/cat.hpp>
+
+#include <cstddef>
+#include <map>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The distributed collectives (all_reduce, all_gather, all_to_all, etc.)
+    // are implemented as a sequence of point-to-point exchanges between the
+    // participating sites. Each site has one mailbox for each base name (and
+    // value type), which is created on first use and is reused by all
+    // invocations of collective operations on that base name. Every value
+    // sent to a site is tagged with the generation of the invocation and the
+    // step of the operation, the receiving site picks it up using the same
+    // generation and tag, regardless of whether the value has arrived before
+    // or after the receive was issued.
+    template <typename T>
+    class collective_mailbox_server
+      : public hpx::components::simple_component_base<
+            collective_mailbox_server<T> >
+    {
+        typedef lcos::local::spinlock mutex_type;
+        typedef lcos::local::promise<T> promise_type;
+
+        // generation, tag
+        typedef std::pair<std::size_t, std::size_t> key_type;
+
+    public:
+        collective_mailbox_server() {}
+
+        hpx::future<T> get_value(std::size_t generation, std::size_t tag)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            key_type key(generation, tag);
+            typename std::map<key_type, promise_type>::iterator it =
+                values_.find(key);
+            if (it == values_.end())
+            {
+                // the value has not arrived yet
+                return values_[key].get_future();
+            }
+
+            // the value has arrived already
+            hpx::future<T> f = it->second.get_future();
+            values_.erase(it);
+            return f;
+        }
+
+        void set_value(std::size_t generation, std::size_t tag, T && t)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            key_type key(generation, tag);
+            typename std::map<key_type, promise_type>::iterator it =
+                values_.find(key);
+            if (it == values_.end())
+            {
+                // nobody is waiting for the value yet, setting it can't
+                // trigger any continuations
+                values_[key].set_value(std::move(t));
+                return;
+            }
+
+            // somebody is waiting already, make the value available outside
+            // of the lock as this will run the attached continuations
+            promise_type p(std::move(it->second));
+            values_.erase(it);
+
+            l.unlock();
+            p.set_value(std::move(t));
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(
+            collective_mailbox_server, get_value, get_value_action);
+        HPX_DEFINE_COMPONENT_ACTION(
+            collective_mailbox_server, set_value, set_value_action);
+
+    private:
+        mutex_type mtx_;
+        std::map<key_type, promise_type> values_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline hpx::id_type register_mailbox_name(hpx::future<hpx::id_type> f,
+        std::string const& name, std::size_t site)
+    {
+        hpx::id_type target = f.get();
+        hpx::register_with_basename(name, hpx::unmanaged(target), site);
+        return target;
+    }
+
+    template <typename T>
+    hpx::future<hpx::id_type>
+    create_mailbox(std::string const& name, std::size_t this_site)
+    {
+        hpx::future<hpx::id_type> id =
+            hpx::new_<collective_mailbox_server<T> >(hpx::find_here());
+
+        using util::placeholders::_1;
+        return id.then(
+                util::bind(&detail::register_mailbox_name, _1, name, this_site)
+            );
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // The mailbox of this site for one base name, together with the
+    // mailboxes of the partner sites resolved so far. Each partner is
+    // resolved only once, regardless of the number of collective operations
+    // performed on the base name.
+    class collective_site
+    {
+        typedef lcos::local::spinlock mutex_type;
+
+    public:
+        collective_site(std::string const& name, std::size_t this_site,
+                hpx::future<hpx::id_type> id)
+          : name_(name), this_site_(this_site), id_(id.share())
+        {}
+
+        hpx::shared_future<hpx::id_type> get_partner(std::size_t site)
+        {
+            std::lock_guard<mutex_type> l(mtx_);
+
+            std::map<std::size_t, hpx::shared_future<hpx::id_type> >::iterator
+                it = partners_.find(site);
+            if (it == partners_.end())
+            {
+                it = partners_.insert(std::make_pair(site,
+                    hpx::find_from_basename(name_, site).share())).first;
+            }
+            return it->second;
+        }
+
+        std::string const name_;
+        std::size_t const this_site_;
+        hpx::shared_future<hpx::id_type> const id_;
+
+    private:
+        mutex_type mtx_;
+        std::map<std::size_t, hpx::shared_future<hpx::id_type> > partners_;
+    };
+
+    // All mailboxes created on this locality. They stay registered until
+    // the runtime shuts down.
+    class collective_sites
+    {
+        typedef lcos::local::spinlock mutex_type;
+        typedef std::pair<std::string, std::size_t> key_type;
+
+    public:
+        collective_sites()
+          : shutdown_registered_(false)
+        {}
+
+        template <typename T>
+        std::shared_ptr<collective_site>
+        get(std::string const& name, std::size_t this_site)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            key_type key(name, this_site);
+            typename std::map<key_type, std::shared_ptr<collective_site> >
+                ::iterator it = sites_.find(key);
+            if (it != sites_.end())
+                return it->second;
+
+            bool register_shutdown = !shutdown_registered_;
+            shutdown_registered_ = true;
+
+            std::shared_ptr<collective_site> site =
+                std::make_shared<collective_site>(name, this_site,
+                    create_mailbox<T>(name, this_site));
+            sites_.insert(std::make_pair(key, site));
+
+            l.unlock();
+
+            if (register_shutdown)
+            {
+                hpx::register_pre_shutdown_function(
+                    util::bind(&collective_sites::release, this));
+            }
+            return site;
+        }
+
+    private:
+        // unregister and release all mailboxes
+        void release()
+        {
+            std::map<key_type, std::shared_ptr<collective_site> > sites;
+
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                std::swap(sites, sites_);
+                shutdown_registered_ = false;
+            }
+
+            std::vector<hpx::future<hpx::id_type> > unregistered;
+            unregistered.reserve(sites.size());
+            for (auto const& site : sites)
+            {
+                site.second->id_.wait();
+                unregistered.push_back(hpx::unregister_with_basename(
+                    site.first.first, site.first.second));
+            }
+            hpx::wait_all(unregistered);
+        }
+
+        mutex_type mtx_;
+        std::map<key_type, std::shared_ptr<collective_site> > sites_;
+        bool shutdown_registered_;
+    };
+
+    inline collective_sites& get_collective_sites()
+    {
+        static collective_sites sites;
+        return sites;
+    }
+
+    // The mailbox of this site for the given base name and value type. The
+    // name of the action setting the values distinguishes the mailboxes of
+    // different value types registered with the same base name.
+    template <typename T>
+    std::shared_ptr<collective_site>
+    get_collective_site(char const* basename, std::size_t this_site)
+    {
+        typedef typename collective_mailbox_server<T>::set_value_action
+            action_type;
+
+        std::string name(basename);
+        name += "/";
+        name += hpx::actions::detail::get_action_name<action_type>();
+
+        return get_collective_sites().get<T>(name, this_site);
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    // Data shared by all steps of one invocation of a collective operation
+    // on one site.
+    struct collective_data
+    {
+        collective_data(std::shared_ptr<collective_site> site,
+                std::size_t num_sites, std::size_t generation)
+          : site_(std::move(site)), num_sites_(num_sites),
+            this_site_(site_->this_site_), generation_(generation)
+        {}
+
+        std::shared_ptr<collective_site> const site_;
+        std::size_t const num_sites_;
+        std::size_t const this_site_;
+        std::size_t const generation_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    // A (segment of a) value distributed by broadcast_to, carrying the shape
+    // of the broadcast tree and the number of segments to expect.
+    template <typename T>
+    struct broadcast_message
+    {
+        std::size_t radix_;
+        std::size_t num_segments_;
+        T data_;
+
+        template <typename Archive>
+        void serialize(Archive& ar, unsigned)
+        {
+            ar & radix_ & num_segments_ & data_;
+        }
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T>
+    hpx::future<void>
+    set_mailbox_value(hpx::shared_future<hpx::id_type> f,
+        std::size_t generation, std::size_t tag, T const& t)
+    {
+        typedef typename collective_mailbox_server<T>::set_value_action
+            action_type;
+        return async(action_type(), f.get(), generation, tag, t);
+    }
+
+    template <typename T>
+    hpx::future<T>
+    get_mailbox_value(hpx::shared_future<hpx::id_type> f,
+        std::size_t generation, std::size_t tag)
+    {
+        typedef typename collective_mailbox_server<T>::get_value_action
+            action_type;
+        return async(action_type(), f.get(), generation, tag);
+    }
+
+    // send the given value to the mailbox of the given site
+    template <typename T>
+    hpx::future<void>
+    send_value(collective_data const& data, std::size_t site,
+        std::size_t tag, T const& t)
+    {
+        hpx::shared_future<hpx::id_type> id = data.site_->get_partner(site);
+        if (id.is_ready())
+            return set_mailbox_value(id, data.generation_, tag, t);
+
+        using util::placeholders::_1;
+        return id.then(util::bind(&detail::set_mailbox_value<T>, _1,
+            data.generation_, tag, t));
+    }
+
+    // retrieve the value sent to this site using the given tag
+    template <typename T>
+    hpx::future<T>
+    receive_value(collective_data const& data, std::size_t tag)
+    {
+        hpx::shared_future<hpx::id_type> const& id = data.site_->id_;
+        if (id.is_ready())
+            return get_mailbox_value<T>(id, data.generation_, tag);
+
+        using util::placeholders::_1;
+        return id.then(util::bind(&detail::get_mailbox_value<T>, _1,
+            data.generation_, tag));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    inline void init_collective_sites(std::size_t& num_sites,
+        std::size_t& this_site)
+    {
+        if (num_sites == std::size_t(-1))
+            num_sites = hpx::get_num_localities_sync();
+        if (this_site == std::size_t(-1))
+            this_site = static_cast<std::size_t>(hpx::get_locality_id());
+
+        HPX_ASSERT(this_site < num_sites);
+    }
+}}}
+
+///////////////////////////////////////////////////////////////////////////////
+#define HPX_REGISTER_COLLECTIVE_MAILBOX_DECLARATION(type, name)               \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::collective_mailbox_server<type>::get_value_action, \
+        BOOST_PP_CAT(collective_get_value_action_, name));                    \
+    HPX_REGISTER_ACTION_DECLARATION(                                          \
+        hpx::lcos::detail::collective_mailbox_server<type>::set_value_action, \
+        BOOST_PP_CAT(collective_set_value_action_, name))                     \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVE_MAILBOX(type, name)                           \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::collective_mailbox_server<type>::get_value_action, \
+        BOOST_PP_CAT(collective_get_value_action_, name));                    \
+    HPX_REGISTER_ACTION(                                                      \
+        hpx::lcos::detail::collective_mailbox_server<type>::set_value_action, \
+        BOOST_PP_CAT(collective_set_value_action_, name));                    \
+    typedef hpx::components::simple_component<                                \
+        hpx::lcos::detail::collective_mailbox_server<type>                    \
+    > BOOST_PP_CAT(collective_mailbox_, name);                                \
+    HPX_REGISTER_COMPONENT(BOOST_PP_CAT(collective_mailbox_, name))           \
+    /**/
+
+// Register the types needed for using the distributed collectives
+// (all_reduce, all_gather, all_to_all, reduce_scatter, inclusive_scan,
+// exclusive_scan, and broadcast_to/broadcast_from) with values of the given
+// type.
+#define HPX_REGISTER_COLLECTIVES_DECLARATION(type, name)                      \
+    HPX_REGISTER_COLLECTIVE_MAILBOX_DECLARATION(type, name);                  \
+    HPX_REGISTER_COLLECTIVE_MAILBOX_DECLARATION(std::vector<type>,            \
+        BOOST_PP_CAT(vector_, name));                                         \
+    HPX_REGISTER_COLLECTIVE_MAILBOX_DECLARATION(                              \
+        hpx::lcos::detail::broadcast_message<type>,                           \
+        BOOST_PP_CAT(broadcast_, name));                                      \
+    HPX_REGISTER_COLLECTIVE_MAILBOX_DECLARATION(                              \
+        hpx::lcos::detail::broadcast_message<std::vector<type> >,             \
+        BOOST_PP_CAT(broadcast_vector_, name))                                \
+    /**/
+
+#define HPX_REGISTER_COLLECTIVES(type, name)                                  \
+    HPX_REGISTER_COLLECTIVE_MAILBOX(type, name)                               \
+    HPX_REGISTER_COLLECTIVE_MAILBOX(std::vector<type>,                        \
+        BOOST_PP_CAT(vector_, name))                                          \
+    HPX_REGISTER_COLLECTIVE_MAILBOX(                                          \
+        hpx::lcos::detail::broadcast_message<type>,                           \
+        BOOST_PP_CAT(broadcast_, name))                                       \
+    HPX_REGISTER_COLLECTIVE_MAILBOX(                                          \
+        hpx::lcos::detail::broadcast_message<std::vector<type> >,             \
+        BOOST_PP_CAT(broadcast_vector_, name))                                \
+    /**/
+
+#endif
@@ -22,7 +22,11 @@
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/unused.hpp>
+#include <hpx/util/detail/size_class_pool.hpp>
+#include <hpx/util/detail/yield_k.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
 #include <boost/exception_ptr.hpp>
 #include <boost/intrusive_ptr.hpp>
 #include <boost/math/common_factor_ct.hpp>
@@ -31,6 +35,7 @@
 #include <boost/type_traits/aligned_storage.hpp>
 #include <boost/type_traits/alignment_of.hpp>
 
+#include <cstddef>
 #include <memory>
 #include <mutex>
 
@@ -79,6 +84,29 @@ namespace detail
             delete this;
         }
 
+        /// Shared states are allocated from per-worker caches of memory
+        /// blocks (one per size class), which allows for them to be
+        /// recycled without touching the global allocator.
+        static void* operator new(std::size_t size)
+        {
+            return util::detail::size_class_pool::allocate(size);
+        }
+        static void operator delete(void* p, std::size_t size)
+        {
+            util::detail::size_class_pool::deallocate(p, size);
+        }
+
+        /// The placement operator new has to be overloaded as well (the
+        /// global placement operators are hidden because of the new/delete
+        /// overloads above).
+        static void* operator new(std::size_t, void* p)
+        {
+            return p;
+        }
+        /// This operator delete is called only if the placement new fails.
+        static void operator delete(void*, void*)
+        {}
+
     protected:
         future_data_refcnt_base() : count_(0) {}
 
@@ -237,6 +265,25 @@ namespace detail
     HPX_EXPORT bool run_on_completed_on_new_thread(
         util::unique_function_nonser<bool()> && f, error_code& ec);
 
+    ///////////////////////////////////////////////////////////////////////////
+    // The decisions about how continuations are run, these are exposed as the
+    // performance counters /lcos/count/continuations/<event>.
+    enum continuation_event
+    {
+        continuation_inlined = 0,           // run by the thread making the
+                                            // input ready
+        continuation_spawned = 1,           // run on a new thread
+        continuation_recursion_limited = 2, // run on a new thread as running
+                                            // it inline would overflow the
+                                            // stack
+        continuation_event_count = 3
+    };
+
+    HPX_EXPORT void count_continuation(continuation_event event);
+    HPX_EXPORT boost::int64_t get_continuation_count(
+        continuation_event event, bool reset);
+    HPX_EXPORT void register_continuation_counter_types();
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Result>
     struct future_data : future_data_refcnt_base
@@ -252,7 +299,16 @@ namespace detail
             empty = 0,
             ready = 1,
             value = 2 | ready,
-            exception = 4 | ready
+            exception = 4 | ready,
+            state_mask = 7
+        };
+
+        // additional flags stored in the state word alongside the state
+        enum state_flags
+        {
+            has_continuation = 8,   // on_completed_ holds a callback
+            locked = 16,            // storage_/on_completed_ are being set
+            waiting = 32            // threads may be suspended on cond_
         };
 
     public:
@@ -308,7 +364,8 @@ namespace detail
             // - there are multiple readers only (shared_future, lock hurts
             //   concurrency)
 
-            if (state_ == empty) {
+            int const s = state_.load(boost::memory_order_acquire) & state_mask;
+            if (s == empty) {
                 // the value has already been moved out of this future
                 HPX_THROWS_IF(ec, no_state,
                     "future_data::get_result",
@@ -319,7 +376,7 @@ namespace detail
             // the thread has been re-activated by one of the actions
             // supported by this promise (see promise::set_event
             // and promise::set_exception).
-            if (state_ == exception)
+            if (s == exception)
             {
                 boost::exception_ptr* exception_ptr =
                     static_cast<boost::exception_ptr*>(storage_.address());
@@ -382,6 +439,8 @@ namespace detail
             }
             else
             {
+                count_continuation(continuation_recursion_limited);
+
                 // re-spawn continuation on a new thread
                 boost::intrusive_ptr<future_data> this_(this);
 
@@ -410,73 +469,47 @@ namespace detail
         template <typename Target>
         void set_value(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked()) {
-                l.unlock();
+            if (!lock_state()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_value",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed;
-
-            on_completed = std::move(this->on_completed_);
-
             // set the data
-            result_type* value_ptr =
-                static_cast<result_type*>(storage_.address());
-            ::new ((void*)value_ptr) result_type(
-                future_data_result<Result>::set(std::forward<Target>(data)));
-            state_ = value;
-
-            // handle all threads waiting for the future to become ready
-            cond_.notify_all(std::move(l), ec);
-
-            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
+            try {
+                result_type* value_ptr =
+                    static_cast<result_type*>(storage_.address());
+                ::new ((void*)value_ptr) result_type(
+                    future_data_result<Result>::set(std::forward<Target>(data)));
+            }
+            catch (...) {
+                state_.fetch_and(~locked, boost::memory_order_release);
+                throw;
+            }
 
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            make_ready(value, ec);
         }
 
         template <typename Target>
         void set_exception(Target && data, error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(this->mtx_);
-
             // check whether the data has already been set
-            if (is_ready_locked()) {
-                l.unlock();
+            if (!lock_state()) {
                 HPX_THROWS_IF(ec, promise_already_satisfied,
                     "future_data::set_exception",
                     "data has already been set for this future");
                 return;
             }
 
-            completed_callback_type on_completed;
-
-            on_completed = std::move(this->on_completed_);
-
             // set the data
             boost::exception_ptr* exception_ptr =
                 static_cast<boost::exception_ptr*>(storage_.address());
             ::new ((void*)exception_ptr) boost::exception_ptr(
                 std::forward<Target>(data));
-            state_ = exception;
-
-            // handle all threads waiting for the future to become ready
-            cond_.notify_all(std::move(l), ec);
 
-            // Note: cv.notify_all() above 'consumes' the lock 'l' and leaves
-            //       it unlocked when returning.
-
-            // invoke the callback (continuation) function
-            if (on_completed)
-                handle_on_completed(std::move(on_completed));
+            make_ready(exception, ec);
         }
 
         // helper functions for setting data (if successful) or the error (if
@@ -522,7 +555,7 @@ namespace detail
             // and no reader
 
             // release any stored data and callback functions
-            switch (state_) {
+            switch (state_.load(boost::memory_order_relaxed) & state_mask) {
             case value:
             {
                 result_type* value_ptr =
@@ -540,7 +573,7 @@ namespace detail
             default: break;
             }
 
-            state_ = empty;
+            state_.store(empty, boost::memory_order_release);
             on_completed_ = completed_callback_type();
         }
 
@@ -553,32 +586,36 @@ namespace detail
         {
             if (!data_sink) return;
 
-            std::unique_lock<mutex_type> l(this->mtx_);
-
-            if (is_ready_locked()) {
-
+            if (lock_state(has_continuation))
+            {
+                // store a combined callback wrapping the old and the new one
+                try {
+                    this->on_completed_ = compose_cb(
+                        std::move(data_sink), std::move(on_completed_));
+                }
+                catch (...) {
+                    state_.fetch_and(~locked, boost::memory_order_release);
+                    throw;
+                }
+                state_.fetch_and(~locked, boost::memory_order_release);
+            }
+            else {
                 HPX_ASSERT(!on_completed_);
 
                 // invoke the callback (continuation) function right away
-                l.unlock();
-
                 handle_on_completed(std::move(data_sink));
             }
-            else {
-                // store a combined callback wrapping the old and the new one
-                this->on_completed_ = compose_cb(
-                    std::move(data_sink), std::move(on_completed_));
-            }
         }
 
         virtual void wait(error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // block if this entry is empty
-            if (state_ == empty) {
-                cond_.wait(std::move(l), "future_data::wait", ec);
-                if (ec) return;
+            if (!is_ready()) {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (announce_waiting()) {
+                    cond_.wait(std::move(l), "future_data::wait", ec);
+                    if (ec) return;
+                }
             }
 
             if (&ec != &throws)
@@ -589,19 +626,20 @@ namespace detail
         wait_until(boost::chrono::steady_clock::time_point const& abs_time,
             error_code& ec = throws)
         {
-            std::unique_lock<mutex_type> l(mtx_);
-
             // block if this entry is empty
-            if (state_ == empty) {
-                threads::thread_state_ex_enum const reason =
-                    cond_.wait_until(std::move(l), abs_time,
-                        "future_data::wait_until", ec);
-                if (ec) return future_status::uninitialized;
-
-                if (reason == threads::wait_timeout)
-                    return future_status::timeout;
-
-                return future_status::ready;
+            if (!is_ready()) {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (announce_waiting()) {
+                    threads::thread_state_ex_enum const reason =
+                        cond_.wait_until(std::move(l), abs_time,
+                            "future_data::wait_until", ec);
+                    if (ec) return future_status::uninitialized;
+
+                    if (reason == threads::wait_timeout)
+                        return future_status::timeout;
+
+                    return future_status::ready;
+                }
             }
 
             if (&ec != &throws)
@@ -614,37 +652,131 @@ namespace detail
         /// \a future.
         bool is_ready() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return is_ready_locked();
+            return (state_.load(boost::memory_order_acquire) & ready) != 0;
         }
 
         bool is_ready_locked() const
         {
-            return (state_ & ready) != 0;
+            return is_ready();
         }
 
         bool has_value() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == value;
+            return (state_.load(boost::memory_order_acquire) & state_mask)
+                == value;
         }
 
         bool has_exception() const
         {
-            std::unique_lock<mutex_type> l(mtx_);
-            return state_ == exception;
+            return (state_.load(boost::memory_order_acquire) & state_mask)
+                == exception;
+        }
+
+    private:
+        // Gain exclusive access to storage_ and on_completed_, additionally
+        // setting the given flags. Returns false if the shared state is
+        // ready already.
+        bool lock_state(int flags = 0)
+        {
+            for (std::size_t k = 0; /**/; ++k)
+            {
+                int s = state_.load(boost::memory_order_acquire);
+                if (s & ready)
+                    return false;
+
+                if (!(s & locked) &&
+                    state_.compare_exchange_weak(s, s | locked | flags,
+                        boost::memory_order_acquire))
+                {
+                    return true;
+                }
+
+                util::detail::yield_k(k, "future_data::lock_state");
+            }
+        }
+
+        // Publish the (already stored) data, this releases the lock acquired
+        // by lock_state(). Wakes up any suspended threads and invokes the
+        // continuation.
+        void make_ready(state new_state, error_code& ec)
+        {
+            completed_callback_type on_completed;
+            if (state_.load(boost::memory_order_relaxed) & has_continuation)
+                on_completed = std::move(this->on_completed_);
+
+            int const s = state_.exchange(new_state,
+                boost::memory_order_acq_rel);
+
+            // handle all threads waiting for the future to become ready, the
+            // condition variable is touched only if there are any
+            if (s & waiting)
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                cond_.notify_all(std::move(l), ec);
+
+                // Note: cv.notify_all() above 'consumes' the lock 'l' and
+                //       leaves it unlocked when returning.
+            }
+
+            // invoke the callback (continuation) function
+            if (on_completed)
+                handle_on_completed(std::move(on_completed));
+        }
+
+        // Mark the shared state as having suspended threads, must be called
+        // with mtx_ held. Returns false if the shared state became ready in
+        // the meantime.
+        bool announce_waiting()
+        {
+            int s = state_.load(boost::memory_order_acquire);
+            while (!(s & ready))
+            {
+                if (state_.compare_exchange_weak(s, s | waiting,
+                        boost::memory_order_acq_rel))
+                {
+                    return true;
+                }
+            }
+            return false;
         }
 
     protected:
-        mutable mutex_type mtx_;
+        mutable mutex_type mtx_;    // protects cond_ (and state of derived types)
         completed_callback_type on_completed_;
 
     private:
         local::detail::condition_variable cond_;    // threads waiting in read
-        state state_;                               // current state
+        boost::atomic<int> state_;                  // current state and flags
         typename future_data_storage<Result>::type storage_;
     };
 
+    ///////////////////////////////////////////////////////////////////////////
+    // A shared state which is allocated (and released) using the given
+    // allocator
+    template <typename Result, typename Allocator>
+    struct future_data_allocator : future_data<Result>
+    {
+        typedef typename std::allocator_traits<Allocator>::template
+            rebind_alloc<future_data_allocator> other_allocator;
+
+        explicit future_data_allocator(other_allocator const& alloc)
+          : future_data<Result>(), alloc_(alloc)
+        {}
+
+    private:
+        void destroy()
+        {
+            typedef std::allocator_traits<other_allocator> traits;
+
+            other_allocator alloc(alloc_);
+            traits::destroy(alloc, this);
+            traits::deallocate(alloc, this, 1);
+        }
+
+    private:
+        other_allocator alloc_;
+    };
+
     ///////////////////////////////////////////////////////////////////////////
     template <typename Result>
     struct timed_future_data : future_data<Result>
@@ -0,0 +1,352 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file hierarchical_barrier.hpp
+
+#if !defined(HPX_LCOS_HIERARCHICAL_BARRIER_OCT_19_2016_0530PM)
+#define HPX_LCOS_HIERARCHICAL_BARRIER_OCT_19_2016_0530PM
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/basename_registration.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/bind.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <string>
+#include <utility>
+#include <vector>
+
+HPX_REGISTER_COLLECTIVE_MAILBOX_DECLARATION(bool, hierarchical_barrier);
+
+namespace hpx { namespace lcos
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // State of a hierarchical barrier on one site (locality). The
+        // threads of the site synchronize through a local counter, the last
+        // one arriving runs a dissemination barrier between the sites: in
+        // round k each site signals site (i + 2^k) mod P and waits for the
+        // signal from site (i - 2^k) mod P, which takes ceil(log2(P)) rounds
+        // for P sites. The mailbox of each site is created once and the
+        // partners of all rounds are resolved once, the signal of round k of
+        // phase n is sent using the generation n and the tag k.
+        struct hierarchical_barrier_data
+        {
+            typedef lcos::local::spinlock mutex_type;
+            typedef lcos::local::promise<void> promise_type;
+
+            hierarchical_barrier_data(std::string const& name,
+                    std::size_t local_participants, std::size_t num_sites,
+                    std::size_t this_site)
+              : name_(name), num_sites_(num_sites), this_site_(this_site),
+                rounds_(0), local_participants_(local_participants),
+                arrived_(0), phase_(0)
+            {
+                HPX_ASSERT(local_participants != 0);
+
+                for (std::size_t dist = 1; dist < num_sites; dist *= 2)
+                    ++rounds_;
+
+                released_ = promise_.get_future().share();
+
+                if (num_sites_ != 1)
+                {
+                    id_ = create_mailbox<bool>(name_, this_site_).share();
+
+                    partners_.reserve(rounds_);
+                    for (std::size_t dist = 1; dist < num_sites; dist *= 2)
+                    {
+                        partners_.push_back(hpx::find_from_basename(name_,
+                            (this_site_ + dist) % num_sites_).share());
+                    }
+                }
+            }
+
+            ~hierarchical_barrier_data()
+            {
+                if (num_sites_ != 1)
+                    hpx::unregister_with_basename(name_, this_site_);
+            }
+
+            // Register the arrival of one local participant, the returned
+            // future becomes ready once the current phase has completed.
+            hpx::shared_future<void> arrive(
+                std::shared_ptr<hierarchical_barrier_data> const& self);
+
+            std::string const name_;
+            std::size_t const num_sites_;
+            std::size_t const this_site_;
+            std::size_t rounds_;
+            std::size_t const local_participants_;
+
+            hpx::shared_future<hpx::id_type> id_;
+            std::vector<hpx::shared_future<hpx::id_type> > partners_;
+
+            mutex_type mtx_;
+            std::size_t arrived_;               // protected by mtx_
+            std::size_t phase_;                 // protected by mtx_
+            promise_type promise_;              // protected by mtx_
+            hpx::shared_future<void> released_; // protected by mtx_
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        inline hpx::future<void>
+        send_barrier_signal(hpx::shared_future<hpx::id_type> f,
+            std::size_t phase, std::size_t round)
+        {
+            typedef collective_mailbox_server<bool>::set_value_action
+                action_type;
+            return hpx::async(action_type(), f.get(), phase, round, true);
+        }
+
+        inline hpx::future<bool>
+        receive_barrier_signal(hpx::shared_future<hpx::id_type> f,
+            std::size_t phase, std::size_t round)
+        {
+            typedef collective_mailbox_server<bool>::get_value_action
+                action_type;
+            return hpx::async(action_type(), f.get(), phase, round);
+        }
+
+        inline void hierarchical_barrier_round(
+            std::shared_ptr<hierarchical_barrier_data> data,
+            std::shared_ptr<hierarchical_barrier_data::promise_type> p,
+            std::size_t phase, std::size_t round);
+
+        inline void hierarchical_barrier_step(
+            std::shared_ptr<hierarchical_barrier_data> data,
+            std::shared_ptr<hierarchical_barrier_data::promise_type> p,
+            std::size_t phase, std::size_t round, hpx::future<void> sent,
+            hpx::future<bool> received)
+        {
+            try {
+                sent.get();         // propagate any exceptions
+                received.get();
+            }
+            catch (...) {
+                p->set_exception(boost::current_exception());
+                return;
+            }
+
+            hierarchical_barrier_round(std::move(data), std::move(p), phase,
+                round + 1);
+        }
+
+        inline void hierarchical_barrier_round(
+            std::shared_ptr<hierarchical_barrier_data> data,
+            std::shared_ptr<hierarchical_barrier_data::promise_type> p,
+            std::size_t phase, std::size_t round)
+        {
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+
+            if (round == data->rounds_)
+            {
+                // all sites have arrived, release the local participants
+                p->set_value();
+                return;
+            }
+
+            hpx::future<void> sent = data->partners_[round].then(
+                util::bind(&detail::send_barrier_signal, _1, phase, round));
+            hpx::future<bool> received = data->id_.then(
+                util::bind(&detail::receive_barrier_signal, _1, phase,
+                    round));
+
+            hpx::dataflow(
+                util::bind(&detail::hierarchical_barrier_step, data, p,
+                    phase, round, _1, _2),
+                std::move(sent), std::move(received));
+        }
+
+        inline hpx::shared_future<void> hierarchical_barrier_data::arrive(
+            std::shared_ptr<hierarchical_barrier_data> const& self)
+        {
+            std::unique_lock<mutex_type> l(mtx_);
+
+            hpx::shared_future<void> released = released_;
+            if (++arrived_ != local_participants_)
+                return released;
+
+            // this is the last local participant, start the next phase
+            // locally and synchronize the current one with the other sites
+            std::size_t const phase = phase_++;
+            arrived_ = 0;
+
+            std::shared_ptr<promise_type> p =
+                std::make_shared<promise_type>(std::move(promise_));
+            promise_ = promise_type();
+            released_ = promise_.get_future().share();
+
+            l.unlock();
+
+            hierarchical_barrier_round(self, std::move(p), phase, 0);
+            return released;
+        }
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a hierarchical_barrier synchronizes a number of threads on each of
+    /// a number of sites (usually localities).
+    ///
+    /// The threads running on the same site combine their arrivals locally,
+    /// only the last thread arriving on a site takes part in the
+    /// synchronization between the sites. The sites synchronize using a
+    /// dissemination barrier, which requires ceil(log2(num_sites)) rounds
+    /// of point-to-point messages and no central component. The barrier can
+    /// be reused any number of times.
+    ///
+    /// The barrier is split-phase: \a arrive() announces the arrival of the
+    /// calling thread without waiting for the other participants, the
+    /// returned future becomes ready once all participants have arrived.
+    /// This allows to overlap the synchronization with independent work:
+    ///
+    /// \code
+    ///     hpx::shared_future<void> f = b.arrive();
+    ///     do_local_work();
+    ///     f.get();
+    /// \endcode
+    ///
+    /// \note Each site has to create its barrier with the same base name
+    ///       and number of sites. The barrier on a site must not be
+    ///       destroyed before the last phase it took part in has completed
+    ///       on this site.
+    class hierarchical_barrier
+    {
+    public:
+        hierarchical_barrier() {}
+
+        /// Create the part of a barrier local to this site.
+        ///
+        /// \param basename     The base name identifying the barrier.
+        /// \param local_participants The number of threads on this site
+        ///                     taking part in each phase of the barrier.
+        /// \param num_sites    The number of participating sites (default:
+        ///                     all localities).
+        /// \param this_site    The sequence number of this site (default:
+        ///                     the locality id).
+        ///
+        explicit hierarchical_barrier(std::string const& basename,
+                std::size_t local_participants = 1,
+                std::size_t num_sites = std::size_t(-1),
+                std::size_t this_site = std::size_t(-1))
+        {
+            detail::init_collective_sites(num_sites, this_site);
+            data_ = std::make_shared<detail::hierarchical_barrier_data>(
+                basename, local_participants, num_sites, this_site);
+        }
+
+        /// Announce the arrival of the calling thread at the barrier without
+        /// waiting for the other participants.
+        ///
+        /// \returns A future which becomes ready once all participants have
+        ///          arrived at the current phase of the barrier.
+        hpx::shared_future<void> arrive()
+        {
+            HPX_ASSERT(data_);
+            return data_->arrive(data_);
+        }
+
+        /// Arrive at the barrier and wait for all other participants.
+        void wait()
+        {
+            arrive().get();
+        }
+
+        /// Return the number of participating sites.
+        std::size_t num_sites() const
+        {
+            HPX_ASSERT(data_);
+            return data_->num_sites_;
+        }
+
+    private:
+        std::shared_ptr<detail::hierarchical_barrier_data> data_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a hierarchical_latch is the single use variant of a
+    /// \a hierarchical_barrier: it becomes ready once it has been counted
+    /// down \a local_count times on each of the participating sites.
+    /// Threads may wait for the latch without counting it down.
+    class hierarchical_latch
+    {
+    public:
+        hierarchical_latch() {}
+
+        /// Create the part of a latch local to this site.
+        ///
+        /// \param basename     The base name identifying the latch.
+        /// \param local_count  The number of times the latch has to be
+        ///                     counted down on this site.
+        /// \param num_sites    The number of participating sites (default:
+        ///                     all localities).
+        /// \param this_site    The sequence number of this site (default:
+        ///                     the locality id).
+        ///
+        explicit hierarchical_latch(std::string const& basename,
+                std::size_t local_count = 1,
+                std::size_t num_sites = std::size_t(-1),
+                std::size_t this_site = std::size_t(-1))
+        {
+            detail::init_collective_sites(num_sites, this_site);
+            data_ = std::make_shared<detail::hierarchical_barrier_data>(
+                basename, local_count, num_sites, this_site);
+            released_ = data_->released_;
+        }
+
+        /// Decrement the local count of the latch by \a n without waiting.
+        void count_down(std::size_t n = 1)
+        {
+            HPX_ASSERT(data_);
+            while (n-- != 0)
+                data_->arrive(data_);
+        }
+
+        /// Decrement the local count of the latch by one and wait for the
+        /// latch to become ready.
+        void count_down_and_wait()
+        {
+            HPX_ASSERT(data_);
+            data_->arrive(data_).get();
+        }
+
+        /// Wait for the latch to become ready.
+        void wait() const
+        {
+            released_.get();
+        }
+
+        /// Return a future which becomes ready together with the latch.
+        hpx::shared_future<void> get_future() const
+        {
+            return released_;
+        }
+
+        /// Return whether the latch has become ready.
+        bool is_ready() const
+        {
+            return released_.is_ready();
+        }
+
+    private:
+        std::shared_ptr<detail::hierarchical_barrier_data> data_;
+        hpx::shared_future<void> released_;
+    };
+}}
+
+#endif
@@ -0,0 +1,527 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/atomic_future.hpp
+
+#if !defined(HPX_LCOS_LOCAL_ATOMIC_FUTURE_OCT_19_2016_0715PM)
+#define HPX_LCOS_LOCAL_ATOMIC_FUTURE_OCT_19_2016_0715PM
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/result_of.hpp>
+#include <hpx/util/thread_description.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+#include <boost/intrusive_ptr.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local
+{
+    template <typename T>
+    class atomic_future;
+
+    template <typename T>
+    class atomic_promise;
+
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The shared state of an atomic_future. The value is stored inline
+        // and published through a single atomic state word, which also
+        // records whether a continuation has been attached. Setting the
+        // value and attaching the continuation are both a single atomic
+        // read-modify-write operation; whichever comes second runs the
+        // continuation. The continuation is a plain function pointer (plus
+        // its data), there is no virtual dispatch involved.
+        template <typename T>
+        class atomic_future_state
+        {
+            HPX_NON_COPYABLE(atomic_future_state);
+
+            enum state_bits
+            {
+                empty = 0,
+                has_value = 1,
+                has_exception = 2,
+                ready = has_value | has_exception,
+                has_continuation = 4
+            };
+
+            void run_continuation()
+            {
+                continuation_(continuation_data_);
+            }
+
+            void make_ready(int bits)
+            {
+                int old_state = state_.fetch_or(bits,
+                    boost::memory_order_acq_rel);
+                HPX_ASSERT((old_state & ready) == 0);
+
+                if (old_state & has_continuation)
+                    run_continuation();
+            }
+
+        public:
+            typedef void (*continuation_type)(void*);
+
+            atomic_future_state()
+              : count_(0), state_(empty), continuation_(0),
+                continuation_data_(0)
+            {}
+
+            bool is_ready() const
+            {
+                return (state_.load(boost::memory_order_acquire) & ready) != 0;
+            }
+
+            bool has_exception_set() const
+            {
+                return (state_.load(boost::memory_order_acquire) &
+                    has_exception) != 0;
+            }
+
+            void set_value(T const& value)
+            {
+                ::new (&storage_) T(value);
+                make_ready(has_value);
+            }
+
+            void set_exception(boost::exception_ptr const& e)
+            {
+                exception_ = e;
+                make_ready(has_exception);
+            }
+
+            // Attach the (only) continuation. The continuation is run right
+            // away if the value has been set already.
+            void set_continuation(continuation_type f, void* data)
+            {
+                continuation_ = f;
+                continuation_data_ = data;
+
+                int old_state = state_.fetch_or(has_continuation,
+                    boost::memory_order_acq_rel);
+                HPX_ASSERT((old_state & has_continuation) == 0);
+
+                if (old_state & ready)
+                    run_continuation();
+            }
+
+            void wait() const
+            {
+                for (std::size_t k = 0; !is_ready(); ++k)
+                {
+                    hpx::util::detail::yield_k(k,
+                        "hpx::lcos::local::atomic_future::wait");
+                }
+            }
+
+            T get() const
+            {
+                wait();
+
+                if (state_.load(boost::memory_order_acquire) & has_exception)
+                    boost::rethrow_exception(exception_);
+
+                return *reinterpret_cast<T const*>(&storage_);
+            }
+
+            boost::exception_ptr get_exception() const
+            {
+                HPX_ASSERT(has_exception_set());
+                return exception_;
+            }
+
+        private:
+            friend void intrusive_ptr_add_ref(atomic_future_state* p)
+            {
+                p->count_.fetch_add(1, boost::memory_order_relaxed);
+            }
+
+            friend void intrusive_ptr_release(atomic_future_state* p)
+            {
+                if (p->count_.fetch_sub(1, boost::memory_order_acq_rel) == 1)
+                    delete p;
+            }
+
+            boost::atomic<int> count_;
+            boost::atomic<int> state_;
+            typename std::aligned_storage<sizeof(T),
+                std::alignment_of<T>::value>::type storage_;
+            boost::exception_ptr exception_;
+
+            continuation_type continuation_;
+            void* continuation_data_;
+        };
+
+        template <typename T>
+        struct is_atomic_future_value
+          : std::integral_constant<bool,
+                !std::is_void<T>::value && !std::is_reference<T>::value &&
+#if defined(HPX_HAVE_CXX11_STD_IS_TRIVIALLY_COPYABLE)
+                std::is_trivially_copyable<T>::value &&
+#endif
+                sizeof(T) <= 16>
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        // Store the result of invoking f (or the exception thrown) in the
+        // given shared state.
+        template <typename R, typename F, typename ... Ts>
+        void set_atomic_future_result(atomic_future_state<R>& state, F && f,
+            Ts &&... ts)
+        {
+            try {
+                state.set_value(hpx::util::invoke(std::forward<F>(f),
+                    std::forward<Ts>(ts)...));
+            }
+            catch (...) {
+                state.set_exception(boost::current_exception());
+            }
+        }
+
+        template <typename T, typename F, typename R>
+        struct atomic_continuation
+        {
+            template <typename F_>
+            atomic_continuation(
+                    boost::intrusive_ptr<atomic_future_state<T> > const& input,
+                    F_ && f)
+              : input_(input), f_(std::forward<F_>(f)),
+                result_(new atomic_future_state<R>)
+            {}
+
+            static void invoke(void* data)
+            {
+                std::unique_ptr<atomic_continuation> this_(
+                    static_cast<atomic_continuation*>(data));
+
+                set_atomic_future_result(*this_->result_, std::move(this_->f_),
+                    atomic_future<T>(std::move(this_->input_)));
+            }
+
+            boost::intrusive_ptr<atomic_future_state<T> > input_;
+            F f_;
+            boost::intrusive_ptr<atomic_future_state<R> > result_;
+        };
+
+        template <typename T>
+        struct atomic_future_converter
+        {
+            explicit atomic_future_converter(
+                    boost::intrusive_ptr<atomic_future_state<T> > const& input)
+              : input_(input)
+            {}
+
+            static void invoke(void* data)
+            {
+                std::unique_ptr<atomic_future_converter> this_(
+                    static_cast<atomic_future_converter*>(data));
+
+                atomic_future_state<T>& input = *this_->input_;
+                if (input.has_exception_set())
+                    this_->promise_.set_exception(input.get_exception());
+                else
+                    this_->promise_.set_value(input.get());
+            }
+
+            boost::intrusive_ptr<atomic_future_state<T> > input_;
+            lcos::local::promise<T> promise_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An \a atomic_future is a lightweight alternative to \a hpx::future for
+    /// trivially copyable results of at most 16 bytes.
+    ///
+    /// The result is stored inline in the shared state and published using
+    /// a single atomic operation, setting the result and attaching a
+    /// continuation are wait-free. In exchange, an \a atomic_future supports
+    /// only a single continuation (which is run on the thread making the
+    /// result available), and waiting for the result is implemented by
+    /// repeatedly yielding the waiting thread. An \a atomic_future can be
+    /// converted into an \a hpx::future whenever the full functionality is
+    /// needed.
+    template <typename T>
+    class atomic_future
+    {
+        static_assert(detail::is_atomic_future_value<T>::value,
+            "atomic_future<T> requires T to be trivially copyable and "
+            "not larger than 16 bytes");
+
+        typedef detail::atomic_future_state<T> shared_state_type;
+
+    public:
+        typedef T result_type;
+
+        atomic_future() {}
+
+        /// \cond NOINTERNAL
+        explicit atomic_future(
+                boost::intrusive_ptr<shared_state_type> && state)
+          : state_(std::move(state))
+        {}
+
+        explicit atomic_future(
+                boost::intrusive_ptr<shared_state_type> const& state)
+          : state_(state)
+        {}
+        /// \endcond
+
+        /// Return whether this future refers to a shared state.
+        bool valid() const
+        {
+            return state_ != 0;
+        }
+
+        /// Return whether the result (or an exception) is available.
+        bool is_ready() const
+        {
+            return state_ != 0 && state_->is_ready();
+        }
+
+        /// Return whether an exception has been stored.
+        bool has_exception() const
+        {
+            return state_ != 0 && state_->has_exception_set();
+        }
+
+        /// Wait for the result to become available.
+        void wait() const
+        {
+            if (!state_)
+            {
+                HPX_THROW_EXCEPTION(no_state,
+                    "atomic_future<T>::wait",
+                    "this future has no valid shared state");
+            }
+            state_->wait();
+        }
+
+        /// Wait for the result and return it, rethrows the stored exception
+        /// if any. This invalidates the future.
+        T get()
+        {
+            if (!state_)
+            {
+                HPX_THROW_EXCEPTION(no_state,
+                    "atomic_future<T>::get",
+                    "this future has no valid shared state");
+            }
+
+            boost::intrusive_ptr<shared_state_type> state(std::move(state_));
+            return state->get();
+        }
+
+        /// Attach a continuation which is invoked with this future once it
+        /// has become ready. The continuation is run on the thread making
+        /// the result available (or right away, if the result is available
+        /// already), it should therefore be short. The result of the
+        /// continuation has to satisfy the same requirements as \a T. This
+        /// invalidates the future.
+        template <typename F>
+        atomic_future<
+            typename util::result_of<typename util::decay<F>::type(
+                atomic_future<T>)>::type>
+        then(F && f)
+        {
+            typedef typename util::decay<F>::type function_type;
+            typedef typename util::result_of<
+                    function_type(atomic_future<T>)
+                >::type result_type;
+            typedef detail::atomic_continuation<T, function_type, result_type>
+                continuation_type;
+
+            if (!state_)
+            {
+                HPX_THROW_EXCEPTION(no_state,
+                    "atomic_future<T>::then",
+                    "this future has no valid shared state");
+            }
+
+            boost::intrusive_ptr<shared_state_type> state(std::move(state_));
+
+            continuation_type* cont =
+                new continuation_type(state, std::forward<F>(f));
+            atomic_future<result_type> result(cont->result_);
+
+            state->set_continuation(&continuation_type::invoke, cont);
+            return result;
+        }
+
+        /// Convert this future into an \a hpx::future. This invalidates the
+        /// future.
+        hpx::future<T> to_future()
+        {
+            if (!state_)
+            {
+                HPX_THROW_EXCEPTION(no_state,
+                    "atomic_future<T>::to_future",
+                    "this future has no valid shared state");
+            }
+
+            boost::intrusive_ptr<shared_state_type> state(std::move(state_));
+            if (state->is_ready())
+            {
+                if (state->has_exception_set())
+                {
+                    return hpx::make_exceptional_future<T>(
+                        state->get_exception());
+                }
+                return hpx::make_ready_future(state->get());
+            }
+
+            typedef detail::atomic_future_converter<T> converter_type;
+            converter_type* conv = new converter_type(state);
+            hpx::future<T> result = conv->promise_.get_future();
+
+            state->set_continuation(&converter_type::invoke, conv);
+            return result;
+        }
+
+    private:
+        boost::intrusive_ptr<shared_state_type> state_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// The producing side of an \a atomic_future.
+    template <typename T>
+    class atomic_promise
+    {
+        static_assert(detail::is_atomic_future_value<T>::value,
+            "atomic_promise<T> requires T to be trivially copyable and "
+            "not larger than 16 bytes");
+
+        typedef detail::atomic_future_state<T> shared_state_type;
+
+    public:
+        atomic_promise()
+          : state_(new shared_state_type), future_retrieved_(false)
+        {}
+
+        atomic_promise(atomic_promise && rhs)
+          : state_(std::move(rhs.state_)),
+            future_retrieved_(rhs.future_retrieved_)
+        {
+            rhs.future_retrieved_ = false;
+        }
+
+        ~atomic_promise()
+        {
+            if (state_ && future_retrieved_ && !state_->is_ready())
+            {
+                state_->set_exception(HPX_GET_EXCEPTION(broken_promise,
+                    "atomic_promise<T>::~atomic_promise",
+                    "the promise has been destroyed without setting a value"));
+            }
+        }
+
+        atomic_promise& operator=(atomic_promise && rhs)
+        {
+            if (this != &rhs)
+            {
+                atomic_promise tmp(std::move(*this));
+                state_ = std::move(rhs.state_);
+                future_retrieved_ = rhs.future_retrieved_;
+                rhs.future_retrieved_ = false;
+            }
+            return *this;
+        }
+
+        /// Return the future associated with this promise, this can be
+        /// called only once.
+        atomic_future<T> get_future()
+        {
+            if (future_retrieved_ || !state_)
+            {
+                HPX_THROW_EXCEPTION(future_already_retrieved,
+                    "atomic_promise<T>::get_future",
+                    "future has already been retrieved from this promise");
+            }
+
+            future_retrieved_ = true;
+            return atomic_future<T>(state_);
+        }
+
+        /// Make the given value available to the associated future.
+        void set_value(T const& value)
+        {
+            HPX_ASSERT(state_);
+            state_->set_value(value);
+        }
+
+        /// Make the given exception available to the associated future.
+        void set_exception(boost::exception_ptr const& e)
+        {
+            HPX_ASSERT(state_);
+            state_->set_exception(e);
+        }
+
+    private:
+        HPX_MOVABLE_ONLY(atomic_promise);
+
+        boost::intrusive_ptr<shared_state_type> state_;
+        bool future_retrieved_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        template <typename R, typename F, typename ... Ts>
+        void run_atomic_task(boost::intrusive_ptr<atomic_future_state<R> > state,
+            F && f, Ts &&... ts)
+        {
+            set_atomic_future_result(*state, std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+    }
+    /// \endcond
+
+    /// Run the given function on a new HPX thread and return an
+    /// \a atomic_future referring to its result. The result type of the
+    /// function has to be trivially copyable and not larger than 16 bytes.
+    template <typename F, typename ... Ts>
+    atomic_future<
+        typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type>
+    atomic_async(F && f, Ts &&... ts)
+    {
+        typedef typename hpx::util::detail::deferred_result_of<
+                F(Ts&&...)
+            >::type result_type;
+        typedef detail::atomic_future_state<result_type> shared_state_type;
+
+        boost::intrusive_ptr<shared_state_type> state(new shared_state_type);
+        atomic_future<result_type> result(state);
+
+        util::thread_description desc(f, "atomic_async");
+        threads::register_thread_nullary(
+            util::deferred_call(
+                &detail::run_atomic_task<result_type,
+                    typename util::decay<F>::type,
+                    typename util::decay<Ts>::type...>,
+                std::move(state), std::forward<F>(f), std::forward<Ts>(ts)...),
+            desc);
+
+        return result;
+    }
+}}}
+
+#endif
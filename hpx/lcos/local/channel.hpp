@@ -0,0 +1,441 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/channel.hpp
+
+#if !defined(HPX_LCOS_LOCAL_CHANNEL_OCT_19_2016_1130AM)
+#define HPX_LCOS_LOCAL_CHANNEL_OCT_19_2016_1130AM
+
+#include <hpx/config.hpp>
+#include <hpx/throw_exception.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/counting_semaphore.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/lockfree/queue.hpp>
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Unbounded lock-free queue of pointers usable by any number of
+        // producers and consumers.
+        template <typename T>
+        class mpmc_pointer_queue
+        {
+        public:
+            mpmc_pointer_queue()
+              : queue_(128)
+            {}
+
+            void push(T* value)
+            {
+                queue_.push(value);
+            }
+
+            bool pop(T*& value)
+            {
+                return queue_.pop(value);
+            }
+
+        private:
+            boost::lockfree::queue<T*> queue_;
+        };
+
+        // Unbounded wait-free queue of pointers usable by exactly one
+        // producer and one consumer.
+        template <typename T>
+        class spsc_pointer_queue
+        {
+            struct node
+            {
+                node(T* value = 0)
+                  : next_(0), value_(value)
+                {}
+
+                boost::atomic<node*> next_;
+                T* value_;
+            };
+
+        public:
+            spsc_pointer_queue()
+              : head_(new node), tail_(head_)
+            {}
+
+            ~spsc_pointer_queue()
+            {
+                while (tail_ != 0)
+                {
+                    node* next = tail_->next_.load(boost::memory_order_relaxed);
+                    delete tail_;
+                    tail_ = next;
+                }
+            }
+
+            // called by the producer only
+            void push(T* value)
+            {
+                node* n = new node(value);
+                head_->next_.store(n, boost::memory_order_release);
+                head_ = n;
+            }
+
+            // called by the consumer only
+            bool pop(T*& value)
+            {
+                node* next = tail_->next_.load(boost::memory_order_acquire);
+                if (next == 0)
+                    return false;
+
+                value = next->value_;
+                delete tail_;
+                tail_ = next;
+                return true;
+            }
+
+        private:
+            node* head_;        // last node, owned by the producer
+            node* tail_;        // dummy node, owned by the consumer
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The channel keeps track of the difference between the number of
+        // values sent and the number of values requested (balance_). If the
+        // balance is positive, values are buffered, otherwise the promises
+        // of the waiting receivers are buffered. Sending a value and
+        // requesting a value first update the balance and then push to (or
+        // pop from) the corresponding queue, which makes both operations
+        // lock-free. The values are buffered using the given Queue, the
+        // waiting receivers always use an mpmc_pointer_queue as they are
+        // cancelled by whoever closes the channel.
+        template <typename T, template <typename> class Queue>
+        class basic_channel
+        {
+        private:
+            typedef lcos::local::promise<T> promise_type;
+
+            HPX_NON_COPYABLE(basic_channel);
+
+            template <typename Q, typename U>
+            static void pop(Q& queue, U*& value)
+            {
+                // the corresponding push may not have completed yet
+                for (std::size_t k = 0; !queue.pop(value); ++k)
+                {
+                    hpx::util::detail::yield_k(k % 16,
+                        "hpx::lcos::local::channel::pop");
+                }
+            }
+
+            bool is_bounded() const
+            {
+                return capacity_ != std::size_t(-1);
+            }
+
+            // make all waiting receivers return an error
+            void cancel_waiting()
+            {
+                std::lock_guard<mutex_type> l(cancel_mtx_);
+
+                boost::int64_t balance = balance_.load();
+                while (balance < 0)
+                {
+                    if (!balance_.compare_exchange_weak(balance, balance + 1))
+                        continue;
+
+                    promise_type* p = 0;
+                    pop(waiting_, p);
+
+                    std::unique_ptr<promise_type> guard(p);
+                    p->set_exception(HPX_GET_EXCEPTION(hpx::invalid_status,
+                        "hpx::lcos::local::channel::get",
+                        "the channel has been closed"));
+
+                    balance = balance_.load();
+                }
+            }
+
+        public:
+            explicit basic_channel(std::size_t capacity = std::size_t(-1))
+              : balance_(0), closed_(false), capacity_(capacity),
+                slots_(capacity == std::size_t(-1) ? 0 :
+                    static_cast<boost::int64_t>(capacity))
+            {
+                HPX_ASSERT(capacity != 0);
+            }
+
+            ~basic_channel()
+            {
+                close();
+
+                T* value = 0;
+                while (values_.pop(value))
+                    delete value;
+            }
+
+            /// Send the given value through the channel. For bounded
+            /// channels this suspends the calling thread while the channel
+            /// is full.
+            ///
+            /// \throws An exception of type hpx::exception with the error
+            ///         code \a hpx::invalid_status if the channel has been
+            ///         closed.
+            ///
+            void set(T val)
+            {
+                if (is_bounded())
+                    slots_.wait();
+
+                if (closed_.load(boost::memory_order_acquire))
+                {
+                    if (is_bounded())
+                        slots_.signal();
+
+                    HPX_THROW_EXCEPTION(hpx::invalid_status,
+                        "hpx::lcos::local::channel::set",
+                        "attempting to write to a closed channel");
+                }
+
+                if (balance_.fetch_add(1) >= 0)
+                {
+                    // nobody is waiting, buffer the value
+                    values_.push(new T(std::move(val)));
+                    return;
+                }
+
+                // hand the value to a waiting receiver
+                promise_type* p = 0;
+                pop(waiting_, p);
+
+                if (is_bounded())
+                    slots_.signal();
+
+                std::unique_ptr<promise_type> guard(p);
+                p->set_value(std::move(val));
+            }
+
+            /// Return a future which becomes ready as soon as a value has
+            /// been received. Values are received in the order they were
+            /// sent. All values sent before the channel has been closed can
+            /// still be received, afterwards the returned future holds an
+            /// exception.
+            hpx::future<T> get()
+            {
+                if (closed_.load(boost::memory_order_acquire) &&
+                    balance_.load() <= 0)
+                {
+                    return HPX_MAKE_EXCEPTIONAL_FUTURE(T, hpx::invalid_status,
+                        "hpx::lcos::local::channel::get",
+                        "the channel has been closed");
+                }
+
+                if (balance_.fetch_sub(1) > 0)
+                {
+                    // a value has been buffered already
+                    T* value = 0;
+                    pop(values_, value);
+
+                    if (is_bounded())
+                        slots_.signal();
+
+                    std::unique_ptr<T> guard(value);
+                    return hpx::make_ready_future(std::move(*value));
+                }
+
+                // wait for the next value
+                promise_type* p = new promise_type;
+                hpx::future<T> f = p->get_future();
+                waiting_.push(p);
+
+                // the channel might have been closed concurrently
+                if (closed_.load(boost::memory_order_acquire))
+                    cancel_waiting();
+
+                return f;
+            }
+
+            /// Close the channel. Any subsequent attempt to send a value
+            /// throws, any pending and subsequent requests for a value which
+            /// can't be satisfied from the values sent before receive an
+            /// error.
+            void close()
+            {
+                closed_.store(true, boost::memory_order_release);
+                cancel_waiting();
+
+                // Wake up all senders blocked on a full channel. Every sender
+                // returns its slot after noticing that the channel has been
+                // closed, the additional slot wakes up the senders which are
+                // just about to block as well.
+                if (is_bounded())
+                {
+                    slots_.signal_all();
+                    slots_.signal();
+                }
+            }
+
+            /// Return whether the channel has been closed.
+            bool is_closed() const
+            {
+                return closed_.load(boost::memory_order_acquire);
+            }
+
+            /// Return the maximal number of values buffered by this channel
+            /// (std::size_t(-1) for unbounded channels).
+            std::size_t capacity() const
+            {
+                return capacity_;
+            }
+
+        private:
+            typedef lcos::local::spinlock mutex_type;
+
+            boost::atomic<boost::int64_t> balance_;
+            boost::atomic<bool> closed_;
+            std::size_t const capacity_;
+
+            Queue<T> values_;
+            mpmc_pointer_queue<promise_type> waiting_;
+
+            lcos::local::counting_semaphore slots_;     // bounded channels
+            mutex_type cancel_mtx_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Channel, typename T>
+        class channel_iterator
+        {
+        public:
+            typedef std::input_iterator_tag iterator_category;
+            typedef T value_type;
+            typedef std::ptrdiff_t difference_type;
+            typedef T const* pointer;
+            typedef T const& reference;
+
+            channel_iterator()
+              : channel_(0)
+            {}
+
+            explicit channel_iterator(Channel* c)
+              : channel_(c)
+            {
+                next();
+            }
+
+            reference operator*() const
+            {
+                HPX_ASSERT(value_);
+                return *value_;
+            }
+
+            pointer operator->() const
+            {
+                HPX_ASSERT(value_);
+                return &*value_;
+            }
+
+            channel_iterator& operator++()
+            {
+                next();
+                return *this;
+            }
+
+            friend bool operator==(channel_iterator const& lhs,
+                channel_iterator const& rhs)
+            {
+                return lhs.channel_ == rhs.channel_;
+            }
+
+            friend bool operator!=(channel_iterator const& lhs,
+                channel_iterator const& rhs)
+            {
+                return !(lhs == rhs);
+            }
+
+        private:
+            // the iteration ends as soon as the channel has been closed and
+            // all values have been received
+            void next()
+            {
+                hpx::future<T> f = channel_->get();
+                f.wait();
+
+                if (f.has_exception())
+                {
+                    channel_ = 0;
+                    value_ = boost::none;
+                    return;
+                }
+                value_ = f.get();
+            }
+
+            Channel* channel_;
+            boost::optional<T> value_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A channel connects any number of producers with any number of
+    /// consumers. Values are received in the order they were sent. The
+    /// channel is unbounded unless a capacity is given, in which case
+    /// sending a value suspends the sending thread while the channel holds
+    /// \a capacity values which have not been received.
+    template <typename T>
+    class channel
+      : public detail::basic_channel<T, detail::mpmc_pointer_queue>
+    {
+        typedef detail::basic_channel<T, detail::mpmc_pointer_queue>
+            base_type;
+
+    public:
+        typedef detail::channel_iterator<channel, T> iterator;
+
+        explicit channel(std::size_t capacity = std::size_t(-1))
+          : base_type(capacity)
+        {}
+
+        /// Iterate over all values received from this channel until it has
+        /// been closed.
+        iterator begin() { return iterator(this); }
+        iterator end() { return iterator(); }
+    };
+
+    /// A channel connecting exactly one producer with exactly one consumer.
+    /// Buffered values are passed through a wait-free queue.
+    template <typename T>
+    class spsc_channel
+      : public detail::basic_channel<T, detail::spsc_pointer_queue>
+    {
+        typedef detail::basic_channel<T, detail::spsc_pointer_queue>
+            base_type;
+
+    public:
+        typedef detail::channel_iterator<spsc_channel, T> iterator;
+
+        explicit spsc_channel(std::size_t capacity = std::size_t(-1))
+          : base_type(capacity)
+        {}
+
+        /// Iterate over all values received from this channel until it has
+        /// been closed.
+        iterator begin() { return iterator(this); }
+        iterator end() { return iterator(); }
+    };
+}}}
+
+#endif
@@ -0,0 +1,143 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/cohort_lock.hpp
+
+#if !defined(HPX_LCOS_LOCAL_COHORT_LOCK_OCT_19_2016_0245PM)
+#define HPX_LCOS_LOCAL_COHORT_LOCK_OCT_19_2016_0245PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/mcs_lock.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/topology.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <cstddef>
+#include <memory>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A NUMA-aware lock built from one \a mcs_lock per NUMA domain (the
+    /// cohort) and one global \a mcs_lock.
+    ///
+    /// A thread acquires the lock of the NUMA domain it runs on first. The
+    /// first thread of a cohort acquires the global lock as well, and on
+    /// release hands both locks to the next waiting thread of the same
+    /// cohort. This keeps the protected data in the caches of one NUMA
+    /// domain for a number of consecutive critical sections. After
+    /// \a max_handoffs consecutive handoffs inside a cohort (or if no other
+    /// thread of the cohort is waiting) the global lock is released to
+    /// prevent starving the other NUMA domains.
+    class cohort_lock
+    {
+        HPX_NON_COPYABLE(cohort_lock);
+
+    private:
+        struct cohort
+        {
+            cohort() : owns_global_(false), handoffs_(0) {}
+
+            mcs_lock local_;
+            mcs_lock::node global_node_;
+
+            // these are protected by local_
+            bool owns_global_;
+            std::size_t handoffs_;
+        };
+
+        static std::size_t get_num_cohorts()
+        {
+            std::size_t num_domains =
+                threads::get_topology().get_number_of_numa_nodes();
+            return num_domains == 0 ? 1 : num_domains;
+        }
+
+        cohort& current_cohort()
+        {
+            if (hpx::get_worker_thread_num() == std::size_t(-1))
+                return cohorts_[0];             // not an HPX worker thread
+
+            std::size_t domain = threads::get_numa_node_number();
+            return cohorts_[domain < num_cohorts_ ? domain : 0];
+        }
+
+    public:
+        /// Create the lock with one cohort per NUMA domain of this machine.
+        explicit cohort_lock(std::size_t max_handoffs = 64)
+          : num_cohorts_(get_num_cohorts()),
+            cohorts_(new cohort[num_cohorts_]),
+            max_handoffs_(max_handoffs),
+            owner_(0)
+        {}
+
+        void lock()
+        {
+            cohort& c = current_cohort();
+            c.local_.lock();
+
+            if (!c.owns_global_)
+            {
+                global_.lock(c.global_node_);
+                c.owns_global_ = true;
+            }
+
+            // the thread may be resumed on another NUMA domain while it
+            // holds the lock
+            owner_ = &c;
+        }
+
+        bool try_lock()
+        {
+            cohort& c = current_cohort();
+            if (!c.local_.try_lock())
+                return false;
+
+            if (!c.owns_global_)
+            {
+                if (!global_.try_lock(c.global_node_))
+                {
+                    c.local_.unlock();
+                    return false;
+                }
+                c.owns_global_ = true;
+            }
+
+            owner_ = &c;
+            return true;
+        }
+
+        void unlock()
+        {
+            cohort* c = owner_;
+            HPX_ASSERT(c != 0 && c->owns_global_);
+
+            owner_ = 0;
+
+            if (c->local_.has_waiters() && ++c->handoffs_ < max_handoffs_)
+            {
+                // pass the global lock on to the next thread of this cohort
+                c->local_.unlock();
+                return;
+            }
+
+            c->handoffs_ = 0;
+            c->owns_global_ = false;
+            global_.unlock(c->global_node_);
+            c->local_.unlock();
+        }
+
+    private:
+        std::size_t const num_cohorts_;
+        std::unique_ptr<cohort[]> cohorts_;
+        std::size_t const max_handoffs_;
+
+        mcs_lock global_;
+        cohort* owner_;
+    };
+}}}
+
+#endif
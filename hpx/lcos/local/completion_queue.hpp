@@ -0,0 +1,255 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/completion_queue.hpp
+
+#if !defined(HPX_LCOS_LOCAL_COMPLETION_QUEUE_OCT_19_2016_0630PM)
+#define HPX_LCOS_LOCAL_COMPLETION_QUEUE_OCT_19_2016_0630PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/promise.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/traits/future_access.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/deferred_call.hpp>
+
+#include <cstddef>
+#include <deque>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // The state shared between a completion_queue and the callbacks
+        // attached to the futures added to it. Each future gets exactly one
+        // callback for its whole lifetime, which moves the future to the
+        // queue of ready futures (or hands it directly to a waiting
+        // consumer) once it has become ready.
+        template <typename T>
+        class completion_queue_data
+          : public std::enable_shared_from_this<completion_queue_data<T> >
+        {
+        public:
+            typedef std::pair<std::size_t, hpx::future<T> > value_type;
+
+        private:
+            typedef lcos::local::spinlock mutex_type;
+            typedef lcos::local::promise<value_type> promise_type;
+            typedef typename traits::detail::shared_state_ptr<T>::type
+                shared_state_type;
+
+            void on_ready(std::size_t id, shared_state_type const& state)
+            {
+                value_type value(id,
+                    traits::future_access<hpx::future<T> >::create(state));
+
+                std::unique_lock<mutex_type> l(mtx_);
+                --outstanding_;
+
+                if (waiting_.empty())
+                {
+                    ready_.push_back(std::move(value));
+                    return;
+                }
+
+                // hand the future to the longest waiting consumer, outside
+                // of the lock as this will run its continuations
+                std::unique_ptr<promise_type> p(waiting_.front());
+                waiting_.pop_front();
+
+                l.unlock();
+                p->set_value(std::move(value));
+            }
+
+        public:
+            completion_queue_data()
+              : next_id_(0), outstanding_(0)
+            {}
+
+            ~completion_queue_data()
+            {
+                for (promise_type* p : waiting_)
+                    delete p;
+            }
+
+            std::size_t add(hpx::future<T> && f)
+            {
+                HPX_ASSERT(f.valid());
+
+                shared_state_type state =
+                    traits::future_access<hpx::future<T> >::get_shared_state(f);
+                f = hpx::future<T>();
+
+                std::size_t id = 0;
+                {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    id = next_id_++;
+                    ++outstanding_;
+                }
+
+                // this invokes the callback right away if the future is
+                // ready already
+                state->execute_deferred();
+                state->set_on_completed(util::deferred_call(
+                    &completion_queue_data::on_ready, this->shared_from_this(),
+                    id, state));
+
+                return id;
+            }
+
+            bool try_get(value_type& value)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (ready_.empty())
+                    return false;
+
+                value = std::move(ready_.front());
+                ready_.pop_front();
+                return true;
+            }
+
+            hpx::future<value_type> get_async()
+            {
+                std::unique_lock<mutex_type> l(mtx_);
+                if (!ready_.empty())
+                {
+                    value_type value = std::move(ready_.front());
+                    ready_.pop_front();
+
+                    l.unlock();
+                    return hpx::make_ready_future(std::move(value));
+                }
+
+                std::unique_ptr<promise_type> p(new promise_type);
+                hpx::future<value_type> f = p->get_future();
+                waiting_.push_back(p.get());
+                p.release();
+                return f;
+            }
+
+            std::size_t size() const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return outstanding_ + ready_.size();
+            }
+
+            std::size_t ready_count() const
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return ready_.size();
+            }
+
+        private:
+            mutable mutex_type mtx_;
+            std::size_t next_id_;
+            std::size_t outstanding_;
+            std::deque<value_type> ready_;
+            std::deque<promise_type*> waiting_;
+        };
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a completion_queue tracks any number of futures and hands them out
+    /// in the order they become ready.
+    ///
+    /// Unlike \a when_any or \a wait_any, which attach a callback to every
+    /// future passed to them on each call, a future is added to the
+    /// completion queue once and is tracked using a single callback until
+    /// it becomes ready. Harvesting a ready future costs O(1) independently
+    /// of the number of futures still outstanding, which makes this suitable
+    /// for loops handling large numbers of in-flight requests:
+    ///
+    /// \code
+    ///     hpx::lcos::local::completion_queue<int> q;
+    ///     for (std::size_t i = 0; i != n; ++i)
+    ///         q.add(hpx::async(f, i));
+    ///
+    ///     while (!q.empty())
+    ///     {
+    ///         auto r = q.get();       // suspends until a future is ready
+    ///         handle(r.first, r.second.get());
+    ///     }
+    /// \endcode
+    ///
+    /// Each future is identified by the sequence number which has been
+    /// assigned to it by \a add. All functions are thread-safe.
+    template <typename T>
+    class completion_queue
+    {
+    public:
+        /// The type of a ready future handed out by the queue, together with
+        /// the sequence number returned from \a add.
+        typedef typename detail::completion_queue_data<T>::value_type
+            value_type;
+
+        completion_queue()
+          : data_(std::make_shared<detail::completion_queue_data<T> >())
+        {}
+
+        /// Add the given future to the queue.
+        ///
+        /// \returns The sequence number identifying the future once it is
+        ///          handed out by the queue.
+        std::size_t add(hpx::future<T> && f)
+        {
+            return data_->add(std::move(f));
+        }
+
+        /// Retrieve the next ready future, if any.
+        ///
+        /// \returns true if a ready future has been stored in \a value.
+        bool try_get(value_type& value)
+        {
+            return data_->try_get(value);
+        }
+
+        /// Return a future which becomes ready as soon as a future in the
+        /// queue has become ready and which holds that future. Futures are
+        /// handed out in the order they have become ready, concurrent
+        /// requests are served in the order they were made. If the queue
+        /// is empty, the returned future waits for futures added later.
+        hpx::future<value_type> get_async()
+        {
+            return data_->get_async();
+        }
+
+        /// Suspend the calling thread until a future in the queue has become
+        /// ready and return it.
+        value_type get()
+        {
+            return data_->get_async().get();
+        }
+
+        /// Return the number of futures which have been added and have not
+        /// been handed out yet.
+        std::size_t size() const
+        {
+            return data_->size();
+        }
+
+        /// Return whether all futures added have been handed out.
+        bool empty() const
+        {
+            return data_->size() == 0;
+        }
+
+        /// Return the number of ready futures which can be handed out
+        /// without waiting.
+        std::size_t ready_count() const
+        {
+            return data_->ready_count();
+        }
+
+    private:
+        std::shared_ptr<detail::completion_queue_data<T> > data_;
+    };
+}}}
+
+#endif
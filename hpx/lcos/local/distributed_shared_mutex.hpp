@@ -0,0 +1,202 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/distributed_shared_mutex.hpp
+
+#if !defined(HPX_LCOS_LOCAL_DISTRIBUTED_SHARED_MUTEX_OCT_19_2016_0230PM)
+#define HPX_LCOS_LOCAL_DISTRIBUTED_SHARED_MUTEX_OCT_19_2016_0230PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/mcs_lock.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <new>
+
+namespace hpx { namespace lcos { namespace local
+{
+    namespace detail
+    {
+        // reader counter occupying a cache line of its own
+        struct reader_counter
+        {
+            reader_counter() : count_(0) {}
+
+            boost::atomic<boost::int64_t> count_;
+            char pad_[64 - sizeof(boost::atomic<boost::int64_t>)];
+        };
+
+        // Construct the reader counters in the given storage (which has to
+        // have room for one more counter) starting at a cache line boundary,
+        // this way no two counters share a cache line and no counter shares
+        // a cache line with other data.
+        inline reader_counter* construct_reader_counters(char* storage,
+            std::size_t num_counters)
+        {
+            std::size_t const misalignment =
+                reinterpret_cast<std::size_t>(storage) % sizeof(reader_counter);
+            if (misalignment != 0)
+                storage += sizeof(reader_counter) - misalignment;
+
+            reader_counter* counters =
+                reinterpret_cast<reader_counter*>(storage);
+            for (std::size_t i = 0; i != num_counters; ++i)
+                new (&counters[i]) reader_counter;
+            return counters;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A reader-writer lock optimized for read-mostly data.
+    ///
+    /// Every worker thread has a reader counter of its own, acquiring and
+    /// releasing the lock for reading touches only the counter of the
+    /// current worker thread (and reads the writer flag) as long as no writer
+    /// is active. Readers never serialize on a common memory location.
+    /// Writers exclude each other using a queue lock, announce themselves
+    /// and wait for all readers to drain, which makes acquiring the lock for
+    /// writing more expensive than for \a shared_mutex.
+    ///
+    /// As HPX threads may be resumed on a different worker thread, a reader
+    /// may release the lock through another counter than it has acquired it
+    /// through. The counters are signed for this reason; only their sum is
+    /// meaningful.
+    class distributed_shared_mutex
+    {
+        HPX_NON_COPYABLE(distributed_shared_mutex);
+
+    private:
+        detail::reader_counter& counter()
+        {
+            std::size_t num_thread = hpx::get_worker_thread_num();
+            if (num_thread >= num_counters_)
+                num_thread = num_counters_ - 1;   // not an HPX worker thread
+            return counters_[num_thread];
+        }
+
+        bool readers_active() const
+        {
+            boost::int64_t sum = 0;
+            for (std::size_t i = 0; i != num_counters_; ++i)
+                sum += counters_[i].count_.load(boost::memory_order_seq_cst);
+            return sum != 0;
+        }
+
+    public:
+        /// Create the lock using one reader counter per worker thread (and
+        /// an additional one shared by all other threads).
+        distributed_shared_mutex()
+          : num_counters_(hpx::get_os_thread_count() + 1),
+            storage_(new char[
+                (num_counters_ + 1) * sizeof(detail::reader_counter)]),
+            counters_(detail::construct_reader_counters(
+                storage_.get(), num_counters_)),
+            writer_(false)
+        {}
+
+        explicit distributed_shared_mutex(std::size_t num_counters)
+          : num_counters_(num_counters + 1),
+            storage_(new char[
+                (num_counters_ + 1) * sizeof(detail::reader_counter)]),
+            counters_(detail::construct_reader_counters(
+                storage_.get(), num_counters_)),
+            writer_(false)
+        {}
+
+        ~distributed_shared_mutex()
+        {
+            for (std::size_t i = 0; i != num_counters_; ++i)
+                counters_[i].~reader_counter();
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void lock_shared()
+        {
+            for (std::size_t k = 0; !try_lock_shared(); /**/)
+            {
+                // wait for the writer to finish before announcing this reader
+                // again
+                while (writer_.load(boost::memory_order_acquire))
+                {
+                    hpx::util::detail::yield_k(k++,
+                        "hpx::lcos::local::distributed_shared_mutex::lock_shared");
+                }
+            }
+        }
+
+        bool try_lock_shared()
+        {
+            boost::atomic<boost::int64_t>& count = counter().count_;
+
+            // Both, the increment and the load below are sequentially
+            // consistent, either the writer sees this reader or this reader
+            // sees the writer.
+            count.fetch_add(1, boost::memory_order_seq_cst);
+            if (!writer_.load(boost::memory_order_seq_cst))
+                return true;
+
+            count.fetch_sub(1, boost::memory_order_release);
+            return false;
+        }
+
+        void unlock_shared()
+        {
+            counter().count_.fetch_sub(1, boost::memory_order_release);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        void lock()
+        {
+            writers_.lock();
+
+            HPX_ASSERT(!writer_.load());
+            writer_.store(true, boost::memory_order_seq_cst);
+
+            for (std::size_t k = 0; readers_active(); ++k)
+            {
+                hpx::util::detail::yield_k(k,
+                    "hpx::lcos::local::distributed_shared_mutex::lock");
+            }
+        }
+
+        bool try_lock()
+        {
+            if (!writers_.try_lock())
+                return false;
+
+            writer_.store(true, boost::memory_order_seq_cst);
+            if (readers_active())
+            {
+                writer_.store(false, boost::memory_order_release);
+                writers_.unlock();
+                return false;
+            }
+            return true;
+        }
+
+        void unlock()
+        {
+            writer_.store(false, boost::memory_order_release);
+            writers_.unlock();
+        }
+
+    private:
+        std::size_t const num_counters_;
+        std::unique_ptr<char[]> storage_;
+        detail::reader_counter* counters_;
+
+        boost::atomic<bool> writer_;
+        mcs_lock writers_;
+    };
+}}}
+
+#endif
@@ -14,6 +14,7 @@
 #include <hpx/runtime/threads/thread_data_fwd.hpp>
 #include <hpx/runtime/threads/thread_helpers.hpp>
 #include <hpx/runtime/launch_policy.hpp>
+#include <hpx/util/decay.hpp>
 #include <hpx/util/deferred_call.hpp>
 #include <hpx/util/thread_description.hpp>
 
@@ -21,6 +22,7 @@
 #include <boost/intrusive_ptr.hpp>
 
 #include <cstddef>
+#include <memory>
 #include <type_traits>
 #include <utility>
 
@@ -115,6 +117,39 @@ namespace hpx { namespace lcos { namespace local
             }
         };
 
+        ///////////////////////////////////////////////////////////////////////
+        // A task object which is allocated (and released) using the given
+        // allocator
+        template <typename Allocator, typename Result, typename F>
+        struct task_object_allocator : task_object<Result, F>
+        {
+            typedef task_object<Result, F> base_type;
+            typedef typename std::allocator_traits<Allocator>::template
+                rebind_alloc<task_object_allocator> other_allocator;
+
+            task_object_allocator(other_allocator const& alloc, F const& f)
+              : base_type(f), alloc_(alloc)
+            {}
+
+            task_object_allocator(other_allocator const& alloc, F&& f)
+              : base_type(std::move(f)), alloc_(alloc)
+            {}
+
+        private:
+            void destroy()
+            {
+                typedef std::allocator_traits<other_allocator> traits;
+
+                other_allocator alloc(alloc_);
+                traits::destroy(alloc, this);
+                traits::deallocate(alloc, this, 1);
+            }
+
+        private:
+            other_allocator alloc_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
         template <typename Result, typename F>
         struct cancelable_task_object
           : task_object<Result, F, lcos::detail::cancelable_task_base<Result> >
@@ -182,6 +217,28 @@ namespace hpx { namespace lcos { namespace local
             {
                 return new task_object<Result, Result (*)()>(f);
             }
+
+            template <typename Allocator, typename F>
+            static return_type call(std::allocator_arg_t, Allocator const& a,
+                F&& f)
+            {
+                typedef task_object_allocator<
+                        Allocator, Result, typename util::decay<F>::type
+                    > shared_state;
+                typedef typename shared_state::other_allocator other_allocator;
+                typedef std::allocator_traits<other_allocator> traits;
+
+                other_allocator alloc(a);
+                shared_state* p = traits::allocate(alloc, 1);
+                try {
+                    traits::construct(alloc, p, alloc, std::forward<F>(f));
+                }
+                catch (...) {
+                    traits::deallocate(alloc, p, 1);
+                    throw;
+                }
+                return return_type(p);
+            }
         };
 
         template <typename Result>
@@ -256,6 +313,14 @@ namespace hpx { namespace lcos { namespace local
             future_obtained_(false)
         {}
 
+        // the shared state is allocated using the given allocator
+        template <typename Allocator, typename F>
+        futures_factory(std::allocator_arg_t, Allocator const& a, F&& f)
+          : task_(detail::create_task_object<Result, Cancelable>::call(
+                std::allocator_arg, a, std::forward<F>(f))),
+            future_obtained_(false)
+        {}
+
         ~futures_factory()
         {}
 
@@ -0,0 +1,261 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file lcos/local/mcs_lock.hpp
+
+#if !defined(HPX_LCOS_LOCAL_MCS_LOCK_OCT_19_2016_0215PM)
+#define HPX_LCOS_LOCAL_MCS_LOCK_OCT_19_2016_0215PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/detail/size_class_pool.hpp>
+#include <hpx/util/detail/yield_k.hpp>
+#include <hpx/util/itt_notify.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <mutex>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace local
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// A fair queue lock (Mellor-Crummey and Scott) for HPX threads.
+    ///
+    /// Each thread trying to acquire the lock enqueues a node of its own and
+    /// waits on this node only, which avoids the cache line ping-pong caused
+    /// by all waiting threads polling the same memory location. The lock is
+    /// granted in FIFO order. A waiting HPX thread spins for a short while
+    /// and is suspended afterwards (without blocking its worker thread)
+    /// until its predecessor hands over the lock.
+    class mcs_lock
+    {
+        HPX_NON_COPYABLE(mcs_lock);
+
+    public:
+        /// The queue node representing one acquisition of the lock.
+        class node
+        {
+            HPX_NON_COPYABLE(node);
+
+        public:
+            node()
+              : next_(0), locked_(false)
+            {}
+
+            /// Nodes allocated by the Lockable interface are recycled through
+            /// per-worker caches of memory blocks, acquiring the lock does
+            /// not touch the global allocator.
+            static void* operator new(std::size_t size)
+            {
+                return util::detail::size_class_pool::allocate(size);
+            }
+            static void operator delete(void* p, std::size_t size)
+            {
+                util::detail::size_class_pool::deallocate(p, size);
+            }
+
+        private:
+            friend class mcs_lock;
+
+            typedef lcos::local::spinlock mutex_type;
+
+            boost::atomic<node*> next_;
+            boost::atomic<bool> locked_;
+
+            mutex_type mtx_;
+            detail::condition_variable cond_;
+        };
+
+    private:
+        // number of attempts a waiting thread polls its node before it gets
+        // suspended
+        enum { spin_count = 32 };
+
+        static void wait_for_grant(node& n)
+        {
+            for (std::size_t k = 0; k != spin_count; ++k)
+            {
+                if (!n.locked_.load(boost::memory_order_acquire))
+                    break;
+                hpx::util::detail::yield_k(k < 16 ? k : 4,
+                    "hpx::lcos::local::mcs_lock::lock");
+            }
+
+            // always synchronize with grant() as the node may go out of
+            // scope as soon as this function returns
+            std::unique_lock<node::mutex_type> l(n.mtx_);
+            while (n.locked_.load(boost::memory_order_acquire))
+                n.cond_.wait(l, "hpx::lcos::local::mcs_lock::lock");
+        }
+
+        static void grant(node& n)
+        {
+            std::unique_lock<node::mutex_type> l(n.mtx_);
+            n.locked_.store(false, boost::memory_order_release);
+            n.cond_.notify_one(std::move(l));
+        }
+
+    public:
+        mcs_lock(char const* const desc = "hpx::lcos::local::mcs_lock")
+          : tail_(0), owner_(0)
+        {
+            HPX_ITT_SYNC_CREATE(this, desc, "");
+        }
+
+        ~mcs_lock()
+        {
+            HPX_ASSERT(tail_.load() == 0);
+            HPX_ITT_SYNC_DESTROY(this);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Acquire the lock using the given node, which has to stay alive
+        /// until the lock has been released with the same node.
+        void lock(node& n)
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            n.next_.store(0, boost::memory_order_relaxed);
+            n.locked_.store(true, boost::memory_order_relaxed);
+
+            node* pred = tail_.exchange(&n, boost::memory_order_acq_rel);
+            if (pred != 0)
+            {
+                pred->next_.store(&n, boost::memory_order_release);
+                wait_for_grant(n);
+            }
+
+            HPX_ITT_SYNC_ACQUIRED(this);
+        }
+
+        bool try_lock(node& n)
+        {
+            HPX_ITT_SYNC_PREPARE(this);
+
+            n.next_.store(0, boost::memory_order_relaxed);
+            n.locked_.store(false, boost::memory_order_relaxed);
+
+            node* expected = 0;
+            if (!tail_.compare_exchange_strong(expected, &n,
+                    boost::memory_order_acq_rel))
+            {
+                HPX_ITT_SYNC_CANCEL(this);
+                return false;
+            }
+
+            HPX_ITT_SYNC_ACQUIRED(this);
+            return true;
+        }
+
+        void unlock(node& n)
+        {
+            HPX_ITT_SYNC_RELEASING(this);
+
+            node* succ = n.next_.load(boost::memory_order_acquire);
+            if (succ == 0)
+            {
+                node* expected = &n;
+                if (tail_.compare_exchange_strong(expected, 0,
+                        boost::memory_order_acq_rel))
+                {
+                    HPX_ITT_SYNC_RELEASED(this);
+                    return;
+                }
+
+                // a successor is about to link itself to our node
+                for (std::size_t k = 0;
+                     (succ = n.next_.load(boost::memory_order_acquire)) == 0;
+                     ++k)
+                {
+                    hpx::util::detail::yield_k(k % 16,
+                        "hpx::lcos::local::mcs_lock::unlock");
+                }
+            }
+
+            HPX_ITT_SYNC_RELEASED(this);
+
+            grant(*succ);
+        }
+
+        /// Return whether other threads are waiting for the lock. This may
+        /// be called only by the current owner of the lock.
+        bool has_waiters(node const& n) const
+        {
+            return tail_.load(boost::memory_order_acquire) != &n;
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Lockable interface, this takes the node for each acquisition from
+        // the per-worker caches of memory blocks
+        void lock()
+        {
+            node* n = new node;
+            lock(*n);
+            owner_ = n;
+        }
+
+        bool try_lock()
+        {
+            node* n = new node;
+            if (!try_lock(*n))
+            {
+                delete n;
+                return false;
+            }
+            owner_ = n;
+            return true;
+        }
+
+        void unlock()
+        {
+            node* n = owner_;
+            HPX_ASSERT(n != 0);
+
+            owner_ = 0;
+            unlock(*n);
+            delete n;
+        }
+
+        bool has_waiters() const
+        {
+            HPX_ASSERT(owner_ != 0);
+            return has_waiters(*owner_);
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        /// Hold the lock for the lifetime of this object without allocating
+        /// a queue node.
+        class scoped_lock
+        {
+            HPX_NON_COPYABLE(scoped_lock);
+
+        public:
+            explicit scoped_lock(mcs_lock& l)
+              : lock_(l)
+            {
+                lock_.lock(node_);
+            }
+
+            ~scoped_lock()
+            {
+                lock_.unlock(node_);
+            }
+
+        private:
+            mcs_lock& lock_;
+            node node_;
+        };
+
+    private:
+        boost::atomic<node*> tail_;
+        node* owner_;           // used by the Lockable interface only
+    };
+}}}
+
+#endif
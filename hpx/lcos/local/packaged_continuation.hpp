@@ -225,6 +225,7 @@ namespace hpx { namespace lcos { namespace detail
                 started_ = true;
             }
 
+            count_continuation(continuation_inlined);
             run_impl(f);
 
             if (&ec != &throws)
@@ -274,6 +275,8 @@ namespace hpx { namespace lcos { namespace detail
                 typename traits::detail::shared_state_ptr_for<Future>::type const&
             ) = &continuation::async_impl;
 
+            count_continuation(continuation_spawned);
+
             util::thread_description desc(f_, "continuation::async");
             applier::register_thread_plain(
                 util::bind(async_impl_ptr, std::move(this_), f), desc);
@@ -304,6 +307,8 @@ namespace hpx { namespace lcos { namespace detail
                 typename traits::detail::shared_state_ptr_for<Future>::type const&
             ) = &continuation::async_impl;
 
+            count_continuation(continuation_spawned);
+
             util::thread_description desc(f_, "continuation::async");
             sched.add(util::bind(async_impl_ptr, std::move(this_), f), desc);
 
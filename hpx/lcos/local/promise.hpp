@@ -16,6 +16,8 @@
 #include <boost/intrusive_ptr.hpp>
 #include <boost/utility/swap.hpp>
 
+#include <memory>
+
 namespace hpx { namespace lcos { namespace local
 {
     namespace detail
@@ -35,6 +37,30 @@ namespace hpx { namespace lcos { namespace local
               , has_result_(false)
             {}
 
+            template <typename Allocator>
+            promise_base(std::allocator_arg_t, Allocator const& a)
+              : shared_state_()
+              , future_retrieved_(false)
+              , has_result_(false)
+            {
+                typedef lcos::detail::future_data_allocator<R, Allocator>
+                    allocated_shared_state;
+                typedef typename allocated_shared_state::other_allocator
+                    other_allocator;
+                typedef std::allocator_traits<other_allocator> traits;
+
+                other_allocator alloc(a);
+                allocated_shared_state* p = traits::allocate(alloc, 1);
+                try {
+                    traits::construct(alloc, p, alloc);
+                }
+                catch (...) {
+                    traits::deallocate(alloc, p, 1);
+                    throw;
+                }
+                shared_state_.reset(p);
+            }
+
             promise_base(promise_base&& other) HPX_NOEXCEPT
               : shared_state_(std::move(other.shared_state_))
               , future_retrieved_(other.future_retrieved_)
@@ -182,6 +208,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -290,6 +323,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -380,6 +420,13 @@ namespace hpx { namespace lcos { namespace local
           : base_type()
         {}
 
+        // Effects: constructs a promise object and a shared state. The
+        //          shared state is allocated using the given allocator.
+        template <typename Allocator>
+        promise(std::allocator_arg_t, Allocator const& a)
+          : base_type(std::allocator_arg, a)
+        {}
+
         // Effects: constructs a new promise object and transfers ownership of
         //          the shared state of other (if any) to the newly-
         //          constructed object.
@@ -0,0 +1,105 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file reduce_scatter.hpp
+
+#if !defined(HPX_LCOS_REDUCE_SCATTER_OCT_18_2016_0850PM)
+#define HPX_LCOS_REDUCE_SCATTER_OCT_18_2016_0850PM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// ReduceScatter a set of values from different call sites
+    ///
+    /// Each call site operating on the given base name supplies one value
+    /// for each of the call sites. This function combines the i-th values
+    /// supplied by all call sites and delivers the result to the i-th call
+    /// site.
+    ///
+    /// \param  basename    The base name identifying the reduce_scatter
+    ///                     operation
+    /// \param  local_result The values to combine with the values from the
+    ///                     other call sites. This vector must hold exactly
+    ///                     one element for each of the sites.
+    /// \param  op          Reduction operation to apply to all values
+    ///                     supplied from all participating sites. The
+    ///                     operation has to be associative.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the reduce_scatter operation performed
+    ///                     on the given base name. This is optional and needs
+    ///                     to be supplied only if the reduce_scatter operation
+    ///                     on the given base name has to be performed more
+    ///                     than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding the combination of
+    ///             the values supplied for this site (combined in the order
+    ///             of the sequence number of the sites). It will become ready
+    ///             once the reduce_scatter operation has been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<T>
+    reduce_scatter(char const* basename, std::vector<T> const& local_result,
+        F && op, std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/all_to_all.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename F>
+        T reduce_scatter_finish(F const& op, hpx::future<std::vector<T> > f)
+        {
+            std::vector<T> values = f.get();
+            HPX_ASSERT(!values.empty());
+
+            T result = std::move(values[0]);
+            for (std::size_t i = 1; i != values.size(); ++i)
+                result = op(std::move(result), std::move(values[i]));
+
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    hpx::future<T>
+    reduce_scatter(char const* basename, std::vector<T> const& local_result,
+        F && op, std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<F>::type reduction_type;
+
+        // exchange the values directly, each site combines the values it
+        // has received
+        using util::placeholders::_1;
+        return all_to_all(basename, local_result, num_sites, generation,
+                this_site
+            ).then(util::bind(&detail::reduce_scatter_finish<T, reduction_type>,
+                std::forward<F>(op), _1));
+    }
+}}
+
+#endif // DOXYGEN
+#endif
@@ -0,0 +1,272 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file scan.hpp
+
+#if !defined(HPX_LCOS_SCAN_OCT_18_2016_0900PM)
+#define HPX_LCOS_SCAN_OCT_18_2016_0900PM
+
+#if defined(DOXYGEN)
+namespace hpx { namespace lcos
+{
+    /// Compute the inclusive prefix scan of a set of values from different
+    /// call sites
+    ///
+    /// The i-th call site operating on the given base name receives the
+    /// combination of the values supplied by the call sites 0, 1, ..., i.
+    /// The values are combined using recursive doubling, which requires
+    /// ceil(log2(num_sites)) rounds of point-to-point exchanges.
+    ///
+    /// \param  basename    The base name identifying the scan operation
+    /// \param  local_result The value to contribute from this call site.
+    /// \param  op          Binary operation to apply to the values. The
+    ///                     operation has to be associative.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the scan operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the scan operation on the given
+    ///                     base name has to be performed more than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding the prefix scan
+    ///             value for this call site. It will become ready once the
+    ///             scan operation has been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename std::decay<T>::type>
+    inclusive_scan(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+
+    /// Compute the exclusive prefix scan of a set of values from different
+    /// call sites
+    ///
+    /// The i-th call site operating on the given base name receives the
+    /// combination of \a init and the values supplied by the call sites
+    /// 0, 1, ..., i-1. The values are combined using recursive doubling,
+    /// which requires ceil(log2(num_sites)) rounds of point-to-point
+    /// exchanges.
+    ///
+    /// \param  basename    The base name identifying the scan operation
+    /// \param  local_result The value to contribute from this call site.
+    /// \param  init        The initial value for the scan (this is the value
+    ///                     the call site 0 receives).
+    /// \param  op          Binary operation to apply to the values. The
+    ///                     operation has to be associative.
+    /// \param  num_sites   The number of participating sites (default: all
+    ///                     localities).
+    /// \param  generation  The generational counter identifying the sequence
+    ///                     number of the scan operation performed on the
+    ///                     given base name. This is optional and needs to be
+    ///                     supplied only if the scan operation on the given
+    ///                     base name has to be performed more than once.
+    /// \param this_site    The sequence number of this invocation (usually
+    ///                     the locality id). This value is optional and
+    ///                     defaults to whatever hpx::get_locality_id() returns.
+    ///
+    /// \returns    This function returns a future holding the prefix scan
+    ///             value for this call site. It will become ready once the
+    ///             scan operation has been completed.
+    ///
+    template <typename T, typename F>
+    hpx::future<typename std::decay<T>::type>
+    exclusive_scan(char const* basename, T && local_result,
+        typename std::decay<T>::type const& init, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1));
+}}
+#else
+
+#include <hpx/config.hpp>
+#include <hpx/dataflow.hpp>
+#include <hpx/lcos/detail/collective_mailbox.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <boost/optional.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <utility>
+
+namespace hpx { namespace lcos
+{
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T, typename F>
+        struct scan_data : collective_data
+        {
+            template <typename F_>
+            scan_data(std::shared_ptr<collective_site> site,
+                    std::size_t num_sites, std::size_t generation, F_ && op,
+                    boost::optional<T> const& init)
+              : collective_data(std::move(site), num_sites, generation),
+                op_(std::forward<F_>(op)),
+                init_(init)
+            {}
+
+            F op_;
+            boost::optional<T> init_;     // set for exclusive scans only
+        };
+
+        // After round k (with dist = 2^k), the inclusive value of site i
+        // covers the values of the sites (i - 2*dist, i] and the exclusive
+        // value covers the sites (i - 2*dist, i).
+        template <typename T>
+        struct scan_partial
+        {
+            T inclusive_;
+            boost::optional<T> exclusive_;
+        };
+
+        template <typename T, typename F>
+        T scan_finish(std::shared_ptr<scan_data<T, F> > const& data,
+            scan_partial<T> const& partial)
+        {
+            if (!data->init_)
+                return partial.inclusive_;
+
+            if (!partial.exclusive_)
+                return *data->init_;
+
+            return data->op_(*data->init_, *partial.exclusive_);
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        scan_round(std::shared_ptr<scan_data<T, F> > data,
+            std::size_t dist, scan_partial<T> && partial);
+
+        template <typename T, typename F>
+        hpx::future<T>
+        scan_step(std::shared_ptr<scan_data<T, F> > data, std::size_t dist,
+            scan_partial<T> const& partial, hpx::future<void> sent,
+            hpx::future<T> received)
+        {
+            sent.get();         // propagate any exceptions
+
+            T value = received.get();
+
+            scan_partial<T> result = { data->op_(value, partial.inclusive_) };
+            if (data->init_)
+            {
+                if (partial.exclusive_)
+                    result.exclusive_ = data->op_(value, *partial.exclusive_);
+                else
+                    result.exclusive_ = std::move(value);
+            }
+
+            return scan_round(data, dist * 2, std::move(result));
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        scan_skip(std::shared_ptr<scan_data<T, F> > data, std::size_t dist,
+            scan_partial<T> const& partial, hpx::future<void> sent)
+        {
+            sent.get();         // propagate any exceptions
+            return scan_round(data, dist * 2, scan_partial<T>(partial));
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        scan_round(std::shared_ptr<scan_data<T, F> > data,
+            std::size_t dist, scan_partial<T> && partial)
+        {
+            using util::placeholders::_1;
+            using util::placeholders::_2;
+
+            std::size_t const num_sites = data->num_sites_;
+            std::size_t const this_site = data->this_site_;
+
+            if (dist >= num_sites)
+                return hpx::make_ready_future(scan_finish(data, partial));
+
+            hpx::future<void> sent;
+            if (this_site + dist < num_sites)
+            {
+                sent = send_value(*data, this_site + dist, dist,
+                    partial.inclusive_);
+            }
+            else
+            {
+                sent = hpx::make_ready_future();
+            }
+
+            if (this_site < dist)
+            {
+                // nothing to receive in this round
+                return sent.then(util::bind(&detail::scan_skip<T, F>,
+                    data, dist, std::move(partial), _1));
+            }
+
+            return dataflow(
+                    util::bind(&detail::scan_step<T, F>, data, dist,
+                        std::move(partial), _1, _2),
+                    std::move(sent), receive_value<T>(*data, dist)
+                );
+        }
+
+        template <typename T, typename F>
+        hpx::future<T>
+        scan_collective(char const* basename, T const& local_result, F && op,
+            boost::optional<T> const& init, std::size_t num_sites,
+            std::size_t generation, std::size_t this_site)
+        {
+            init_collective_sites(num_sites, this_site);
+
+            typedef typename util::decay<F>::type scan_op_type;
+            typedef scan_data<T, scan_op_type> data_type;
+
+            std::shared_ptr<data_type> data = std::make_shared<data_type>(
+                get_collective_site<T>(basename, this_site), num_sites,
+                generation, std::forward<F>(op), init);
+
+            scan_partial<T> partial = { local_result };
+            return scan_round(data, 1, std::move(partial));
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    inclusive_scan(char const* basename, T && local_result, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type result_type;
+        return detail::scan_collective(basename,
+            result_type(std::forward<T>(local_result)),
+            std::forward<F>(op), boost::optional<result_type>(), num_sites,
+            generation, this_site);
+    }
+
+    template <typename T, typename F>
+    hpx::future<typename util::decay<T>::type>
+    exclusive_scan(char const* basename, T && local_result,
+        typename util::decay<T>::type const& init, F && op,
+        std::size_t num_sites = std::size_t(-1),
+        std::size_t generation = std::size_t(-1),
+        std::size_t this_site = std::size_t(-1))
+    {
+        typedef typename util::decay<T>::type result_type;
+        return detail::scan_collective(basename,
+            result_type(std::forward<T>(local_result)),
+            std::forward<F>(op), boost::optional<result_type>(init), num_sites,
+            generation, this_site);
+    }
+}}
+
+#endif // DOXYGEN
+#endif
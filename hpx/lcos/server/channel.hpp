@@ -0,0 +1,56 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_LCOS_SERVER_CHANNEL_OCT_19_2016_1145AM)
+#define HPX_LCOS_SERVER_CHANNEL_OCT_19_2016_1145AM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/local/channel.hpp>
+#include <hpx/runtime/actions/component_action.hpp>
+#include <hpx/runtime/components/server/simple_component_base.hpp>
+
+#include <cstddef>
+#include <utility>
+
+namespace hpx { namespace lcos { namespace server
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // The server side of a distributed channel simply exposes the operations
+    // of a local channel living on the locality the component was created on.
+    template <typename T>
+    class channel
+      : public hpx::components::simple_component_base<channel<T> >
+    {
+    public:
+        explicit channel(std::size_t capacity = std::size_t(-1))
+          : channel_(capacity)
+        {}
+
+        void set(T && val)
+        {
+            channel_.set(std::move(val));
+        }
+
+        hpx::future<T> get()
+        {
+            return channel_.get();
+        }
+
+        void close()
+        {
+            channel_.close();
+        }
+
+        HPX_DEFINE_COMPONENT_ACTION(channel, set, set_action);
+        HPX_DEFINE_COMPONENT_ACTION(channel, get, get_action);
+        HPX_DEFINE_COMPONENT_ACTION(channel, close, close_action);
+
+    private:
+        lcos::local::channel<T> channel_;
+    };
+}}}
+
+#endif
@@ -16,6 +16,7 @@
 #include <hpx/parallel/executors/thread_timed_executor_traits.hpp>
 #include <hpx/parallel/executors/thread_executor_parameter_traits.hpp>
 
+#include <hpx/parallel/executors/continuation_executors.hpp>
 #include <hpx/parallel/executors/parallel_executor.hpp>
 #include <hpx/parallel/executors/sequential_executor.hpp>
 #include <hpx/parallel/executors/distribution_policy_executor.hpp>
@@ -25,5 +26,6 @@
 #include <hpx/parallel/executors/thread_pool_os_executors.hpp>
 #include <hpx/parallel/executors/thread_pool_attached_executors.hpp>
 #include <hpx/parallel/executors/default_executor.hpp>
+#include <hpx/parallel/executors/numa_executor.hpp>
 
 #endif
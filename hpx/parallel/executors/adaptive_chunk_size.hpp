@@ -0,0 +1,413 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/adaptive_chunk_size.hpp
+
+#if !defined(HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_OCT_18_2016_1012AM)
+#define HPX_PARALLEL_ADAPTIVE_CHUNK_SIZE_OCT_18_2016_1012AM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/is_executor_parameters.hpp>
+#include <hpx/runtime/serialization/serialize.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_parameter_traits.hpp>
+#include <hpx/parallel/executors/executor_information_traits.hpp>
+#include <hpx/runtime/threads/thread_data_fwd.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/date_time_chrono.hpp>
+#include <hpx/util/unlock_guard.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <mutex>
+#include <typeindex>
+#include <typeinfo>
+#include <utility>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // Timing history collected for one call site (i.e. one instantiation
+        // of the chunking logic of a parallel algorithm, which in turn
+        // depends on the type of the user supplied function object).
+        struct adaptive_chunk_size_site
+        {
+            adaptive_chunk_size_site()
+              : chunks_per_core_(0), stable_(0)
+            {}
+
+            // chunks per core -> measured nanoseconds per iteration
+            std::map<std::size_t, double> history_;
+
+            std::size_t chunks_per_core_;   // current choice, 0 if unseeded
+            std::size_t stable_;            // invocations without a change
+        };
+
+        // One invocation of an algorithm which is being measured. It is
+        // created by mark_begin_execution on the thread invoking the
+        // algorithm, which is the same thread calling get_chunk_size.
+        struct adaptive_chunk_size_invocation
+        {
+            adaptive_chunk_size_invocation()
+              : thread_(threads::get_self_id().get()), start_(0),
+                site_(typeid(void)), count_(0), chunks_per_core_(0)
+            {}
+
+            threads::thread_id_repr_type thread_;
+            boost::uint64_t start_;         // nanoseconds
+
+            // filled in by get_chunk_size, count_ is zero if not called
+            std::type_index site_;
+            std::size_t count_;
+            std::size_t chunks_per_core_;
+        };
+
+        struct adaptive_chunk_size_data
+        {
+            typedef hpx::lcos::local::spinlock mutex_type;
+
+            mutex_type mtx_;
+            std::map<std::type_index, adaptive_chunk_size_site> sites_;
+
+            // invocations started by a thread which have not called
+            // get_chunk_size yet
+            std::map<
+                    threads::thread_id_repr_type,
+                    boost::shared_ptr<adaptive_chunk_size_invocation>
+                > starting_;
+        };
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Loop iterations are divided into pieces and then assigned to threads.
+    /// The number of chunks created per core is learned from the wall time of
+    /// previous invocations of the same parallel algorithm (the same call
+    /// site, as identified by the type of the function object which is
+    /// applied to the elements).
+    ///
+    /// The first invocation of an algorithm measures the execution time of
+    /// 1% of the iterations (same as \a auto_chunk_size) to seed the chunk
+    /// count. Subsequent invocations skip this probe and instead perform a
+    /// local search over the number of chunks per core (in powers of two),
+    /// settling on the count which minimizes the overall time per iteration.
+    /// This captures both the per-task overhead (too many chunks) and the
+    /// load imbalance (too few chunks). Once converged, the neighboring chunk
+    /// counts are re-evaluated periodically, and the collected history is
+    /// discarded whenever the measured cost per iteration changes noticeably,
+    /// which makes the parameters adapt to changing iteration costs.
+    ///
+    /// \note Copies of an \a adaptive_chunk_size object share their timing
+    ///       history. Concurrent algorithm invocations using the same object
+    ///       are measured separately, but will make the collected timings
+    ///       less precise.
+    ///
+    struct adaptive_chunk_size : executor_parameters_tag
+    {
+    public:
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \note Default constructed \a adaptive_chunk_size executor parameter
+        ///       types will use 80 microseconds as the minimal time for which
+        ///       any of the chunks scheduled during the first invocation of an
+        ///       algorithm should run.
+        ///
+        adaptive_chunk_size()
+          : data_(boost::make_shared<detail::adaptive_chunk_size_data>()),
+            min_time_(80000)
+        {}
+
+        /// Construct an \a adaptive_chunk_size executor parameters object
+        ///
+        /// \param rel_time     [in] The time duration to use as the minimum
+        ///                     to decide how many loop iterations should be
+        ///                     combined during the first invocation of an
+        ///                     algorithm.
+        ///
+        explicit adaptive_chunk_size(hpx::util::steady_duration const& rel_time)
+          : data_(boost::make_shared<detail::adaptive_chunk_size_data>()),
+            min_time_(rel_time.value().count())
+        {}
+
+        /// Discard all collected timing information.
+        void reset()
+        {
+            std::lock_guard<mutex_type> l(data_->mtx_);
+            data_->sites_.clear();
+        }
+
+        /// \cond NOINTERNAL
+        template <typename Executor, typename F>
+        std::size_t get_chunk_size(Executor& exec, F && f, std::size_t count)
+        {
+            std::size_t const cores = executor_information_traits<Executor>::
+                processing_units_count(exec, *this);
+
+            if (count == 0 || cores == 0)
+                return 0;
+
+            std::size_t const total = count;
+            std::unique_lock<mutex_type> l(data_->mtx_);
+
+            // the invocation started by this thread (if any), it has to be
+            // taken before running the probe below, which may invoke other
+            // algorithms
+            boost::shared_ptr<detail::adaptive_chunk_size_invocation>
+                invocation;
+            {
+                auto it = data_->starting_.find(threads::get_self_id().get());
+                if (it != data_->starting_.end())
+                {
+                    invocation = std::move(it->second);
+                    data_->starting_.erase(it);
+                }
+            }
+
+            std::type_index const key(typeid(F));
+            detail::adaptive_chunk_size_site& site = data_->sites_[key];
+
+            if (site.chunks_per_core_ == 0)
+            {
+                // first invocation for this call site, seed the chunk count
+                // by timing 1% of the iterations
+                std::size_t chunks_per_core = 1;
+                if (count > 100*cores)
+                {
+                    using hpx::util::high_resolution_clock;
+
+                    std::size_t test_chunk_size = 0;
+                    boost::uint64_t t = high_resolution_clock::now();
+                    {
+                        hpx::util::unlock_guard<std::unique_lock<mutex_type> >
+                            ul(l);
+                        test_chunk_size = f();
+                    }
+
+                    if (test_chunk_size != 0)
+                    {
+                        count -= test_chunk_size;
+                        t = (high_resolution_clock::now() - t) /
+                            test_chunk_size;
+                        if (t != 0)
+                        {
+                            std::size_t chunk_size = (std::max)(
+                                std::size_t(1), std::size_t(min_time_ / t));
+                            chunks_per_core = (count / chunk_size) / cores;
+                        }
+                    }
+                }
+
+                site.chunks_per_core_ = round_chunks_per_core(
+                    chunks_per_core, count, cores);
+            }
+
+            // clamp the current choice to what this invocation can support
+            std::size_t chunks_per_core = (std::min)(
+                site.chunks_per_core_, max_chunks_per_core(count, cores));
+
+            if (invocation)
+            {
+                invocation->site_ = key;
+                invocation->count_ = total;
+                invocation->chunks_per_core_ = chunks_per_core;
+            }
+
+            std::size_t const chunks = chunks_per_core * cores;
+            return (count + chunks - 1) / chunks;
+        }
+
+        // The algorithms invoke mark_begin_execution/mark_end_execution on
+        // their own copy of the parameters object, while get_chunk_size is
+        // invoked on the original object. The invocation is handed over
+        // using the id of the invoking thread.
+        void mark_begin_execution()
+        {
+            invocation_ =
+                boost::make_shared<detail::adaptive_chunk_size_invocation>();
+
+            {
+                std::lock_guard<mutex_type> l(data_->mtx_);
+                data_->starting_[invocation_->thread_] = invocation_;
+            }
+
+            invocation_->start_ = hpx::util::high_resolution_clock::now();
+        }
+
+        void mark_end_execution()
+        {
+            if (!invocation_)
+                return;
+
+            boost::uint64_t elapsed =
+                hpx::util::high_resolution_clock::now() - invocation_->start_;
+
+            boost::shared_ptr<detail::adaptive_chunk_size_invocation>
+                invocation(std::move(invocation_));
+
+            std::lock_guard<mutex_type> l(data_->mtx_);
+
+            // get_chunk_size might not have been called
+            auto it = data_->starting_.find(invocation->thread_);
+            if (it != data_->starting_.end() && it->second == invocation)
+                data_->starting_.erase(it);
+
+            if (invocation->count_ == 0)
+                return;
+
+            // the history might have been discarded in the meantime
+            auto site = data_->sites_.find(invocation->site_);
+            if (site == data_->sites_.end())
+                return;
+
+            update_site(site->second, invocation->chunks_per_core_,
+                double(elapsed) / double(invocation->count_));
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        typedef detail::adaptive_chunk_size_data::mutex_type mutex_type;
+
+        // re-evaluate the neighbors of a converged choice this often
+        HPX_STATIC_CONSTEXPR std::size_t reexplore_interval = 16;
+
+        // upper limit for the number of chunks created per core
+        HPX_STATIC_CONSTEXPR std::size_t max_chunks_per_core_limit = 64;
+
+        static std::size_t max_chunks_per_core(std::size_t count,
+            std::size_t cores)
+        {
+            std::size_t max_chunks = (std::max)(std::size_t(1), count / cores);
+            return (std::min)(max_chunks,
+                std::size_t(max_chunks_per_core_limit));
+        }
+
+        // round to the nearest power of two within the allowed range
+        static std::size_t round_chunks_per_core(std::size_t chunks_per_core,
+            std::size_t count, std::size_t cores)
+        {
+            std::size_t const upper = max_chunks_per_core(count, cores);
+
+            std::size_t result = 1;
+            while (result < chunks_per_core && 2*result <= upper)
+                result *= 2;
+            return result;
+        }
+
+        static double const* find_time(detail::adaptive_chunk_size_site& site,
+            std::size_t chunks_per_core)
+        {
+            std::map<std::size_t, double>::const_iterator it =
+                site.history_.find(chunks_per_core);
+            return it != site.history_.end() ? &it->second : nullptr;
+        }
+
+        static void update_site(detail::adaptive_chunk_size_site& site,
+            std::size_t current, double time_per_iteration)
+        {
+            std::map<std::size_t, double>::iterator it =
+                site.history_.find(current);
+            if (it == site.history_.end())
+            {
+                site.history_.insert(
+                    std::make_pair(current, time_per_iteration));
+            }
+            else
+            {
+                // the iteration cost has changed noticeably, forget
+                // everything we know and start over from the current choice
+                double const previous = it->second;
+                if (time_per_iteration > 1.25 * previous ||
+                    time_per_iteration < 0.8 * previous)
+                {
+                    site.history_.clear();
+                    site.history_.insert(
+                        std::make_pair(current, time_per_iteration));
+                    site.stable_ = 0;
+                }
+                else
+                {
+                    it->second = 0.5 * (it->second + time_per_iteration);
+                }
+            }
+
+            // explore the direct neighbors of the current choice first
+            std::size_t const lower = current > 1 ? current / 2 : current;
+            std::size_t const upper = (std::min)(2 * current,
+                std::size_t(max_chunks_per_core_limit));
+
+            if (lower != current && find_time(site, lower) == nullptr)
+            {
+                site.chunks_per_core_ = lower;
+                return;
+            }
+            if (upper != current && find_time(site, upper) == nullptr)
+            {
+                site.chunks_per_core_ = upper;
+                return;
+            }
+
+            // move towards the best of the known candidates
+            std::size_t best = current;
+            double best_time = *find_time(site, current);
+            for (std::size_t candidate : { lower, upper })
+            {
+                double const* t = find_time(site, candidate);
+                if (t != nullptr && *t < best_time)
+                {
+                    best = candidate;
+                    best_time = *t;
+                }
+            }
+
+            if (best != site.chunks_per_core_)
+            {
+                site.chunks_per_core_ = best;
+                site.stable_ = 0;
+            }
+            else if (++site.stable_ >= reexplore_interval)
+            {
+                // periodically re-measure the neighbors of a stable choice
+                site.history_.erase(lower);
+                site.history_.erase(upper);
+                site.stable_ = 0;
+            }
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        friend class hpx::serialization::access;
+
+        template <typename Archive>
+        void serialize(Archive & ar, const unsigned int version)
+        {
+            // the timing history is specific to the local execution
+            // environment and is not transferred
+            ar & min_time_;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        boost::shared_ptr<detail::adaptive_chunk_size_data> data_;
+        boost::uint64_t min_time_;      // nanoseconds
+
+        // the invocation measured using this copy of the parameters
+        boost::shared_ptr<detail::adaptive_chunk_size_invocation> invocation_;
+        /// \endcond
+    };
+}}}
+
+#endif
@@ -0,0 +1,328 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/continuation_executors.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_CONTINUATION_EXECUTORS_OCT_19_2016_0400PM)
+#define HPX_PARALLEL_EXECUTORS_CONTINUATION_EXECUTORS_OCT_19_2016_0400PM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/threads/executors/default_executor.hpp>
+#include <hpx/runtime/threads/policies/topology.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/thread_description.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+#include <boost/make_shared.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <cstddef>
+#include <iterator>
+#include <map>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The executors in this file are meant to be passed to future::then() and
+// dataflow() to control where a continuation is run once its input is ready.
+//
+//     f.then(parallel::inline_executor(), g);     // always inline
+//     dataflow(parallel::adaptive_inline_executor(), g, f1, f2);
+//
+// All of them contribute to the performance counters
+// /lcos/count/continuations/{inlined,spawned}.
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        template <typename F, typename ... Ts>
+        void run_continuation_inline(F && f, Ts &&... ts)
+        {
+            lcos::detail::count_continuation(
+                lcos::detail::continuation_inlined);
+            hpx::util::invoke(std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        void spawn_continuation(std::size_t os_thread, F && f, Ts &&... ts)
+        {
+            lcos::detail::count_continuation(
+                lcos::detail::continuation_spawned);
+
+            util::thread_description desc(f, "spawn_continuation");
+            threads::register_thread_nullary(
+                util::deferred_call(std::forward<F>(f),
+                    std::forward<Ts>(ts)...),
+                desc, threads::pending, true,
+                threads::thread_priority_normal, os_thread);
+        }
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// An \a inline_executor always runs a continuation on the thread which
+    /// makes its input ready. Continuations are still moved onto a new
+    /// thread if running them inline would exhaust the stack.
+    ///
+    struct inline_executor : executor_tag
+    {
+        /// \cond NOINTERNAL
+        template <typename F, typename ... Ts>
+        static void apply_execute(F && f, Ts &&... ts)
+        {
+            detail::run_continuation_inline(std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        static hpx::future<
+            typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type>
+        async_execute(F && f, Ts &&... ts)
+        {
+            lcos::detail::count_continuation(
+                lcos::detail::continuation_inlined);
+            return hpx::async(launch::sync, std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        std::size_t processing_units_count() const
+        {
+            return 1;
+        }
+        /// \endcond
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        // Running average of the execution time of a continuation type, in
+        // nanoseconds. The average is updated without synchronization, lost
+        // updates only delay the adaptation.
+        template <typename F>
+        struct continuation_cost
+        {
+            static boost::atomic<boost::uint64_t>& average()
+            {
+                static boost::atomic<boost::uint64_t> average_(0);
+                return average_;
+            }
+
+            static void update(boost::uint64_t elapsed)
+            {
+                boost::atomic<boost::uint64_t>& avg = average();
+                boost::uint64_t const old_avg =
+                    avg.load(boost::memory_order_relaxed);
+                avg.store(old_avg == 0 ? elapsed : (7 * old_avg + elapsed) / 8,
+                    boost::memory_order_relaxed);
+            }
+
+            template <typename ... Ts>
+            static void measure(F f, Ts... ts)
+            {
+                boost::uint64_t const start = util::high_resolution_clock::now();
+                hpx::util::invoke(f, std::move(ts)...);
+                update(util::high_resolution_clock::now() - start);
+            }
+        };
+    }
+    /// \endcond
+
+    /// An \a adaptive_inline_executor runs a continuation inline if
+    /// continuations of the same type have been measured to be cheap, and on
+    /// a new thread otherwise. The execution time is measured for every
+    /// invocation and kept as a running average per continuation type (which
+    /// depends on the type of the function passed to then() or dataflow()).
+    /// Continuations of an unknown cost are run inline the first time. The
+    /// continuation is always run on a new thread if the thread making the
+    /// input ready is not an HPX thread (for instance an I/O thread).
+    ///
+    struct adaptive_inline_executor : executor_tag
+    {
+        /// Create a new adaptive_inline_executor
+        ///
+        /// \param threshold    [in] The execution time (in nanoseconds) up to
+        ///                     which continuations are considered cheap.
+        ///
+        explicit adaptive_inline_executor(boost::uint64_t threshold = 10000)
+          : threshold_(threshold)
+        {}
+
+        /// \cond NOINTERNAL
+        template <typename F, typename ... Ts>
+        void apply_execute(F && f, Ts &&... ts) const
+        {
+            typedef typename util::decay<F>::type function_type;
+            typedef detail::continuation_cost<function_type> cost_type;
+
+            if (threads::get_self_ptr() != 0 &&
+                cost_type::average().load(boost::memory_order_relaxed) <=
+                    threshold_)
+            {
+                lcos::detail::count_continuation(
+                    lcos::detail::continuation_inlined);
+                cost_type::measure(std::forward<F>(f), std::forward<Ts>(ts)...);
+                return;
+            }
+
+            detail::spawn_continuation(std::size_t(-1),
+                &cost_type::template measure<typename util::decay<Ts>::type...>,
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        hpx::future<
+            typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type>
+        async_execute(F && f, Ts &&... ts) const
+        {
+            return hpx::async(launch::async, std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        std::size_t processing_units_count() const
+        {
+            return hpx::get_os_thread_count();
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        boost::uint64_t threshold_;
+        /// \endcond
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a producer_executor runs a continuation on a new thread which is
+    /// scheduled on the worker thread making the input of the continuation
+    /// ready. This keeps the continuation close to the data produced by its
+    /// predecessor. Continuations triggered from outside of the HPX worker
+    /// threads are scheduled on any worker thread.
+    ///
+    struct producer_executor : executor_tag
+    {
+        /// \cond NOINTERNAL
+        template <typename F, typename ... Ts>
+        static void apply_execute(F && f, Ts &&... ts)
+        {
+            detail::spawn_continuation(hpx::get_worker_thread_num(),
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        static hpx::future<
+            typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type>
+        async_execute(F && f, Ts &&... ts)
+        {
+            return hpx::async(launch::async, std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        std::size_t processing_units_count() const
+        {
+            return 1;
+        }
+        /// \endcond
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a numa_domain_executor runs continuations on new threads which are
+    /// scheduled round robin on the worker threads of one NUMA domain.
+    ///
+    struct numa_domain_executor : executor_tag
+    {
+        /// Create a new numa_domain_executor
+        ///
+        /// \param domain   [in] The (zero based) NUMA domain the
+        ///                 continuations are run on.
+        ///
+        explicit numa_domain_executor(std::size_t domain)
+          : data_(boost::make_shared<data>(domain))
+        {}
+
+        /// \cond NOINTERNAL
+        template <typename F, typename ... Ts>
+        void apply_execute(F && f, Ts &&... ts) const
+        {
+            detail::spawn_continuation(data_->next_thread(),
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        hpx::future<
+            typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type>
+        async_execute(F && f, Ts &&... ts) const
+        {
+            threads::executors::default_executor exec(data_->next_thread());
+            return hpx::async(exec, std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        std::size_t processing_units_count() const
+        {
+            return data_->threads_.size();
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        struct data
+        {
+            explicit data(std::size_t domain)
+              : next_(0)
+            {
+                threads::topology& topo = threads::create_topology();
+                threads::threadmanager_base& tm =
+                    hpx::get_runtime().get_thread_manager();
+
+                // group the worker threads by the NUMA domain of their PU
+                std::map<std::size_t, std::vector<std::size_t> > domains;
+                std::size_t const num_threads = hpx::get_os_thread_count();
+                for (std::size_t t = 0; t != num_threads; ++t)
+                {
+                    domains[topo.get_numa_node_number(tm.get_pu_num(t))]
+                        .push_back(t);
+                }
+
+                HPX_ASSERT(!domains.empty());
+                if (domain >= domains.size())
+                    domain = domains.size() - 1;
+
+                std::map<std::size_t, std::vector<std::size_t> >::iterator it =
+                    domains.begin();
+                std::advance(it, domain);
+                threads_.swap(it->second);
+            }
+
+            std::size_t next_thread()
+            {
+                return threads_[next_++ % threads_.size()];
+            }
+
+            std::vector<std::size_t> threads_;
+            boost::atomic<std::size_t> next_;
+        };
+
+        boost::shared_ptr<data> data_;
+        /// \endcond
+    };
+}}}
+
+#endif
@@ -0,0 +1,196 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/executors/numa_executor.hpp
+
+#if !defined(HPX_PARALLEL_EXECUTORS_NUMA_EXECUTOR_OCT_18_2016_0414PM)
+#define HPX_PARALLEL_EXECUTORS_NUMA_EXECUTOR_OCT_18_2016_0414PM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/runtime.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/launch_policy.hpp>
+#include <hpx/runtime/threads/executors/default_executor.hpp>
+#include <hpx/runtime/threads/policies/topology.hpp>
+#include <hpx/runtime/threads/threadmanager.hpp>
+#include <hpx/traits/is_executor.hpp>
+#include <hpx/util/assert.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/executors/executor_traits.hpp>
+#include <hpx/parallel/executors/static_chunk_size.hpp>
+
+#include <boost/make_shared.hpp>
+#include <boost/range/functions.hpp>
+#include <boost/shared_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <map>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v3)
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        struct numa_executor_data
+        {
+            explicit numa_executor_data(std::size_t num_domains)
+            {
+                threads::topology& topo = threads::create_topology();
+                threads::threadmanager_base& tm =
+                    hpx::get_runtime().get_thread_manager();
+
+                // group the worker threads by the NUMA domain of their PU
+                std::map<std::size_t, std::vector<std::size_t> > domains;
+                std::size_t const num_threads = hpx::get_os_thread_count();
+                for (std::size_t t = 0; t != num_threads; ++t)
+                {
+                    std::size_t domain =
+                        topo.get_numa_node_number(tm.get_pu_num(t));
+                    domains[domain].push_back(t);
+                }
+
+                if (num_domains == 0 || num_domains > domains.size())
+                    num_domains = domains.size();
+
+                executors_.reserve(num_threads);
+                domain_first_.reserve(num_domains + 1);
+
+                typedef std::map<std::size_t, std::vector<std::size_t> >
+                    domains_type;
+
+                domains_type::const_iterator it = domains.begin();
+                for (std::size_t d = 0; d != num_domains; ++d, ++it)
+                {
+                    domain_first_.push_back(executors_.size());
+                    for (std::size_t t : it->second)
+                    {
+                        executors_.push_back(
+                            threads::executors::default_executor(t));
+                    }
+                }
+                domain_first_.push_back(executors_.size());
+            }
+
+            // one executor per worker thread, ordered by NUMA domain
+            std::vector<threads::executors::default_executor> executors_;
+
+            // index of the first executor of each domain (plus end marker)
+            std::vector<std::size_t> domain_first_;
+        };
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A \a numa_executor creates groups of parallel execution agents which
+    /// are bound to the worker threads of one or more NUMA domains. Bulk
+    /// execution deterministically maps the i-th element of the shape onto
+    /// the same worker thread (and thus the same NUMA domain) on every
+    /// invocation: the elements are assigned in contiguous blocks, the first
+    /// block to the first worker thread of the first domain, etc.
+    ///
+    /// Together with its default executor parameters (\a static_chunk_size)
+    /// this guarantees that a parallel algorithm invoked on a range of the
+    /// same size processes each part of the range on the same domain every
+    /// time. Memory allocated with \a util::numa_first_touch_allocator using
+    /// the same executor is first touched by that very domain.
+    ///
+    /// \note Worker threads may still steal work across NUMA domains unless
+    ///       this is disabled by setting hpx.numa_sensitive=2.
+    ///
+    struct numa_executor : executor_tag
+    {
+        /// The default executor parameters for this executor
+        typedef static_chunk_size executor_parameters_type;
+
+        /// Create a new numa_executor using the worker threads of the given
+        /// number of NUMA domains.
+        ///
+        /// \param num_domains  [in] The number of NUMA domains to use, the
+        ///                     default (zero) uses all available domains.
+        ///
+        explicit numa_executor(std::size_t num_domains = 0)
+          : data_(boost::make_shared<detail::numa_executor_data>(num_domains))
+        {}
+
+        /// Return the number of NUMA domains used by this executor
+        std::size_t num_domains() const
+        {
+            return data_->domain_first_.size() - 1;
+        }
+
+        /// Return the NUMA domain the i-th out of \a size elements of a shape
+        /// passed to bulk_async_execute is executed on.
+        std::size_t get_domain(std::size_t i, std::size_t size) const
+        {
+            std::size_t const thread = get_thread(i, size);
+            std::vector<std::size_t> const& first = data_->domain_first_;
+            return std::upper_bound(first.begin(), first.end(), thread) -
+                first.begin() - 1;
+        }
+
+        /// \cond NOINTERNAL
+        template <typename F, typename ... Ts>
+        hpx::future<
+            typename hpx::util::detail::deferred_result_of<F(Ts&&...)>::type>
+        async_execute(F && f, Ts &&... ts)
+        {
+            return hpx::async(launch::async, std::forward<F>(f),
+                std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename Shape, typename ... Ts>
+        std::vector<hpx::future<
+            typename detail::bulk_async_execute_result<F, Shape, Ts...>::type
+        > >
+        bulk_async_execute(F && f, Shape const& shape, Ts &&... ts)
+        {
+            typedef typename
+                    detail::bulk_async_execute_result<F, Shape, Ts...>::type
+                result_type;
+
+            std::size_t const size = boost::size(shape);
+
+            std::vector<hpx::future<result_type> > results;
+            results.reserve(size);
+
+            std::size_t i = 0;
+            for (auto const& elem: shape)
+            {
+                threads::executors::default_executor& exec =
+                    data_->executors_[get_thread(i++, size)];
+                results.push_back(hpx::async(exec, f, elem, ts...));
+            }
+
+            return results;
+        }
+
+        std::size_t processing_units_count() const
+        {
+            return data_->executors_.size();
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        std::size_t get_thread(std::size_t i, std::size_t size) const
+        {
+            HPX_ASSERT(i < size);
+            return (i * data_->executors_.size()) / size;
+        }
+        /// \endcond
+
+    private:
+        /// \cond NOINTERNAL
+        boost::shared_ptr<detail::numa_executor_data> data_;
+        /// \endcond
+    };
+}}}
+
+#endif
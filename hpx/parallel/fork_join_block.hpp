@@ -0,0 +1,584 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file fork_join_block.hpp
+
+#if !defined(HPX_PARALLEL_FORK_JOIN_BLOCK_OCT_18_2016_0540PM)
+#define HPX_PARALLEL_FORK_JOIN_BLOCK_OCT_18_2016_0540PM
+
+#include <hpx/config.hpp>
+#include <hpx/exception.hpp>
+#include <hpx/lcos/local/detail/condition_variable.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/get_os_thread_count.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/deferred_call.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/unique_function.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/exception_list.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/task_block.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/exception_ptr.hpp>
+
+#include <cstddef>
+#include <list>
+#include <memory>
+#include <mutex>
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v2)
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        struct fork_join_block_base;
+
+        ///////////////////////////////////////////////////////////////////////
+        // A task forked from a fork_join_block. Jobs are stored in the block
+        // itself, i.e. on the stack of the forking thread.
+        struct fork_join_job
+        {
+            fork_join_job()
+              : block_(nullptr)
+            {}
+
+            hpx::util::unique_function_nonser<void()> f_;
+            fork_join_block_base* block_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The join state of a fork_join_block. Stealing threads access it
+        // only while holding the mutex, which the joining thread acquires
+        // before returning, if any of its jobs were stolen.
+        struct fork_join_block_base
+        {
+            typedef hpx::lcos::local::spinlock mutex_type;
+
+            fork_join_block_base()
+              : stolen_done_(0)
+            {}
+
+            // execute the given job, capturing any exception
+            void execute(fork_join_job& job)
+            {
+                try {
+                    job.f_();
+                }
+                catch (...) {
+                    std::lock_guard<mutex_type> l(mtx_);
+                    detail::handle_task_block_exceptions(errors_);
+                }
+                job.f_.reset();
+            }
+
+            // execute a job on behalf of the block's owner
+            void execute_stolen(fork_join_job& job)
+            {
+                execute(job);
+
+                // the block may go away as soon as the lock is released
+                std::unique_lock<mutex_type> l(mtx_);
+                ++stolen_done_;
+                cond_.notify_all(std::move(l));
+            }
+
+            mutex_type mtx_;
+            hpx::lcos::local::detail::condition_variable cond_;
+            parallel::exception_list errors_;
+            std::size_t stolen_done_;       // number of finished stolen jobs
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The queue of forked jobs of one worker thread. The owning blocks
+        // take their most recent jobs from the back, stealing threads take
+        // the oldest ones from the front. Jobs removed by their block from
+        // the middle of the queue leave a hole which is skipped.
+        class fork_join_queue
+        {
+        private:
+            typedef hpx::lcos::local::spinlock mutex_type;
+
+            static std::size_t const capacity = 256;
+
+            // remove the holes at both ends of the queue
+            void trim()
+            {
+                while (tail_ != head_ && jobs_[(tail_ - 1) % capacity] == nullptr)
+                    --tail_;
+                while (head_ != tail_ && jobs_[head_ % capacity] == nullptr)
+                    ++head_;
+            }
+
+        public:
+            fork_join_queue()
+              : head_(0), tail_(0)
+            {}
+
+            // returns false if the queue is full
+            bool push(fork_join_job* job)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (tail_ - head_ == capacity)
+                    return false;
+
+                jobs_[tail_++ % capacity] = job;
+                return true;
+            }
+
+            // remove the most recently pushed job of the given block
+            fork_join_job* pop(fork_join_block_base const* block)
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                for (std::size_t i = tail_; i != head_; --i)
+                {
+                    fork_join_job*& slot = jobs_[(i - 1) % capacity];
+                    if (slot != nullptr && slot->block_ == block)
+                    {
+                        fork_join_job* job = slot;
+                        slot = nullptr;
+                        trim();
+                        return job;
+                    }
+                }
+                return nullptr;
+            }
+
+            // remove the oldest job
+            fork_join_job* steal()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (head_ == tail_)
+                    return nullptr;
+
+                fork_join_job* job = jobs_[head_++ % capacity];
+                trim();
+                return job;
+            }
+
+            bool empty()
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                return head_ == tail_;
+            }
+
+        private:
+            mutex_type mtx_;
+            std::size_t head_;
+            std::size_t tail_;
+            fork_join_job* jobs_[capacity];
+            char pad_[64];      // avoid false sharing between worker queues
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The job queues of all worker threads. They are created once and
+        // reused by all fork_join_blocks. At most one stealing thread per
+        // worker thread is running, stealing threads keep running as long
+        // as there are jobs left in any of the queues.
+        class fork_join_queues
+        {
+        public:
+            explicit fork_join_queues(std::size_t num_queues)
+              : queues_(new fork_join_queue[num_queues]),
+                num_queues_(num_queues),
+                thieves_(0)
+            {}
+
+            // the queue of the current worker thread, if any
+            fork_join_queue* get()
+            {
+                std::size_t const num_thread = hpx::get_worker_thread_num();
+                if (num_thread >= num_queues_)
+                    return nullptr;
+                return &queues_[num_thread];
+            }
+
+            // returns false if the job could not be queued
+            bool push(fork_join_queue& queue, fork_join_job* job)
+            {
+                if (!queue.push(job))
+                    return false;
+
+                if (acquire_thief())
+                {
+                    threads::register_thread_nullary(
+                        hpx::util::bind(&fork_join_queues::steal, this),
+                        "fork_join_block::steal");
+                }
+                return true;
+            }
+
+        private:
+            bool acquire_thief()
+            {
+                std::size_t thieves = thieves_.load(boost::memory_order_relaxed);
+                while (thieves < num_queues_)
+                {
+                    if (thieves_.compare_exchange_weak(thieves, thieves + 1))
+                        return true;
+                }
+                return false;
+            }
+
+            fork_join_job* steal_any()
+            {
+                std::size_t first = hpx::get_worker_thread_num();
+                for (std::size_t i = 0; i != num_queues_; ++i)
+                {
+                    fork_join_job* job =
+                        queues_[(first + i) % num_queues_].steal();
+                    if (job != nullptr)
+                        return job;
+                }
+                return nullptr;
+            }
+
+            bool empty()
+            {
+                for (std::size_t i = 0; i != num_queues_; ++i)
+                {
+                    if (!queues_[i].empty())
+                        return false;
+                }
+                return true;
+            }
+
+            // thread function of the stealing threads
+            void steal()
+            {
+                do {
+                    while (fork_join_job* job = steal_any())
+                        job->block_->execute_stolen(*job);
+
+                    --thieves_;
+
+                    // jobs pushed while this thread was retiring would
+                    // otherwise wait for their owner to join
+                } while (!empty() && acquire_thief());
+            }
+
+            std::unique_ptr<fork_join_queue[]> queues_;
+            std::size_t const num_queues_;
+            boost::atomic<std::size_t> thieves_;
+        };
+
+        inline fork_join_queues& get_fork_join_queues()
+        {
+            static fork_join_queues queues(hpx::get_os_thread_count());
+            return queues;
+        }
+    }
+    /// \endcond
+
+    /// The class \a fork_join_block provides a lightweight interface for
+    /// forking and joining parallel tasks, targeting fine grained recursive
+    /// divide-and-conquer algorithms. The \a define_fork_join_block function
+    /// templates create an object of type fork_join_block and pass a
+    /// reference to that object to a user-provided callable object.
+    ///
+    /// Other than \a task_block, spawning a task does not create a future
+    /// (and its shared state) or a thread. The forked tasks and the join
+    /// counter are stored in the block on the stack of the creating thread,
+    /// the tasks are announced in a queue of the current worker thread.
+    /// These queues are created once and shared by all blocks. Idle worker
+    /// threads steal the oldest queued tasks (which for divide-and-conquer
+    /// algorithms usually represent the largest amount of work), while the
+    /// thread waiting for the block to finish executes its most recently
+    /// forked tasks itself. Tasks which can't be queued are executed
+    /// immediately by the forking thread.
+    ///
+    /// The same rules as for \a task_block apply with regard to a
+    /// fork_join_block being active: \a run and \a wait may be invoked only
+    /// from the code creating the block, nested blocks have to be created
+    /// for recursive invocations.
+    ///
+    /// \code
+    /// Example:
+    ///     int fib(int n)
+    ///     {
+    ///         if (n < 2) return n;
+    ///         int x = 0, y = 0;
+    ///         define_fork_join_block([&](auto& fj) {
+    ///             fj.run([&] { x = fib(n - 1); });
+    ///             y = fib(n - 2);
+    ///         });
+    ///         return x + y;
+    ///     }
+    /// \endcode
+    ///
+    /// \tparam ExPolicy The execution policy an instance of a
+    ///         \a fork_join_block was created with. This defaults to
+    ///         \a parallel_execution_policy. A sequential execution policy
+    ///         causes all forked tasks to be invoked immediately.
+    ///
+    template <typename ExPolicy = parallel::parallel_execution_policy>
+    class fork_join_block : private detail::fork_join_block_base
+    {
+    private:
+        /// \cond NOINTERNAL
+        typedef detail::fork_join_block_base::mutex_type mutex_type;
+
+        // number of jobs stored in the block itself
+        static std::size_t const num_slots = 4;
+
+        template <typename ExPolicy_, typename F>
+        friend void define_fork_join_block(ExPolicy_ &&, F &&);
+
+        explicit fork_join_block(ExPolicy const& policy = ExPolicy())
+          : id_(threads::get_self_id()),
+            policy_(policy),
+            queue_(nullptr),
+            forked_(0),
+            used_slots_(0)
+        {
+        }
+
+        fork_join_block(fork_join_block const &) = delete;
+        fork_join_block& operator=(fork_join_block const &) = delete;
+
+        fork_join_block* operator&() const = delete;
+
+        void check_active(char const* name) const
+        {
+            // The fork_join_block should be 'active' to be usable.
+            if (id_ != threads::get_self_id())
+            {
+                HPX_THROW_EXCEPTION(task_block_not_active, name,
+                    "the fork_join_block is not active");
+            }
+        }
+
+        // jobs beyond the slots of the block are kept in a list
+        detail::fork_join_job& allocate_job()
+        {
+            if (used_slots_ != num_slots)
+                return slots_[used_slots_++];
+
+            overflow_.emplace_back();
+            return overflow_.back();
+        }
+
+        // sequential execution policies invoke the task immediately
+        template <typename F, typename ... Ts>
+        void spawn(std::true_type, F && f, Ts &&... ts)
+        {
+            hpx::util::invoke(std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        template <typename F, typename ... Ts>
+        void spawn(std::false_type, F && f, Ts &&... ts)
+        {
+            detail::fork_join_queues& queues = detail::get_fork_join_queues();
+
+            if (queue_ == nullptr)
+                queue_ = queues.get();
+
+            detail::fork_join_job& job = allocate_job();
+            job.f_ = hpx::util::deferred_call(
+                std::forward<F>(f), std::forward<Ts>(ts)...);
+            job.block_ = this;
+
+            if (queue_ != nullptr && queues.push(*queue_, &job))
+            {
+                ++forked_;
+                return;
+            }
+
+            // not running on a worker thread or the queue is full
+            execute(job);
+        }
+
+        // wait for all forked tasks to finish
+        void join()
+        {
+            // execute the most recently forked tasks first
+            std::size_t executed = 0;
+            if (queue_ != nullptr)
+            {
+                while (detail::fork_join_job* job = queue_->pop(this))
+                {
+                    execute(*job);
+                    ++executed;
+                }
+            }
+
+            // wait for the tasks stolen by other threads
+            if (executed != forked_)
+            {
+                std::size_t const stolen = forked_ - executed;
+
+                std::unique_lock<mutex_type> l(mtx_);
+                while (stolen_done_ != stolen)
+                    cond_.wait(l, "fork_join_block::join");
+
+                stolen_done_ = 0;
+            }
+
+            // all jobs have finished, the slots can be reused
+            forked_ = 0;
+            used_slots_ = 0;
+            overflow_.clear();
+        }
+        /// \endcond
+
+    public:
+        /// Refers to the type of the execution policy used to create the
+        /// \a fork_join_block.
+        typedef ExPolicy execution_policy;
+
+        /// Causes the expression f(ts...) to be invoked asynchronously.
+        /// The invocation of f is permitted to run on an unspecified thread
+        /// in an unordered fashion relative to the sequence of operations
+        /// following the call to run(f), or by the thread which waits for
+        /// the completion of this fork_join_block.
+        ///
+        /// The completion of f() synchronizes with the next invocation of
+        /// wait on the same fork_join_block or completion of the
+        /// \a define_fork_join_block that created this block.
+        ///
+        /// Precondition: this shall be the active fork_join_block.
+        ///
+        template <typename F, typename ... Ts>
+        void run(F && f, Ts &&... ts)
+        {
+            check_active("fork_join_block::run");
+
+            typedef parallel::is_sequential_execution_policy<ExPolicy> is_seq;
+            spawn(is_seq(), std::forward<F>(f), std::forward<Ts>(ts)...);
+        }
+
+        /// Blocks until the tasks spawned using this fork_join_block have
+        /// finished. The calling thread executes any of the forked tasks
+        /// which have not been started yet.
+        ///
+        /// Precondition: this shall be the active fork_join_block.
+        ///
+        /// \note Exceptions thrown by the forked tasks are reported only on
+        ///       completion of the nearest enclosing
+        ///       \a define_fork_join_block.
+        ///
+        void wait()
+        {
+            check_active("fork_join_block::wait");
+            join();
+        }
+
+        /// Returns a reference to the execution policy used to construct this
+        /// object.
+        ///
+        /// Precondition: this shall be the active fork_join_block.
+        ///
+        ExPolicy const& policy() const { return policy_; }
+
+    private:
+        threads::thread_id_type id_;
+        ExPolicy policy_;
+        detail::fork_join_queue* queue_;
+        std::size_t forked_;                // number of queued jobs
+        std::size_t used_slots_;
+        detail::fork_join_job slots_[num_slots];
+        std::list<detail::fork_join_job> overflow_;
+    };
+
+    /// Constructs a \a fork_join_block, \a fj, using the given execution
+    /// policy \a policy, and invokes the expression \a f(fj) on the
+    /// user-provided object, \a f.
+    ///
+    /// \tparam ExPolicy    The type of the execution policy to use (deduced).
+    ///                     It describes the manner in which the execution
+    ///                     of the forked tasks may be parallelized. Only
+    ///                     synchronous execution policies are supported.
+    /// \tparam F   The type of the user defined function to invoke inside the
+    ///             define_fork_join_block (deduced).
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the forked tasks.
+    /// \param f    The user defined function to invoke inside the block.
+    ///             Given an lvalue \a fj of type \a fork_join_block, the
+    ///             expression, (void)f(fj), shall be well-formed.
+    ///
+    /// Postcondition: All tasks spawned from \a f have finished execution.
+    ///
+    /// \throws An \a exception_list holding all exceptions thrown by \a f
+    ///         and the forked tasks.
+    ///
+    template <typename ExPolicy, typename F>
+    void define_fork_join_block(ExPolicy && policy, F && f)
+    {
+        static_assert(
+            parallel::is_execution_policy<ExPolicy>::value,
+            "parallel::is_execution_policy<ExPolicy>::value");
+        static_assert(
+            !parallel::is_async_execution_policy<ExPolicy>::value,
+            "define_fork_join_block does not support asynchronous "
+            "execution policies");
+
+        typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+        fork_join_block<policy_type> fj(std::forward<ExPolicy>(policy));
+
+        // invoke the user supplied function
+        try {
+            f(fj);
+        }
+        catch (...) {
+            std::lock_guard<typename fork_join_block<policy_type>::mutex_type>
+                l(fj.mtx_);
+            detail::handle_task_block_exceptions(fj.errors_);
+        }
+
+        // regardless of whether f(fj) has thrown an exception we need to
+        // wait for all tasks to join
+        fj.join();
+
+        if (fj.errors_.size() != 0)
+            boost::throw_exception(fj.errors_);
+    }
+
+    /// Constructs a \a fork_join_block, \a fj, and invokes the expression
+    /// \a f(fj) on the user-provided object, \a f. This version uses
+    /// \a parallel_execution_policy for task scheduling.
+    ///
+    /// \tparam F   The type of the user defined function to invoke inside the
+    ///             define_fork_join_block (deduced).
+    ///
+    /// \param f    The user defined function to invoke inside the block.
+    ///             Given an lvalue \a fj of type \a fork_join_block, the
+    ///             expression, (void)f(fj), shall be well-formed.
+    ///
+    /// Postcondition: All tasks spawned from \a f have finished execution.
+    ///
+    /// \throws An \a exception_list holding all exceptions thrown by \a f
+    ///         and the forked tasks.
+    ///
+    template <typename F>
+    void define_fork_join_block(F && f)
+    {
+        define_fork_join_block(parallel::par, std::forward<F>(f));
+    }
+}}}
+
+/// \cond NOINTERNAL
+namespace std
+{
+    template <typename ExPolicy>
+    hpx::parallel::v2::fork_join_block<ExPolicy>*
+    addressof(hpx::parallel::v2::fork_join_block<ExPolicy>&) = delete;
+}
+namespace boost
+{
+    template <typename ExPolicy>
+    hpx::parallel::v2::fork_join_block<ExPolicy>*
+    addressof(hpx::parallel::v2::fork_join_block<ExPolicy>&) = delete;
+}
+/// \endcond
+
+#endif
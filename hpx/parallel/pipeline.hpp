@@ -0,0 +1,843 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/pipeline.hpp
+
+#if !defined(HPX_PARALLEL_PIPELINE_OCT_18_2016_0211PM)
+#define HPX_PARALLEL_PIPELINE_OCT_18_2016_0211PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/traits/is_iterator.hpp>
+#include <hpx/util/decay.hpp>
+#include <hpx/util/invoke.hpp>
+#include <hpx/util/unwrapped.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/foreach_partitioner.hpp>
+#include <hpx/parallel/util/loop.hpp>
+#include <hpx/parallel/util/partitioner.hpp>
+#include <hpx/parallel/util/scan_partitioner.hpp>
+
+#include <boost/optional.hpp>
+#include <boost/range/functions.hpp>
+#include <boost/range/iterator.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// The pipeline layer allows to lazily compose element-wise operations
+// (transform, filter) on top of an input range. The composed operations are
+// evaluated only when a terminal operation (for_each, reduce, count, copy) is
+// invoked. All stages are fused into a single partitioned pass over the input
+// sequence, which avoids materializing intermediate ranges and synchronizing
+// after each of the stages:
+//
+//      using namespace hpx::parallel;
+//      int sum = pipeline::reduce(par,
+//          pipeline::from(v) |
+//              pipeline::transform([](int i) { return i * i; }) |
+//              pipeline::filter([](int i) { return i % 2 == 0; }),
+//          0, std::plus<int>());
+//
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1) {
+    namespace pipeline
+{
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        // A sink is a function object which is invoked for each element
+        // flowing through the pipeline. Stages create new sinks by wrapping
+        // the sink of their downstream stage.
+        template <typename F, typename Sink>
+        struct transform_sink
+        {
+            transform_sink(F const& f, Sink const& sink)
+              : f_(f), sink_(sink)
+            {}
+
+            template <typename T>
+            void operator()(T && t)
+            {
+                sink_(hpx::util::invoke(f_, std::forward<T>(t)));
+            }
+
+            F f_;
+            Sink sink_;
+        };
+
+        template <typename Pred, typename Sink>
+        struct filter_sink
+        {
+            filter_sink(Pred const& pred, Sink const& sink)
+              : pred_(pred), sink_(sink)
+            {}
+
+            template <typename T>
+            void operator()(T && t)
+            {
+                if (hpx::util::invoke(pred_, t))
+                    sink_(std::forward<T>(t));
+            }
+
+            Pred pred_;
+            Sink sink_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // Terminal sinks
+        template <typename F>
+        struct invoke_sink
+        {
+            explicit invoke_sink(F& f)
+              : f_(f)
+            {}
+
+            template <typename T>
+            void operator()(T && t)
+            {
+                hpx::util::invoke(f_, std::forward<T>(t));
+            }
+
+            F& f_;
+        };
+
+        template <typename T, typename Reduce>
+        struct accumulate_sink
+        {
+            accumulate_sink(T& val, Reduce& r)
+              : val_(val), r_(r)
+            {}
+
+            template <typename U>
+            void operator()(U && u)
+            {
+                val_ = hpx::util::invoke(r_, val_, std::forward<U>(u));
+            }
+
+            T& val_;
+            Reduce& r_;
+        };
+
+        template <typename T, typename Reduce>
+        struct optional_accumulate_sink
+        {
+            optional_accumulate_sink(boost::optional<T>& val, Reduce& r)
+              : val_(val), r_(r)
+            {}
+
+            template <typename U>
+            void operator()(U && u)
+            {
+                if (val_)
+                    val_ = T(hpx::util::invoke(r_, *val_, std::forward<U>(u)));
+                else
+                    val_ = T(std::forward<U>(u));
+            }
+
+            boost::optional<T>& val_;
+            Reduce& r_;
+        };
+
+        struct count_sink
+        {
+            explicit count_sink(std::size_t& count)
+              : count_(count)
+            {}
+
+            template <typename T>
+            void operator()(T &&)
+            {
+                ++count_;
+            }
+
+            std::size_t& count_;
+        };
+
+        template <typename OutIter>
+        struct output_sink
+        {
+            explicit output_sink(OutIter& dest)
+              : dest_(dest)
+            {}
+
+            template <typename T>
+            void operator()(T && t)
+            {
+                *dest_ = std::forward<T>(t);
+                ++dest_;
+            }
+
+            OutIter& dest_;
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Iter, typename Stages, typename Sink>
+        void apply_stages_n(Iter first, std::size_t count, Stages const& stages,
+            Sink && sink)
+        {
+            auto s = stages.make_sink(std::forward<Sink>(sink));
+            util::loop_n(first, count,
+                [&s](Iter it)
+                {
+                    s(*it);
+                });
+        }
+
+        template <typename Iter, typename Stages, typename Sink>
+        void apply_stages(Iter first, Iter last, Stages const& stages,
+            Sink && sink)
+        {
+            auto s = stages.make_sink(std::forward<Sink>(sink));
+            for (/**/; first != last; ++first)
+                s(*first);
+        }
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Base class of all pipeline stages
+    struct stage_tag {};
+
+    /// Trait detecting pipeline stages
+    template <typename T>
+    struct is_stage
+      : std::is_base_of<stage_tag, typename hpx::util::decay<T>::type>
+    {};
+
+    /// The identity stage passes all elements through unchanged.
+    struct identity_stage : stage_tag
+    {
+        /// \cond NOINTERNAL
+        typedef std::true_type is_size_preserving;
+
+        template <typename Sink>
+        typename hpx::util::decay<Sink>::type make_sink(Sink && sink) const
+        {
+            return std::forward<Sink>(sink);
+        }
+        /// \endcond
+    };
+
+    /// The transform stage applies a function to each element.
+    template <typename F>
+    struct transform_stage : stage_tag
+    {
+        /// \cond NOINTERNAL
+        typedef std::true_type is_size_preserving;
+
+        explicit transform_stage(F const& f)
+          : f_(f)
+        {}
+
+        explicit transform_stage(F && f)
+          : f_(std::move(f))
+        {}
+
+        template <typename Sink>
+        detail::transform_sink<F, typename hpx::util::decay<Sink>::type>
+        make_sink(Sink && sink) const
+        {
+            return detail::transform_sink<
+                    F, typename hpx::util::decay<Sink>::type
+                >(f_, std::forward<Sink>(sink));
+        }
+
+        F f_;
+        /// \endcond
+    };
+
+    /// The filter stage passes on only those elements for which a predicate
+    /// returns true.
+    template <typename Pred>
+    struct filter_stage : stage_tag
+    {
+        /// \cond NOINTERNAL
+        typedef std::false_type is_size_preserving;
+
+        explicit filter_stage(Pred const& pred)
+          : pred_(pred)
+        {}
+
+        explicit filter_stage(Pred && pred)
+          : pred_(std::move(pred))
+        {}
+
+        template <typename Sink>
+        detail::filter_sink<Pred, typename hpx::util::decay<Sink>::type>
+        make_sink(Sink && sink) const
+        {
+            return detail::filter_sink<
+                    Pred, typename hpx::util::decay<Sink>::type
+                >(pred_, std::forward<Sink>(sink));
+        }
+
+        Pred pred_;
+        /// \endcond
+    };
+
+    /// The composed stage applies the stage \a First and passes its
+    /// results on to the stage \a Second.
+    template <typename First, typename Second>
+    struct composed_stage : stage_tag
+    {
+        /// \cond NOINTERNAL
+        typedef std::integral_constant<bool,
+                First::is_size_preserving::value &&
+                Second::is_size_preserving::value
+            > is_size_preserving;
+
+        composed_stage(First const& first, Second const& second)
+          : first_(first), second_(second)
+        {}
+
+        template <typename Sink>
+        auto make_sink(Sink && sink) const
+        ->  decltype(std::declval<First const&>().make_sink(
+                std::declval<Second const&>().make_sink(
+                    std::forward<Sink>(sink))))
+        {
+            return first_.make_sink(
+                second_.make_sink(std::forward<Sink>(sink)));
+        }
+
+        First first_;
+        Second second_;
+        /// \endcond
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// A lazily evaluated view of the range [first, last) with a (possibly
+    /// empty) chain of stages applied to its elements.
+    template <typename Iter, typename Stages = identity_stage>
+    class view
+    {
+    public:
+        typedef Iter iterator;
+        typedef Stages stages_type;
+
+        view(Iter first, Iter last, Stages const& stages = Stages())
+          : first_(first), last_(last), stages_(stages)
+        {}
+
+        Iter begin() const { return first_; }
+        Iter end() const { return last_; }
+        Stages const& stages() const { return stages_; }
+
+    private:
+        Iter first_;
+        Iter last_;
+        Stages stages_;
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create a pipeline view of the range [first, last).
+    template <typename Iter>
+    view<Iter> from(Iter first, Iter last)
+    {
+        return view<Iter>(first, last);
+    }
+
+    /// Create a pipeline view of the given range.
+    template <typename Rng>
+    view<typename boost::range_iterator<Rng>::type> from(Rng& rng)
+    {
+        typedef typename boost::range_iterator<Rng>::type iterator;
+        return view<iterator>(boost::begin(rng), boost::end(rng));
+    }
+
+    /// Create a stage which applies \a f to each of the elements.
+    template <typename F>
+    transform_stage<typename hpx::util::decay<F>::type> transform(F && f)
+    {
+        return transform_stage<typename hpx::util::decay<F>::type>(
+            std::forward<F>(f));
+    }
+
+    /// Create a stage which drops all elements for which \a pred returns
+    /// false.
+    template <typename Pred>
+    filter_stage<typename hpx::util::decay<Pred>::type> filter(Pred && pred)
+    {
+        return filter_stage<typename hpx::util::decay<Pred>::type>(
+            std::forward<Pred>(pred));
+    }
+
+    /// Append the stage \a s to the given view.
+    template <typename Iter, typename Stages, typename Stage>
+    typename std::enable_if<
+        is_stage<Stage>::value,
+        view<Iter, composed_stage<
+            Stages, typename hpx::util::decay<Stage>::type> >
+    >::type
+    operator|(view<Iter, Stages> const& v, Stage && s)
+    {
+        typedef composed_stage<
+                Stages, typename hpx::util::decay<Stage>::type
+            > stages_type;
+        return view<Iter, stages_type>(v.begin(), v.end(),
+            stages_type(v.stages(), std::forward<Stage>(s)));
+    }
+
+    /// Compose the two given stages.
+    template <typename Stage1, typename Stage2>
+    typename std::enable_if<
+        is_stage<Stage1>::value && is_stage<Stage2>::value,
+        composed_stage<
+            typename hpx::util::decay<Stage1>::type,
+            typename hpx::util::decay<Stage2>::type>
+    >::type
+    operator|(Stage1 && s1, Stage2 && s2)
+    {
+        typedef composed_stage<
+                typename hpx::util::decay<Stage1>::type,
+                typename hpx::util::decay<Stage2>::type
+            > stages_type;
+        return stages_type(std::forward<Stage1>(s1), std::forward<Stage2>(s2));
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// \cond NOINTERNAL
+    namespace detail
+    {
+        template <typename ExPolicy, typename Iter>
+        struct is_sequential
+          : std::integral_constant<bool,
+                parallel::is_sequential_execution_policy<ExPolicy>::value ||
+               !hpx::traits::is_forward_iterator<Iter>::value>
+        {};
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Iter>
+        struct for_each
+          : public parallel::v1::detail::algorithm<for_each<Iter>, Iter>
+        {
+            for_each()
+              : for_each::algorithm("pipeline::for_each")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Stages,
+                typename F>
+            static InIter
+            sequential(ExPolicy, InIter first, InIter last,
+                Stages const& stages, F && f)
+            {
+                detail::apply_stages(first, last, stages,
+                    invoke_sink<typename std::remove_reference<F>::type>(f));
+                return last;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stages,
+                typename F>
+            static typename util::detail::algorithm_result<
+                ExPolicy, FwdIter
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Stages const& stages, F && f)
+            {
+                std::size_t count = std::distance(first, last);
+                if (count == 0)
+                {
+                    return util::detail::algorithm_result<
+                            ExPolicy, FwdIter
+                        >::get(std::move(last));
+                }
+
+                typedef typename std::remove_reference<F>::type func_type;
+                return util::foreach_partitioner<ExPolicy>::call(
+                    std::forward<ExPolicy>(policy), first, count,
+                    [stages, f](std::size_t /*base_idx*/,
+                        FwdIter part_begin, std::size_t part_size) mutable
+                    {
+                        detail::apply_stages_n(part_begin, part_size, stages,
+                            invoke_sink<func_type>(f));
+                    });
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename T>
+        struct reduce
+          : public parallel::v1::detail::algorithm<reduce<T>, T>
+        {
+            reduce()
+              : reduce::algorithm("pipeline::reduce")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Stages,
+                typename T_, typename Reduce>
+            static T
+            sequential(ExPolicy, InIter first, InIter last,
+                Stages const& stages, T_ && init, Reduce && r)
+            {
+                T val = std::forward<T_>(init);
+                detail::apply_stages(first, last, stages,
+                    accumulate_sink<
+                        T, typename std::remove_reference<Reduce>::type
+                    >(val, r));
+                return val;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stages,
+                typename T_, typename Reduce>
+            static typename util::detail::algorithm_result<ExPolicy, T>::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Stages const& stages, T_ && init, Reduce && r)
+            {
+                std::size_t count = std::distance(first, last);
+                if (count == 0)
+                {
+                    T init_ = init;
+                    return util::detail::algorithm_result<ExPolicy, T>::get(
+                        std::move(init_));
+                }
+
+                typedef typename std::remove_reference<Reduce>::type
+                    reduce_type;
+                typedef boost::optional<T> partial_type;
+
+                return util::partitioner<ExPolicy, T, partial_type>::call(
+                    std::forward<ExPolicy>(policy), first, count,
+                    [stages, r](FwdIter part_begin, std::size_t part_size)
+                        mutable -> partial_type
+                    {
+                        partial_type val;
+                        detail::apply_stages_n(part_begin, part_size, stages,
+                            optional_accumulate_sink<T, reduce_type>(val, r));
+                        return val;
+                    },
+                    hpx::util::unwrapped(
+                        [init, r](std::vector<partial_type> && results) -> T
+                        {
+                            T val = init;
+                            for (partial_type const& p : results)
+                            {
+                                if (p)
+                                    val = hpx::util::invoke(r, val, *p);
+                            }
+                            return val;
+                        }));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        struct count
+          : public parallel::v1::detail::algorithm<count, std::size_t>
+        {
+            count()
+              : count::algorithm("pipeline::count")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Stages>
+            static std::size_t
+            sequential(ExPolicy, InIter first, InIter last,
+                Stages const& stages)
+            {
+                std::size_t result = 0;
+                detail::apply_stages(first, last, stages, count_sink(result));
+                return result;
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stages>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::size_t
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Stages const& stages)
+            {
+                std::size_t size = std::distance(first, last);
+                if (size == 0)
+                {
+                    return util::detail::algorithm_result<
+                            ExPolicy, std::size_t
+                        >::get(std::size_t(0));
+                }
+
+                return util::partitioner<
+                        ExPolicy, std::size_t, std::size_t
+                    >::call(
+                    std::forward<ExPolicy>(policy), first, size,
+                    [stages](FwdIter part_begin, std::size_t part_size)
+                        -> std::size_t
+                    {
+                        std::size_t result = 0;
+                        detail::apply_stages_n(part_begin, part_size, stages,
+                            count_sink(result));
+                        return result;
+                    },
+                    hpx::util::unwrapped(
+                        [](std::vector<std::size_t> && results)
+                        {
+                            std::size_t result = 0;
+                            for (std::size_t r : results)
+                                result += r;
+                            return result;
+                        }));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename OutIter>
+        struct copy
+          : public parallel::v1::detail::algorithm<copy<OutIter>, OutIter>
+        {
+            copy()
+              : copy::algorithm("pipeline::copy")
+            {}
+
+            template <typename ExPolicy, typename InIter, typename Stages,
+                typename OutIter_>
+            static OutIter
+            sequential(ExPolicy, InIter first, InIter last,
+                Stages const& stages, OutIter_ dest)
+            {
+                detail::apply_stages(first, last, stages,
+                    output_sink<OutIter_>(dest));
+                return dest;
+            }
+
+            // If none of the stages drops elements, the position of each
+            // result is known upfront and a single pass is sufficient.
+            template <typename ExPolicy, typename FwdIter, typename Stages,
+                typename OutIter_>
+            static typename util::detail::algorithm_result<
+                ExPolicy, OutIter
+            >::type
+            parallel_copy(ExPolicy && policy, FwdIter first,
+                std::size_t count, Stages const& stages, OutIter_ dest,
+                std::true_type)
+            {
+                return util::partitioner<ExPolicy, OutIter, void>::
+                    call_with_index(
+                        std::forward<ExPolicy>(policy), first, count, 1,
+                        [stages, dest](std::size_t base_idx,
+                            FwdIter part_begin, std::size_t part_size)
+                        {
+                            OutIter_ out = dest;
+                            std::advance(out, base_idx);
+                            detail::apply_stages_n(part_begin, part_size,
+                                stages, output_sink<OutIter_>(out));
+                        },
+                        [dest, count](std::vector<hpx::future<void> > &&)
+                            mutable -> OutIter
+                        {
+                            std::advance(dest, count);
+                            return dest;
+                        });
+            }
+
+            // Otherwise the number of elements surviving each partition is
+            // counted first, the output positions are derived from a scan
+            // over those counts, and the elements are written in a second
+            // step (similar to copy_if).
+            template <typename ExPolicy, typename FwdIter, typename Stages,
+                typename OutIter_>
+            static typename util::detail::algorithm_result<
+                ExPolicy, OutIter
+            >::type
+            parallel_copy(ExPolicy && policy, FwdIter first,
+                std::size_t count, Stages const& stages, OutIter_ dest,
+                std::false_type)
+            {
+                typedef util::scan_partitioner<
+                        ExPolicy, OutIter, std::size_t
+                    > scan_partitioner_type;
+
+                return scan_partitioner_type::call(
+                    std::forward<ExPolicy>(policy), first, count,
+                    std::size_t(0),
+                    // step 1 counts the elements which pass all stages
+                    [stages](FwdIter part_begin, std::size_t part_size)
+                        -> std::size_t
+                    {
+                        std::size_t curr = 0;
+                        detail::apply_stages_n(part_begin, part_size, stages,
+                            count_sink(curr));
+                        return curr;
+                    },
+                    // step 2 propagates the partition results from left
+                    // to right
+                    hpx::util::unwrapped(std::plus<std::size_t>()),
+                    // step 3 writes the elements of each partition
+                    [stages, dest](FwdIter part_begin, std::size_t part_size,
+                        hpx::shared_future<std::size_t> f_accu)
+                    {
+                        OutIter_ out = dest;
+                        std::advance(out, f_accu.get());
+                        detail::apply_stages_n(part_begin, part_size, stages,
+                            output_sink<OutIter_>(out));
+                    },
+                    // step 4 use this return value
+                    [dest](
+                        std::vector<hpx::shared_future<std::size_t> > && items,
+                        std::vector<hpx::future<void> > &&) mutable
+                    ->  OutIter
+                    {
+                        std::advance(dest, items.back().get());
+                        return dest;
+                    });
+            }
+
+            template <typename ExPolicy, typename FwdIter, typename Stages,
+                typename OutIter_>
+            static typename util::detail::algorithm_result<
+                ExPolicy, OutIter
+            >::type
+            parallel(ExPolicy && policy, FwdIter first, FwdIter last,
+                Stages const& stages, OutIter_ dest)
+            {
+                std::size_t count = std::distance(first, last);
+                if (count == 0)
+                {
+                    return util::detail::algorithm_result<
+                            ExPolicy, OutIter
+                        >::get(std::move(dest));
+                }
+
+                return parallel_copy(std::forward<ExPolicy>(policy), first,
+                    count, stages, dest,
+                    typename Stages::is_size_preserving());
+            }
+        };
+    }
+    /// \endcond
+
+    ///////////////////////////////////////////////////////////////////////////
+    /// Applies \a f to each of the elements produced by the given pipeline
+    /// view. All stages of the view are fused into a single pass over the
+    /// underlying sequence.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param v            The pipeline view to evaluate.
+    /// \param f            The function to invoke for each element.
+    ///
+    /// \returns  The \a for_each algorithm returns a \a hpx::future<Iter> if
+    ///           the execution policy is of type
+    ///           \a parallel_task_execution_policy and returns \a Iter
+    ///           otherwise. The returned iterator refers to the end of the
+    ///           underlying sequence.
+    ///
+    template <typename ExPolicy, typename Iter, typename Stages, typename F>
+    inline typename std::enable_if<
+        is_execution_policy<ExPolicy>::value,
+        typename util::detail::algorithm_result<ExPolicy, Iter>::type
+    >::type
+    for_each(ExPolicy && policy, view<Iter, Stages> const& v, F && f)
+    {
+        typedef detail::is_sequential<ExPolicy, Iter> is_seq;
+        return detail::for_each<Iter>().call(
+            std::forward<ExPolicy>(policy), is_seq(),
+            v.begin(), v.end(), v.stages(), std::forward<F>(f));
+    }
+
+    /// Returns GENERALIZED_SUM(red_op, init, e1, ..., eN), where e1 to eN are
+    /// the elements produced by the given pipeline view. All stages of the
+    /// view and the reduction are fused into a single pass over the
+    /// underlying sequence.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param v            The pipeline view to evaluate.
+    /// \param init         The initial value for the generalized sum.
+    /// \param red_op       The binary reduction operation.
+    ///
+    /// \returns  The \a reduce algorithm returns a \a hpx::future<T> if the
+    ///           execution policy is of type \a parallel_task_execution_policy
+    ///           and returns \a T otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Stages, typename T,
+        typename Reduce>
+    inline typename std::enable_if<
+        is_execution_policy<ExPolicy>::value,
+        typename util::detail::algorithm_result<
+            ExPolicy, typename hpx::util::decay<T>::type
+        >::type
+    >::type
+    reduce(ExPolicy && policy, view<Iter, Stages> const& v, T && init,
+        Reduce && red_op)
+    {
+        typedef detail::is_sequential<ExPolicy, Iter> is_seq;
+        typedef typename hpx::util::decay<T>::type init_type;
+
+        return detail::reduce<init_type>().call(
+            std::forward<ExPolicy>(policy), is_seq(),
+            v.begin(), v.end(), v.stages(), std::forward<T>(init),
+            std::forward<Reduce>(red_op));
+    }
+
+    /// Returns the number of elements produced by the given pipeline view.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param v            The pipeline view to evaluate.
+    ///
+    /// \returns  The \a count algorithm returns a
+    ///           \a hpx::future<std::size_t> if the execution policy is of
+    ///           type \a parallel_task_execution_policy and returns
+    ///           \a std::size_t otherwise.
+    ///
+    template <typename ExPolicy, typename Iter, typename Stages>
+    inline typename std::enable_if<
+        is_execution_policy<ExPolicy>::value,
+        typename util::detail::algorithm_result<ExPolicy, std::size_t>::type
+    >::type
+    count(ExPolicy && policy, view<Iter, Stages> const& v)
+    {
+        typedef detail::is_sequential<ExPolicy, Iter> is_seq;
+        return detail::count().call(
+            std::forward<ExPolicy>(policy), is_seq(),
+            v.begin(), v.end(), v.stages());
+    }
+
+    /// Copies the elements produced by the given pipeline view to the range
+    /// beginning at \a dest.
+    ///
+    /// \param policy       The execution policy to use for the scheduling of
+    ///                     the iterations.
+    /// \param v            The pipeline view to evaluate.
+    /// \param dest         Refers to the beginning of the destination range.
+    ///
+    /// \note   If none of the stages of the view is a filter, this is a
+    ///         single pass over the underlying sequence. Otherwise the
+    ///         stages are evaluated twice for each element: once to determine
+    ///         the output position and once to produce the value.
+    ///
+    /// \returns  The \a copy algorithm returns a \a hpx::future<OutIter> if
+    ///           the execution policy is of type
+    ///           \a parallel_task_execution_policy and returns \a OutIter
+    ///           otherwise. The returned iterator refers to the element in
+    ///           the destination range one past the last element copied.
+    ///
+    template <typename ExPolicy, typename Iter, typename Stages,
+        typename OutIter>
+    inline typename std::enable_if<
+        is_execution_policy<ExPolicy>::value,
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+    >::type
+    copy(ExPolicy && policy, view<Iter, Stages> const& v, OutIter dest)
+    {
+        typedef std::integral_constant<bool,
+                parallel::is_sequential_execution_policy<ExPolicy>::value ||
+               !hpx::traits::is_forward_iterator<Iter>::value ||
+               !hpx::traits::is_forward_iterator<OutIter>::value
+            > is_seq;
+
+        return detail::copy<OutIter>().call(
+            std::forward<ExPolicy>(policy), is_seq(),
+            v.begin(), v.end(), v.stages(), dest);
+    }
+}}}}
+
+#endif
@@ -0,0 +1,167 @@
+//  Copyright (c) 2007-2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHMS_DETAIL_SCAN_OCT_18_2016_0322PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHMS_DETAIL_SCAN_OCT_18_2016_0322PM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/lcos/dataflow.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/transfer.hpp>
+#include <hpx/parallel/segmented_algorithms/reduce.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented scan
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // sequential remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename SegOutIter, typename T, typename Op>
+        static typename util::detail::algorithm_result<
+            ExPolicy, SegOutIter
+        >::type
+        segmented_scan(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, SegOutIter dest, T && init, Op && op,
+            std::true_type)
+        {
+            typedef typename hpx::util::decay<T>::type value_type;
+            typedef segmented_chunks<SegIter, SegOutIter> chunks_type;
+            typedef typename chunks_type::local_output_iterator_type
+                local_output_iterator_type;
+
+            chunks_type chunks(first, last, dest);
+
+            value_type carry = std::forward<T>(init);
+            local_output_iterator_type out = chunks.chunks_.back().out;
+
+            for (std::size_t i = 0; i != chunks.chunks_.size(); ++i)
+            {
+                typename chunks_type::chunk const& c = chunks.chunks_[i];
+
+                // the reduction of a chunk is needed only for the carry
+                // into the next one, skip it for the last chunk
+                if (i + 1 == chunks.chunks_.size())
+                {
+                    out = chunks_type::run(c, algo, policy, carry, op);
+                    break;
+                }
+
+                value_type sum = dispatch(c.id,
+                    reduce_partition<value_type>(), policy, std::true_type(),
+                    c.beg, c.end, op);
+
+                out = chunks_type::run(c, algo, policy, carry, op);
+
+                carry = op(carry, sum);
+            }
+
+            return util::detail::algorithm_result<ExPolicy, SegOutIter>::get(
+                chunks.compose(out));
+        }
+
+        // parallel remote implementation
+        template <typename Algo, typename ExPolicy, typename SegIter,
+            typename SegOutIter, typename T, typename Op>
+        static typename util::detail::algorithm_result<
+            ExPolicy, SegOutIter
+        >::type
+        segmented_scan(Algo && algo, ExPolicy const& policy,
+            SegIter first, SegIter last, SegOutIter dest, T && init, Op && op,
+            std::false_type)
+        {
+            typedef typename hpx::util::decay<T>::type value_type;
+            typedef typename hpx::util::decay<Algo>::type algo_type;
+            typedef typename hpx::util::decay<Op>::type op_type;
+            typedef segmented_chunks<SegIter, SegOutIter> chunks_type;
+            typedef typename chunks_type::local_output_iterator_type
+                local_output_iterator_type;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            chunks_type chunks(first, last, dest);
+
+            // step 1: reduce all chunks (but the last) concurrently
+            std::vector<shared_future<value_type> > sums;
+            sums.reserve(chunks.chunks_.size());
+
+            for (std::size_t i = 0; i + 1 < chunks.chunks_.size(); ++i)
+            {
+                typename chunks_type::chunk const& c = chunks.chunks_[i];
+                sums.push_back(dispatch_async(c.id,
+                    reduce_partition<value_type>(), policy, forced_seq(),
+                    c.beg, c.end, op));
+            }
+
+            value_type carry = std::forward<T>(init);
+            algo_type scan_algo = std::forward<Algo>(algo);
+            op_type scan_op = std::forward<Op>(op);
+
+            return util::detail::algorithm_result<ExPolicy, SegOutIter>::get(
+                dataflow(
+                    [=](std::vector<shared_future<value_type> > && r)
+                        mutable -> SegOutIter
+                    {
+                        // handle any remote exceptions, will throw on error
+                        std::list<boost::exception_ptr> errors;
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(r, errors);
+
+                        // step 2: compute the carry into each of the
+                        // chunks, step 3: scan all chunks concurrently
+                        std::vector<shared_future<local_output_iterator_type> >
+                            segments;
+                        segments.reserve(chunks.chunks_.size());
+
+                        for (std::size_t i = 0; i != chunks.chunks_.size();
+                             ++i)
+                        {
+                            segments.push_back(chunks_type::run_async(
+                                chunks.chunks_[i], scan_algo, policy,
+                                forced_seq(), carry, scan_op));
+
+                            if (i != r.size())
+                                carry = scan_op(carry, r[i].get());
+                        }
+
+                        hpx::wait_all(segments);
+                        parallel::util::detail::handle_remote_exceptions<
+                            ExPolicy
+                        >::call(segments, errors);
+
+                        return chunks.compose(segments.back().get());
+                    },
+                    std::move(sums)));
+        }
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -9,6 +9,7 @@
 #include <hpx/config.hpp>
 #include <hpx/traits/segmented_iterator_traits.hpp>
 #include <hpx/lcos/local/dataflow.hpp>
+#include <hpx/runtime/naming/name.hpp>
 
 #include <hpx/parallel/config/inline_namespace.hpp>
 #include <hpx/parallel/execution_policy.hpp>
@@ -22,6 +23,7 @@
 #include <algorithm>
 #include <iterator>
 #include <list>
+#include <memory>
 #include <type_traits>
 #include <utility>
 #include <vector>
@@ -54,6 +56,337 @@ namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
                     ::is_segmented_iterator::value>
         {};
 
+        ///////////////////////////////////////////////////////////////////////
+        // Return whether the destination starting at dest is partitioned
+        // identically to the source range [first, last): every piece of the
+        // source range has to have its counterpart at the same position of a
+        // destination segment located on the same locality. Only then the
+        // source and destination segments can be processed in lockstep by
+        // the locality owning them.
+        template <typename SegIter, typename SegOutIter>
+        bool segmented_layouts_match(SegIter first, SegIter last,
+            SegOutIter dest)
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+
+            typedef hpx::traits::segmented_iterator_traits<SegOutIter>
+                output_traits;
+            typedef typename output_traits::segment_iterator
+                segment_output_iterator;
+
+            segment_iterator sit = traits::segment(first);
+            segment_iterator send = traits::segment(last);
+            segment_output_iterator sdest = output_traits::segment(dest);
+
+            if (std::distance(traits::begin(sit), traits::local(first)) !=
+                std::distance(output_traits::begin(sdest),
+                    output_traits::local(dest)))
+            {
+                return false;
+            }
+
+            for (/**/; sit != send; (void) ++sit, ++sdest)
+            {
+                if (naming::get_locality_id_from_id(traits::get_id(sit)) !=
+                        naming::get_locality_id_from_id(
+                            output_traits::get_id(sdest)) ||
+                    std::distance(traits::begin(sit), traits::end(sit)) !=
+                        std::distance(output_traits::begin(sdest),
+                            output_traits::end(sdest)))
+                {
+                    return false;
+                }
+            }
+
+            // the last destination segment has to be large enough only
+            return naming::get_locality_id_from_id(traits::get_id(sit)) ==
+                    naming::get_locality_id_from_id(
+                        output_traits::get_id(sdest)) &&
+                std::distance(traits::begin(sit), traits::local(last)) <=
+                    std::distance(output_traits::begin(sdest),
+                        output_traits::end(sdest));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // Copy the elements of a (local) range into a buffer which can be sent
+        // to the locality owning the corresponding destination segment.
+        template <typename T>
+        struct copy_to_buffer
+          : public detail::algorithm<copy_to_buffer<T>, std::vector<T> >
+        {
+            copy_to_buffer()
+              : copy_to_buffer::algorithm("copy_to_buffer")
+            {}
+
+            template <typename ExPolicy, typename InIter>
+            static std::vector<T>
+            sequential(ExPolicy, InIter first, InIter last)
+            {
+                return std::vector<T>(first, last);
+            }
+
+            template <typename ExPolicy, typename InIter>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, InIter first, InIter last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(std::vector<T>(first, last));
+            }
+        };
+
+        template <typename T, typename OutIter, typename R>
+        OutIter apply_from_buffer_result(
+            std::shared_ptr<std::vector<T> > const&, OutIter dest, R &&)
+        {
+            return dest;
+        }
+
+        template <typename T, typename OutIter, typename R>
+        future<OutIter> apply_from_buffer_result(
+            std::shared_ptr<std::vector<T> > const& buffer, OutIter dest,
+            future<R> && f)
+        {
+            // keep the buffer alive until the algorithm has finished
+            return f.then(
+                [buffer, dest](future<R> && f) -> OutIter
+                {
+                    f.get();            // rethrow exceptions
+                    return dest;
+                });
+        }
+
+        // Run the algorithm Algo on the elements of a buffer received from
+        // the locality owning the source segment, writing to the (local)
+        // destination. Returns the end of the written destination range.
+        template <typename Algo, typename OutIter>
+        struct apply_from_buffer
+          : public detail::algorithm<apply_from_buffer<Algo, OutIter>, OutIter>
+        {
+            apply_from_buffer()
+              : apply_from_buffer::algorithm("apply_from_buffer")
+            {}
+
+            template <typename ExPolicy, typename T, typename LocalOutIter,
+                typename... Args>
+            static LocalOutIter
+            sequential(ExPolicy && policy, std::vector<T> buffer,
+                LocalOutIter dest, Args &&... args)
+            {
+                Algo::sequential(std::forward<ExPolicy>(policy),
+                    buffer.begin(), buffer.end(), dest,
+                    std::forward<Args>(args)...);
+
+                std::advance(dest, buffer.size());
+                return dest;
+            }
+
+            template <typename ExPolicy, typename T, typename LocalOutIter,
+                typename... Args>
+            static typename util::detail::algorithm_result<
+                ExPolicy, LocalOutIter
+            >::type
+            parallel(ExPolicy && policy, std::vector<T> buffer,
+                LocalOutIter dest, Args &&... args)
+            {
+                std::shared_ptr<std::vector<T> > data =
+                    std::make_shared<std::vector<T> >(std::move(buffer));
+
+                LocalOutIter end = dest;
+                std::advance(end, data->size());
+
+                return util::detail::algorithm_result<
+                        ExPolicy, LocalOutIter
+                    >::get(apply_from_buffer_result(data, end,
+                        Algo::parallel(std::forward<ExPolicy>(policy),
+                            data->begin(), data->end(), dest,
+                            std::forward<Args>(args)...)));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        template <typename Iter>
+        Iter chunk_result(Iter it)
+        {
+            return it;
+        }
+
+        template <typename Iter1, typename Iter2>
+        Iter2 chunk_result(std::pair<Iter1, Iter2> const& p)
+        {
+            return p.second;
+        }
+
+        // The pieces the source range [first, last) has to be split into such
+        // that each of them lies within a single source and a single
+        // destination segment. For identically partitioned ranges these are
+        // the pieces of the source segments. Pieces whose source and
+        // destination segments are located on the same locality are processed
+        // in place by that locality, all others copy the source elements in
+        // bulk to the locality owning the destination segment, which then
+        // runs the algorithm on this temporary buffer.
+        template <typename SegIter, typename SegOutIter>
+        struct segmented_chunks
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef hpx::traits::segmented_iterator_traits<SegOutIter>
+                output_traits;
+            typedef typename output_traits::segment_iterator
+                segment_output_iterator;
+            typedef typename output_traits::local_iterator
+                local_output_iterator_type;
+
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            struct chunk
+            {
+                id_type id;                         // source segment
+                local_iterator_type beg;
+                local_iterator_type end;
+                id_type dest_id;                    // destination segment
+                local_output_iterator_type out;
+                bool colocated;
+            };
+
+            segmented_chunks(SegIter first, SegIter last, SegOutIter dest)
+              : sdest_(output_traits::segment(dest))
+            {
+                segment_iterator sit = traits::segment(first);
+                segment_iterator send = traits::segment(last);
+
+                local_iterator_type beg = traits::local(first);
+                local_output_iterator_type out = output_traits::local(dest);
+
+                while (true)
+                {
+                    local_iterator_type end =
+                        (sit == send) ? traits::local(last) : traits::end(sit);
+
+                    while (beg != end)
+                    {
+                        local_output_iterator_type out_end =
+                            output_traits::end(sdest_);
+
+                        if (out == out_end)
+                        {
+                            // the current destination segment is full
+                            ++sdest_;
+                            out = output_traits::begin(sdest_);
+                            continue;
+                        }
+
+                        std::size_t count = (std::min)(
+                            static_cast<std::size_t>(std::distance(beg, end)),
+                            static_cast<std::size_t>(
+                                std::distance(out, out_end)));
+
+                        local_iterator_type chunk_end = beg;
+                        std::advance(chunk_end, count);
+
+                        add(traits::get_id(sit), beg, chunk_end,
+                            output_traits::get_id(sdest_), out);
+
+                        beg = chunk_end;
+                        std::advance(out, count);
+                    }
+
+                    if (sit == send)
+                        break;
+
+                    ++sit;
+                    beg = traits::begin(sit);
+                }
+            }
+
+            void add(id_type const& id, local_iterator_type beg,
+                local_iterator_type end, id_type const& dest_id,
+                local_output_iterator_type out)
+            {
+                chunk c = { id, beg, end, dest_id, out,
+                    naming::get_locality_id_from_id(id) ==
+                        naming::get_locality_id_from_id(dest_id)
+                };
+                chunks_.push_back(c);
+            }
+
+            SegOutIter compose(local_output_iterator_type out) const
+            {
+                return output_traits::compose(sdest_, out);
+            }
+
+            // synchronously run the algorithm on the given chunk, returns the
+            // end of the written destination range
+            template <typename Algo, typename ExPolicy, typename... Args>
+            static local_output_iterator_type
+            run(chunk const& c, Algo const& algo, ExPolicy const& policy,
+                Args const&... args)
+            {
+                if (c.colocated)
+                {
+                    return chunk_result(dispatch(c.id, algo, policy,
+                        std::true_type(), c.beg, c.end, c.out, args...));
+                }
+
+                std::vector<value_type> buffer = dispatch(c.id,
+                    copy_to_buffer<value_type>(), policy, std::true_type(),
+                    c.beg, c.end);
+
+                return dispatch(c.dest_id,
+                    apply_from_buffer<Algo, local_output_iterator_type>(),
+                    policy, std::true_type(), std::move(buffer), c.out,
+                    args...);
+            }
+
+            // asynchronously run the algorithm on the given chunk
+            template <typename Algo, typename ExPolicy, typename IsSeq,
+                typename... Args>
+            static future<local_output_iterator_type>
+            run_async(chunk const& c, Algo const& algo, ExPolicy const& policy,
+                IsSeq is_seq, Args const&... args)
+            {
+                typedef typename hpx::util::decay<Algo>::type::result_type
+                    algo_result_type;
+
+                if (c.colocated)
+                {
+                    return dispatch_async(c.id, algo, policy, is_seq,
+                            c.beg, c.end, c.out, args...
+                        ).then(
+                            [](future<algo_result_type> && f)
+                                -> local_output_iterator_type
+                            {
+                                return chunk_result(f.get());
+                            });
+                }
+
+                id_type dest_id = c.dest_id;
+                local_output_iterator_type out = c.out;
+
+                return dispatch_async(c.id, copy_to_buffer<value_type>(),
+                        policy, is_seq, c.beg, c.end
+                    ).then(
+                        [=](future<std::vector<value_type> > && f)
+                            -> future<local_output_iterator_type>
+                        {
+                            return dispatch_async(dest_id,
+                                apply_from_buffer<
+                                    Algo, local_output_iterator_type
+                                >(),
+                                policy, is_seq, f.get(), out, args...);
+                        });
+            }
+
+            std::vector<chunk> chunks_;
+            segment_output_iterator sdest_;     // segment of the last chunk
+        };
+
         ///////////////////////////////////////////////////////////////////////
         // sequential remote implementation
         template <typename Algo, typename ExPolicy, typename SegIter,
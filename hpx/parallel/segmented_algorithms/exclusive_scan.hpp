@@ -0,0 +1,66 @@
+//  Copyright (c) 2007-2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_EXCLUSIVE_SCAN_OCT_18_2016_0341PM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_EXCLUSIVE_SCAN_OCT_18_2016_0341PM
+
+#include <hpx/config.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/algorithms/exclusive_scan.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/scan.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+
+#include <type_traits>
+#include <utility>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_exclusive_scan
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // segmented implementation
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename T, typename Op>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        exclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, T && init, Op && op, std::true_type)
+        {
+            typedef parallel::is_sequential_execution_policy<ExPolicy> is_seq;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, OutIter
+                    >::get(std::move(dest));
+            }
+
+            typedef typename hpx::traits::segmented_iterator_traits<OutIter>
+                ::local_iterator local_output_iterator_type;
+
+            return segmented_scan(
+                exclusive_scan<local_output_iterator_type>(),
+                std::forward<ExPolicy>(policy), first, last, dest,
+                std::forward<T>(init), std::forward<Op>(op), is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename InIter, typename OutIter,
+            typename T, typename Op>
+        typename util::detail::algorithm_result<ExPolicy, OutIter>::type
+        exclusive_scan_(ExPolicy && policy, InIter first, InIter last,
+            OutIter dest, T && init, Op && op, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,618 @@
+//  Copyright (c) 2007-2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_19_2016_1042AM)
+#define HPX_PARALLEL_SEGMENTED_ALGORITHM_SORT_OCT_19_2016_1042AM
+
+#include <hpx/config.hpp>
+#include <hpx/async.hpp>
+#include <hpx/traits/segmented_iterator_traits.hpp>
+#include <hpx/lcos/future.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/naming/id_type.hpp>
+#include <hpx/util/decay.hpp>
+
+#include <hpx/parallel/config/inline_namespace.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/algorithms/copy.hpp>
+#include <hpx/parallel/algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/algorithms/sort.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/dispatch.hpp>
+#include <hpx/parallel/segmented_algorithms/detail/transfer.hpp>
+#include <hpx/parallel/util/compare_projected.hpp>
+#include <hpx/parallel/util/detail/algorithm_result.hpp>
+#include <hpx/parallel/util/detail/handle_remote_exceptions.hpp>
+
+#include <boost/exception_ptr.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <iterator>
+#include <list>
+#include <type_traits>
+#include <utility>
+#include <vector>
+
+namespace hpx { namespace parallel { HPX_INLINE_NAMESPACE(v1)
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // segmented_sort
+    namespace detail
+    {
+        ///////////////////////////////////////////////////////////////////////
+        /// \cond NOINTERNAL
+
+        // The segmented sort is a sample sort:
+        //
+        //  1. every segment is sorted by the locality owning it, which returns
+        //     a number of regularly spaced samples of its data,
+        //  2. the calling locality sorts the samples and selects the splitters
+        //     dividing the values into one bucket per segment,
+        //  3. every segment sends its data split into these buckets,
+        //  4. the sorted runs making up a bucket are merged by the locality
+        //     owning the segment which receives most of the bucket, it writes
+        //     its part directly and returns the remaining elements,
+        //  5. the remaining elements are written to the neighboring segments.
+        //
+        // All elements have been read (step 3) before any of them are
+        // overwritten. The sizes of the segments are not changed.
+
+        // the number of samples taken per segment and bucket
+        static const std::size_t sort_oversampling = 8;
+
+        // step 1: sort the local data, return count regularly spaced samples
+        template <typename T>
+        struct sort_and_sample
+          : public detail::algorithm<sort_and_sample<T>, std::vector<T> >
+        {
+            sort_and_sample()
+              : sort_and_sample::algorithm("sort_and_sample")
+            {}
+
+            template <typename RandomIt>
+            static std::vector<T>
+            samples(RandomIt first, RandomIt last, std::size_t count)
+            {
+                std::size_t size = std::distance(first, last);
+
+                std::vector<T> result;
+                result.reserve(count);
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    result.push_back(
+                        *(first + (2 * i + 1) * size / (2 * count)));
+                }
+                return result;
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static std::vector<T>
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                std::size_t count, Compare && comp, Proj && proj)
+            {
+                std::sort(first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)));
+
+                return samples(first, last, count);
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                std::size_t count, Compare && comp, Proj && proj)
+            {
+                // the policy is referenced by the sort, wait for it to finish
+                parallel_sort_async(policy, first, last,
+                    util::compare_projected<Compare, Proj>(
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj))
+                    ).get();
+
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(samples(first, last, count));
+            }
+        };
+
+        // step 3: split the sorted local data into the buckets
+        template <typename T>
+        struct sort_split
+          : public detail::algorithm<
+                sort_split<T>, std::vector<std::vector<T> > >
+        {
+            sort_split()
+              : sort_split::algorithm("sort_split")
+            {}
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static std::vector<std::vector<T> >
+            sequential(ExPolicy, RandomIt first, RandomIt last,
+                std::vector<T> const& splitters, Compare && comp,
+                Proj && proj)
+            {
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                std::vector<std::vector<T> > buckets;
+                buckets.reserve(splitters.size() + 1);
+
+                for (std::size_t i = 0; i != splitters.size(); ++i)
+                {
+                    RandomIt it =
+                        std::lower_bound(first, last, splitters[i], pred);
+                    buckets.push_back(std::vector<T>(first, it));
+                    first = it;
+                }
+                buckets.push_back(std::vector<T>(first, last));
+
+                return buckets;
+            }
+
+            template <typename ExPolicy, typename RandomIt, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<std::vector<T> >
+            >::type
+            parallel(ExPolicy && policy, RandomIt first, RandomIt last,
+                std::vector<T> const& splitters, Compare && comp,
+                Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<std::vector<T> >
+                    >::get(sequential(policy, first, last, splitters,
+                        std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)));
+            }
+        };
+
+        // step 4: merge the sorted runs of a bucket, write the elements
+        // [skip, skip + count) of the result to dest, return all others
+        template <typename T>
+        struct sort_merge
+          : public detail::algorithm<sort_merge<T>, std::vector<T> >
+        {
+            sort_merge()
+              : sort_merge::algorithm("sort_merge")
+            {}
+
+            template <typename ExPolicy, typename OutIter, typename Compare,
+                typename Proj>
+            static std::vector<T>
+            sequential(ExPolicy, std::vector<std::vector<T> > runs,
+                OutIter dest, std::size_t skip, std::size_t count,
+                Compare && comp, Proj && proj)
+            {
+                util::compare_projected<Compare, Proj> pred(
+                    std::forward<Compare>(comp), std::forward<Proj>(proj));
+
+                // merge pairs of runs until a single one is left
+                while (runs.size() > 1)
+                {
+                    std::vector<std::vector<T> > merged;
+                    merged.reserve((runs.size() + 1) / 2);
+
+                    for (std::size_t i = 0; i + 1 < runs.size(); i += 2)
+                    {
+                        std::vector<T> run;
+                        run.reserve(runs[i].size() + runs[i + 1].size());
+
+                        std::merge(runs[i].begin(), runs[i].end(),
+                            runs[i + 1].begin(), runs[i + 1].end(),
+                            std::back_inserter(run), pred);
+
+                        merged.push_back(std::move(run));
+                    }
+                    if (runs.size() % 2 != 0)
+                        merged.push_back(std::move(runs.back()));
+
+                    std::swap(runs, merged);
+                }
+
+                std::vector<T>& result = runs.front();
+                typename std::vector<T>::iterator it = result.begin() + skip;
+
+                std::copy(it, it + count, dest);
+                result.erase(it, it + count);
+
+                return std::move(result);
+            }
+
+            template <typename ExPolicy, typename OutIter, typename Compare,
+                typename Proj>
+            static typename util::detail::algorithm_result<
+                ExPolicy, std::vector<T>
+            >::type
+            parallel(ExPolicy && policy, std::vector<std::vector<T> > runs,
+                OutIter dest, std::size_t skip, std::size_t count,
+                Compare && comp, Proj && proj)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, std::vector<T>
+                    >::get(sequential(policy, std::move(runs), dest, skip,
+                        count, std::forward<Compare>(comp),
+                        std::forward<Proj>(proj)));
+            }
+        };
+
+        ///////////////////////////////////////////////////////////////////////
+        // The (non-empty) pieces of the range, one per touched segment
+        template <typename SegIter>
+        struct segmented_sort_pieces
+        {
+            typedef hpx::traits::segmented_iterator_traits<SegIter> traits;
+            typedef typename traits::segment_iterator segment_iterator;
+            typedef typename traits::local_iterator local_iterator_type;
+
+            typedef typename std::iterator_traits<SegIter>::value_type
+                value_type;
+
+            struct piece
+            {
+                id_type id;
+                local_iterator_type beg;
+                local_iterator_type end;
+                std::size_t offset;             // offset from first
+                std::size_t size;
+            };
+
+            segmented_sort_pieces(SegIter first, SegIter last)
+              : size_(0)
+            {
+                segment_iterator sit = traits::segment(first);
+                segment_iterator send = traits::segment(last);
+
+                if (sit == send)
+                {
+                    // all elements are on the same partition
+                    add(sit, traits::local(first), traits::local(last));
+                }
+                else {
+                    // handle the remaining part of the first partition
+                    add(sit, traits::local(first), traits::end(sit));
+
+                    // handle all of the full partitions
+                    for (++sit; sit != send; ++sit)
+                        add(sit, traits::begin(sit), traits::end(sit));
+
+                    // handle the beginning of the last partition
+                    add(sit, traits::begin(sit), traits::local(last));
+                }
+            }
+
+            void add(segment_iterator sit, local_iterator_type beg,
+                local_iterator_type end)
+            {
+                std::size_t size = std::distance(beg, end);
+                if (size != 0)
+                {
+                    piece p = { traits::get_id(sit), beg, end, size_, size };
+                    pieces_.push_back(p);
+                    size_ += size;
+                }
+            }
+
+            // the piece overlapping most with [offset, offset + size)
+            std::size_t home(std::size_t offset, std::size_t size) const
+            {
+                std::size_t result = 0;
+                std::size_t max_overlap = 0;
+
+                for (std::size_t i = 0; i != pieces_.size(); ++i)
+                {
+                    std::size_t overlap = overlap_size(i, offset, size);
+                    if (overlap > max_overlap)
+                    {
+                        result = i;
+                        max_overlap = overlap;
+                    }
+                }
+                return result;
+            }
+
+            std::size_t overlap_begin(std::size_t i, std::size_t offset) const
+            {
+                return (std::max)(offset, pieces_[i].offset);
+            }
+
+            std::size_t overlap_end(std::size_t i, std::size_t offset,
+                std::size_t size) const
+            {
+                return (std::min)(offset + size,
+                    pieces_[i].offset + pieces_[i].size);
+            }
+
+            std::size_t overlap_size(std::size_t i, std::size_t offset,
+                std::size_t size) const
+            {
+                std::size_t beg = overlap_begin(i, offset);
+                std::size_t end = overlap_end(i, offset, size);
+                return beg < end ? end - beg : 0;
+            }
+
+            local_iterator_type at(std::size_t i, std::size_t offset) const
+            {
+                local_iterator_type it = pieces_[i].beg;
+                std::advance(it, offset - pieces_[i].offset);
+                return it;
+            }
+
+            // write the elements [data, data + size) to the positions
+            // [offset, offset + size)
+            template <typename ExPolicy, typename IsSeq, typename Iter>
+            void write(ExPolicy const& policy, IsSeq is_seq, Iter data,
+                std::size_t offset, std::size_t size,
+                std::vector<future<local_iterator_type> >& writes) const
+            {
+                typedef copy<
+                        std::pair<local_iterator_type, local_iterator_type>
+                    > copy_algo;
+
+                for (std::size_t i = 0; i != pieces_.size(); ++i)
+                {
+                    if (overlap_size(i, offset, size) == 0)
+                        continue;
+
+                    std::size_t beg = overlap_begin(i, offset);
+                    std::size_t end = overlap_end(i, offset, size);
+
+                    writes.push_back(dispatch_async(pieces_[i].id,
+                        apply_from_buffer<copy_algo, local_iterator_type>(),
+                        policy, is_seq,
+                        std::vector<value_type>(data + (beg - offset),
+                            data + (end - offset)),
+                        at(i, beg)));
+                }
+            }
+
+            std::vector<piece> pieces_;
+            std::size_t size_;
+        };
+
+        template <typename ExPolicy, typename FwdIter>
+        void segmented_sort_wait(std::vector<future<FwdIter> > const& f)
+        {
+            hpx::wait_all(f);
+
+            // handle any remote exceptions, will throw on error
+            std::list<boost::exception_ptr> errors;
+            parallel::util::detail::handle_remote_exceptions<
+                ExPolicy
+            >::call(f, errors);
+        }
+
+        template <typename ExPolicy, typename IsSeq, typename SegIter,
+            typename Compare, typename Proj>
+        SegIter segmented_sort_impl(ExPolicy const& policy, IsSeq is_seq,
+            SegIter first, SegIter last, Compare const& comp,
+            Proj const& proj)
+        {
+            typedef segmented_sort_pieces<SegIter> pieces_type;
+            typedef typename pieces_type::piece piece;
+            typedef typename pieces_type::local_iterator_type
+                local_iterator_type;
+            typedef typename pieces_type::value_type value_type;
+
+            typedef std::vector<value_type> run_type;
+
+            pieces_type pieces(first, last);
+            std::size_t const num_pieces = pieces.pieces_.size();
+
+            if (num_pieces == 0)
+                return last;
+
+            if (num_pieces == 1)
+            {
+                // all elements are on the same partition
+                piece const& p = pieces.pieces_.front();
+                dispatch(p.id, sort_and_sample<value_type>(), policy,
+                    is_seq, p.beg, p.end, std::size_t(0), comp, proj);
+                return last;
+            }
+
+            // step 1: sort all segments concurrently, the number of samples
+            // is proportional to the size of the segment
+            std::vector<future<run_type> > samples;
+            samples.reserve(num_pieces);
+
+            for (std::size_t i = 0; i != num_pieces; ++i)
+            {
+                piece const& p = pieces.pieces_[i];
+                std::size_t count = (std::min)(p.size,
+                    (sort_oversampling * num_pieces * p.size +
+                        pieces.size_ - 1) / pieces.size_);
+
+                samples.push_back(dispatch_async(p.id,
+                    sort_and_sample<value_type>(), policy, is_seq,
+                    p.beg, p.end, count, comp, proj));
+            }
+            segmented_sort_wait<ExPolicy>(samples);
+
+            // step 2: select the splitters
+            util::compare_projected<Compare, Proj> pred(comp, proj);
+
+            run_type all_samples;
+            for (std::size_t i = 0; i != num_pieces; ++i)
+            {
+                run_type s = samples[i].get();
+                all_samples.insert(all_samples.end(), s.begin(), s.end());
+            }
+            std::sort(all_samples.begin(), all_samples.end(), pred);
+
+            run_type splitters;
+            splitters.reserve(num_pieces - 1);
+            for (std::size_t i = 1; i != num_pieces; ++i)
+            {
+                splitters.push_back(
+                    all_samples[i * all_samples.size() / num_pieces]);
+            }
+
+            // step 3: split all segments into the buckets
+            std::vector<future<std::vector<run_type> > > splits;
+            splits.reserve(num_pieces);
+
+            for (std::size_t i = 0; i != num_pieces; ++i)
+            {
+                piece const& p = pieces.pieces_[i];
+                splits.push_back(dispatch_async(p.id,
+                    sort_split<value_type>(), policy, is_seq,
+                    p.beg, p.end, splitters, comp, proj));
+            }
+            segmented_sort_wait<ExPolicy>(splits);
+
+            // runs[j][i] is the part of bucket j received from segment i
+            std::vector<std::vector<run_type> > runs(num_pieces);
+            for (std::size_t i = 0; i != num_pieces; ++i)
+            {
+                std::vector<run_type> buckets = splits[i].get();
+                for (std::size_t j = 0; j != num_pieces; ++j)
+                    runs[j].push_back(std::move(buckets[j]));
+            }
+
+            // step 4: merge all buckets concurrently
+            std::vector<std::size_t> offsets(num_pieces);
+            std::vector<std::size_t> sizes(num_pieces);
+            std::vector<std::size_t> skips(num_pieces);
+            std::vector<std::size_t> counts(num_pieces);
+            std::vector<future<run_type> > merged;
+            merged.reserve(num_pieces);
+
+            std::size_t offset = 0;
+            for (std::size_t j = 0; j != num_pieces; ++j)
+            {
+                std::size_t size = 0;
+                for (std::size_t i = 0; i != num_pieces; ++i)
+                    size += runs[j][i].size();
+
+                offsets[j] = offset;
+                sizes[j] = size;
+                offset += size;
+
+                if (size == 0)
+                {
+                    skips[j] = counts[j] = 0;
+                    merged.push_back(hpx::make_ready_future(run_type()));
+                    continue;
+                }
+
+                std::size_t h = pieces.home(offsets[j], size);
+                std::size_t beg = pieces.overlap_begin(h, offsets[j]);
+                std::size_t end = pieces.overlap_end(h, offsets[j], size);
+
+                skips[j] = beg - offsets[j];
+                counts[j] = end - beg;
+
+                merged.push_back(dispatch_async(pieces.pieces_[h].id,
+                    sort_merge<value_type>(), policy, is_seq,
+                    std::move(runs[j]), pieces.at(h, beg), skips[j],
+                    counts[j], comp, proj));
+            }
+            segmented_sort_wait<ExPolicy>(merged);
+
+            // step 5: write the parts of the buckets not written by step 4
+            std::vector<future<local_iterator_type> > writes;
+            for (std::size_t j = 0; j != num_pieces; ++j)
+            {
+                run_type rest = merged[j].get();
+                if (rest.empty())
+                    continue;
+
+                // rest holds the elements before and after the part written
+                // by the merge
+                pieces.write(policy, is_seq, rest.begin(),
+                    offsets[j], skips[j], writes);
+                pieces.write(policy, is_seq, rest.begin() + skips[j],
+                    offsets[j] + skips[j] + counts[j],
+                    sizes[j] - skips[j] - counts[j], writes);
+            }
+            segmented_sort_wait<ExPolicy>(writes);
+
+            return last;
+        }
+
+        // sequential remote implementation
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, SegIter
+        >::type
+        segmented_sort(ExPolicy const& policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                segmented_sort_impl(policy, std::true_type(), first, last,
+                    comp, proj));
+        }
+
+        // parallel remote implementation
+        template <typename ExPolicy, typename SegIter, typename Compare,
+            typename Proj>
+        static typename util::detail::algorithm_result<
+            ExPolicy, SegIter
+        >::type
+        segmented_sort(ExPolicy const& policy, SegIter first, SegIter last,
+            Compare && comp, Proj && proj, std::false_type)
+        {
+            typedef typename hpx::util::decay<ExPolicy>::type policy_type;
+            typedef typename hpx::util::decay<Compare>::type compare_type;
+            typedef typename hpx::util::decay<Proj>::type proj_type;
+
+            typedef std::integral_constant<bool,
+                    !hpx::traits::is_forward_iterator<SegIter>::value
+                > forced_seq;
+
+            policy_type sort_policy = policy;
+            compare_type sort_comp = std::forward<Compare>(comp);
+            proj_type sort_proj = std::forward<Proj>(proj);
+
+            return util::detail::algorithm_result<ExPolicy, SegIter>::get(
+                hpx::async(
+                    [=]() -> SegIter
+                    {
+                        return segmented_sort_impl(sort_policy, forced_seq(),
+                            first, last, sort_comp, sort_proj);
+                    }));
+        }
+
+        ///////////////////////////////////////////////////////////////////////
+        // segmented implementation
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::true_type)
+        {
+            typedef parallel::is_sequential_execution_policy<ExPolicy> is_seq;
+
+            if (first == last)
+            {
+                return util::detail::algorithm_result<
+                        ExPolicy, RandomIt
+                    >::get(std::move(last));
+            }
+
+            return segmented_sort(std::forward<ExPolicy>(policy), first, last,
+                std::forward<Compare>(comp), std::forward<Proj>(proj),
+                is_seq());
+        }
+
+        // forward declare the non-segmented version of this algorithm
+        template <typename ExPolicy, typename RandomIt, typename Compare,
+            typename Proj>
+        typename util::detail::algorithm_result<ExPolicy, RandomIt>::type
+        sort_(ExPolicy && policy, RandomIt first, RandomIt last,
+            Compare && comp, Proj && proj, std::false_type);
+
+        /// \endcond
+    }
+}}}
+
+#endif
@@ -0,0 +1,136 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+/// \file parallel/util/numa_first_touch_allocator.hpp
+
+#ifndef HPX_PARALLEL_UTIL_NUMA_FIRST_TOUCH_ALLOCATOR_OCT_18_2016_0452PM
+#define HPX_PARALLEL_UTIL_NUMA_FIRST_TOUCH_ALLOCATOR_OCT_18_2016_0452PM
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/threads/policies/topology.hpp>
+#include <hpx/parallel/execution_policy.hpp>
+#include <hpx/parallel/algorithms/for_each.hpp>
+#include <hpx/parallel/executors/numa_executor.hpp>
+#include <hpx/parallel/executors/static_chunk_size.hpp>
+
+#include <cstddef>
+#include <limits>
+#include <memory>
+#include <new>
+
+namespace hpx { namespace parallel { namespace util
+{
+    ///////////////////////////////////////////////////////////////////////////
+    /// An allocator which places the allocated memory onto the NUMA domains
+    /// of the given \a numa_executor using a first-touch policy: the memory
+    /// is touched by a parallel \a for_each executed on the executor using
+    /// \a static_chunk_size. Any subsequent parallel algorithm using the same
+    /// executor (and its default executor parameters) on a range of the same
+    /// size processes each element on the NUMA domain which holds it.
+    ///
+    template <typename T>
+    class numa_first_touch_allocator
+    {
+    public:
+        // typedefs
+        typedef T value_type;
+        typedef value_type* pointer;
+        typedef value_type const* const_pointer;
+        typedef value_type& reference;
+        typedef value_type const& const_reference;
+        typedef std::size_t size_type;
+        typedef std::ptrdiff_t difference_type;
+
+    public:
+        // convert an allocator<T> to allocator<U>
+        template <typename U>
+        struct rebind
+        {
+            typedef numa_first_touch_allocator<U> other;
+        };
+
+    public:
+        explicit numa_first_touch_allocator(
+                parallel::numa_executor const& exec = parallel::numa_executor())
+          : exec_(exec)
+        {}
+
+        template <typename U>
+        numa_first_touch_allocator(numa_first_touch_allocator<U> const& rhs)
+          : exec_(rhs.exec_)
+        {}
+
+        /// Return the executor which is used to place the allocated memory
+        parallel::numa_executor const& executor() const
+        {
+            return exec_;
+        }
+
+        // address
+        pointer address(reference r) { return &r; }
+        const_pointer address(const_reference r) { return &r; }
+
+        // memory allocation
+        pointer allocate(size_type cnt,
+            typename std::allocator<void>::const_pointer = 0)
+        {
+            if (cnt > max_size())
+                throw std::bad_alloc();
+
+            pointer p = reinterpret_cast<pointer>(
+                threads::create_topology().allocate(cnt * sizeof(T)));
+
+            // first touch policy, touch the memory using the same mapping
+            // of chunks to domains as any later parallel algorithm
+            parallel::for_each(
+                parallel::par.on(exec_).with(parallel::static_chunk_size()),
+                p, p + cnt,
+                [](T& val)
+                {
+                    // touch first byte of every object
+                    *reinterpret_cast<char*>(&val) = 0;
+                });
+
+            return p;
+        }
+
+        void deallocate(pointer p, size_type cnt)
+        {
+            threads::create_topology().deallocate(p, cnt * sizeof(T));
+        }
+
+        // size
+        size_type max_size() const
+        {
+            return (std::numeric_limits<size_type>::max)() / sizeof(T);
+        }
+
+        // construction/destruction
+        void construct(pointer p, const T& t) { new(p) T(t); }
+        void destroy(pointer p) { p->~T(); }
+
+        // memory allocated through any instance can be deallocated through
+        // any other instance
+        friend bool operator==(numa_first_touch_allocator const&,
+            numa_first_touch_allocator const&)
+        {
+            return true;
+        }
+
+        friend bool operator!=(numa_first_touch_allocator const& l,
+            numa_first_touch_allocator const& r)
+        {
+            return !(l == r);
+        }
+
+    private:
+        template <typename>
+        friend class numa_first_touch_allocator;
+
+        parallel::numa_executor exec_;
+    };
+}}}
+
+#endif
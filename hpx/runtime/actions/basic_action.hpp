@@ -543,6 +543,7 @@ namespace hpx { namespace actions
     {
         register_worker_action_id = 0,
         notify_worker_action_id,
+        notify_workers_action_id,
         allocate_action_id,
         base_connect_action_id,
         base_disconnect_action_id,
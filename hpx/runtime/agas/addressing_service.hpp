@@ -15,7 +15,9 @@
 #include <hpx/exception_fwd.hpp>
 #include <hpx/state.hpp>
 #include <hpx/lcos/local/mutex.hpp>
+#include <hpx/lcos/local/promise.hpp>
 #include <hpx/runtime/agas/detail/agas_service_client.hpp>
+#include <hpx/runtime/agas/detail/sharded_gva_cache.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/components/pinned_ptr.hpp>
 #include <hpx/runtime/naming/address.hpp>
@@ -75,6 +77,12 @@ public:
     typedef std::set<naming::gid_type> migrated_objects_table_type;
     typedef std::map<naming::gid_type, boost::int64_t> refcnt_requests_type;
 
+    // Entries for single GIDs are kept in a sharded cache which can be read
+    // without acquiring a lock, only entries for ranges of GIDs are kept in
+    // gva_cache_.
+    detail::sharded_gva_cache gid_cache_;
+    boost::atomic<bool> has_range_entries_;
+
     mutable mutex_type gva_cache_mtx_;
     std::shared_ptr<gva_cache_type> gva_cache_;
 
@@ -85,18 +93,89 @@ public:
     boost::uint32_t console_cache_;
 
     std::size_t const max_refcnt_requests_;
+    std::uint64_t const refcnt_flush_interval_;     // [ms]
 
     mutex_type refcnt_requests_mtx_;
     std::size_t refcnt_requests_count_;
     bool enable_refcnt_caching_;
+    bool refcnt_flush_pending_;
 
     std::shared_ptr<refcnt_requests_type> refcnt_requests_;
 
+    // Increment requests are aggregated per AGAS service instance: while a
+    // request is in flight to an instance, new requests for this instance
+    // are queued and are sent as one message as soon as the response has
+    // been received.
+    struct incref_batch;
+    typedef std::map<naming::gid_type, std::shared_ptr<incref_batch> >
+        incref_batches_type;
+
+    mutex_type incref_batches_mtx_;
+    incref_batches_type incref_batches_;
+
+    // statistics of the credit traffic
+    boost::atomic<boost::int64_t> incref_requests_;
+    boost::atomic<boost::int64_t> incref_messages_;
+    boost::atomic<boost::int64_t> decref_requests_;
+    boost::atomic<boost::int64_t> decref_messages_;
+
+    // Names resolved by this locality are replicated locally if symbol
+    // caching is enabled. Each entry holds the (possibly still pending)
+    // result of the remote resolution, which is shared by all concurrent
+    // lookups of the name. The symbol namespace notifies this locality
+    // whenever a replicated name is unbound, which removes the entry.
+    typedef hpx::shared_future<naming::id_type> symbol_cache_entry;
+    typedef std::map<std::string, std::shared_ptr<symbol_cache_entry> >
+        symbol_cache_type;
+
+    mutable mutex_type symbol_cache_mtx_;
+    symbol_cache_type symbol_cache_;
+
+    // names for which a notification about their unbinding is pending, at
+    // most one is requested for each name
+    std::set<std::string> symbol_listeners_;
+
+    boost::atomic<boost::int64_t> symbol_cache_hits_;
+    boost::atomic<boost::int64_t> symbol_cache_misses_;
+
+    // GIDs of non-migratable objects may directly encode an index into this
+    // table of objects and the generation of the entry (if address encoding
+    // is enabled). Releasing an entry increments its generation, which
+    // invalidates all GIDs referring to the released object. The table grows
+    // in chunks which are freed only when this instance is destroyed, which
+    // allows to decode the GIDs without acquiring any lock.
+    struct encoded_object
+    {
+        encoded_object()
+          : generation_(0), type_(components::component_invalid), lva_(0)
+        {}
+
+        boost::atomic<boost::uint32_t> generation_;
+        boost::atomic<components::component_type> type_;
+        boost::atomic<boost::uint64_t> lva_;
+    };
+
+    enum { encoded_chunk_size = 4096 };
+    enum {
+        encoded_chunks_count =
+            (HPX_AGAS_MAX_ENCODED_ADDRESSES + encoded_chunk_size - 1) /
+                encoded_chunk_size
+    };
+
+    encoded_object* get_encoded_object(boost::uint32_t index) const;
+
+    mutex_type encoded_objects_mtx_;
+    boost::uint32_t encoded_objects_count_;   // protected by encoded_objects_mtx_
+    std::vector<boost::uint32_t> free_encoded_objects_;
+    boost::atomic<encoded_object*> encoded_chunks_[encoded_chunks_count];
+
     service_mode const service_type;
     runtime_mode const runtime_type;
 
     bool const caching_;
     bool const range_caching_;
+    bool const symbol_caching_;
+    bool const address_encoding_;
     threads::thread_priority const action_priority_;
 
     boost::uint64_t rts_lva_;
@@ -128,6 +207,9 @@ public:
     {
         // TODO: Free the future pools?
         destroy_big_boot_barrier();
+
+        for (boost::atomic<encoded_object*>& chunk : encoded_chunks_)
+            delete [] chunk.load();
     }
 
     void initialize(parcelset::parcelhandler& ph, boost::uint64_t rts_lva,
@@ -237,6 +319,32 @@ protected:
       , gva const& g
         );
 
+    // requests of a bulk operation, grouped by their destination
+    struct bulk_requests
+    {
+        std::vector<request> requests_;
+        std::vector<std::size_t> indices_;  // position of each request
+    };
+    typedef std::map<naming::gid_type, bulk_requests> bulk_requests_type;
+
+    std::vector<future<std::vector<response> > > send_bulk_requests(
+        bulk_requests_type& batches
+      , std::vector<std::vector<std::size_t> >& indices
+        );
+
+    std::vector<bool> bulk_bind_postproc(
+        future<std::vector<future<std::vector<response> > > > f
+      , std::vector<naming::gid_type> const& ids
+      , std::vector<gva> const& gvas
+      , std::vector<std::vector<std::size_t> > const& indices
+        );
+    std::vector<naming::address> bulk_resolve_postproc(
+        future<std::vector<future<std::vector<response> > > > f
+      , std::vector<naming::gid_type> const& ids
+      , std::vector<naming::address> addrs
+      , std::vector<std::vector<std::size_t> > const& indices
+        );
+
     /// Maintain list of migrated objects
     bool was_object_migrated_locked(
         naming::gid_type const& id
@@ -267,6 +375,80 @@ private:
       , error_code& ec
         );
 
+    /// Send the buffered decrement requests after the flush interval has
+    /// expired.
+    void flush_refcnt_requests();
+
+    /// Send the given increment request to the given AGAS service instance
+    /// or queue it if another request to this instance is in flight.
+    lcos::future<boost::int64_t> send_incref_request(
+        request && req
+      , naming::gid_type const& service
+        );
+
+    /// Send all increment requests queued for the given AGAS service
+    /// instance.
+    void send_incref_requests(
+        naming::gid_type const& service
+        );
+
+    boost::int64_t incref_request_sent(
+        hpx::future<boost::int64_t> f
+      , naming::gid_type const& service
+        );
+
+    void incref_requests_sent(
+        hpx::future<std::vector<response> > f
+      , naming::gid_type const& service
+      , std::shared_ptr<std::vector<lcos::local::promise<boost::int64_t> > >
+            promises
+        );
+
+    /// Resolve the given name remotely and subscribe to its unbinding, the
+    /// result is replicated in the symbol cache.
+    lcos::future<naming::id_type> resolve_name_cached_async(
+        std::string const& name
+        );
+
+    void symbol_resolved(
+        hpx::future<std::vector<response> > f
+      , std::string const& name
+      , std::shared_ptr<symbol_cache_entry> const& entry
+      , std::shared_ptr<lcos::local::promise<naming::id_type> > const& p
+      , bool subscribed
+        );
+
+    void symbol_unbound(
+        hpx::future<naming::id_type> f
+      , std::string const& name
+        );
+
+    /// Remove the given entry from the symbol cache (if it is still there).
+    void erase_symbol_cache_entry(
+        std::string const& name
+      , std::shared_ptr<symbol_cache_entry> const& entry
+        );
+
+    /// Forget about the pending notification for the given name, a new one
+    /// is requested when the name is resolved the next time.
+    void erase_symbol_listener(
+        std::string const& name
+        );
+
+    // Helper functions to access the timings of the startup phases
+    boost::int64_t get_bootstrap_registration_time(bool reset);
+    boost::int64_t get_bootstrap_notification_time(bool reset);
+
+    // Helper functions to access the statistics of the symbol cache
+    boost::int64_t get_symbol_cache_hits(bool reset);
+    boost::int64_t get_symbol_cache_misses(bool reset);
+
+    // Helper functions to access the statistics of the credit traffic
+    boost::int64_t get_incref_requests(bool reset);
+    boost::int64_t get_incref_messages(bool reset);
+    boost::int64_t get_decref_requests(bool reset);
+    boost::int64_t get_decref_messages(bool reset);
+
     // Helper functions to access the current cache statistics
     boost::uint64_t get_cache_entries(bool);
     boost::uint64_t get_cache_hits(bool);
@@ -690,6 +872,29 @@ public:
             naming::get_gid_from_locality_id(locality_id));
     }
 
+    /// \brief Bind a number of global ids to the given local addresses
+    ///
+    /// The binding requests are grouped by the primary namespace instance
+    /// responsible for the global ids, one (bulk) request is sent to each
+    /// of those instances.
+    ///
+    /// \param ids        [in] The global ids to bind.
+    /// \param addrs      [in] The local addresses to bind to the global id
+    ///                   with the same index in \a ids.
+    ///
+    /// \returns          A future holding for each of the global ids
+    ///                   whether it was successfully bound. If one of the
+    ///                   requests sent to a primary namespace instance
+    ///                   fails, the ids of this and the following requests
+    ///                   are reported as not bound, and the bindings newly
+    ///                   created by the preceding requests are removed
+    ///                   again. Preceding requests updating an existing
+    ///                   binding are reported as bound.
+    hpx::future<std::vector<bool> > bind_async(
+        std::vector<naming::gid_type> const& ids
+      , std::vector<naming::address> const& addrs
+        );
+
     /// \brief Unbind a global address
     ///
     /// Remove the association of the given global address with any local
@@ -919,6 +1124,38 @@ public:
         boost::uint64_t msb
         );
 
+    /// \brief Create a GID which encodes the given local address.
+    ///
+    /// The returned GID can be resolved on this locality without acquiring
+    /// any lock and is never bound in AGAS. It must be used for
+    /// non-migratable objects only and has to be released using
+    /// \a release_encoded_address once the object is destroyed.
+    ///
+    /// \returns naming::invalid_gid if address encoding is disabled or if
+    ///          the maximum number of encoded addresses has been reached.
+    naming::gid_type encode_address(
+        naming::address const& addr
+        );
+
+    /// \brief Resolve a GID which has been created by \a encode_address on
+    ///        this locality.
+    ///
+    /// \returns false if the GID does not encode the address of an object
+    ///          located on this locality or if the GID has been released.
+    bool resolve_encoded_address(
+        naming::gid_type const& id
+      , naming::address& addr
+        ) const;
+
+    /// \brief Release a GID which has been created by \a encode_address on
+    ///        this locality. The GID can't be resolved anymore afterwards.
+    ///
+    /// \returns false if the GID does not encode the address of an object
+    ///          located on this locality or if it has been released already.
+    bool release_encoded_address(
+        naming::gid_type const& id
+        );
+
     // same, but bulk operation
 //     bool is_local_address(
 //         naming::gid_type const* gids
@@ -1017,6 +1254,18 @@ public:
         return resolve_async(id.get_gid());
     }
 
+    /// \brief Resolve a number of global ids
+    ///
+    /// Global ids which can't be resolved from the local cache are grouped
+    /// by the primary namespace instance responsible for them, one (bulk)
+    /// request is sent to each of those instances.
+    ///
+    /// \returns          A future holding the addresses of the given global
+    ///                   ids (in the same order).
+    hpx::future<std::vector<naming::address> > resolve_async(
+        std::vector<naming::gid_type> const& ids
+        );
+
     ///////////////////////////////////////////////////////////////////////////
     hpx::future<naming::id_type> get_colocation_id_async(
         naming::id_type const& id
@@ -25,11 +25,13 @@
 #include <boost/thread/condition_variable.hpp>
 
 #include <string>
+#include <vector>
 
 #include <hpx/config/warnings_prefix.hpp>
 
 namespace hpx { namespace agas
 {
+struct notification_entry;
 
 struct HPX_EXPORT big_boot_barrier
 {
@@ -49,6 +51,14 @@ struct HPX_EXPORT big_boot_barrier
 
     boost::lockfree::queue<util::unique_function_nonser<void()>* > thunks;
 
+    // The notifications for the localities which have registered during
+    // startup, these are sent once the runtime is up (see trigger()).
+    std::vector<notification_entry> notifications;
+
+    // timings of the startup phases [ns]
+    boost::uint64_t registration_time;
+    boost::uint64_t notification_time;
+
     void spin();
 
     void notify();
@@ -80,12 +90,7 @@ struct HPX_EXPORT big_boot_barrier
       , util::runtime_configuration const& ini_
         );
 
-    ~big_boot_barrier()
-    {
-        util::unique_function_nonser<void()>* f;
-        while (thunks.pop(f))
-            delete f;
-    }
+    ~big_boot_barrier();
 
     parcelset::locality here() { return bootstrap_agas; }
     parcelset::endpoints_type const &get_endpoints() { return endpoints; }
@@ -131,6 +136,37 @@ struct HPX_EXPORT big_boot_barrier
     // no-op on non-bootstrap localities
     void trigger();
 
+    // Queue the notification for a locality which has registered during
+    // startup. Assumes that mtx is locked.
+    void add_notification(notification_entry && entry);
+
+    // Send the given notifications along a tree: the entries are split into
+    // at most HPX_AGAS_BOOTSTRAP_FANOUT consecutive chunks, each chunk is
+    // sent to the locality of its first entry which forwards the remaining
+    // entries of the chunk in the same way.
+    void send_notifications(
+        boost::uint32_t source_locality_id
+      , std::vector<notification_entry> && entries
+        );
+
+    // Mark the end of the notification phase on this locality
+    void notification_done(boost::uint64_t started_at);
+
+    // The time it took to register this locality with the bootstrap
+    // locality (or, on the bootstrap locality, the time it took for all
+    // localities to register) [ns].
+    boost::uint64_t get_registration_time() const
+    {
+        return registration_time;
+    }
+
+    // The time spent in sending or forwarding the notifications to the
+    // registered localities [ns].
+    boost::uint64_t get_notification_time() const
+    {
+        return notification_time;
+    }
+
     void add_thunk(util::unique_function_nonser<void()>* f)
     {
         std::size_t k = 0;
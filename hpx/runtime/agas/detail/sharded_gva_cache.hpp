@@ -0,0 +1,129 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_AGAS_DETAIL_SHARDED_GVA_CACHE_OCT_19_2016_0800PM)
+#define HPX_AGAS_DETAIL_SHARDED_GVA_CACHE_OCT_19_2016_0800PM
+
+#include <hpx/config.hpp>
+#include <hpx/lcos/local/spinlock.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <vector>
+
+namespace hpx { namespace agas { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // A concurrent cache mapping single GIDs to their gva.
+    //
+    // The entries are distributed over a number of shards based on a hash
+    // of the GID. Each shard owns a fixed number of slots, an entry may be
+    // stored in any slot of a small window determined by its hash (the
+    // cache is set-associative). Lookups do not acquire any lock: every
+    // slot is protected by a sequence counter which is odd while the slot
+    // is being written, readers retry (or report a miss) if the counter has
+    // changed while they were reading the slot. Writers serialize on the
+    // lock of the shard.
+    //
+    // If a window is full, the entry to replace is selected using the CLOCK
+    // algorithm (an approximation of LRU): every lookup marks the entry as
+    // referenced, the clock hand of the shard skips (and clears) referenced
+    // entries.
+    //
+    // Resizing the cache drops all entries. The slot tables replaced by a
+    // resize are kept alive until the cache is destroyed as concurrent
+    // lookups may still access them, the cache should therefore be sized
+    // once at construction.
+    class HPX_EXPORT sharded_gva_cache
+    {
+        HPX_NON_COPYABLE(sharded_gva_cache);
+
+    public:
+        typedef naming::gid_type key_type;
+        typedef gva entry_type;
+
+        explicit sharded_gva_cache(std::size_t capacity = 0);
+        ~sharded_gva_cache();
+
+        // Change the number of entries the cache can hold. This drops all
+        // entries, it does nothing if the number of slots does not change.
+        void reserve(std::size_t capacity);
+
+        std::size_t capacity() const;
+        std::size_t size() const;
+
+        // Retrieve the entry for the given GID. A failed lookup is not
+        // counted as a miss if count_miss is false, which allows to consult
+        // another cache before deciding (see count_miss()).
+        bool get_entry(key_type const& gid, entry_type& g,
+            bool count_miss = true);
+
+        // Insert an entry for the given GID, returns false if an entry for
+        // this GID exists already (which is left unchanged).
+        bool insert(key_type const& gid, entry_type const& g);
+
+        // Insert an entry for the given GID, or replace the existing entry for
+        // this GID. Returns false if an entry has been replaced.
+        bool update(key_type const& gid, entry_type const& g);
+
+        // Remove the entry for the given GID, if any.
+        bool erase(key_type const& gid);
+
+        void clear();
+
+        // statistics
+        void count_miss(key_type const& gid);
+
+        boost::uint64_t lookups(bool reset);
+        boost::uint64_t hits(bool reset);
+        boost::uint64_t misses(bool reset);
+        boost::uint64_t evictions(bool reset);
+        boost::uint64_t insertions(bool reset);     // inserted entries
+        boost::uint64_t insert_entry_count(bool reset); // calls to insert/update
+        boost::uint64_t updates(bool reset);        // replaced entries
+        boost::uint64_t erasures(bool reset);
+
+    private:
+        typedef lcos::local::spinlock mutex_type;
+
+        enum { num_shards = 64 };
+
+        struct slot;
+        struct table;
+        struct shard;
+
+        enum statistics_type
+        {
+            stat_hits = 0,
+            stat_misses = 1,
+            stat_evictions = 2,
+            stat_insertions = 3,
+            stat_erasures = 4,
+            stat_lookups = 5,
+            stat_updates = 6,
+            stat_insert_calls = 7,
+            stat_count = 8
+        };
+
+        bool insert_entry(key_type const& gid, entry_type const& g,
+            bool replace);
+
+        boost::uint64_t get_statistics(statistics_type which, bool reset);
+
+        shard& get_shard(boost::uint64_t hash) const;
+
+        boost::atomic<table*> table_;
+        std::vector<std::unique_ptr<table> > tables_;   // all tables ever used
+        std::unique_ptr<shard[]> shards_;
+        mutex_type resize_mtx_;
+    };
+}}}
+
+#endif
@@ -214,6 +214,18 @@ inline bool is_local_lva_encoded_address(
     return is_local_lva_encoded_address(gid.get_gid());
 }
 
+///////////////////////////////////////////////////////////////////////////////
+// Create a GID which encodes the given local address of a non-migratable
+// object, returns naming::invalid_gid if this is not possible.
+HPX_API_EXPORT naming::gid_type encode_address(
+    naming::address const& addr
+    );
+
+// Release a GID created by encode_address once the object is destroyed.
+HPX_API_EXPORT void release_encoded_address(
+    naming::gid_type const& gid
+    );
+
 ///////////////////////////////////////////////////////////////////////////////
 HPX_API_EXPORT hpx::future<naming::address> resolve(
     naming::id_type const& id
@@ -224,6 +236,12 @@ HPX_API_EXPORT naming::address resolve_sync(
   , error_code& ec = throws
     );
 
+// Resolve all given ids, sending one request to each AGAS instance
+// responsible for ids which can't be resolved locally.
+HPX_API_EXPORT hpx::future<std::vector<naming::address> > resolve(
+    std::vector<naming::id_type> const& ids
+    );
+
 HPX_API_EXPORT hpx::future<bool> bind(
     naming::gid_type const& id
   , naming::address const& addr
@@ -250,6 +268,13 @@ HPX_API_EXPORT bool bind_sync(
   , error_code& ec = throws
     );
 
+// Bind all given ids to the corresponding addresses, sending one request to
+// each AGAS instance responsible for some of the ids.
+HPX_API_EXPORT hpx::future<std::vector<bool> > bind(
+    std::vector<naming::gid_type> const& ids
+  , std::vector<naming::address> const& addrs
+    );
+
 HPX_API_EXPORT hpx::future<naming::address> unbind(
     naming::gid_type const& id
   , boost::uint64_t count = 1
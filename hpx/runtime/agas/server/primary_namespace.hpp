@@ -134,12 +134,39 @@ struct HPX_EXPORT primary_namespace
     // }}}
 
   private:
-    // REVIEW: Separate mutexes might reduce contention here. This has to be
-    // investigated carefully.
-    mutex_type mutex_;
+    // The GVA and reference count tables are partitioned over blocks of
+    // 2^partition_block_bits consecutive GIDs, each block is assigned to one
+    // of num_partitions partitions (based on a hash of the block number).
+    // Every partition is protected by its own lock. GVA entries for ranges
+    // of GIDs crossing a block boundary are stored in a separate table
+    // (range_gvas_), which is consulted only if it is not empty.
+    //
+    // Lock ordering: partition lock, then ranges_mutex_. The migration table
+    // is protected by migration_mutex_ which is never held while acquiring
+    // any of the other locks.
+    enum
+    {
+        num_partitions = 64,
+        partition_block_bits = 12
+    };
+
+    struct partition
+    {
+        partition() {}
+
+        mutex_type mutex_;
+        gva_table_type gvas_;
+        refcnt_table_type refcnts_;
+
+        char pad_[64];      // avoid false sharing between partitions
+    };
+
+    partition partitions_[num_partitions];
+
+    mutex_type ranges_mutex_;
+    gva_table_type range_gvas_;                 // protected by ranges_mutex_
+    boost::atomic<std::size_t> range_count_;
 
-    gva_table_type gvas_;
-    refcnt_table_type refcnts_;
 #if !defined(HPX_GCC_VERSION) || HPX_GCC_VERSION >= 408000
     typedef std::map<
             naming::gid_type,
@@ -158,7 +185,10 @@ struct HPX_EXPORT primary_namespace
     std::string instance_name_;
     naming::gid_type next_id_;      // next available gid
     naming::gid_type locality_;     // our locality id
-    migration_table_type migrating_objects_;
+
+    mutex_type migration_mutex_;
+    migration_table_type migrating_objects_;    // protected by migration_mutex_
+    boost::atomic<std::size_t> migrating_count_;
 
     struct update_time_on_exit;
 
@@ -251,18 +281,30 @@ struct HPX_EXPORT primary_namespace
     };
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-    /// Dump the credit counts of all matching ranges. Expects that \p l
-    /// is locked.
+    /// Dump the credit counts of all GIDs in the given range.
     void dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         );
 #endif
 
+    // partitioning helpers
+    static std::size_t partition_index(naming::gid_type const& id);
+
+    /// Make sure \p l holds the lock of the partition responsible for the
+    /// given id, consecutive calls for ids of the same partition acquire
+    /// the lock only once.
+    partition& lock_partition(
+        std::unique_lock<mutex_type>& l
+      , naming::gid_type const& id
+        );
+
+    static gva_table_type::iterator find_gva(
+        gva_table_type& table
+      , naming::gid_type const& id
+        );
+
     // API
     response begin_migration(
         request const& req
@@ -271,8 +313,9 @@ struct HPX_EXPORT primary_namespace
         request const& req
       , error_code& ec);
 
-    // helper function
-    void wait_for_migration_locked(
+    // helper function, releases l (the lock of a partition, if held) if
+    // any object is currently being migrated
+    void wait_for_migration(
         std::unique_lock<mutex_type>& l
       , naming::gid_type id
       , error_code& ec);
@@ -280,10 +323,11 @@ struct HPX_EXPORT primary_namespace
   public:
     primary_namespace()
       : base_type(HPX_AGAS_PRIMARY_NS_MSB, HPX_AGAS_PRIMARY_NS_LSB)
-      , mutex_()
+      , range_count_(0)
       , instance_name_()
       , next_id_(naming::invalid_gid)
       , locality_(naming::invalid_gid)
+      , migrating_count_(0)
     {}
 
     void finalize();
@@ -357,6 +401,26 @@ struct HPX_EXPORT primary_namespace
       , error_code& ec = throws
         );
 
+    /// Handle a sequence of bind_gid requests. Consecutive requests for
+    /// GIDs of the same partition acquire the lock of the partition only
+    /// once. Stops at the first failing request.
+    std::vector<response> bulk_bind_gid(
+        std::vector<request> const& reqs
+      , error_code& ec = throws
+        );
+
+    /// Handle a sequence of resolve_gid requests, see \a bulk_bind_gid.
+    std::vector<response> bulk_resolve_gid(
+        std::vector<request> const& reqs
+      , error_code& ec = throws
+        );
+
+    /// Handle a sequence of unbind_gid requests, see \a bulk_bind_gid.
+    std::vector<response> bulk_unbind_gid(
+        std::vector<request> const& reqs
+      , error_code& ec = throws
+        );
+
     response increment_credit(
         request const& req
       , error_code& ec = throws
@@ -378,12 +442,74 @@ struct HPX_EXPORT primary_namespace
         );
 
   private:
+    // The functions below expect that l holds the lock of the partition
+    // responsible for the given gid (see lock_partition).
+    response bind_gid_locked(
+        std::unique_lock<mutex_type>& l
+      , gva const& g
+      , naming::gid_type const& id
+      , naming::gid_type const& locality
+      , error_code& ec
+        );
+
     resolved_type resolve_gid_locked(
         std::unique_lock<mutex_type>& l
       , naming::gid_type const& gid
       , error_code& ec
         );
 
+    // Waits for any migration of the object to complete, (re-)acquires the
+    // lock of the partition as needed
+    response resolve_gid(
+        std::unique_lock<mutex_type>& l
+      , naming::gid_type const& id
+      , error_code& ec
+        );
+
+    response unbind_gid_locked(
+        std::unique_lock<mutex_type>& l
+      , naming::gid_type const& id
+      , boost::uint64_t count
+      , error_code& ec
+        );
+
+    // Handle the requests [begin, end) of the given sequence, appending
+    // the responses to r.
+    void bulk_bind_gid(
+        std::vector<request> const& reqs
+      , std::size_t begin
+      , std::size_t end
+      , std::vector<response>& r
+      , error_code& ec
+        );
+
+    void bulk_resolve_gid(
+        std::vector<request> const& reqs
+      , std::size_t begin
+      , std::size_t end
+      , std::vector<response>& r
+      , error_code& ec
+        );
+
+    void bulk_unbind_gid(
+        std::vector<request> const& reqs
+      , std::size_t begin
+      , std::size_t end
+      , std::vector<response>& r
+      , error_code& ec
+        );
+
+    template <typename F>
+    void bulk_apply(
+        std::vector<request> const& reqs
+      , std::size_t begin
+      , std::size_t end
+      , counter_data::api_counter_data& counter
+      , F && f
+      , std::vector<response>& r
+      , error_code& ec
+        );
+
     void increment(
         naming::gid_type const& lower
       , naming::gid_type const& upper
@@ -405,8 +531,7 @@ struct HPX_EXPORT primary_namespace
     };
 
     void resolve_free_list(
-        std::unique_lock<mutex_type>& l
-      , std::list<refcnt_table_type::iterator> const& free_list
+        std::list<naming::gid_type> const& free_list
       , std::list<free_entry>& free_entry_list
       , naming::gid_type const& lower
       , naming::gid_type const& upper
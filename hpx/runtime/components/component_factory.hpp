@@ -58,6 +58,7 @@
 
 #include <cstddef>
 #include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace components
@@ -237,6 +238,34 @@ namespace hpx { namespace components
             return naming::invalid_gid;
         }
 
+        /// \brief Create a number of new component instances and initialize
+        ///        each of them using the given constructor function.
+        ///
+        /// \param count [in] The number of component instances to create.
+        /// \param ctor  [in] The constructor function to call in order to
+        ///              initialize each of the newly allocated objects.
+        ///
+        /// \return   Returns the GIDs of the newly created component
+        ///           instances.
+        std::vector<naming::gid_type> bulk_create_with_args(
+            std::size_t count,
+            util::unique_function_nonser<void(void*)> const& ctor)
+        {
+            if (isenabled_)
+            {
+                std::vector<naming::gid_type> ids =
+                    server::bulk_create<Component>(count, ctor);
+                refcnt_ += static_cast<long>(ids.size());
+                return ids;
+            }
+
+            HPX_THROW_EXCEPTION(bad_request,
+                "component_factory::bulk_create_with_args",
+                "this factory instance is disabled for this locality (" +
+                get_component_name() + ")");
+            return std::vector<naming::gid_type>();
+        }
+
         /// \brief Destroy one or more component instances
         ///
         /// \param gid    [in] The gid of the first component instance to
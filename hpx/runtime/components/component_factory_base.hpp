@@ -22,7 +22,9 @@
 #include <hpx/components/security/capability.hpp>
 #endif
 
+#include <cstddef>
 #include <string>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace components
@@ -93,6 +95,26 @@ namespace hpx { namespace components
             naming::gid_type const& assign_gid,
             util::unique_function_nonser<void(void*)> const& f) = 0;
 
+        /// \brief Create a number of new component instances and initialize
+        ///        each of them using the given constructor function.
+        ///
+        /// \param count [in] The number of component instances to create.
+        /// \param f     [in] The constructor function to call in order to
+        ///              initialize each of the newly allocated objects.
+        ///
+        /// \return   Returns the GIDs of the newly created component
+        ///           instances.
+        virtual std::vector<naming::gid_type> bulk_create_with_args(
+            std::size_t count,
+            util::unique_function_nonser<void(void*)> const& f)
+        {
+            std::vector<naming::gid_type> ids;
+            ids.reserve(count);
+            for (std::size_t i = 0; i != count; ++i)
+                ids.push_back(create_with_args(f));
+            return ids;
+        }
+
         /// \brief Destroy one or more component instances
         ///
         /// \param gid    [in] The gid of the first component instance to
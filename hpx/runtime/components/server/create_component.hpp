@@ -12,13 +12,17 @@
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/components/server/create_component_fwd.hpp>
+#include <hpx/traits/is_component.hpp>
 #include <hpx/util/bind.hpp>
 #include <hpx/util/decay.hpp>
 #include <hpx/util/tuple.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/util/functional/new.hpp>
 
+#include <cstddef>
 #include <sstream>
+#include <type_traits>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace components { namespace server
@@ -117,6 +121,69 @@ namespace hpx { namespace components { namespace server
         return naming::invalid_gid;
     }
 
+    ///////////////////////////////////////////////////////////////////////////
+    /// Create a number of components using the given constructor function
+    namespace detail
+    {
+        template <typename Component>
+        std::vector<naming::gid_type> bulk_create(std::size_t count,
+            util::unique_function_nonser<void(void*)> const& ctor,
+            std::false_type)
+        {
+            std::vector<naming::gid_type> ids;
+            ids.reserve(count);
+            for (std::size_t i = 0; i != count; ++i)
+                ids.push_back(server::create<Component>(ctor));
+            return ids;
+        }
+
+        // simple components bind their ids using a single AGAS request
+        template <typename Component>
+        std::vector<naming::gid_type> bulk_create(std::size_t count,
+            util::unique_function_nonser<void(void*)> const& ctor,
+            std::true_type)
+        {
+            std::vector<Component*> instances;
+            instances.reserve(count);
+
+            try {
+                for (std::size_t i = 0; i != count; ++i)
+                {
+                    void * cv = Component::heap_type::alloc(1);
+                    try {
+                        ctor(cv);
+                    }
+                    catch(...)
+                    {
+                        Component::heap_type::free(cv, 1); //-V107
+                        throw;
+                    }
+                    instances.push_back(static_cast<Component*>(cv));
+                }
+
+                return Component::get_base_gids(instances);
+            }
+            catch(...)
+            {
+                for (Component* c : instances)
+                    Component::destroy(c);
+                throw;
+            }
+        }
+    }
+
+    template <typename Component>
+    std::vector<naming::gid_type> bulk_create(std::size_t count,
+        util::unique_function_nonser<void(void*)> const& ctor)
+    {
+        typedef typename std::is_base_of<
+                traits::detail::simple_component_tag, Component
+            >::type is_simple_component;
+
+        return detail::bulk_create<Component>(count, ctor,
+            is_simple_component());
+    }
+
     ///////////////////////////////////////////////////////////////////////////
     /// Create component with arguments
     namespace detail
@@ -134,6 +201,20 @@ namespace hpx { namespace components { namespace server
                 util::one_shot(util::functional::placement_new<type>()),
                 util::placeholders::_1, std::forward<Ts>(vs)...);
         }
+
+        // The returned constructor function may be invoked any number of
+        // times, each invocation copies the given arguments.
+        template <typename Component, typename ...Ts>
+        util::detail::bound<
+            util::functional::placement_new<typename Component::derived_type>
+            (util::detail::placeholder<1> const&, Ts&&...)
+        > bulk_construct_function(Ts&&... vs)
+        {
+            typedef typename Component::derived_type type;
+
+            return util::bind(util::functional::placement_new<type>(),
+                util::placeholders::_1, std::forward<Ts>(vs)...);
+        }
     }
 
     template <typename Component, typename ...Ts>
@@ -12,7 +12,10 @@
 #include <hpx/runtime/naming/address.hpp>
 #include <hpx/util/unique_function.hpp>
 
+#include <cstddef>
 #include <cstdint>
+#include <type_traits>
+#include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
 namespace hpx { namespace components { namespace server
@@ -29,6 +32,18 @@ namespace hpx { namespace components { namespace server
     template <typename Component>
     naming::gid_type create(naming::gid_type const& gid,
         util::unique_function_nonser<void(void*)> const& ctor);
+
+    namespace detail
+    {
+        template <typename Component>
+        std::vector<naming::gid_type> bulk_create(std::size_t count,
+            util::unique_function_nonser<void(void*)> const& ctor,
+            std::true_type);
+    }
+
+    template <typename Component>
+    std::vector<naming::gid_type> bulk_create(std::size_t count,
+        util::unique_function_nonser<void(void*)> const& ctor);
 }}}
 
 #endif
@@ -583,15 +583,16 @@ namespace hpx { namespace components { namespace server
         }
 
         std::vector<naming::gid_type> ids;
-        ids.reserve(count);
 
         std::shared_ptr<component_factory_base> factory((*it).second.first);
         {
             util::unlock_guard<std::unique_lock<component_map_mutex_type> > ul(l);
-            for (std::size_t i = 0; i != count; ++i)
-            {
-                ids.push_back(factory->create());
-            }
+
+            typedef typename Component::wrapping_type wrapping_type;
+
+            // all new instances are bound using one AGAS request
+            ids = factory->bulk_create_with_args(count,
+                detail::bulk_construct_function<wrapping_type>());
         }
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
@@ -635,22 +636,19 @@ namespace hpx { namespace components { namespace server
         }
 
         std::vector<naming::gid_type> ids;
-        ids.reserve(count);
 
         std::shared_ptr<component_factory_base> factory((*it).second.first);
         {
             util::unlock_guard<std::unique_lock<component_map_mutex_type> > ul(l);
-            for (std::size_t i = 0; i != count; ++i)
-            {
-                typedef typename Component::wrapping_type wrapping_type;
-
-                // Note, T and Ts can't be (non-const) references, and parameters
-                // should be moved to allow for move-only constructor argument
-                // types.
-                ids.push_back(factory->create_with_args(
-                    detail::construct_function<wrapping_type>(
-                        std::move(v), std::move(vs)...)));
-            }
+
+            typedef typename Component::wrapping_type wrapping_type;
+
+            // Note, T and Ts can't be (non-const) references. All instances
+            // are constructed from copies of the arguments and are bound
+            // using one AGAS request.
+            ids = factory->bulk_create_with_args(count,
+                detail::bulk_construct_function<wrapping_type>(
+                    std::move(v), std::move(vs)...));
         }
         LRT_(info) << "successfully created " << count //-V128
                    << " component(s) of type: "
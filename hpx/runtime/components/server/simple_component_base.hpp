@@ -10,6 +10,7 @@
 #include <hpx/config.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/runtime_fwd.hpp>
+#include <hpx/traits/component_supports_migration.hpp>
 #include <hpx/traits/is_component.hpp>
 #include <hpx/runtime/applier_fwd.hpp>
 #include <hpx/runtime/components/component_type.hpp>
@@ -26,7 +27,9 @@
 
 #include <mutex>
 #include <sstream>
+#include <type_traits>
 #include <utility>
+#include <vector>
 
 namespace hpx { namespace detail
 {
@@ -71,8 +74,16 @@ namespace hpx { namespace components
         {
             if (gid_)
             {
-                error_code ec;
-                agas::unbind_sync(gid_, 1, ec);
+                // GIDs encoding the address of this instance are not bound
+                if (naming::detail::is_encoded_address(gid_))
+                {
+                    agas::release_encoded_address(gid_);
+                }
+                else
+                {
+                    error_code ec;
+                    agas::unbind_sync(gid_, 1, ec);
+                }
             }
         }
 
@@ -130,6 +141,93 @@ namespace hpx { namespace components
         friend naming::gid_type server::create(naming::gid_type const& gid,
             util::unique_function_nonser<void(void*)> const& ctor);
 
+        template <typename Component_>
+        friend std::vector<naming::gid_type> server::detail::bulk_create(
+            std::size_t count,
+            util::unique_function_nonser<void(void*)> const& ctor,
+            std::true_type);
+
+        // The GID of a non-migratable instance may directly encode its
+        // address, which does not require binding it. Returns an invalid
+        // GID if the address can't be encoded.
+        naming::gid_type get_encoded_gid(naming::address const& addr) const
+        {
+            if (traits::component_supports_migration<
+                    this_component_type>::call())
+            {
+                return naming::invalid_gid;
+            }
+            return agas::encode_address(addr);
+        }
+
+        // Assign GIDs to all given (newly created) instances and return
+        // them (see get_base_gid). All GIDs which need to be bound are bound
+        // using a single AGAS request.
+        template <typename Derived>
+        static std::vector<naming::gid_type> get_base_gids(
+            std::vector<Derived*> const& instances)
+        {
+            std::vector<std::size_t> unbound;
+            std::vector<naming::address> addrs;
+
+            for (std::size_t i = 0; i != instances.size(); ++i)
+            {
+                simple_component_base const& c = *instances[i];
+
+                naming::address addr(c.get_current_address());
+                c.gid_ = c.get_encoded_gid(addr);
+                if (!c.gid_)
+                {
+                    unbound.push_back(i);
+                    addrs.push_back(addr);
+                }
+            }
+
+            if (!unbound.empty())
+            {
+                // the new GIDs are consecutive
+                naming::gid_type const lower =
+                    hpx::detail::get_next_id(unbound.size());
+
+                std::vector<naming::gid_type> gids;
+                gids.reserve(unbound.size());
+                for (std::size_t i = 0; i != unbound.size(); ++i)
+                    gids.push_back(lower + i);
+
+                std::vector<bool> bound = agas::bind(gids, addrs).get();
+
+                // the instances keep their GIDs even if binding some other
+                // GID failed, which makes sure all bound GIDs are unbound
+                // once the instances are destroyed
+                std::size_t failed = unbound.size();
+                for (std::size_t i = 0; i != unbound.size(); ++i)
+                {
+                    simple_component_base const& c = *instances[unbound[i]];
+                    if (bound[i])
+                        c.gid_ = gids[i];
+                    else if (failed == unbound.size())
+                        failed = i;
+                }
+
+                if (failed != unbound.size())
+                {
+                    std::ostringstream strm;
+                    strm << "failed to bind id " << gids[failed]
+                         << "to locality: " << hpx::get_locality();
+
+                    HPX_THROW_EXCEPTION(duplicate_component_address,
+                        "simple_component_base<Component>::get_base_gids",
+                        strm.str());
+                }
+            }
+
+            std::vector<naming::gid_type> ids;
+            ids.reserve(instances.size());
+            for (Derived* c : instances)
+                ids.push_back(c->get_base_gid());
+            return ids;
+        }
+
         // Create a new GID (if called for the first time), assign this
         // GID to this instance of a component and register this gid
         // with the AGAS service
@@ -143,18 +241,22 @@ namespace hpx { namespace components
                 naming::address addr(get_current_address());
                 if (!assign_gid)
                 {
-                    gid_ = hpx::detail::get_next_id();
-                    if (!applier::bind_gid_local(gid_, addr))
+                    gid_ = get_encoded_gid(addr);
+                    if (!gid_)
                     {
-                        std::ostringstream strm;
-                        strm << "failed to bind id " << gid_
-                             << "to locality: " << hpx::get_locality();
-
-                        gid_ = naming::invalid_gid;   // invalidate GID
-
-                        HPX_THROW_EXCEPTION(duplicate_component_address,
-                            "simple_component_base<Component>::get_base_gid",
-                            strm.str());
+                        gid_ = hpx::detail::get_next_id();
+                        if (!applier::bind_gid_local(gid_, addr))
+                        {
+                            std::ostringstream strm;
+                            strm << "failed to bind id " << gid_
+                                 << "to locality: " << hpx::get_locality();
+
+                            gid_ = naming::invalid_gid;   // invalidate GID
+
+                            HPX_THROW_EXCEPTION(duplicate_component_address,
+                                "simple_component_base<Component>::get_base_gid",
+                                strm.str());
+                        }
                     }
                 }
                 else
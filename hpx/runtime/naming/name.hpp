@@ -82,6 +82,10 @@ namespace hpx { namespace naming
 
         static std::uint64_t const virtual_memory_mask = 0x7fffffull;
 
+        // the id encodes an index into the table of encoded objects of the
+        // owning locality and the generation of that entry (lsb)
+        static std::uint64_t const encoded_address_mask = 0x400000ull;
+
         // don't cache this id in the AGAS caches
         static std::uint64_t const dont_cache_mask = 0x800000ull; //-V112
 
@@ -504,6 +508,12 @@ namespace hpx { namespace naming
             id.set_msb(id.get_msb() | gid_type::dont_cache_mask);
         }
 
+        ///////////////////////////////////////////////////////////////////////
+        inline bool is_encoded_address(gid_type const& id)
+        {
+            return (id.get_msb() & gid_type::encoded_address_mask) ? true : false;
+        }
+
         ///////////////////////////////////////////////////////////////////////
         inline std::int64_t get_credit_from_gid(gid_type const& id) HPX_PURE;
 
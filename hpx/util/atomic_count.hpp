@@ -32,6 +32,11 @@ namespace hpx { namespace util
             return value_.fetch_sub(1, boost::memory_order_acq_rel) - 1;
         }
 
+        long operator+=(long n)
+        {
+            return value_.fetch_add(n, boost::memory_order_acq_rel) + n;
+        }
+
         operator long() const
         {
             return value_.load(boost::memory_order_acquire);
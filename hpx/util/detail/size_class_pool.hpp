@@ -0,0 +1,142 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#if !defined(HPX_UTIL_DETAIL_SIZE_CLASS_POOL_OCT_18_2016_0640PM)
+#define HPX_UTIL_DETAIL_SIZE_CLASS_POOL_OCT_18_2016_0640PM
+
+#include <hpx/config.hpp>
+#include <hpx/util/thread_specific_ptr.hpp>
+
+#if defined(HPX_NATIVE_TLS)
+#include <boost/thread/tss.hpp>
+#endif
+
+#include <cstddef>
+#include <new>
+
+namespace hpx { namespace util { namespace detail
+{
+    ///////////////////////////////////////////////////////////////////////////
+    // Allocate small memory blocks from per-OS-thread (i.e. per worker
+    // thread) caches, one for each size class. Blocks released on a thread
+    // are recycled by subsequent allocations of the same size class on that
+    // thread without touching the global allocator. Blocks which are too
+    // large, or which do not fit into a (bounded) cache are handled by the
+    // global operator new/delete. The blocks cached by an OS-thread are
+    // returned to the global allocator when that thread exits.
+    struct size_class_pool
+    {
+        static HPX_CONSTEXPR_OR_CONST std::size_t granularity = 16;
+        static HPX_CONSTEXPR_OR_CONST std::size_t num_size_classes = 32;
+        static HPX_CONSTEXPR_OR_CONST std::size_t max_cached_blocks = 64;
+
+        static void* allocate(std::size_t size)
+        {
+#if defined(HPX_NATIVE_TLS)
+            std::size_t const size_class = get_size_class(size);
+            if (size_class < num_size_classes)
+            {
+                cache& c = get_cache(size_class);
+                if (c.head_ != 0)
+                {
+                    block* b = c.head_;
+                    c.head_ = b->next_;
+                    --c.count_;
+                    return b;
+                }
+                return ::operator new((size_class + 1) * granularity);
+            }
+#endif
+            return ::operator new(size);
+        }
+
+        static void deallocate(void* p, std::size_t size)
+        {
+            if (p == 0)
+                return;
+
+#if defined(HPX_NATIVE_TLS)
+            std::size_t const size_class = get_size_class(size);
+            if (size_class < num_size_classes)
+            {
+                cache& c = get_cache(size_class);
+                if (c.count_ < max_cached_blocks)
+                {
+                    block* b = static_cast<block*>(p);
+                    b->next_ = c.head_;
+                    c.head_ = b;
+                    ++c.count_;
+                    return;
+                }
+            }
+#endif
+            ::operator delete(p);
+        }
+
+    private:
+#if defined(HPX_NATIVE_TLS)
+        struct block
+        {
+            block* next_;
+        };
+
+        struct cache
+        {
+            block* head_;
+            std::size_t count_;
+        };
+
+        static std::size_t get_size_class(std::size_t size)
+        {
+            return size == 0 ? 0 : (size - 1) / granularity;
+        }
+
+        static cache* get_caches()
+        {
+            // zero-initialized for each OS-thread
+            static HPX_NATIVE_TLS cache caches[num_size_classes];
+            return caches;
+        }
+
+        // An instance of this is held in thread specific storage of each
+        // OS-thread which has used its caches, it returns the cached blocks
+        // to the global allocator on thread exit. The caches are left
+        // disabled (empty and full), blocks released on this thread after
+        // that are handed directly to the global allocator.
+        struct cache_releaser
+        {
+            ~cache_releaser()
+            {
+                cache* caches = get_caches();
+                for (std::size_t i = 0; i != num_size_classes; ++i)
+                {
+                    cache& c = caches[i];
+                    while (c.head_ != 0)
+                    {
+                        block* b = c.head_;
+                        c.head_ = b->next_;
+                        ::operator delete(b);
+                    }
+                    c.count_ = max_cached_blocks;
+                }
+            }
+        };
+
+        static cache& get_cache(std::size_t size_class)
+        {
+            static HPX_NATIVE_TLS bool registered = false;
+            if (!registered)
+            {
+                static boost::thread_specific_ptr<cache_releaser> releaser;
+                releaser.reset(new cache_releaser);
+                registered = true;
+            }
+            return get_caches()[size_class];
+        }
+#endif
+    };
+}}}
+
+#endif
@@ -24,21 +24,31 @@ namespace hpx { namespace util
 {
     /// The unique_id_ranges class is a type responsible for generating
     /// unique ids for components, parcels, threads etc.
+    ///
+    /// Ids are handed out from a locally reserved range. The next range is
+    /// reserved in the background as soon as less than half of the current
+    /// range is left, which keeps the (synchronous) AGAS request off the
+    /// path of the thread creating the id.
     class HPX_EXPORT unique_id_ranges
     {
         typedef hpx::util::spinlock mutex_type;
 
         mutex_type mtx_;
 
-        /// size of the id range returned by command_getidrange
+        /// size of the id range returned by command_getidrange, larger
+        /// requests are served directly by AGAS
         /// FIXME: is this a policy?
         enum { range_delta = 0x100000 };
 
     public:
         unique_id_ranges()
-          : mtx_(), lower_(0), upper_(0)
+          : mtx_(), lower_(0), upper_(0), next_lower_(0), next_upper_(0),
+            refill_pending_(false)
         {}
 
+        /// Waits for a pending background refill, which accesses this object
+        ~unique_id_ranges();
+
         /// Generate next unique component id
         naming::gid_type get_id(std::size_t count = 1);
 
@@ -52,9 +62,17 @@ namespace hpx { namespace util
         }
 
     private:
+        /// Reserve the next range of ids, called on a separate thread
+        void refill();
+
         /// The range of available ids for components
         naming::gid_type lower_;
         naming::gid_type upper_;
+
+        /// The range reserved to be used once the current one is exhausted
+        naming::gid_type next_lower_;
+        naming::gid_type next_upper_;
+        bool refill_pending_;
     };
 }}
 
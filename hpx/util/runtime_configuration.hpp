@@ -82,8 +82,16 @@ namespace hpx { namespace util
 
         bool get_agas_range_caching_mode() const;
 
+        bool get_agas_symbol_caching_mode() const;
+
+        bool get_agas_address_encoding_mode() const;
+
         std::size_t get_agas_max_pending_refcnt_requests() const;
 
+        // Get the maximum time (in milliseconds) buffered reference counting
+        // requests are kept before being sent.
+        std::uint64_t get_agas_refcnt_flush_interval() const;
+
         // Get whether the AGAS server is running as a dedicated runtime.
         // This decides whether the AGAS actions are executed with normal
         // priority (if dedicated) or with high priority (non-dedicated)
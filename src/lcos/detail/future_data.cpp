@@ -1,14 +1,25 @@
-//  Copyright (c) 2015 Hartmut Kaiser
+//  Copyright (c) 2015-2016 Hartmut Kaiser
 //
 //  Distributed under the Boost Software License, Version 1.0. (See accompanying
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
 #include <hpx/exception.hpp>
+#include <hpx/performance_counters/counters.hpp>
+#include <hpx/performance_counters/counter_creators.hpp>
+#include <hpx/performance_counters/manage_counter_type.hpp>
+#include <hpx/runtime/get_worker_thread_num.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/function.hpp>
 #include <hpx/util/unique_function.hpp>
 #include <hpx/lcos/local/futures_factory.hpp>
 #include <hpx/lcos/detail/future_data.hpp>
 
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+
 namespace hpx { namespace lcos { namespace detail
 {
     bool run_on_completed_on_new_thread(
@@ -24,4 +35,96 @@ namespace hpx { namespace lcos { namespace detail
         // wait for the task to run
         return p.get_future().get(ec);
     }
+
+    ///////////////////////////////////////////////////////////////////////////
+    namespace
+    {
+        // The events are counted in separate cache lines for groups of
+        // worker threads to avoid contention on a single counter.
+        std::size_t const num_continuation_counter_slots = 64;
+
+        struct continuation_counter_slot
+        {
+            boost::atomic<boost::int64_t> counts_[continuation_event_count];
+            char pad_[64 -
+                (sizeof(boost::atomic<boost::int64_t>) *
+                    continuation_event_count) % 64];
+        };
+
+        continuation_counter_slot
+            continuation_counters[num_continuation_counter_slots];
+    }
+
+    void count_continuation(continuation_event event)
+    {
+        std::size_t slot =
+            hpx::get_worker_thread_num() % num_continuation_counter_slots;
+        continuation_counters[slot].counts_[event].fetch_add(1,
+            boost::memory_order_relaxed);
+    }
+
+    boost::int64_t get_continuation_count(continuation_event event,
+        bool reset)
+    {
+        boost::int64_t result = 0;
+        for (continuation_counter_slot& slot : continuation_counters)
+        {
+            if (reset)
+                result += slot.counts_[event].exchange(0);
+            else
+                result += slot.counts_[event].load();
+        }
+        return result;
+    }
+
+    void register_continuation_counter_types()
+    {
+        using util::placeholders::_1;
+        using util::placeholders::_2;
+
+        util::function_nonser<boost::int64_t(bool)> inlined(
+            util::bind(&get_continuation_count, continuation_inlined, _1));
+        util::function_nonser<boost::int64_t(bool)> spawned(
+            util::bind(&get_continuation_count, continuation_spawned, _1));
+        util::function_nonser<boost::int64_t(bool)> recursion_limited(
+            util::bind(&get_continuation_count,
+                continuation_recursion_limited, _1));
+
+        performance_counters::generic_counter_type_data const counter_types[] =
+        {
+            { "/lcos/count/continuations/inlined",
+              performance_counters::counter_raw,
+              "returns the number of continuations (of futures and dataflow) "
+                  "which were run by the thread making their input ready",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, inlined, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/lcos/count/continuations/spawned",
+              performance_counters::counter_raw,
+              "returns the number of continuations (of futures and dataflow) "
+                  "which were run on a new thread",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, spawned, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            },
+            { "/lcos/count/continuations/recursion_limited",
+              performance_counters::counter_raw,
+              "returns the number of continuations which were run on a new "
+                  "thread as running them inline would have exceeded the "
+                  "maximal recursion depth",
+              HPX_PERFORMANCE_COUNTER_V1,
+              util::bind(&performance_counters::locality_raw_counter_creator,
+                  _1, recursion_limited, _2),
+              &performance_counters::locality_counter_discoverer,
+              ""
+            }
+        };
+        performance_counters::install_counter_types(
+            counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
+    }
 }}}
@@ -0,0 +1,14 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/actions/continuation.hpp>
+#include <hpx/runtime/components/component_factory.hpp>
+#include <hpx/runtime/components/server/runtime_support.hpp>
+#include <hpx/lcos/hierarchical_barrier.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+// mailboxes used by hierarchical_barrier and hierarchical_latch
+HPX_REGISTER_COLLECTIVE_MAILBOX(bool, hierarchical_barrier)
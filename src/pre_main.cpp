@@ -11,6 +11,7 @@
 #include <hpx/error_code.hpp>
 #include <hpx/throw_exception.hpp>
 #include <hpx/lcos/barrier.hpp>
+#include <hpx/lcos/detail/future_data.hpp>
 #include <hpx/runtime/agas/interface.hpp>
 #include <hpx/runtime/applier/applier.hpp>
 #include <hpx/runtime/components/runtime_support.hpp>
@@ -25,6 +26,8 @@
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/tuple.hpp>
 
+#include <boost/chrono/chrono.hpp>
+
 #define HPX_USE_FAST_BOOTSTRAP_SYNCHRONIZATION
 
 #if defined(HPX_USE_FAST_BOOTSTRAP_SYNCHRONIZATION)
@@ -88,14 +91,16 @@ static void delete_barrier(lcos::barrier& b, char const* symname)
 static lcos::barrier
 find_barrier(char const* symname)
 {
+    // wait for the barrier to be registered instead of polling for it
+    hpx::future<naming::id_type> f = agas::on_symbol_namespace_event(
+        symname, agas::symbol_ns_bind, true);
+
     naming::id_type barrier_id;
-    for (std::size_t i = 0; i < HPX_MAX_NETWORK_RETRIES; ++i)
+    if (f.wait_for(boost::chrono::milliseconds(
+            HPX_MAX_NETWORK_RETRIES * HPX_NETWORK_RETRIES_SLEEP)) ==
+        lcos::future_status::ready)
     {
-        if (agas::resolve_name_sync(symname, barrier_id))
-            break;
-
-        boost::this_thread::sleep(boost::get_system_time() +
-            boost::posix_time::milliseconds(HPX_NETWORK_RETRIES_SLEEP));
+        barrier_id = f.get();
     }
     if (HPX_UNLIKELY(!barrier_id))
     {
@@ -128,6 +133,10 @@ static void register_counter_types()
      applier::get_applier().get_parcel_handler().register_counter_types();
      LBT_(info) << "(2nd stage) pre_main: registered parcelset performance "
                    "counter types";
+
+     lcos::detail::register_continuation_counter_types();
+     LBT_(info) << "(2nd stage) pre_main: registered continuation performance "
+                   "counter types";
 }
 
 ///////////////////////////////////////////////////////////////////////////////
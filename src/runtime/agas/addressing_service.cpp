@@ -29,6 +29,7 @@
 #include <hpx/runtime/find_localities.hpp>
 #include <hpx/runtime/naming/split_gid.hpp>
 #include <hpx/util/bind.hpp>
+#include <hpx/util/get_and_reset_value.hpp>
 #include <hpx/util/logging.hpp>
 #include <hpx/util/runtime_configuration.hpp>
 #include <hpx/util/safe_lexical_cast.hpp>
@@ -39,6 +40,7 @@
 #include <hpx/performance_counters/counter_creators.hpp>
 #include <hpx/performance_counters/manage_counter_type.hpp>
 #include <hpx/lcos/wait_all.hpp>
+#include <hpx/lcos/when_all.hpp>
 #include <hpx/lcos/broadcast.hpp>
 
 #include <boost/format.hpp>
@@ -117,21 +119,46 @@ struct addressing_service::gva_cache_key
     }
 }; // }}}
 
+struct addressing_service::incref_batch
+{
+    incref_batch()
+      : in_flight_(false)
+    {}
+
+    bool in_flight_;
+    std::vector<request> requests_;
+    std::vector<lcos::local::promise<boost::int64_t> > promises_;
+};
+
 addressing_service::addressing_service(
     parcelset::parcelhandler& ph
   , util::runtime_configuration const& ini_
   , runtime_mode runtime_type_
     )
-  : gva_cache_(new gva_cache_type)
+  : gid_cache_(ini_.get_agas_caching_mode() ?
+        ini_.get_agas_local_cache_size() : 1)
+  , has_range_entries_(false)
+  , gva_cache_(new gva_cache_type)
   , console_cache_(naming::invalid_locality_id)
   , max_refcnt_requests_(ini_.get_agas_max_pending_refcnt_requests())
+  , refcnt_flush_interval_(ini_.get_agas_refcnt_flush_interval())
   , refcnt_requests_count_(0)
   , enable_refcnt_caching_(true)
+  , refcnt_flush_pending_(false)
   , refcnt_requests_(new refcnt_requests_type)
+  , incref_requests_(0)
+  , incref_messages_(0)
+  , decref_requests_(0)
+  , decref_messages_(0)
+  , symbol_cache_hits_(0)
+  , symbol_cache_misses_(0)
+  , encoded_objects_count_(0)
   , service_type(ini_.get_agas_service_mode())
   , runtime_type(runtime_type_)
   , caching_(ini_.get_agas_caching_mode())
   , range_caching_(caching_ ? ini_.get_agas_range_caching_mode() : false)
+  , symbol_caching_(ini_.get_agas_symbol_caching_mode())
+  , address_encoding_(ini_.get_agas_address_encoding_mode())
   , action_priority_(ini_.get_agas_dedicated_server() ?
         threads::thread_priority_normal : threads::thread_priority_boost)
   , rts_lva_(0)
@@ -139,11 +166,16 @@ addressing_service::addressing_service(
   , state_(state_starting)
   , locality_()
 { // {{{
+    for (boost::atomic<encoded_object*>& chunk : encoded_chunks_)
+        chunk.store(0, boost::memory_order_relaxed);
+
     std::shared_ptr<parcelset::parcelport> pp = ph.get_bootstrap_parcelport();
     create_big_boot_barrier(pp ? pp.get() : 0, ph.endpoints(), ini_);
 
     if (caching_)
+    {
         gva_cache_->reserve(ini_.get_agas_local_cache_size());
+    }
 
     if (service_type == service_mode_bootstrap)
     {
@@ -341,8 +373,9 @@ void addressing_service::adjust_local_cache_size(std::size_t cache_size)
     // create the hierarchy based on the topology
     if (caching_)
     {
-        std::size_t previous = gva_cache_->size();
-            gva_cache_->reserve(cache_size);
+        std::size_t previous = gid_cache_.capacity();
+        gid_cache_.reserve(cache_size);
+        gva_cache_->reserve(cache_size);
 
         LAGAS_(info) << (boost::format(
             "addressing_service::adjust_local_cache_size, previous size: %1%, "
@@ -968,6 +1001,135 @@ hpx::future<bool> addressing_service::bind_range_async(
         ));
 }
 
+///////////////////////////////////////////////////////////////////////////////
+std::vector<future<std::vector<response> > >
+addressing_service::send_bulk_requests(
+    bulk_requests_type& batches
+  , std::vector<std::vector<std::size_t> >& indices
+    )
+{
+    std::vector<future<std::vector<response> > > futures;
+    futures.reserve(batches.size());
+    indices.reserve(batches.size());
+
+    for (bulk_requests_type::value_type& batch : batches)
+    {
+        naming::id_type target(batch.first, naming::id_type::unmanaged);
+        futures.push_back(stubs::primary_namespace::bulk_service_async(
+            target, std::move(batch.second.requests_), action_priority_));
+        indices.push_back(std::move(batch.second.indices_));
+    }
+
+    return futures;
+}
+
+std::vector<bool> addressing_service::bulk_bind_postproc(
+    future<std::vector<future<std::vector<response> > > > f
+  , std::vector<naming::gid_type> const& ids
+  , std::vector<gva> const& gvas
+  , std::vector<std::vector<std::size_t> > const& indices
+    )
+{
+    std::vector<future<std::vector<response> > > replies = f.get();
+    HPX_ASSERT(replies.size() == indices.size());
+
+    std::vector<bool> result(ids.size(), false);
+    std::vector<future<naming::address> > unbinds;
+    for (std::size_t i = 0; i != replies.size(); ++i)
+    {
+        // nothing is known about the requests of a failed bulk request
+        if (replies[i].has_exception())
+            continue;
+
+        std::vector<std::size_t> const& batch = indices[i];
+
+        // The primary namespace stops processing the bind requests at the
+        // first failing one, which is reported in its response. Requests
+        // without a response have not been applied.
+        std::vector<response> reps = replies[i].get();
+        HPX_ASSERT(reps.size() <= batch.size());
+
+        std::size_t applied = 0;
+        while (applied != reps.size() && applied != batch.size())
+        {
+            error const s = reps[applied].get_status();
+            if (success != s && repeated_request != s)
+                break;
+            ++applied;
+        }
+
+        bool const failed = applied != batch.size();
+        for (std::size_t j = 0; j != applied; ++j)
+        {
+            std::size_t const k = batch[j];
+
+            // Remove the bindings created by a failing request again. The
+            // ids which were bound before (repeated_request) may belong to
+            // somebody else and are not unbound.
+            if (failed && success == reps[j].get_status())
+            {
+                unbinds.push_back(unbind_range_async(ids[k], 1));
+                continue;
+            }
+
+            update_cache_entry(ids[k], gvas[k]);
+            result[k] = true;
+        }
+    }
+
+    // the unbound ids are reported as not bound regardless of errors
+    if (!unbinds.empty())
+        hpx::wait_all(unbinds);
+
+    return result;
+}
+
+hpx::future<std::vector<bool> > addressing_service::bind_async(
+    std::vector<naming::gid_type> const& ids
+  , std::vector<naming::address> const& addrs
+    )
+{
+    HPX_ASSERT(ids.size() == addrs.size());
+
+    std::vector<naming::gid_type> stripped_ids;
+    std::vector<gva> gvas;
+    stripped_ids.reserve(ids.size());
+    gvas.reserve(ids.size());
+
+    // group the requests by the responsible primary namespace instance
+    bulk_requests_type batches;
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        naming::gid_type id(
+            naming::detail::get_stripped_gid_except_dont_cache(ids[i]));
+        gva const g(addrs[i].locality_, addrs[i].type_, 1,
+            addrs[i].address_, 0);
+
+        bulk_requests& batch =
+            batches[stubs::primary_namespace::get_service_instance(id)];
+        batch.requests_.push_back(
+            request(primary_ns_bind_gid, id, g, addrs[i].locality_));
+        batch.indices_.push_back(i);
+
+        stripped_ids.push_back(id);
+        gvas.push_back(g);
+    }
+
+    if (batches.empty())
+        return make_ready_future(std::vector<bool>());
+
+    std::vector<std::vector<std::size_t> > indices;
+    std::vector<future<std::vector<response> > > futures =
+        send_bulk_requests(batches, indices);
+
+    using util::placeholders::_1;
+    return hpx::when_all(futures).then(util::bind(
+            util::one_shot(&addressing_service::bulk_bind_postproc),
+            this, _1, std::move(stripped_ids), std::move(gvas),
+            std::move(indices)
+        ));
+}
+
 hpx::future<naming::address> addressing_service::unbind_range_async(
     naming::gid_type const& lower_id
   , boost::uint64_t count
@@ -1058,6 +1220,15 @@ bool addressing_service::is_local_address_cached(
     // Assume non-local operation if the gid is known to have been migrated
     naming::gid_type id(naming::detail::get_stripped_gid_except_dont_cache(gid));
 
+    // GIDs encoding the address of a (non-migratable) object are decoded
+    // without consulting any table
+    if (resolve_encoded_address(id, addr))
+    {
+        if (&ec != &throws)
+            ec = make_success_code();
+        return true;
+    }
+
     {
         std::lock_guard<mutex_type> lock(migrated_objects_mtx_);
         if (was_object_migrated_locked(id))
@@ -1119,11 +1290,150 @@ bool addressing_service::is_local_lva_encoded_address(
         get_local_locality().get_msb();
 }
 
+addressing_service::encoded_object*
+addressing_service::get_encoded_object(boost::uint32_t index) const
+{
+    std::size_t const chunk = index / encoded_chunk_size;
+    if (chunk >= encoded_chunks_count)
+        return 0;
+
+    encoded_object* objects =
+        encoded_chunks_[chunk].load(boost::memory_order_acquire);
+    if (objects == 0)
+        return 0;
+
+    return &objects[index % encoded_chunk_size];
+}
+
+naming::gid_type addressing_service::encode_address(
+    naming::address const& addr
+    )
+{
+    if (!address_encoding_)
+        return naming::invalid_gid;
+
+    HPX_ASSERT(addr.locality_ == get_local_locality());
+
+    // reuse a released entry, allocate a new one if needed
+    boost::uint32_t index = 0;
+    {
+        std::lock_guard<mutex_type> l(encoded_objects_mtx_);
+
+        if (!free_encoded_objects_.empty())
+        {
+            index = free_encoded_objects_.back();
+            free_encoded_objects_.pop_back();
+        }
+        else
+        {
+            if (encoded_objects_count_ == HPX_AGAS_MAX_ENCODED_ADDRESSES)
+                return naming::invalid_gid;
+
+            index = encoded_objects_count_++;
+            if (index % encoded_chunk_size == 0)
+            {
+                encoded_chunks_[index / encoded_chunk_size].store(
+                    new encoded_object[encoded_chunk_size],
+                    boost::memory_order_release);
+            }
+        }
+    }
+
+    // the generation of a reused entry has been incremented when it was
+    // released, readers of GIDs referring to the previous object detect
+    // the change
+    encoded_object* entry = get_encoded_object(index);
+    HPX_ASSERT(entry != 0);
+
+    entry->type_.store(addr.type_, boost::memory_order_relaxed);
+    entry->lva_.store(addr.address_, boost::memory_order_relaxed);
+
+    boost::uint64_t const generation =
+        entry->generation_.load(boost::memory_order_relaxed);
+
+    naming::gid_type id(
+        get_local_locality().get_msb() | naming::gid_type::encoded_address_mask,
+        (generation << 32) | index);
+    naming::detail::set_credit_for_gid(id,
+        boost::int64_t(HPX_GLOBALCREDIT_INITIAL));
+    return id;
+}
+
+bool addressing_service::resolve_encoded_address(
+    naming::gid_type const& id
+  , naming::address& addr
+    ) const
+{
+    boost::uint64_t msb =
+        naming::detail::strip_internal_bits_from_gid(id.get_msb());
+
+    if (!(msb & naming::gid_type::encoded_address_mask) ||
+        (msb & naming::gid_type::locality_id_mask) != locality_.get_msb())
+    {
+        return false;
+    }
+
+    boost::uint64_t const lsb = id.get_lsb();
+    boost::uint32_t const generation = static_cast<boost::uint32_t>(lsb >> 32);
+
+    encoded_object const* entry =
+        get_encoded_object(static_cast<boost::uint32_t>(lsb));
+    if (entry == 0 ||
+        entry->generation_.load(boost::memory_order_acquire) != generation)
+    {
+        return false;
+    }
+
+    components::component_type type =
+        entry->type_.load(boost::memory_order_relaxed);
+    boost::uint64_t lva = entry->lva_.load(boost::memory_order_relaxed);
+
+    // the entry might have been released (and reused) while it was read
+    boost::atomic_thread_fence(boost::memory_order_acquire);
+    if (entry->generation_.load(boost::memory_order_relaxed) != generation)
+        return false;
+
+    addr.locality_ = locality_;
+    addr.type_ = type;
+    addr.address_ = lva;
+    return true;
+}
+
+bool addressing_service::release_encoded_address(
+    naming::gid_type const& id
+    )
+{
+    naming::address addr;
+    if (!resolve_encoded_address(id, addr))
+        return false;
+
+    boost::uint64_t const lsb = id.get_lsb();
+    boost::uint32_t const index = static_cast<boost::uint32_t>(lsb);
+    boost::uint32_t generation = static_cast<boost::uint32_t>(lsb >> 32);
+
+    // invalidate all GIDs referring to the released object before the
+    // entry can be reused
+    encoded_object* entry = get_encoded_object(index);
+    if (!entry->generation_.compare_exchange_strong(generation,
+            generation + 1, boost::memory_order_acq_rel))
+    {
+        return false;
+    }
+
+    std::lock_guard<mutex_type> l(encoded_objects_mtx_);
+    free_encoded_objects_.push_back(index);
+    return true;
+}
+
 bool addressing_service::resolve_locally_known_addresses(
     naming::gid_type const& id
   , naming::address& addr
     )
 {
+    // GIDs encoding the address of an object located on this locality
+    if (resolve_encoded_address(id, addr))
+        return true;
+
     // LVA-encoded GIDs (located on this machine)
     boost::uint64_t lsb = id.get_lsb();
     boost::uint64_t msb =
@@ -1408,6 +1718,112 @@ hpx::future<naming::address> addressing_service::resolve_async(
     return resolve_full_async(gid);
 }
 
+std::vector<naming::address> addressing_service::bulk_resolve_postproc(
+    future<std::vector<future<std::vector<response> > > > f
+  , std::vector<naming::gid_type> const& ids
+  , std::vector<naming::address> addrs
+  , std::vector<std::vector<std::size_t> > const& indices
+    )
+{
+    std::vector<future<std::vector<response> > > replies = f.get();
+    HPX_ASSERT(replies.size() == indices.size());
+
+    for (std::size_t i = 0; i != replies.size(); ++i)
+    {
+        std::vector<response> reps = replies[i].get();
+        std::vector<std::size_t> const& batch = indices[i];
+        HPX_ASSERT(reps.size() <= batch.size());
+
+        for (std::size_t j = 0; j != batch.size(); ++j)
+        {
+            // requests without a response have not been applied
+            std::size_t const k = batch[j];
+            if (j >= reps.size() || success != reps[j].get_status())
+            {
+                HPX_THROW_EXCEPTION(bad_parameter,
+                    "addressing_service::bulk_resolve_postproc",
+                    boost::str(boost::format(
+                        "could not resolve global id %1%") % ids[k]));
+                return addrs;
+            }
+
+            // Resolve the gva to the real resolved address (which is just a
+            // gva with as fully resolved LVA and and offset of zero).
+            naming::gid_type base_gid = reps[j].get_base_gid();
+            gva const base_gva = reps[j].get_gva();
+
+            gva const g = base_gva.resolve(ids[k], base_gid);
+
+            addrs[k].locality_ = g.prefix;
+            addrs[k].type_ = g.type;
+            addrs[k].address_ = g.lva();
+
+            if (naming::detail::store_in_cache(ids[k]))
+            {
+                if (range_caching_)
+                    update_cache_entry(base_gid, base_gva);
+                else
+                    update_cache_entry(ids[k], g);
+            }
+        }
+    }
+
+    return addrs;
+}
+
+hpx::future<std::vector<naming::address> > addressing_service::resolve_async(
+    std::vector<naming::gid_type> const& ids
+    )
+{
+    std::vector<naming::address> addrs(ids.size());
+
+    // group the requests for all ids which can't be resolved locally by the
+    // responsible primary namespace instance
+    bulk_requests_type batches;
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        if (!ids[i])
+        {
+            HPX_THROW_EXCEPTION(bad_parameter,
+                "addressing_service::resolve_async",
+                "invalid reference id");
+            return make_ready_future(std::vector<naming::address>());
+        }
+
+        if (caching_)
+        {
+            error_code ec;
+            if (resolve_cached(ids[i], addrs[i], ec))
+                continue;
+
+            if (ec)
+            {
+                return hpx::make_exceptional_future<
+                        std::vector<naming::address>
+                    >(hpx::detail::access_exception(ec));
+            }
+        }
+
+        bulk_requests& batch =
+            batches[stubs::primary_namespace::get_service_instance(ids[i])];
+        batch.requests_.push_back(request(primary_ns_resolve_gid, ids[i]));
+        batch.indices_.push_back(i);
+    }
+
+    if (batches.empty())
+        return make_ready_future(std::move(addrs));
+
+    std::vector<std::vector<std::size_t> > indices;
+    std::vector<future<std::vector<response> > > futures =
+        send_bulk_requests(batches, indices);
+
+    using util::placeholders::_1;
+    return hpx::when_all(futures).then(util::bind(
+            util::one_shot(&addressing_service::bulk_resolve_postproc),
+            this, _1, ids, std::move(addrs), std::move(indices)
+        ));
+}
+
 hpx::future<naming::id_type> addressing_service::get_colocation_id_async(
     naming::id_type const& id
     )
@@ -1817,12 +2233,8 @@ lcos::future<boost::int64_t> addressing_service::incref_async(
     naming::gid_type const e_lower = pending_incref.first;
     request req(primary_ns_increment_credit, e_lower, e_lower, pending_incref.second);
 
-    naming::id_type target(
-        stubs::primary_namespace::get_service_instance(e_lower)
-      , naming::id_type::unmanaged);
-
-    lcos::future<std::int64_t> f =
-        stubs::primary_namespace::service_async<std::int64_t>(target, req);
+    lcos::future<std::int64_t> f = send_incref_request(std::move(req),
+        stubs::primary_namespace::get_service_instance(e_lower));
 
     // pass the amount of compensated decrefs to the callback
     using util::placeholders::_1;
@@ -1832,6 +2244,134 @@ lcos::future<boost::int64_t> addressing_service::incref_async(
         ));
 } // }}}
 
+lcos::future<boost::int64_t> addressing_service::send_incref_request(
+    request && req
+  , naming::gid_type const& service
+    )
+{
+    ++incref_requests_;
+
+    {
+        std::lock_guard<mutex_type> l(incref_batches_mtx_);
+
+        std::shared_ptr<incref_batch>& batch = incref_batches_[service];
+        if (!batch)
+            batch = std::make_shared<incref_batch>();
+
+        if (batch->in_flight_)
+        {
+            // this request will be sent together with all other requests
+            // queued for this service instance as soon as the response for
+            // the request in flight has been received
+            batch->requests_.push_back(std::move(req));
+            batch->promises_.push_back(
+                lcos::local::promise<boost::int64_t>());
+            return batch->promises_.back().get_future();
+        }
+
+        batch->in_flight_ = true;
+    }
+
+    ++incref_messages_;
+
+    naming::id_type target(service, naming::id_type::unmanaged);
+    lcos::future<std::int64_t> f =
+        stubs::primary_namespace::service_async<std::int64_t>(target, req);
+
+    using util::placeholders::_1;
+    return f.then(util::bind(
+            util::one_shot(&addressing_service::incref_request_sent),
+            this, _1, service
+        ));
+}
+
+boost::int64_t addressing_service::incref_request_sent(
+    hpx::future<boost::int64_t> f
+  , naming::gid_type const& service
+    )
+{
+    send_incref_requests(service);
+    return f.get();
+}
+
+void addressing_service::send_incref_requests(
+    naming::gid_type const& service
+    )
+{
+    typedef lcos::local::promise<boost::int64_t> promise_type;
+
+    std::vector<request> requests;
+    std::shared_ptr<std::vector<promise_type> > promises =
+        std::make_shared<std::vector<promise_type> >();
+
+    {
+        std::lock_guard<mutex_type> l(incref_batches_mtx_);
+
+        incref_batches_type::iterator it = incref_batches_.find(service);
+        HPX_ASSERT(it != incref_batches_.end() && it->second->in_flight_);
+
+        incref_batch& batch = *it->second;
+        if (batch.requests_.empty())
+        {
+            batch.in_flight_ = false;
+            return;
+        }
+
+        requests.swap(batch.requests_);
+        promises->swap(batch.promises_);
+    }
+
+    ++incref_messages_;
+
+    LAGAS_(info) << (boost::format(
+        "addressing_service::send_incref_requests, service(%1%), "
+        "requests(%2%)")
+        % service % requests.size());
+
+    naming::id_type target(service, naming::id_type::unmanaged);
+    lcos::future<std::vector<response> > f =
+        stubs::primary_namespace::bulk_service_async(
+            target, std::move(requests));
+
+    using util::placeholders::_1;
+    f.then(util::bind(
+            util::one_shot(&addressing_service::incref_requests_sent),
+            this, _1, service, std::move(promises)
+        ));
+}
+
+void addressing_service::incref_requests_sent(
+    hpx::future<std::vector<response> > f
+  , naming::gid_type const& service
+  , std::shared_ptr<std::vector<lcos::local::promise<boost::int64_t> > >
+        promises
+    )
+{
+    std::size_t i = 0;
+    try {
+        std::vector<response> reps = f.get();
+        for (/**/; i != promises->size(); ++i)
+        {
+            if (i == reps.size() || success != reps[i].get_status())
+            {
+                HPX_THROW_EXCEPTION(
+                    i == reps.size() ? no_success : reps[i].get_status()
+                  , "addressing_service::incref_requests_sent"
+                  , "could not increment reference count");
+            }
+            (*promises)[i].set_value(reps[i].get_added_credits());
+        }
+    }
+    catch (...) {
+        boost::exception_ptr e = boost::current_exception();
+        for (/**/; i != promises->size(); ++i)
+            (*promises)[i].set_exception(e);
+    }
+
+    // send the requests which have been queued in the meantime
+    send_incref_requests(service);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 void addressing_service::decref(
     naming::gid_type const& gid
@@ -1867,6 +2407,8 @@ void addressing_service::decref(
         return;
     }
 
+    ++decref_requests_;
+
     try {
         std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
 
@@ -1968,6 +2510,12 @@ bool addressing_service::unregister_name(
   , error_code& ec
     )
 { // {{{
+    if (symbol_caching_)
+    {
+        std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+        symbol_cache_.erase(name);
+    }
+
     try {
         request req(symbol_ns_unbind, name);
         response rep = client_->service_symbol(req, action_priority_, name, ec);
@@ -1990,6 +2538,12 @@ lcos::future<naming::id_type> addressing_service::unregister_name_async(
     std::string const& name
     )
 { // {{{
+    if (symbol_caching_)
+    {
+        std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+        symbol_cache_.erase(name);
+    }
+
     request req(symbol_ns_unbind, name);
 
     return stubs::symbol_namespace::service_async<naming::id_type>(
@@ -2025,12 +2579,190 @@ lcos::future<naming::id_type> addressing_service::resolve_name_async(
     std::string const& name
     )
 { // {{{
+    if (symbol_caching_)
+        return resolve_name_cached_async(name);
+
     request req(symbol_ns_resolve, name);
 
     return stubs::symbol_namespace::service_async<naming::id_type>(
         name, req, action_priority_);
 } // }}}
 
+namespace detail
+{
+    naming::id_type get_cached_symbol(
+        hpx::shared_future<naming::id_type> const& f)
+    {
+        return f.get();
+    }
+}
+
+lcos::future<naming::id_type> addressing_service::resolve_name_cached_async(
+    std::string const& name
+    )
+{ // {{{
+    typedef lcos::local::promise<naming::id_type> promise_type;
+
+    std::shared_ptr<symbol_cache_entry> entry;
+    std::shared_ptr<promise_type> p;
+    bool subscribe = false;
+
+    {
+        std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+
+        symbol_cache_type::iterator it = symbol_cache_.find(name);
+        if (it != symbol_cache_.end())
+        {
+            symbol_cache_entry f = *it->second;
+            if (!f.is_ready())
+            {
+                // the name is being resolved already
+                ++symbol_cache_hits_;
+                return f.then(&detail::get_cached_symbol);
+            }
+
+            if (!f.has_exception() && f.get())
+            {
+                ++symbol_cache_hits_;
+                return hpx::make_ready_future(f.get());
+            }
+
+            // the resolution has failed, the entry is about to be removed
+            symbol_cache_.erase(it);
+        }
+
+        ++symbol_cache_misses_;
+
+        p = std::make_shared<promise_type>();
+        entry = std::make_shared<symbol_cache_entry>(p->get_future().share());
+        symbol_cache_.insert(symbol_cache_type::value_type(name, entry));
+
+        // a pending notification covers the new entry as well
+        subscribe = symbol_listeners_.insert(name).second;
+    }
+
+    // The subscription to the unbinding of the name and the resolution are
+    // sent as one request, the symbol namespace handles both in order. The
+    // resolved id can not be outdated without the subscription being
+    // triggered. If the name is not bound, the symbol namespace triggers the
+    // subscription right away instead of registering it.
+    std::vector<request> reqs;
+    reqs.reserve(2);
+
+    using util::placeholders::_1;
+    if (subscribe)
+    {
+        lcos::promise<naming::id_type, naming::gid_type> unbound;
+
+        reqs.push_back(request(symbol_ns_on_event, name, symbol_ns_unbind,
+            true, unbound.get_id()));
+
+        unbound.get_future().then(util::bind(
+                util::one_shot(&addressing_service::symbol_unbound),
+                this, _1, name
+            ));
+    }
+    reqs.push_back(request(symbol_ns_resolve, name));
+
+    stubs::symbol_namespace::bulk_service_async(
+            stubs::symbol_namespace::symbol_namespace_locality(name),
+            std::move(reqs), action_priority_
+        ).then(util::bind(
+            util::one_shot(&addressing_service::symbol_resolved),
+            this, _1, name, entry, p, subscribe
+        ));
+
+    return p->get_future();
+} // }}}
+
+void addressing_service::symbol_resolved(
+    hpx::future<std::vector<response> > f
+  , std::string const& name
+  , std::shared_ptr<symbol_cache_entry> const& entry
+  , std::shared_ptr<lcos::local::promise<naming::id_type> > const& p
+  , bool subscribed
+    )
+{ // {{{
+    try {
+        std::vector<response> reps = f.get();
+        HPX_ASSERT(reps.size() == (subscribed ? 2 : 1));
+
+        naming::id_type id;
+        if (success == reps.back().get_status())
+            id = get_response_result<naming::id_type>::call(reps.back());
+
+        // don't keep the entry if the name is not bound or if the entry
+        // would not be invalidated when the name is unbound
+        if (subscribed && success != reps[0].get_status())
+        {
+            erase_symbol_listener(name);
+            erase_symbol_cache_entry(name, entry);
+        }
+        else if (!id)
+        {
+            erase_symbol_cache_entry(name, entry);
+        }
+
+        p->set_value(std::move(id));
+    }
+    catch (...) {
+        if (subscribed)
+            erase_symbol_listener(name);
+        erase_symbol_cache_entry(name, entry);
+        p->set_exception(boost::current_exception());
+    }
+} // }}}
+
+void addressing_service::symbol_unbound(
+    hpx::future<naming::id_type> f
+  , std::string const& name
+    )
+{ // {{{
+    LAGAS_(info) << (boost::format(
+        "addressing_service::symbol_unbound, name(%1%)") % name);
+
+    // The notification may have been requested for an entry which was
+    // replaced since, any entry of this name might be outdated now.
+    std::shared_ptr<symbol_cache_entry> erased;
+
+    std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+
+    symbol_listeners_.erase(name);
+
+    symbol_cache_type::iterator it = symbol_cache_.find(name);
+    if (it != symbol_cache_.end())
+    {
+        erased = std::move(it->second);
+        symbol_cache_.erase(it);
+    }
+} // }}}
+
+void addressing_service::erase_symbol_listener(
+    std::string const& name
+    )
+{ // {{{
+    std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+    symbol_listeners_.erase(name);
+} // }}}
+
+void addressing_service::erase_symbol_cache_entry(
+    std::string const& name
+  , std::shared_ptr<symbol_cache_entry> const& entry
+    )
+{ // {{{
+    // hold on to the erased entry until the lock has been released
+    std::shared_ptr<symbol_cache_entry> erased;
+
+    std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+
+    symbol_cache_type::iterator it = symbol_cache_.find(name);
+    if (it != symbol_cache_.end() && it->second == entry)
+    {
+        erased = std::move(it->second);
+        symbol_cache_.erase(it);
+    }
+} // }}}
+
 namespace detail
 {
     hpx::future<hpx::id_type> on_register_event(hpx::future<bool> f,
@@ -2060,6 +2792,20 @@ future<hpx::id_type> addressing_service::on_symbol_namespace_event(
         return hpx::future<hpx::id_type>();
     }
 
+    if (symbol_caching_ && call_for_past_events)
+    {
+        // the name is known to be bound if it has been replicated locally
+        std::lock_guard<mutex_type> l(symbol_cache_mtx_);
+
+        symbol_cache_type::iterator it = symbol_cache_.find(name);
+        if (it != symbol_cache_.end() && it->second->is_ready() &&
+            !it->second->has_exception() && it->second->get())
+        {
+            ++symbol_cache_hits_;
+            return hpx::make_ready_future(it->second->get());
+        }
+    }
+
     lcos::promise<naming::id_type, naming::gid_type> p;
     request req(symbol_ns_on_event, name, evt, call_for_past_events, p.get_id());
     hpx::future<bool> f = stubs::symbol_namespace::service_async<bool>(
@@ -2145,8 +2891,11 @@ void addressing_service::update_cache_entry(
         return;
     }
 
-    // don't look at cache if id is marked as non-cache-able
-    if (!naming::detail::store_in_cache(id))
+    // don't look at cache if id is marked as non-cache-able, ids encoding
+    // the address of an object are invalidated without notifying the
+    // caches of other localities
+    if (!naming::detail::store_in_cache(id) ||
+        naming::detail::is_encoded_address(id))
     {
         if (&ec != &throws)
             ec = make_success_code();
@@ -2193,10 +2942,23 @@ void addressing_service::update_cache_entry(
             "addressing_service::update_cache_entry, gid(%1%), count(%2%)"
             ) % gid % count);
 
+        if (count == 1)
+        {
+            // entries for single GIDs don't need the (locked) range cache,
+            // an existing entry is replaced (it may have been moved)
+            gid_cache_.update(gid, g);
+
+            if (&ec != &throws)
+                ec = make_success_code();
+            return;
+        }
+
         const gva_cache_key key(gid, count);
 
         {
             std::lock_guard<mutex_type> lock(gva_cache_mtx_);
+            has_range_entries_.store(true, boost::memory_order_relaxed);
+
             if (!gva_cache_->update_if(key, g, check_for_collisions))
             {
                 if (LAGAS_ENABLED(warning))
@@ -2245,6 +3007,21 @@ bool addressing_service::get_cache_entry(
         return false;
     }
     HPX_ASSERT(hpx::threads::get_self_ptr());
+
+    // try the entries for single GIDs first, this does not acquire any lock
+    naming::gid_type const id = naming::detail::get_stripped_gid(gid);
+    bool const has_range_entries =
+        has_range_entries_.load(boost::memory_order_relaxed);
+
+    if (gid_cache_.get_entry(id, gva, !has_range_entries))
+    {
+        idbase = id;
+        return true;
+    }
+
+    if (!has_range_entries)
+        return false;
+
     gva_cache_key k(gid);
     gva_cache_key idbase_key;
 
@@ -2285,6 +3062,8 @@ void addressing_service::clear_cache(
     try {
         LAGAS_(warning) << "addressing_service::clear_cache, clearing cache";
 
+        gid_cache_.clear();
+
         std::lock_guard<mutex_type> lock(gva_cache_mtx_);
 
         gva_cache_->clear();
@@ -2332,6 +3111,8 @@ void addressing_service::remove_cache_entry(
     try {
         LAGAS_(warning) << "addressing_service::remove_cache_entry";
 
+        gid_cache_.erase(gid);
+
         std::lock_guard<mutex_type> lock(gva_cache_mtx_);
 
         gva_cache_->erase(
@@ -2513,57 +3294,77 @@ bool addressing_service::retrieve_statistics_counter(
 // Helper functions to access the current cache statistics
 boost::uint64_t addressing_service::get_cache_entries(bool reset)
 {
+    std::size_t const entries = gid_cache_.size();
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->size();
+    return entries + gva_cache_->size();
 }
 
 boost::uint64_t addressing_service::get_cache_hits(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.hits(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().hits(reset);
+    return result + gva_cache_->get_statistics().hits(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_misses(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.misses(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().misses(reset);
+    return result + gva_cache_->get_statistics().misses(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_evictions(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.evictions(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().evictions(reset);
+    return result + gva_cache_->get_statistics().evictions(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_insertions(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.insertions(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().insertions(reset);
+    return result + gva_cache_->get_statistics().insertions(reset);
 }
 
 ///////////////////////////////////////////////////////////////////////////////
 boost::uint64_t addressing_service::get_cache_get_entry_count(bool reset)
 {
+    // every lookup is counted exactly once, either by gid_cache_ or by
+    // gva_cache_
+    boost::uint64_t const result = gid_cache_.lookups(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_get_entry_count(reset);
+    return result + gva_cache_->get_statistics().get_get_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_insertion_entry_count(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.insert_entry_count(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_insert_entry_count(reset);
+    return result + gva_cache_->get_statistics().get_insert_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_update_entry_count(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.updates(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_update_entry_count(reset);
+    return result + gva_cache_->get_statistics().get_update_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_erase_entry_count(bool reset)
 {
+    boost::uint64_t const result = gid_cache_.erasures(reset);
+
     std::lock_guard<mutex_type> lock(gva_cache_mtx_);
-    return gva_cache_->get_statistics().get_erase_entry_count(reset);
+    return result + gva_cache_->get_statistics().get_erase_entry_count(reset);
 }
 
 boost::uint64_t addressing_service::get_cache_get_entry_time(bool reset)
@@ -2590,6 +3391,49 @@ boost::uint64_t addressing_service::get_cache_erase_entry_time(bool reset)
     return gva_cache_->get_statistics().get_erase_entry_time(reset);
 }
 
+// Helper functions to access the timings of the startup phases
+boost::int64_t addressing_service::get_bootstrap_registration_time(bool)
+{
+    return boost::int64_t(get_big_boot_barrier().get_registration_time());
+}
+
+boost::int64_t addressing_service::get_bootstrap_notification_time(bool)
+{
+    return boost::int64_t(get_big_boot_barrier().get_notification_time());
+}
+
+// Helper functions to access the statistics of the symbol cache
+boost::int64_t addressing_service::get_symbol_cache_hits(bool reset)
+{
+    return util::get_and_reset_value(symbol_cache_hits_, reset);
+}
+
+boost::int64_t addressing_service::get_symbol_cache_misses(bool reset)
+{
+    return util::get_and_reset_value(symbol_cache_misses_, reset);
+}
+
+// Helper functions to access the statistics of the credit traffic
+boost::int64_t addressing_service::get_incref_requests(bool reset)
+{
+    return util::get_and_reset_value(incref_requests_, reset);
+}
+
+boost::int64_t addressing_service::get_incref_messages(bool reset)
+{
+    return util::get_and_reset_value(incref_messages_, reset);
+}
+
+boost::int64_t addressing_service::get_decref_requests(bool reset)
+{
+    return util::get_and_reset_value(decref_requests_, reset);
+}
+
+boost::int64_t addressing_service::get_decref_messages(bool reset)
+{
+    return util::get_and_reset_value(decref_messages_, reset);
+}
+
 /// Install performance counter types exposing properties from the local cache.
 void addressing_service::register_counter_types()
 { // {{{
@@ -2634,6 +3478,25 @@ void addressing_service::register_counter_types()
         util::bind(
             &addressing_service::get_cache_erase_entry_time, this, _1));
 
+    util::function_nonser<boost::int64_t(bool)> bootstrap_registration_time(
+        util::bind(&addressing_service::get_bootstrap_registration_time,
+            this, _1));
+    util::function_nonser<boost::int64_t(bool)> bootstrap_notification_time(
+        util::bind(&addressing_service::get_bootstrap_notification_time,
+            this, _1));
+    util::function_nonser<boost::int64_t(bool)> symbol_cache_hits(
+        util::bind(&addressing_service::get_symbol_cache_hits, this, _1));
+    util::function_nonser<boost::int64_t(bool)> symbol_cache_misses(
+        util::bind(&addressing_service::get_symbol_cache_misses, this, _1));
+    util::function_nonser<boost::int64_t(bool)> incref_requests(
+        util::bind(&addressing_service::get_incref_requests, this, _1));
+    util::function_nonser<boost::int64_t(bool)> incref_messages(
+        util::bind(&addressing_service::get_incref_messages, this, _1));
+    util::function_nonser<boost::int64_t(bool)> decref_requests(
+        util::bind(&addressing_service::get_decref_requests, this, _1));
+    util::function_nonser<boost::int64_t(bool)> decref_messages(
+        util::bind(&addressing_service::get_decref_messages, this, _1));
+
     performance_counters::generic_counter_type_data const counter_types[] =
     {
         { "/agas/count/cache/entries", performance_counters::counter_raw,
@@ -2748,6 +3611,77 @@ void addressing_service::register_counter_types()
           &performance_counters::locality_counter_discoverer,
           ""
         },
+        { "/agas/time/bootstrap/registration", performance_counters::counter_raw,
+          "returns the time it took to register this locality with the "
+                "bootstrap locality (on the bootstrap locality: the time it "
+                "took for all localities to register)",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, bootstrap_registration_time, _2),
+          &performance_counters::locality_counter_discoverer,
+          "ns"
+        },
+        { "/agas/time/bootstrap/notification", performance_counters::counter_raw,
+          "returns the time spent sending or forwarding the startup "
+                "notifications to the registered localities",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, bootstrap_notification_time, _2),
+          &performance_counters::locality_counter_discoverer,
+          "ns"
+        },
+        { "/agas/count/symbol_cache/hits", performance_counters::counter_raw,
+          "returns the number of names resolved using the local symbol cache",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, symbol_cache_hits, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/symbol_cache/misses", performance_counters::counter_raw,
+          "returns the number of names which had to be resolved remotely "
+                "as they were not found in the local symbol cache",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, symbol_cache_misses, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/credit/incref_requests", performance_counters::counter_raw,
+          "returns the number of requests to increment global reference "
+                "counts which could not be satisfied locally",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, incref_requests, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/credit/incref_messages", performance_counters::counter_raw,
+          "returns the number of messages sent to AGAS to increment global "
+                "reference counts",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, incref_messages, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/credit/decref_requests", performance_counters::counter_raw,
+          "returns the number of requests to decrement global reference counts",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, decref_requests, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
+        { "/agas/count/credit/decref_messages", performance_counters::counter_raw,
+          "returns the number of messages sent to AGAS to decrement global "
+                "reference counts",
+          HPX_PERFORMANCE_COUNTER_V1,
+          util::bind(&performance_counters::locality_raw_counter_creator,
+              _1, decref_messages, _2),
+          &performance_counters::locality_counter_discoverer,
+          ""
+        },
     };
     performance_counters::install_counter_types(
         counter_types, sizeof(counter_types)/sizeof(counter_types[0]));
@@ -2795,12 +3729,42 @@ void addressing_service::send_refcnt_requests(
     }
 
     if (!enable_refcnt_caching_ || max_refcnt_requests_ == ++refcnt_requests_count_)
+    {
         send_refcnt_requests_non_blocking(l, ec);
+        return;
+    }
 
-    else if (&ec != &throws)
+    // make sure the buffered requests are sent after at most
+    // refcnt_flush_interval_ milliseconds
+    if (refcnt_flush_interval_ != 0 && !refcnt_flush_pending_)
+    {
+        refcnt_flush_pending_ = true;
+        l.unlock();
+
+        threads::register_thread_nullary(
+            util::bind(&addressing_service::flush_refcnt_requests, this),
+            "addressing_service::flush_refcnt_requests", threads::pending,
+            true, threads::thread_priority_normal, std::size_t(-1),
+            threads::thread_stacksize_default, ec);
+        return;
+    }
+
+    if (&ec != &throws)
         ec = make_success_code();
 }
 
+void addressing_service::flush_refcnt_requests()
+{
+    this_thread::suspend(refcnt_flush_interval_,
+        "addressing_service::flush_refcnt_requests");
+
+    std::unique_lock<mutex_type> l(refcnt_requests_mtx_);
+    refcnt_flush_pending_ = false;
+
+    error_code ec(lightweight);
+    send_refcnt_requests_non_blocking(l, ec);
+}
+
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void dump_refcnt_requests(
         std::unique_lock<addressing_service::mutex_type>& l
@@ -2883,6 +3847,8 @@ void addressing_service::send_refcnt_requests_non_blocking(
         }
 
         // send requests to all locality
+        decref_messages_ += requests.size();
+
         requests_type::iterator end = requests.end();
         for (requests_type::iterator it = requests.begin(); it != end; ++it)
         {
@@ -2950,6 +3916,8 @@ addressing_service::send_refcnt_requests_async(
     }
 
     // send requests to all locality
+    decref_messages_ += requests.size();
+
     requests_type::const_iterator end = requests.end();
     for (requests_type::const_iterator it = requests.begin(); it != end; ++it)
     {
@@ -44,8 +44,11 @@
 #include <boost/thread/thread.hpp>
 #include <boost/ref.hpp>
 
+#include <algorithm>
+#include <cstddef>
 #include <cstdint>
 #include <cstdlib>
+#include <iterator>
 #include <memory>
 #include <mutex>
 #include <sstream>
@@ -321,6 +324,46 @@ typedef actions::action<
 > notify_worker_action;
 // }}}
 
+// This structure is used to send the notifications to the localities which
+// have registered during startup. The notifications are forwarded along a
+// tree, each locality forwards the entries for the localities it is
+// responsible for (see big_boot_barrier::send_notifications).
+struct notification_entry
+{
+    notification_entry()
+      : locality_id(naming::invalid_locality_id)
+    {}
+
+    notification_entry(
+        boost::uint32_t locality_id_
+      , parcelset::locality const& dest_
+      , notification_header && header_
+    ) :
+        locality_id(locality_id_)
+      , dest(dest_)
+      , header(std::move(header_))
+    {}
+
+    boost::uint32_t locality_id;
+    parcelset::locality dest;
+    notification_header header;
+
+    template <typename Archive>
+    void serialize(Archive & ar, const unsigned int)
+    {
+        ar & locality_id;
+        ar & dest;
+        ar & header;
+    }
+};
+
+void notify_workers(std::vector<notification_entry> const& entries);
+
+typedef actions::action<
+    void (*)(std::vector<notification_entry> const&)
+  , notify_workers
+> notify_workers_action;
+
 #if defined(HPX_HAVE_SECURITY)
 // This structure is used when a locality registers with node zero
 // (second roundtrip)
@@ -395,9 +438,11 @@ typedef actions::action<
 
 using hpx::agas::register_worker_action;
 using hpx::agas::notify_worker_action;
+using hpx::agas::notify_workers_action;
 
 HPX_ACTION_HAS_CRITICAL_PRIORITY(register_worker_action);
 HPX_ACTION_HAS_CRITICAL_PRIORITY(notify_worker_action);
+HPX_ACTION_HAS_CRITICAL_PRIORITY(notify_workers_action);
 
 HPX_REGISTER_ACTION_ID(register_worker_action,
     register_worker_action,
@@ -405,6 +450,9 @@ HPX_REGISTER_ACTION_ID(register_worker_action,
 HPX_REGISTER_ACTION_ID(notify_worker_action,
     notify_worker_action,
     hpx::actions::notify_worker_action_id)
+HPX_REGISTER_ACTION_ID(notify_workers_action,
+    notify_workers_action,
+    hpx::actions::notify_workers_action_id)
 
 #if defined(HPX_HAVE_SECURITY)
 using hpx::agas::register_worker_security_action;
@@ -575,25 +623,10 @@ void register_worker(registration_header const& header)
           , notify_worker_action()
           , std::move(hdr));
 #else
-        // delay the final response until the runtime system is up and running
-        void (big_boot_barrier::*f)(
-            boost::uint32_t,
-            boost::uint32_t,
-            parcelset::locality const&,
-            notify_worker_action,
-            notification_header&&)
-            = &big_boot_barrier::apply<notify_worker_action, notification_header&&>;
-        util::unique_function_nonser<void()>* thunk
-            = new util::unique_function_nonser<void()>(
-            util::bind(
-                util::one_shot(f)
-              , boost::ref(get_big_boot_barrier())
-              , 0
-              , naming::get_locality_id_from_gid(prefix)
-              , dest
-              , notify_worker_action()
-              , std::move(hdr)));
-        get_big_boot_barrier().add_thunk(thunk);
+        // delay the final response until the runtime system is up and
+        // running, all responses are sent together (see trigger())
+        get_big_boot_barrier().add_notification(notification_entry(
+            naming::get_locality_id_from_gid(prefix), dest, std::move(hdr)));
 #endif
     }
 }
@@ -705,6 +738,28 @@ void notify_worker(notification_header const& header)
       , std::move(hdr));
 #endif
 }
+
+// AGAS callback to client, forwarded along the notification tree
+void notify_workers(std::vector<notification_entry> const& entries)
+{
+    HPX_ASSERT(!entries.empty());
+
+    boost::uint64_t started_at = util::high_resolution_clock::now();
+    big_boot_barrier& bbb = get_big_boot_barrier();
+
+    // the first entry is meant for this locality, forward the remaining
+    // entries before handling it to not delay the localities further down
+    // the tree
+    if (entries.size() > 1)
+    {
+        bbb.send_notifications(entries.front().locality_id,
+            std::vector<notification_entry>(
+                entries.begin() + 1, entries.end()));
+    }
+    bbb.notification_done(started_at);
+
+    notify_worker(entries.front().header);
+}
 // }}}
 
 #if defined(HPX_HAVE_SECURITY)
@@ -848,18 +903,31 @@ big_boot_barrier::big_boot_barrier(
   , mtx()
   , connected(get_number_of_bootstrap_connections(ini_))
   , thunks(32)
+  , registration_time(0)
+  , notification_time(0)
 {
     // register all not registered typenames
     if (service_type == service_mode_bootstrap)
         detail::register_unassigned_typenames();
 }
 
+big_boot_barrier::~big_boot_barrier()
+{
+    util::unique_function_nonser<void()>* f;
+    while (thunks.pop(f))
+        delete f;
+}
+
 void big_boot_barrier::wait_bootstrap()
 { // {{{
     HPX_ASSERT(service_mode_bootstrap == service_type);
 
+    boost::uint64_t started_at = util::high_resolution_clock::now();
+
     // the root just waits until all localities have connected
     spin();
+
+    registration_time = util::high_resolution_clock::now() - started_at;
 } // }}}
 
 namespace detail
@@ -925,7 +993,9 @@ void big_boot_barrier::wait_hosted(
         , unassigned
         , suggested_prefix);
 
-    std::srand(static_cast<unsigned>(util::high_resolution_clock::now()));
+    boost::uint64_t started_at = util::high_resolution_clock::now();
+
+    std::srand(static_cast<unsigned>(started_at));
     apply(
           static_cast<boost::uint32_t>(std::rand()) // random first parcel id
         , 0
@@ -935,6 +1005,8 @@ void big_boot_barrier::wait_hosted(
 
     // wait for registration to be complete
     spin();
+
+    registration_time = util::high_resolution_clock::now() - started_at;
 } // }}}
 
 void big_boot_barrier::notify()
@@ -957,6 +1029,8 @@ void big_boot_barrier::trigger()
 {
     if (service_mode_bootstrap == service_type)
     {
+        boost::uint64_t started_at = util::high_resolution_clock::now();
+
         util::unique_function_nonser<void()>* p;
 
         while (thunks.pop(p))
@@ -972,9 +1046,64 @@ void big_boot_barrier::trigger()
             }
             delete p;
         }
+
+        std::vector<notification_entry> entries;
+        {
+            boost::lock_guard<boost::mutex> l(mtx);
+            entries.swap(notifications);
+        }
+
+        // sort the notifications by locality id to make the notification
+        // tree independent of the order in which the localities registered
+        std::sort(entries.begin(), entries.end(),
+            [](notification_entry const& lhs, notification_entry const& rhs)
+            {
+                return lhs.locality_id < rhs.locality_id;
+            });
+
+        send_notifications(0, std::move(entries));
+        notification_done(started_at);
+    }
+}
+
+void big_boot_barrier::add_notification(notification_entry && entry)
+{
+    notifications.push_back(std::move(entry));
+}
+
+void big_boot_barrier::send_notifications(
+    boost::uint32_t source_locality_id
+  , std::vector<notification_entry> && entries
+    )
+{
+    std::size_t const count = entries.size();
+    if (count == 0)
+        return;
+
+    std::size_t const fanout = HPX_AGAS_BOOTSTRAP_FANOUT;
+    std::size_t const chunk_size = (count + fanout - 1) / fanout;
+
+    for (std::size_t first = 0; first < count; first += chunk_size)
+    {
+        std::size_t const last = (std::min)(first + chunk_size, count);
+
+        std::vector<notification_entry> chunk(
+            std::make_move_iterator(entries.begin() + first),
+            std::make_move_iterator(entries.begin() + last));
+
+        boost::uint32_t const target_locality_id = chunk.front().locality_id;
+        parcelset::locality const dest = chunk.front().dest;
+
+        apply(source_locality_id, target_locality_id, dest,
+            notify_workers_action(), std::move(chunk));
     }
 }
 
+void big_boot_barrier::notification_done(boost::uint64_t started_at)
+{
+    notification_time = util::high_resolution_clock::now() - started_at;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 struct bbb_tag;
 
@@ -0,0 +1,472 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/config.hpp>
+#include <hpx/runtime/agas/detail/sharded_gva_cache.hpp>
+#include <hpx/util/assert.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <mutex>
+#include <vector>
+
+namespace hpx { namespace agas { namespace detail
+{
+    namespace
+    {
+        // number of slots an entry may be stored in
+        std::size_t const window_size = 8;
+
+        // number of slots used if the cache size is unlimited
+        std::size_t const default_capacity = 65536;
+
+        // number of attempts to read a slot which is being written
+        std::size_t const read_retries = 4;
+
+        boost::uint64_t hash_gid(naming::gid_type const& gid)
+        {
+            boost::uint64_t h = gid.get_lsb() ^
+                (gid.get_msb() * 0x9e3779b97f4a7c15ull);
+            h ^= h >> 33;
+            h *= 0xff51afd7ed558ccdull;
+            h ^= h >> 33;
+            return h;
+        }
+
+        // the shard is selected by the upper bits of the hash, the slot
+        // window inside the shard by the lower bits
+        std::size_t shard_index(boost::uint64_t hash)
+        {
+            return static_cast<std::size_t>(hash >> 58);   // 64 shards
+        }
+
+        std::size_t next_power_of_two(std::size_t n)
+        {
+            std::size_t result = 1;
+            while (result < n)
+                result *= 2;
+            return result;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    struct sharded_gva_cache::slot
+    {
+        slot()
+          : seq_(0), key_msb_(0), key_lsb_(0), prefix_msb_(0),
+            prefix_lsb_(0), type_(0), count_(0), lva_(0), offset_(0),
+            referenced_(false)
+        {}
+
+        // all members are atomic, which makes reading a slot while it is
+        // being written well defined (the reader detects it using seq_)
+        boost::atomic<boost::uint64_t> seq_;
+        boost::atomic<boost::uint64_t> key_msb_;    // zero for empty slots
+        boost::atomic<boost::uint64_t> key_lsb_;
+        boost::atomic<boost::uint64_t> prefix_msb_;
+        boost::atomic<boost::uint64_t> prefix_lsb_;
+        boost::atomic<boost::int64_t> type_;
+        boost::atomic<boost::uint64_t> count_;
+        boost::atomic<boost::uint64_t> lva_;
+        boost::atomic<boost::uint64_t> offset_;
+        boost::atomic<bool> referenced_;
+
+        bool is_empty() const
+        {
+            return key_msb_.load(boost::memory_order_relaxed) == 0;
+        }
+
+        bool has_key(naming::gid_type const& gid) const
+        {
+            return key_msb_.load(boost::memory_order_relaxed) ==
+                    gid.get_msb() &&
+                key_lsb_.load(boost::memory_order_relaxed) == gid.get_lsb();
+        }
+
+        // called by writers only (holding the lock of the shard)
+        void store(naming::gid_type const& gid, gva const& g)
+        {
+            boost::uint64_t seq = seq_.load(boost::memory_order_relaxed);
+            seq_.store(seq + 1, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_release);
+
+            key_msb_.store(gid.get_msb(), boost::memory_order_relaxed);
+            key_lsb_.store(gid.get_lsb(), boost::memory_order_relaxed);
+            prefix_msb_.store(g.prefix.get_msb(), boost::memory_order_relaxed);
+            prefix_lsb_.store(g.prefix.get_lsb(), boost::memory_order_relaxed);
+            type_.store(g.type, boost::memory_order_relaxed);
+            count_.store(g.count, boost::memory_order_relaxed);
+            lva_.store(g.lva(), boost::memory_order_relaxed);
+            offset_.store(g.offset, boost::memory_order_relaxed);
+            referenced_.store(false, boost::memory_order_relaxed);
+
+            seq_.store(seq + 2, boost::memory_order_release);
+        }
+
+        void reset()
+        {
+            boost::uint64_t seq = seq_.load(boost::memory_order_relaxed);
+            seq_.store(seq + 1, boost::memory_order_relaxed);
+            boost::atomic_thread_fence(boost::memory_order_release);
+
+            key_msb_.store(0, boost::memory_order_relaxed);
+            key_lsb_.store(0, boost::memory_order_relaxed);
+            referenced_.store(false, boost::memory_order_relaxed);
+
+            seq_.store(seq + 2, boost::memory_order_release);
+        }
+
+        // called by readers, does not acquire any lock
+        bool load(naming::gid_type const& gid, gva& g)
+        {
+            for (std::size_t k = 0; k != read_retries; ++k)
+            {
+                boost::uint64_t seq = seq_.load(boost::memory_order_acquire);
+                if (seq & 1)
+                    continue;           // the slot is being written
+
+                if (!has_key(gid))
+                    return false;
+
+                naming::gid_type prefix(
+                    prefix_msb_.load(boost::memory_order_relaxed),
+                    prefix_lsb_.load(boost::memory_order_relaxed));
+                boost::int64_t type = type_.load(boost::memory_order_relaxed);
+                boost::uint64_t count =
+                    count_.load(boost::memory_order_relaxed);
+                boost::uint64_t lva = lva_.load(boost::memory_order_relaxed);
+                boost::uint64_t offset =
+                    offset_.load(boost::memory_order_relaxed);
+
+                boost::atomic_thread_fence(boost::memory_order_acquire);
+                if (seq_.load(boost::memory_order_relaxed) != seq)
+                    continue;           // the slot has been changed
+
+                g = gva(prefix, static_cast<gva::component_type>(type), count,
+                    lva, offset);
+
+                if (!referenced_.load(boost::memory_order_relaxed))
+                    referenced_.store(true, boost::memory_order_relaxed);
+                return true;
+            }
+            return false;
+        }
+    };
+
+    struct sharded_gva_cache::table
+    {
+        explicit table(std::size_t slots_per_shard)
+          : slots_per_shard_(slots_per_shard),
+            slots_(new slot[slots_per_shard * num_shards])
+        {
+            HPX_ASSERT(slots_per_shard >= window_size);
+        }
+
+        // the first slot of the window of the given hash, the window does
+        // not extend beyond the slots of the shard
+        slot* window(boost::uint64_t hash) const
+        {
+            std::size_t shard = shard_index(hash);
+            std::size_t offset = static_cast<std::size_t>(hash) &
+                (slots_per_shard_ - window_size);
+            return &slots_[shard * slots_per_shard_ + offset];
+        }
+
+        std::size_t const slots_per_shard_;
+        std::unique_ptr<slot[]> slots_;
+    };
+
+    struct sharded_gva_cache::shard
+    {
+        shard()
+          : size_(0), hand_(0)
+        {
+            for (std::size_t i = 0; i != stat_count; ++i)
+                statistics_[i].store(0);
+        }
+
+        void count(statistics_type which)
+        {
+            statistics_[which].fetch_add(1, boost::memory_order_relaxed);
+        }
+
+        void count_lookup(statistics_type which)
+        {
+            count(which);
+            count(stat_lookups);
+        }
+
+        mutex_type mtx_;
+        std::size_t size_;                  // protected by mtx_
+        std::size_t hand_;                  // protected by mtx_
+        boost::atomic<boost::uint64_t> statistics_[stat_count];
+
+        // shards are accessed concurrently, keep them on separate cache
+        // lines
+        char pad_[64];
+    };
+
+    ///////////////////////////////////////////////////////////////////////////
+    sharded_gva_cache::sharded_gva_cache(std::size_t capacity)
+      : table_(0), shards_(new shard[num_shards])
+    {
+        reserve(capacity);
+    }
+
+    sharded_gva_cache::~sharded_gva_cache()
+    {
+    }
+
+    sharded_gva_cache::shard& sharded_gva_cache::get_shard(
+        boost::uint64_t hash) const
+    {
+        return shards_[shard_index(hash)];
+    }
+
+    void sharded_gva_cache::reserve(std::size_t capacity)
+    {
+        if (capacity == 0 || capacity == std::size_t(-1))
+            capacity = default_capacity;
+
+        std::size_t slots_per_shard = next_power_of_two(
+            (capacity + num_shards - 1) / num_shards);
+        if (slots_per_shard < window_size)
+            slots_per_shard = window_size;
+
+        std::lock_guard<mutex_type> l(resize_mtx_);
+
+        // keep the current table (and its entries) if the size does not
+        // change, replaced tables can't be freed before the cache is
+        // destroyed
+        table* current = table_.load(boost::memory_order_acquire);
+        if (current != 0 && current->slots_per_shard_ == slots_per_shard)
+            return;
+
+        std::unique_ptr<table> t(new table(slots_per_shard));
+
+        // block all writers while replacing the table
+        for (std::size_t i = 0; i != num_shards; ++i)
+            shards_[i].mtx_.lock();
+
+        table_.store(t.get(), boost::memory_order_release);
+        tables_.push_back(std::move(t));    // keeps the replaced table alive
+
+        for (std::size_t i = 0; i != num_shards; ++i)
+        {
+            shards_[i].size_ = 0;
+            shards_[i].hand_ = 0;
+            shards_[i].mtx_.unlock();
+        }
+    }
+
+    std::size_t sharded_gva_cache::capacity() const
+    {
+        return table_.load(boost::memory_order_acquire)->slots_per_shard_ *
+            num_shards;
+    }
+
+    std::size_t sharded_gva_cache::size() const
+    {
+        std::size_t size = 0;
+        for (std::size_t i = 0; i != num_shards; ++i)
+        {
+            std::lock_guard<mutex_type> l(shards_[i].mtx_);
+            size += shards_[i].size_;
+        }
+        return size;
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    bool sharded_gva_cache::get_entry(key_type const& gid, entry_type& g,
+        bool count_miss)
+    {
+        boost::uint64_t const hash = hash_gid(gid);
+        slot* window = table_.load(boost::memory_order_acquire)->window(hash);
+
+        for (std::size_t i = 0; i != window_size; ++i)
+        {
+            if (window[i].load(gid, g))
+            {
+                get_shard(hash).count_lookup(stat_hits);
+                return true;
+            }
+        }
+
+        if (count_miss)
+            get_shard(hash).count_lookup(stat_misses);
+        return false;
+    }
+
+    bool sharded_gva_cache::insert(key_type const& gid, entry_type const& g)
+    {
+        return insert_entry(gid, g, false);
+    }
+
+    bool sharded_gva_cache::update(key_type const& gid, entry_type const& g)
+    {
+        return insert_entry(gid, g, true);
+    }
+
+    bool sharded_gva_cache::insert_entry(key_type const& gid,
+        entry_type const& g, bool replace)
+    {
+        HPX_ASSERT(gid.get_msb() != 0);
+
+        boost::uint64_t const hash = hash_gid(gid);
+        shard& s = get_shard(hash);
+        s.count(stat_insert_calls);
+
+        std::lock_guard<mutex_type> l(s.mtx_);
+
+        // the table can't be replaced while we hold the lock of the shard
+        slot* window = table_.load(boost::memory_order_acquire)->window(hash);
+
+        slot* empty = 0;
+        for (std::size_t i = 0; i != window_size; ++i)
+        {
+            if (window[i].has_key(gid))
+            {
+                if (replace)
+                {
+                    window[i].store(gid, g);
+                    s.count(stat_updates);
+                }
+                return false;
+            }
+            if (empty == 0 && window[i].is_empty())
+                empty = &window[i];
+        }
+
+        if (empty == 0)
+        {
+            // evict the first entry which has not been referenced since the
+            // clock hand has passed it the last time (the clock hand of a
+            // shard is shared by all windows of the shard)
+            for (/**/; /**/; s.hand_ = (s.hand_ + 1) % window_size)
+            {
+                slot& victim = window[s.hand_];
+                if (!victim.referenced_.exchange(false,
+                        boost::memory_order_relaxed))
+                {
+                    empty = &victim;
+                    s.hand_ = (s.hand_ + 1) % window_size;
+                    break;
+                }
+            }
+            s.count(stat_evictions);
+        }
+        else
+        {
+            ++s.size_;
+        }
+
+        empty->store(gid, g);
+        s.count(stat_insertions);
+        return true;
+    }
+
+    bool sharded_gva_cache::erase(key_type const& gid)
+    {
+        boost::uint64_t const hash = hash_gid(gid);
+        shard& s = get_shard(hash);
+
+        std::lock_guard<mutex_type> l(s.mtx_);
+
+        slot* window = table_.load(boost::memory_order_acquire)->window(hash);
+        for (std::size_t i = 0; i != window_size; ++i)
+        {
+            if (window[i].has_key(gid))
+            {
+                window[i].reset();
+                --s.size_;
+                s.count(stat_erasures);
+                return true;
+            }
+        }
+        return false;
+    }
+
+    void sharded_gva_cache::clear()
+    {
+        std::lock_guard<mutex_type> l(resize_mtx_);
+
+        table* t = table_.load(boost::memory_order_acquire);
+        for (std::size_t i = 0; i != num_shards; ++i)
+        {
+            shard& s = shards_[i];
+            std::lock_guard<mutex_type> ls(s.mtx_);
+
+            slot* slots = &t->slots_[i * t->slots_per_shard_];
+            for (std::size_t j = 0; j != t->slots_per_shard_; ++j)
+            {
+                if (!slots[j].is_empty())
+                    slots[j].reset();
+            }
+            s.size_ = 0;
+        }
+    }
+
+    ///////////////////////////////////////////////////////////////////////////
+    boost::uint64_t sharded_gva_cache::get_statistics(statistics_type which,
+        bool reset)
+    {
+        boost::uint64_t result = 0;
+        for (std::size_t i = 0; i != num_shards; ++i)
+        {
+            boost::atomic<boost::uint64_t>& value =
+                shards_[i].statistics_[which];
+            result += reset ? value.exchange(0) : value.load();
+        }
+        return result;
+    }
+
+    void sharded_gva_cache::count_miss(key_type const& gid)
+    {
+        get_shard(hash_gid(gid)).count_lookup(stat_misses);
+    }
+
+    boost::uint64_t sharded_gva_cache::lookups(bool reset)
+    {
+        return get_statistics(stat_lookups, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::hits(bool reset)
+    {
+        return get_statistics(stat_hits, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::misses(bool reset)
+    {
+        return get_statistics(stat_misses, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::insert_entry_count(bool reset)
+    {
+        return get_statistics(stat_insert_calls, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::updates(bool reset)
+    {
+        return get_statistics(stat_updates, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::evictions(bool reset)
+    {
+        return get_statistics(stat_evictions, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::insertions(bool reset)
+    {
+        return get_statistics(stat_insertions, reset);
+    }
+
+    boost::uint64_t sharded_gva_cache::erasures(bool reset)
+    {
+        return get_statistics(stat_erasures, reset);
+    }
+}}}
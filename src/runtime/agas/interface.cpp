@@ -276,6 +276,20 @@ bool is_local_lva_encoded_address(
     return naming::get_agas_client().is_local_lva_encoded_address(gid.get_msb());
 }
 
+naming::gid_type encode_address(
+    naming::address const& addr
+    )
+{
+    return naming::get_agas_client().encode_address(addr);
+}
+
+void release_encoded_address(
+    naming::gid_type const& gid
+    )
+{
+    naming::get_agas_client().release_encoded_address(gid);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 hpx::future<naming::address> resolve(
     naming::id_type const& id
@@ -294,6 +308,19 @@ naming::address resolve_sync(
     return agas_.resolve_async(id).get(ec);
 }
 
+hpx::future<std::vector<naming::address> > resolve(
+    std::vector<naming::id_type> const& ids
+    )
+{
+    std::vector<naming::gid_type> gids;
+    gids.reserve(ids.size());
+    for (naming::id_type const& id : ids)
+        gids.push_back(id.get_gid());
+
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.resolve_async(gids);
+}
+
 hpx::future<bool> bind(
     naming::gid_type const& gid
   , naming::address const& addr
@@ -336,6 +363,15 @@ bool bind_sync(
     return agas_.bind_async(gid, addr, locality_).get(ec);
 }
 
+hpx::future<std::vector<bool> > bind(
+    std::vector<naming::gid_type> const& gids
+  , std::vector<naming::address> const& addrs
+    )
+{
+    naming::resolver_client& agas_ = naming::get_agas_client();
+    return agas_.bind_async(gids, addrs);
+}
+
 hpx::future<naming::address> unbind(
     naming::gid_type const& id
   , boost::uint64_t count
@@ -360,16 +360,114 @@ std::vector<response> primary_namespace::bulk_service(
     std::vector<response> r;
     r.reserve(reqs.size());
 
-    for (request const& req : reqs)
+    std::size_t const size = reqs.size();
+    for (std::size_t i = 0; i != size; /**/)
     {
-        r.push_back(service(req, ec));
+        // handle runs of bind, resolve, or unbind requests in one go
+        std::size_t end = i + 1;
+        while (end != size &&
+            reqs[end].get_action_code() == reqs[i].get_action_code())
+        {
+            ++end;
+        }
+
+        switch (reqs[i].get_action_code())
+        {
+        case primary_ns_bind_gid:
+            {
+                // A failing bind request is reported in its response, the
+                // requests following it are not applied. This way the
+                // caller knows which of the bindings have been created.
+                error_code bind_ec(lightweight);
+                bulk_bind_gid(reqs, i, end, r, bind_ec);
+                if (bind_ec)
+                {
+                    r.back() = response(primary_ns_bind_gid,
+                        static_cast<error>(bind_ec.value()));
+                    return r;
+                }
+            }
+            break;
+
+        case primary_ns_resolve_gid:
+            bulk_resolve_gid(reqs, i, end, r, ec);
+            break;
+
+        case primary_ns_unbind_gid:
+            bulk_unbind_gid(reqs, i, end, r, ec);
+            break;
+
+        default:
+            end = i + 1;
+            r.push_back(service(reqs[i], ec));
+            break;
+        }
+
         if (ec)
             break;      // on error: for now stop iterating
+
+        i = end;
     }
 
     return r;
 }
 
+///////////////////////////////////////////////////////////////////////////////
+std::size_t primary_namespace::partition_index(naming::gid_type const& gid)
+{
+    naming::gid_type const id = naming::detail::get_stripped_gid(gid);
+
+    // all GIDs of a block are handled by the same partition
+    boost::uint64_t const block = id.get_lsb() >> partition_block_bits;
+    boost::uint64_t const hash =
+        (block ^ id.get_msb()) * 0x9e3779b97f4a7c15ULL;
+
+    return std::size_t(hash >> 32) % num_partitions;
+}
+
+primary_namespace::partition& primary_namespace::lock_partition(
+    std::unique_lock<mutex_type>& l
+  , naming::gid_type const& id
+    )
+{
+    partition& p = partitions_[partition_index(id)];
+    if (l.mutex() != &p.mutex_ || !l.owns_lock())
+    {
+        if (l.owns_lock())
+            l.unlock();
+        l = std::unique_lock<mutex_type>(p.mutex_);
+    }
+    return p;
+}
+
+// Return the entry of the given table covering the id, if any
+primary_namespace::gva_table_type::iterator primary_namespace::find_gva(
+    gva_table_type& table
+  , naming::gid_type const& id
+    )
+{
+    gva_table_type::iterator it = table.lower_bound(id)
+                           , end = table.end();
+
+    // Check for exact match
+    if (it != end && it->first == id)
+        return it;
+
+    // We need to decrement the iterator, first we check that it's safe
+    // to do this.
+    if (it == table.begin())
+        return end;
+
+    --it;
+
+    // Check whether the previous range covers the id
+    if ((it->first + it->second.first.count) > id)
+        return it;
+
+    return end;
+}
+
+///////////////////////////////////////////////////////////////////////////////
 // start migration of the given object
 response primary_namespace::begin_migration(
     request const& req
@@ -379,13 +477,16 @@ response primary_namespace::begin_migration(
 
     naming::gid_type id = req.get_gid();
 
-    std::unique_lock<mutex_type> l(mutex_);
+    resolved_type r;
+    {
+        std::unique_lock<mutex_type> l;
+        lock_partition(l, id);
+
+        r = resolve_gid_locked(l, id, ec);
+    }
 
-    resolved_type r = resolve_gid_locked(l, id, ec);
     if (get<0>(r) == naming::invalid_gid)
     {
-        l.unlock();
-
         LAGAS_(info) << (boost::format(
             "primary_namespace::begin_migration, gid(%1%), response(no_success)")
             % id);
@@ -394,6 +495,8 @@ response primary_namespace::begin_migration(
             naming::invalid_gid, no_success);
     }
 
+    std::lock_guard<mutex_type> l(migration_mutex_);
+
     migration_table_type::iterator it = migrating_objects_.find(id);
     if (it == migrating_objects_.end())
     {
@@ -415,7 +518,11 @@ response primary_namespace::begin_migration(
     }
 
     // flag this id as being migrated
-    hpx::util::get<0>(it->second) = true; //-V601
+    if (!get<0>(it->second))
+    {
+        get<0>(it->second) = true; //-V601
+        ++migrating_count_;
+    }
 
     return response(primary_ns_begin_migration, get<0>(r), get<1>(r), get<2>(r));
 }
@@ -427,7 +534,7 @@ response primary_namespace::end_migration(
 {
     naming::gid_type id = req.get_gid();
 
-    std::lock_guard<mutex_type> l(mutex_);
+    std::lock_guard<mutex_type> l(migration_mutex_);
 
     using hpx::util::get;
 
@@ -443,29 +550,37 @@ response primary_namespace::end_migration(
 
     // flag this id as not being migrated anymore
     get<0>(it->second) = false;
+    --migrating_count_;
 
     return response(primary_ns_end_migration, success);
 }
 
 // wait if given object is currently being migrated
-void primary_namespace::wait_for_migration_locked(
+void primary_namespace::wait_for_migration(
     std::unique_lock<mutex_type>& l
   , naming::gid_type id
   , error_code& ec)
 {
-    HPX_ASSERT_OWNS_LOCK(l);
+    if (migrating_count_.load(boost::memory_order_acquire) == 0)
+        return;
+
+    // never wait while holding the lock of a partition
+    if (l.owns_lock())
+        l.unlock();
 
     using hpx::util::get;
 
+    std::unique_lock<mutex_type> lm(migration_mutex_);
+
     migration_table_type::iterator it = migrating_objects_.find(id);
     if (it != migrating_objects_.end() && get<0>(it->second))
     {
         ++get<1>(it->second);
 
 #if !defined(HPX_GCC_VERSION) || HPX_GCC_VERSION >= 408000
-        get<2>(it->second).wait(l, ec);
+        get<2>(it->second).wait(lm, ec);
 #else
-        get<2>(it->second)->wait(l, ec);
+        get<2>(it->second)->wait(lm, ec);
 #endif
 
         if (--get<1>(it->second) == 0 && !get<0>(it->second))
@@ -473,13 +588,12 @@ void primary_namespace::wait_for_migration_locked(
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
 response primary_namespace::bind_gid(
     request const& req
   , error_code& ec
     )
 { // {{{ bind_gid implementation
-    using hpx::util::get;
-
     // parameters
     gva g = req.get_gva();
     naming::gid_type id = req.get_gid();
@@ -487,13 +601,49 @@ response primary_namespace::bind_gid(
 
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    std::unique_lock<mutex_type> l;
+    lock_partition(l, id);
 
-    gva_table_type::iterator it = gvas_.lower_bound(id)
-                           , begin = gvas_.begin()
-                           , end = gvas_.end();
+    return bind_gid_locked(l, g, id, locality, ec);
+} // }}}
 
-    if (it != end)
+response primary_namespace::bind_gid_locked(
+    std::unique_lock<mutex_type>& l
+  , gva const& g
+  , naming::gid_type const& id
+  , naming::gid_type const& locality
+  , error_code& ec
+    )
+{ // {{{ bind_gid_locked implementation
+    HPX_ASSERT_OWNS_LOCK(l);
+
+    partition& p = partitions_[partition_index(id)];
+    HPX_ASSERT(l.mutex() == &p.mutex_);
+
+    naming::gid_type upper_bound(id + (g.count - 1));
+
+    // Ranges crossing the boundary of a block are stored separately, the
+    // table of those has to be checked as well if it is not empty.
+    bool const in_block =
+        (id.get_lsb() >> partition_block_bits) ==
+            (upper_bound.get_lsb() >> partition_block_bits);
+
+    std::unique_lock<mutex_type> lr(ranges_mutex_, std::defer_lock);
+    if (!in_block || range_count_.load(boost::memory_order_acquire) != 0)
+        lr.lock();
+
+    // release all locks before reporting an error
+    auto unlock_all = [&]()
+    {
+        if (lr.owns_lock())
+            lr.unlock();
+        l.unlock();
+    };
+
+    gva_table_type& table = in_block ? p.gvas_ : range_gvas_;
+
+    gva_table_type::iterator it = find_gva(table, id);
+    if (it != table.end())
     {
         // If we got an exact match, this is a request to update an existing
         // binding (e.g. move semantics).
@@ -507,7 +657,7 @@ response primary_namespace::bind_gid(
             if (HPX_UNLIKELY(gaddr.count != g.count))
             {
                 // REVIEW: Is this the right error code to use?
-                l.unlock();
+                unlock_all();
 
                 HPX_THROWS_IF(ec, bad_parameter
                   , "primary_namespace::bind_gid"
@@ -517,7 +667,7 @@ response primary_namespace::bind_gid(
 
             if (HPX_UNLIKELY(components::component_invalid == g.type))
             {
-                l.unlock();
+                unlock_all();
 
                 HPX_THROWS_IF(ec, bad_parameter
                   , "primary_namespace::bind_gid"
@@ -530,7 +680,7 @@ response primary_namespace::bind_gid(
 
             if (HPX_UNLIKELY(!locality))
             {
-                l.unlock();
+                unlock_all();
 
                 HPX_THROWS_IF(ec, bad_parameter
                   , "primary_namespace::bind_gid"
@@ -548,7 +698,8 @@ response primary_namespace::bind_gid(
             gaddr.offset = g.offset;
             loc = locality;
 
-            l.unlock();
+            if (lr.owns_lock())
+                lr.unlock();
 
             LAGAS_(info) << (boost::format(
                 "primary_namespace::bind_gid, gid(%1%), gva(%2%), "
@@ -561,48 +712,39 @@ response primary_namespace::bind_gid(
             return response(primary_ns_bind_gid, repeated_request);
         }
 
-        // We're about to decrement the iterator it - first, we
-        // check that it's safe to do this.
-        else if (it != begin)
-        {
-            --it;
+        // A previous range covers the new id.
+        // REVIEW: Is this the right error code to use?
+        unlock_all();
 
-            // Check that a previous range doesn't cover the new id.
-            if (HPX_UNLIKELY((it->first + it->second.first.count) > id))
-            {
-                // REVIEW: Is this the right error code to use?
-                l.unlock();
-
-                HPX_THROWS_IF(ec, bad_parameter
-                  , "primary_namespace::bind_gid"
-                  , "the new GID is contained in an existing range");
-                return response();
-            }
-        }
+        HPX_THROWS_IF(ec, bad_parameter
+          , "primary_namespace::bind_gid"
+          , "the new GID is contained in an existing range");
+        return response();
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    // Check that no entry of the other table covers the new id.
+    if (lr.owns_lock())
     {
-        --it;
+        gva_table_type& other = in_block ? range_gvas_ : p.gvas_;
 
-        // Check that a previous range doesn't cover the new id.
-        if ((it->first + it->second.first.count) > id)
+        it = find_gva(other, id);
+        if (HPX_UNLIKELY(it != other.end()))
         {
-            // REVIEW: Is this the right error code to use?
-            l.unlock();
+            bool const exact_match = (it->first == id);
+            unlock_all();
 
             HPX_THROWS_IF(ec, bad_parameter
               , "primary_namespace::bind_gid"
-              , "the new GID is contained in an existing range");
+              , exact_match ?
+                    "cannot change block size of existing binding" :
+                    "the new GID is contained in an existing range");
             return response();
         }
     }
 
-    naming::gid_type upper_bound(id + (g.count - 1));
-
     if (HPX_UNLIKELY(id.get_msb() != upper_bound.get_msb()))
     {
-        l.unlock();
+        unlock_all();
 
         HPX_THROWS_IF(ec, internal_server_error
           , "primary_namespace::bind_gid"
@@ -612,7 +754,7 @@ response primary_namespace::bind_gid(
 
     if (HPX_UNLIKELY(components::component_invalid == g.type))
     {
-        l.unlock();
+        unlock_all();
 
         HPX_THROWS_IF(ec, bad_parameter
           , "primary_namespace::bind_gid"
@@ -624,10 +766,10 @@ response primary_namespace::bind_gid(
     }
 
     // Insert a GID -> GVA entry into the GVA table.
-    if (HPX_UNLIKELY(!util::insert_checked(gvas_.insert(
+    if (HPX_UNLIKELY(!util::insert_checked(table.insert(
             std::make_pair(id, std::make_pair(g, locality))))))
     {
-        l.unlock();
+        unlock_all();
 
         HPX_THROWS_IF(ec, lock_error
           , "primary_namespace::bind_gid"
@@ -638,7 +780,11 @@ response primary_namespace::bind_gid(
         return response();
     }
 
-    l.unlock();
+    if (!in_block)
+        ++range_count_;
+
+    if (lr.owns_lock())
+        lr.unlock();
 
     LAGAS_(info) << (boost::format(
         "primary_namespace::bind_gid, gid(%1%), gva(%2%), locality(%3%)")
@@ -655,22 +801,24 @@ response primary_namespace::resolve_gid(
   , error_code& ec
     )
 { // {{{ resolve_gid implementation
-    using hpx::util::get;
-
-    // parameters
-    naming::gid_type id = req.get_gid();
-
-    resolved_type r;
+    std::unique_lock<mutex_type> l;
+    return resolve_gid(l, req.get_gid(), ec);
+} // }}}
 
-    {
-        std::unique_lock<mutex_type> l(mutex_);
+response primary_namespace::resolve_gid(
+    std::unique_lock<mutex_type>& l
+  , naming::gid_type const& id
+  , error_code& ec
+    )
+{
+    using hpx::util::get;
 
-        // wait for any migration to be completed
-        wait_for_migration_locked(l, id, ec);
+    // wait for any migration to be completed
+    wait_for_migration(l, id, ec);
 
-        // now, resolve the id
-        r = resolve_gid_locked(l, id, ec);
-    }
+    // now, resolve the id
+    lock_partition(l, id);
+    resolved_type r = resolve_gid_locked(l, id, ec);
 
     if (get<0>(r) == naming::invalid_gid)
     {
@@ -691,7 +839,7 @@ response primary_namespace::resolve_gid(
         % id % get<0>(r) % get<1>(r) % get<2>(r));
 
     return response(primary_ns_resolve_gid, get<0>(r), get<1>(r), get<2>(r));
-} // }}}
+}
 
 response primary_namespace::unbind_gid(
     request const& req
@@ -703,15 +851,43 @@ response primary_namespace::unbind_gid(
     naming::gid_type id = req.get_gid();
     naming::detail::strip_internal_bits_from_gid(id);
 
-    std::unique_lock<mutex_type> l(mutex_);
+    std::unique_lock<mutex_type> l;
+    lock_partition(l, id);
 
-    gva_table_type::iterator it = gvas_.find(id)
-                           , end = gvas_.end();
+    return unbind_gid_locked(l, id, count, ec);
+} // }}}
 
-    if (it != end)
+response primary_namespace::unbind_gid_locked(
+    std::unique_lock<mutex_type>& l
+  , naming::gid_type const& id
+  , boost::uint64_t count
+  , error_code& ec
+    )
+{ // {{{ unbind_gid_locked implementation
+    HPX_ASSERT_OWNS_LOCK(l);
+
+    partition& p = partitions_[partition_index(id)];
+    HPX_ASSERT(l.mutex() == &p.mutex_);
+
+    gva_table_type* table = &p.gvas_;
+    gva_table_type::iterator it = table->find(id);
+
+    // the entry might be a range crossing a block boundary
+    std::unique_lock<mutex_type> lr(ranges_mutex_, std::defer_lock);
+    if (it == table->end() &&
+        range_count_.load(boost::memory_order_acquire) != 0)
+    {
+        lr.lock();
+        table = &range_gvas_;
+        it = table->find(id);
+    }
+
+    if (it != table->end())
     {
         if (HPX_UNLIKELY(it->second.first.count != count))
         {
+            if (lr.owns_lock())
+                lr.unlock();
             l.unlock();
 
             HPX_THROWS_IF(ec, bad_parameter
@@ -720,12 +896,17 @@ response primary_namespace::unbind_gid(
             return response();
         }
 
-        gva_table_data_type& data = it->second;
+        gva_table_data_type const data = it->second;
         response r(primary_ns_unbind_gid, data.first, data.second);
 
-        gvas_.erase(it);
+        table->erase(it);
+
+        if (lr.owns_lock())
+        {
+            --range_count_;
+            lr.unlock();
+        }
 
-        l.unlock();
         LAGAS_(info) << (boost::format(
             "primary_namespace::unbind_gid, gid(%1%), count(%2%), gva(%3%), "
             "locality_id(%4%)")
@@ -737,7 +918,8 @@ response primary_namespace::unbind_gid(
         return r;
     }
 
-    l.unlock();
+    if (lr.owns_lock())
+        lr.unlock();
 
     LAGAS_(info) << (boost::format(
         "primary_namespace::unbind_gid, gid(%1%), count(%2%), "
@@ -753,6 +935,130 @@ response primary_namespace::unbind_gid(
                   , no_success);
 } // }}}
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename F>
+void primary_namespace::bulk_apply(
+    std::vector<request> const& reqs
+  , std::size_t begin
+  , std::size_t end
+  , counter_data::api_counter_data& counter
+  , F && f
+  , std::vector<response>& r
+  , error_code& ec
+    )
+{
+    update_time_on_exit update(counter.time_);
+
+    // the lock of the partition handling the previous request, if any
+    std::unique_lock<mutex_type> l;
+
+    for (std::size_t i = begin; i != end; ++i)
+    {
+        ++counter.count_;
+        r.push_back(f(l, reqs[i], ec));
+        if (ec)
+            break;      // on error: for now stop iterating
+    }
+}
+
+void primary_namespace::bulk_bind_gid(
+    std::vector<request> const& reqs
+  , std::size_t begin
+  , std::size_t end
+  , std::vector<response>& r
+  , error_code& ec
+    )
+{
+    bulk_apply(reqs, begin, end, counter_data_.bind_gid_,
+        [this](std::unique_lock<mutex_type>& l, request const& req,
+            error_code& e) -> response
+        {
+            HPX_ASSERT(req.get_action_code() == primary_ns_bind_gid);
+
+            naming::gid_type id = req.get_gid();
+            naming::detail::strip_internal_bits_from_gid(id);
+
+            lock_partition(l, id);
+            return bind_gid_locked(l, req.get_gva(), id, req.get_locality(),
+                e);
+        },
+        r, ec);
+}
+
+void primary_namespace::bulk_resolve_gid(
+    std::vector<request> const& reqs
+  , std::size_t begin
+  , std::size_t end
+  , std::vector<response>& r
+  , error_code& ec
+    )
+{
+    bulk_apply(reqs, begin, end, counter_data_.resolve_gid_,
+        [this](std::unique_lock<mutex_type>& l, request const& req,
+            error_code& e) -> response
+        {
+            HPX_ASSERT(req.get_action_code() == primary_ns_resolve_gid);
+            return resolve_gid(l, req.get_gid(), e);
+        },
+        r, ec);
+}
+
+void primary_namespace::bulk_unbind_gid(
+    std::vector<request> const& reqs
+  , std::size_t begin
+  , std::size_t end
+  , std::vector<response>& r
+  , error_code& ec
+    )
+{
+    bulk_apply(reqs, begin, end, counter_data_.unbind_gid_,
+        [this](std::unique_lock<mutex_type>& l, request const& req,
+            error_code& e) -> response
+        {
+            HPX_ASSERT(req.get_action_code() == primary_ns_unbind_gid);
+
+            naming::gid_type id = req.get_gid();
+            naming::detail::strip_internal_bits_from_gid(id);
+
+            lock_partition(l, id);
+            return unbind_gid_locked(l, id, req.get_count(), e);
+        },
+        r, ec);
+}
+
+std::vector<response> primary_namespace::bulk_bind_gid(
+    std::vector<request> const& reqs
+  , error_code& ec
+    )
+{
+    std::vector<response> r;
+    r.reserve(reqs.size());
+    bulk_bind_gid(reqs, 0, reqs.size(), r, ec);
+    return r;
+}
+
+std::vector<response> primary_namespace::bulk_resolve_gid(
+    std::vector<request> const& reqs
+  , error_code& ec
+    )
+{
+    std::vector<response> r;
+    r.reserve(reqs.size());
+    bulk_resolve_gid(reqs, 0, reqs.size(), r, ec);
+    return r;
+}
+
+std::vector<response> primary_namespace::bulk_unbind_gid(
+    std::vector<request> const& reqs
+  , error_code& ec
+    )
+{
+    std::vector<response> r;
+    r.reserve(reqs.size());
+    bulk_unbind_gid(reqs, 0, reqs.size(), r, ec);
+    return r;
+}
+
 response primary_namespace::increment_credit(
     request const& req
   , error_code& ec
@@ -857,10 +1163,10 @@ response primary_namespace::allocate(
     if (upper.get_msb() != lower.get_msb())
     {
         // Check for address space exhaustion (we currently use 86 bits of
-        // the gid for the actual id)
+        // the gid for the actual id, the topmost of those marks ids
+        // encoding a local address)
         if (HPX_UNLIKELY(
-            (lower.get_msb() & naming::gid_type::virtual_memory_mask) ==
-                naming::gid_type::virtual_memory_mask)
+            (upper.get_msb() & naming::gid_type::encoded_address_mask) != 0)
            )
         {
             HPX_THROWS_IF(ec, internal_server_error
@@ -895,36 +1201,37 @@ response primary_namespace::allocate(
 
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     void primary_namespace::dump_refcnt_matches(
-        refcnt_table_type::iterator lower_it
-      , refcnt_table_type::iterator upper_it
-      , naming::gid_type const& lower
+        naming::gid_type const& lower
       , naming::gid_type const& upper
-      , std::unique_lock<mutex_type>& l
       , const char* func_name
         )
     { // dump_refcnt_matches implementation
-        HPX_ASSERT(l.owns_lock());
-
-        if (lower_it == refcnts_.end() && upper_it == refcnts_.end())
-            // We got nothing, bail - our caller is probably about to throw.
-            return;
-
         std::stringstream ss;
         ss << (boost::format(
               "%1%, dumping server-side refcnt table matches, lower(%2%), "
               "upper(%3%):")
               % func_name % lower % upper);
 
-        for (/**/; lower_it != upper_it; ++lower_it)
+        std::unique_lock<mutex_type> l;
+        for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
+            partition& p = lock_partition(l, raw);
+
+            refcnt_table_type::iterator it = p.refcnts_.find(raw);
+            if (it == p.refcnts_.end())
+                continue;
+
             // The [server] tag is in there to make it easier to filter
             // through the logs.
             ss << (boost::format(
                    "\n  [server] lower(%1%), credits(%2%)")
-                   % lower_it->first
-                   % lower_it->second);
+                   % it->first
+                   % it->second);
         }
 
+        if (l.owns_lock())
+            l.unlock();
+
         LAGAS_(debug) << ss.str();
     } // dump_refcnt_matches implementation
 #endif
@@ -937,28 +1244,11 @@ void primary_namespace::increment(
   , error_code& ec
     )
 { // {{{ increment implementation
-    std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
     if (LAGAS_ENABLED(debug))
     {
-        typedef refcnt_table_type::iterator iterator;
-
-        // Find the mappings that we're about to touch.
-        refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-        refcnt_table_type::iterator upper_it;
-        if (lower != upper)
-        {
-            upper_it = refcnts_.find(upper);
-        }
-        else
-        {
-            upper_it = lower_it;
-            ++upper_it;
-        }
-
-        dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-            "primary_namespace::increment");
+        // Dump the mappings that we're about to touch.
+        dump_refcnt_matches(lower, upper, "primary_namespace::increment");
     }
 #endif
 
@@ -972,17 +1262,20 @@ void primary_namespace::increment(
     // allocate/bind them, so if a GID is not in the refcnt table, we know that
     // it's global reference count is the initial global reference count.
 
+    std::unique_lock<mutex_type> l;
     for (naming::gid_type raw = lower; raw != upper; ++raw)
     {
-        refcnt_table_type::iterator it = refcnts_.find(raw);
-        if (it == refcnts_.end())
+        partition& p = lock_partition(l, raw);
+
+        refcnt_table_type::iterator it = p.refcnts_.find(raw);
+        if (it == p.refcnts_.end())
         {
             std::int64_t count =
                 std::int64_t(HPX_GLOBALCREDIT_INITIAL) + credits;
 
-            std::pair<refcnt_table_type::iterator, bool> p =
-                refcnts_.insert(refcnt_table_type::value_type(raw, count));
-            if (!p.second)
+            std::pair<refcnt_table_type::iterator, bool> r =
+                p.refcnts_.insert(refcnt_table_type::value_type(raw, count));
+            if (!r.second)
             {
                 l.unlock();
 
@@ -995,7 +1288,7 @@ void primary_namespace::increment(
                 return;
             }
 
-            it = p.first;
+            it = r.first;
         }
         else
         {
@@ -1013,31 +1306,23 @@ void primary_namespace::increment(
 
 ///////////////////////////////////////////////////////////////////////////////
 void primary_namespace::resolve_free_list(
-    std::unique_lock<mutex_type>& l
-  , std::list<refcnt_table_type::iterator> const& free_list
+    std::list<naming::gid_type> const& free_list
   , std::list<free_entry>& free_entry_list
   , naming::gid_type const& lower
   , naming::gid_type const& upper
   , error_code& ec
     )
 {
-    HPX_ASSERT_OWNS_LOCK(l);
-
     using hpx::util::get;
 
-    typedef refcnt_table_type::iterator iterator;
-
-    for (iterator const& it : free_list)
+    std::unique_lock<mutex_type> l;
+    for (naming::gid_type const& gid : free_list)
     {
-        typedef refcnt_table_type::key_type key_type;
-
-        // The mapping's key space.
-        key_type gid = it->first;
-
         // wait for any migration to be completed
-        wait_for_migration_locked(l, gid, ec);
+        wait_for_migration(l, gid, ec);
 
         // Resolve the query GID.
+        lock_partition(l, gid);
         resolved_type r = resolve_gid_locked(l, gid, ec);
         if (ec) return;
 
@@ -1095,9 +1380,6 @@ void primary_namespace::resolve_free_list(
         // Add the information needed to destroy these components to the
         // free list.
         free_entry_list.push_back(free_entry(resolved, gid, get<2>(r)));
-
-        // remove this entry from the refcnt table
-        refcnts_.erase(it);
     }
 }
 
@@ -1117,46 +1399,32 @@ void primary_namespace::decrement_sweep(
 
     free_entry_list.clear();
 
-    {
-        std::unique_lock<mutex_type> l(mutex_);
-
 #if defined(HPX_HAVE_AGAS_DUMP_REFCNT_ENTRIES)
-        if (LAGAS_ENABLED(debug))
-        {
-            typedef refcnt_table_type::iterator iterator;
-
-            // Find the mappings that we just added or modified.
-            refcnt_table_type::iterator lower_it = refcnts_.find(lower);
-            refcnt_table_type::iterator upper_it;
-            if (lower != upper)
-            {
-                upper_it = refcnts_.find(upper);
-            }
-            else
-            {
-                upper_it = lower_it;
-                ++upper_it;
-            }
-
-            dump_refcnt_matches(lower_it, upper_it, lower, upper, l,
-                "primary_namespace::decrement_sweep");
-        }
+    if (LAGAS_ENABLED(debug))
+    {
+        // Dump the mappings that we're about to modify.
+        dump_refcnt_matches(lower, upper, "primary_namespace::decrement_sweep");
+    }
 #endif
 
-        ///////////////////////////////////////////////////////////////////////
-        // Apply the decrement across the entire key space (e.g. [lower, upper]).
+    ///////////////////////////////////////////////////////////////////////////
+    // Apply the decrement across the entire key space (e.g. [lower, upper]).
 
-        // The third parameter we pass here is the default data to use in case
-        // the key is not mapped. We don't insert GIDs into the refcnt table
-        // when we allocate/bind them, so if a GID is not in the refcnt table,
-        // we know that it's global reference count is the initial global
-        // reference count.
+    // The third parameter we pass here is the default data to use in case
+    // the key is not mapped. We don't insert GIDs into the refcnt table
+    // when we allocate/bind them, so if a GID is not in the refcnt table,
+    // we know that it's global reference count is the initial global
+    // reference count.
 
-        std::list<refcnt_table_type::iterator> free_list;
+    std::list<naming::gid_type> free_list;
+    {
+        std::unique_lock<mutex_type> l;
         for (naming::gid_type raw = lower; raw != upper; ++raw)
         {
-            refcnt_table_type::iterator it = refcnts_.find(raw);
-            if (it == refcnts_.end())
+            partition& p = lock_partition(l, raw);
+
+            refcnt_table_type::iterator it = p.refcnts_.find(raw);
+            if (it == p.refcnts_.end())
             {
                 if (credits > std::int64_t(HPX_GLOBALCREDIT_INITIAL))
                 {
@@ -1175,9 +1443,9 @@ void primary_namespace::decrement_sweep(
                 std::int64_t count =
                     std::int64_t(HPX_GLOBALCREDIT_INITIAL) - credits;
 
-                std::pair<refcnt_table_type::iterator, bool> p =
-                    refcnts_.insert(refcnt_table_type::value_type(raw, count));
-                if (!p.second)
+                std::pair<refcnt_table_type::iterator, bool> r =
+                    p.refcnts_.insert(refcnt_table_type::value_type(raw, count));
+                if (!r.second)
                 {
                     l.unlock();
 
@@ -1190,7 +1458,7 @@ void primary_namespace::decrement_sweep(
                     return;
                 }
 
-                it = p.first;
+                it = r.first;
             }
             else
             {
@@ -1211,16 +1479,20 @@ void primary_namespace::decrement_sweep(
                 return;
             }
 
-            // this objects needs to be deleted
+            // this objects needs to be deleted, remove its entry from the
+            // refcnt table
             if (it->second == 0)
-                free_list.push_back(it);
+            {
+                p.refcnts_.erase(it);
+                free_list.push_back(raw);
+            }
         }
-
-        // Resolve the objects which have to be deleted.
-        resolve_free_list(l, free_list, free_entry_list, lower, upper, ec);
-
     } // Unlock the mutex.
 
+    // Resolve the objects which have to be deleted.
+    resolve_free_list(free_list, free_entry_list, lower, upper, ec);
+    if (ec) return;
+
     if (&ec != &throws)
         ec = make_success_code();
 }
@@ -1294,85 +1566,71 @@ primary_namespace::resolved_type primary_namespace::resolve_gid_locked(
 { // {{{ resolve_gid_locked implementation
     HPX_ASSERT_OWNS_LOCK(l);
 
+    using hpx::util::get;
+
     // parameters
     naming::gid_type id = gid;
     naming::detail::strip_internal_bits_from_gid(id);
 
-    gva_table_type::const_iterator it = gvas_.lower_bound(id)
-                                 , begin = gvas_.begin()
-                                 , end = gvas_.end();
+    partition& p = partitions_[partition_index(id)];
+    HPX_ASSERT(l.mutex() == &p.mutex_);
+
+    resolved_type r(naming::invalid_gid, gva(), naming::invalid_gid);
 
-    if (it != end)
+    // GIDs encoding the address of an object are not bound, they can be
+    // resolved only on the locality which has created them (which is the
+    // locality hosting this instance of the primary namespace)
+    if (naming::detail::is_encoded_address(id))
     {
-        // Check for exact match
-        if (it->first == id)
+        naming::address addr;
+        if (naming::get_agas_client().resolve_encoded_address(id, addr))
         {
-            if (&ec != &throws)
-                ec = make_success_code();
-
-            gva_table_data_type const& data = it->second;
-            return resolved_type(it->first, data.first, data.second);
+            r = resolved_type(id,
+                gva(addr.locality_, addr.type_, 1, addr.address_, 0),
+                addr.locality_);
         }
 
-        // We need to decrement the iterator, first we check that it's safe
-        // to do this.
-        else if (it != begin)
-        {
-            --it;
-
-            // Found the GID in a range
-            gva_table_data_type const& data = it->second;
-            if ((it->first + data.first.count) > id)
-            {
-                if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-                {
-                    l.unlock();
-
-                    HPX_THROWS_IF(ec, internal_server_error
-                      , "primary_namespace::resolve_gid_locked"
-                      , "MSBs of lower and upper range bound do not match");
-                    return resolved_type(naming::invalid_gid, gva(),
-                        naming::invalid_gid);
-                }
-
-                if (&ec != &throws)
-                    ec = make_success_code();
+        if (&ec != &throws)
+            ec = make_success_code();
 
-                return resolved_type(it->first, data.first, data.second);
-            }
-        }
+        return r;
     }
 
-    else if (HPX_LIKELY(!gvas_.empty()))
+    gva_table_type::iterator it = find_gva(p.gvas_, id);
+    if (it != p.gvas_.end())
+    {
+        r = resolved_type(it->first, it->second.first, it->second.second);
+    }
+    else if (range_count_.load(boost::memory_order_acquire) != 0)
     {
-        --it;
+        // the id might be covered by a range crossing a block boundary
+        std::lock_guard<mutex_type> lr(ranges_mutex_);
 
-        // Found the GID in a range
-        gva_table_data_type const& data = it->second;
-        if ((it->first + data.first.count) > id)
+        it = find_gva(range_gvas_, id);
+        if (it != range_gvas_.end())
         {
-            if (HPX_UNLIKELY(id.get_msb() != it->first.get_msb()))
-            {
-                l.unlock();
-
-                HPX_THROWS_IF(ec, internal_server_error
-                  , "primary_namespace::resolve_gid_locked"
-                  , "MSBs of lower and upper range bound do not match");
-                return resolved_type(naming::invalid_gid, gva(),
-                    naming::invalid_gid);
-            }
+            r = resolved_type(it->first, it->second.first,
+                it->second.second);
+        }
+    }
 
-            if (&ec != &throws)
-                ec = make_success_code();
+    // Found the GID in a range
+    if (get<0>(r) != naming::invalid_gid &&
+        HPX_UNLIKELY(id.get_msb() != get<0>(r).get_msb()))
+    {
+        l.unlock();
 
-            return resolved_type(it->first, data.first, data.second);
-        }
+        HPX_THROWS_IF(ec, internal_server_error
+          , "primary_namespace::resolve_gid_locked"
+          , "MSBs of lower and upper range bound do not match");
+        return resolved_type(naming::invalid_gid, gva(),
+            naming::invalid_gid);
     }
 
     if (&ec != &throws)
         ec = make_success_code();
 
-    return resolved_type(naming::invalid_gid, gva(), naming::invalid_gid);
+    return r;
 } // }}}
 
 response primary_namespace::statistics_counter(
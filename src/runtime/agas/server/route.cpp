@@ -37,7 +37,9 @@ namespace hpx { namespace agas { namespace server
         // resolve destination addresses, we should be able to resolve all of
         // them, otherwise it's an error
         {
-            std::unique_lock<mutex_type> l(mutex_);
+            // holds the lock of the partition responsible for the previous
+            // destination, if any
+            std::unique_lock<mutex_type> l;
 
             cache_addresses.reserve(size);
             for (std::size_t i = 0; i != size; ++i)
@@ -45,15 +47,17 @@ namespace hpx { namespace agas { namespace server
                 naming::gid_type gid(ids[i].get_gid());
 
                 // wait for any migration to be completed
-                wait_for_migration_locked(l, gid, ec);
+                wait_for_migration(l, gid, ec);
 
+                lock_partition(l, gid);
                 cache_addresses.push_back(resolve_gid_locked(l, gid, ec));
                 resolved_type& r = cache_addresses.back();
 
                 if (ec || hpx::util::get<0>(r) == naming::invalid_gid)
                 {
                     id_type const id = ids[i];
-                    l.unlock();
+                    if (l.owns_lock())
+                        l.unlock();
 
                     HPX_THROWS_IF(ec, no_success,
                         "primary_namespace::route",
@@ -481,7 +481,7 @@ response symbol_namespace::unbind(
     // parameters
     std::string key = req.get_name();
 
-    std::lock_guard<mutex_type> l(mutex_);
+    std::unique_lock<mutex_type> l(mutex_);
 
     gid_table_type::iterator it = gids_.find(key);
     gid_table_type::iterator end = gids_.end();
@@ -502,6 +502,24 @@ response symbol_namespace::unbind(
 
     gids_.erase(it);
 
+    // notify all LCOs which were registered for the unbinding of this name,
+    // these are used to invalidate replicated entries of the name
+    typedef on_event_data_map_type::iterator iterator;
+    std::pair<std::string, namespace_action_code> evtkey(key, symbol_ns_unbind);
+    std::pair<iterator, iterator> p = on_event_data_.equal_range(evtkey);
+
+    std::vector<hpx::id_type> lcos;
+    for (iterator evt_it = p.first; evt_it != p.second; ++evt_it)
+        lcos.push_back((*evt_it).second);
+
+    on_event_data_.erase(p.first, p.second);
+
+    l.unlock();
+
+    naming::gid_type const stripped_gid = naming::detail::get_stripped_gid(gid);
+    for (hpx::id_type const& id : lcos)
+        set_lco_value(id, stripped_gid);
+
     LAGAS_(info) << (boost::format(
         "symbol_namespace::unbind, key(%1%), gid(%2%)")
         % key % gid);
@@ -554,7 +572,7 @@ response symbol_namespace::on_event(
     bool call_for_past_events = req.get_on_event_call_for_past_event();
     hpx::id_type lco = req.get_on_event_result_lco();
 
-    if (evt != symbol_ns_bind)
+    if (evt != symbol_ns_bind && evt != symbol_ns_unbind)
     {
         HPX_THROWS_IF(ec, bad_parameter,
             "addressing_service::on_symbol_namespace_event",
@@ -565,7 +583,18 @@ response symbol_namespace::on_event(
     std::unique_lock<mutex_type> l(mutex_);
 
     bool handled = false;
-    if (call_for_past_events)
+    if (call_for_past_events && evt == symbol_ns_unbind)
+    {
+        // trigger LCO right away if the name is not bound
+        if (gids_.find(name) == gids_.end())
+        {
+            util::unlock_guard<std::unique_lock<mutex_type> > ul(l);
+
+            handled = true;
+            set_lco_value(lco, naming::invalid_gid);
+        }
+    }
+    else if (call_for_past_events)
     {
         gid_table_type::iterator it = gids_.find(name);
         if (it != gids_.end())
@@ -5,16 +5,39 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/config.hpp>
+#include <hpx/error_code.hpp>
 #include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/threads/thread_helpers.hpp>
+#include <hpx/util/bind.hpp>
+#include <hpx/util/detail/yield_k.hpp>
 #include <hpx/util/generate_unique_ids.hpp>
 #include <hpx/util/unlock_guard.hpp>
 
+#include <cstddef>
 #include <mutex>
 
 namespace hpx { namespace util
 {
+    unique_id_ranges::~unique_id_ranges()
+    {
+        // refill() releases the lock as its last access to this object
+        for (std::size_t k = 0; /**/; ++k)
+        {
+            {
+                std::lock_guard<mutex_type> l(mtx_);
+                if (!refill_pending_)
+                    break;
+            }
+            util::detail::yield_k(k, "unique_id_ranges::~unique_id_ranges");
+        }
+    }
+
     naming::gid_type unique_id_ranges::get_id(std::size_t count)
     {
+        // requests for large ranges are served directly
+        if (count > std::size_t(range_delta))
+            return hpx::agas::get_next_id(count);
+
         // create a new id
         std::unique_lock<mutex_type> l(mtx_);
 
@@ -23,8 +46,17 @@ namespace hpx { namespace util
         {
             lower_ = naming::invalid_gid;
 
+            // switch to the range reserved in the background, if any
+            if (next_lower_)
+            {
+                lower_ = next_lower_;
+                upper_ = next_upper_;
+                next_lower_ = naming::invalid_gid;
+                continue;
+            }
+
             naming::gid_type lower;
-            std::size_t count_ = (std::max)(std::size_t(range_delta), count);
+            std::size_t count_ = std::size_t(range_delta);
 
             {
                 unlock_guard<std::unique_lock<mutex_type> > ul(l);
@@ -42,7 +74,51 @@ namespace hpx { namespace util
 
         naming::gid_type result = lower_;
         lower_ += count;
+
+        // reserve the next range in the background once half of the current
+        // one has been used up, this requires to run on an HPX thread
+        if (!next_lower_ && !refill_pending_ &&
+            (lower_ + std::size_t(range_delta / 2)) > upper_ &&
+            threads::get_self_ptr() != nullptr)
+        {
+            refill_pending_ = true;
+            l.unlock();
+
+            error_code ec(lightweight);
+            threads::register_thread_nullary(
+                util::bind(&unique_id_ranges::refill, this),
+                "unique_id_ranges::refill", threads::pending, true,
+                threads::thread_priority_normal, std::size_t(-1),
+                threads::thread_stacksize_default, ec);
+
+            if (ec)
+            {
+                // the ids will be reserved once they are needed
+                l.lock();
+                refill_pending_ = false;
+            }
+        }
+
         return result;
     }
-}}
 
+    void unique_id_ranges::refill()
+    {
+        naming::gid_type lower;
+        try {
+            lower = hpx::agas::get_next_id(std::size_t(range_delta));
+        }
+        catch (...) {
+            lower = naming::invalid_gid;
+        }
+
+        std::lock_guard<mutex_type> l(mtx_);
+        refill_pending_ = false;
+
+        if (lower && !next_lower_)
+        {
+            next_lower_ = lower;
+            next_upper_ = lower + std::size_t(range_delta);
+        }
+    }
+}}
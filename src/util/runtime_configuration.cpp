@@ -258,11 +258,17 @@ namespace hpx { namespace util
                 "${HPX_AGAS_MAX_PENDING_REFCNT_REQUESTS:"
                 BOOST_PP_STRINGIZE(HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS)
                 "}",
+            "refcnt_flush_interval = "
+                "${HPX_AGAS_REFCNT_FLUSH_INTERVAL:"
+                BOOST_PP_STRINGIZE(HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL)
+                "}",
             "service_mode = hosted",
             "dedicated_server = 0",
             "local_cache_size = ${HPX_AGAS_LOCAL_CACHE_SIZE:"
                 BOOST_PP_STRINGIZE(HPX_AGAS_LOCAL_CACHE_SIZE) "}",
             "use_range_caching = ${HPX_AGAS_USE_RANGE_CACHING:1}",
+            "use_symbol_caching = ${HPX_AGAS_USE_SYMBOL_CACHING:0}",
+            "use_address_encoding = ${HPX_AGAS_USE_ADDRESS_ENCODING:0}",
             "use_caching = ${HPX_AGAS_USE_CACHING:1}",
 
             "[hpx.components]",
@@ -687,6 +693,30 @@ namespace hpx { namespace util
         return false;
     }
 
+    bool runtime_configuration::get_agas_symbol_caching_mode() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (NULL != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "use_symbol_caching", "0") != 0;
+            }
+        }
+        return false;
+    }
+
+    bool runtime_configuration::get_agas_address_encoding_mode() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (NULL != sec) {
+                return hpx::util::get_entry_as<int>(
+                    *sec, "use_address_encoding", "0") != 0;
+            }
+        }
+        return false;
+    }
+
     std::size_t
     runtime_configuration::get_agas_max_pending_refcnt_requests() const
     {
@@ -701,6 +731,20 @@ namespace hpx { namespace util
         return HPX_INITIAL_AGAS_MAX_PENDING_REFCNT_REQUESTS;
     }
 
+    std::uint64_t
+    runtime_configuration::get_agas_refcnt_flush_interval() const
+    {
+        if (has_section("hpx.agas")) {
+            util::section const* sec = get_section("hpx.agas");
+            if (NULL != sec) {
+                return hpx::util::get_entry_as<std::uint64_t>(
+                    *sec, "refcnt_flush_interval",
+                    HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL);
+            }
+        }
+        return HPX_INITIAL_AGAS_REFCNT_FLUSH_INTERVAL;
+    }
+
     // Get whether the AGAS server is running as a dedicated runtime.
     // This decides whether the AGAS actions are executed with normal
     // priority (if dedicated) or with high priority (non-dedicated)
@@ -0,0 +1,153 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark compares the overheads of fork_join_block and task_block
+// for a fine grained recursive divide-and-conquer algorithm (a naive
+// Fibonacci computation). Below the given threshold the Fibonacci numbers
+// are computed sequentially. Besides the run times, the overhead per forked
+// task relative to the sequential computation is reported, which is most
+// meaningful if run on a single core (--hpx:threads=1).
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/parallel_task_block.hpp>
+#include <hpx/util/high_resolution_clock.hpp>
+
+#include <boost/cstdint.hpp>
+#include <boost/format.hpp>
+#include <boost/program_options.hpp>
+
+#include <cstddef>
+
+using hpx::parallel::define_fork_join_block;
+using hpx::parallel::define_task_block;
+using hpx::parallel::fork_join_block;
+using hpx::parallel::task_block;
+
+///////////////////////////////////////////////////////////////////////////////
+boost::uint64_t threshold = 2;
+
+boost::uint64_t fib_seq(boost::uint64_t n)
+{
+    if (n < 2)
+        return n;
+    return fib_seq(n - 1) + fib_seq(n - 2);
+}
+
+// number of tasks forked while computing fib(n)
+boost::uint64_t num_forks(boost::uint64_t n)
+{
+    if (n < threshold)
+        return 0;
+    return 1 + num_forks(n - 1) + num_forks(n - 2);
+}
+
+boost::uint64_t fib_fork_join(boost::uint64_t n)
+{
+    if (n < threshold)
+        return fib_seq(n);
+
+    boost::uint64_t x = 0, y = 0;
+    define_fork_join_block(
+        [&](fork_join_block<>& fj)
+        {
+            fj.run([&] { x = fib_fork_join(n - 1); });
+            y = fib_fork_join(n - 2);
+        });
+    return x + y;
+}
+
+boost::uint64_t fib_task_block(boost::uint64_t n)
+{
+    if (n < threshold)
+        return fib_seq(n);
+
+    boost::uint64_t x = 0, y = 0;
+    define_task_block(
+        [&](task_block<>& tb)
+        {
+            tb.run([&] { x = fib_task_block(n - 1); });
+            y = fib_task_block(n - 2);
+        });
+    return x + y;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// returns the average time per repetition in ns
+template <typename F>
+double measure(char const* name, F f, boost::uint64_t n,
+    std::size_t repetitions)
+{
+    boost::uint64_t result = 0;
+    boost::uint64_t t = hpx::util::high_resolution_clock::now();
+
+    for (std::size_t i = 0; i != repetitions; ++i)
+        result = f(n);
+
+    t = hpx::util::high_resolution_clock::now() - t;
+
+    hpx::cout
+        << (boost::format("%1%: fib(%2%) = %3% in %4% ms\n")
+            % name % n % result % (t / (1e6 * repetitions)))
+        << hpx::flush;
+
+    return double(t) / repetitions;
+}
+
+void report_overhead(char const* name, double t, double t_seq,
+    boost::uint64_t forks)
+{
+    hpx::cout
+        << (boost::format("%1%: %2% forks, %3% ns overhead per fork\n")
+            % name % forks % ((t - t_seq) / forks))
+        << hpx::flush;
+}
+
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    boost::uint64_t const n = vm["n-value"].as<boost::uint64_t>();
+    std::size_t const repetitions = vm["repetitions"].as<std::size_t>();
+    threshold = vm["threshold"].as<boost::uint64_t>();
+
+    double const t_seq = measure("sequential", &fib_seq, n, repetitions);
+    double const t_fj =
+        measure("fork_join_block", &fib_fork_join, n, repetitions);
+    double const t_tb =
+        measure("task_block", &fib_task_block, n, repetitions);
+
+    boost::uint64_t const forks = num_forks(n);
+    if (forks != 0)
+    {
+        report_overhead("fork_join_block", t_fj, t_seq, forks);
+        report_overhead("task_block", t_tb, t_seq, forks);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    using boost::program_options::options_description;
+    using boost::program_options::value;
+
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "n-value"
+        , value<boost::uint64_t>()->default_value(30)
+        , "n value for the Fibonacci function")
+
+        ( "threshold"
+        , value<boost::uint64_t>()->default_value(2)
+        , "below this value the Fibonacci numbers are computed sequentially")
+
+        ( "repetitions"
+        , value<std::size_t>()->default_value(5)
+        , "number of repetitions of each measurement")
+        ;
+
+    return hpx::init(cmdline, argc, argv);
+}
@@ -12,6 +12,7 @@
 #include <hpx/util/high_resolution_timer.hpp>
 #include <hpx/include/async.hpp>
 #include <hpx/include/iostreams.hpp>
+#include <hpx/lcos/local/atomic_future.hpp>
 
 #include <stdexcept>
 #include <vector>
@@ -121,6 +122,39 @@ void measure_function_futures(boost::uint64_t count, bool csv)
               << flush;
 }
 
+void measure_atomic_futures(boost::uint64_t count, bool csv)
+{
+    using hpx::lcos::local::atomic_future;
+    using hpx::lcos::local::atomic_async;
+
+    std::vector<atomic_future<double> > futures;
+
+    futures.reserve(count);
+
+    // start the clock
+    high_resolution_timer walltime;
+
+    for (boost::uint64_t i = 0; i < count; ++i)
+        futures.push_back(atomic_async(&null_function));
+
+    for (atomic_future<double>& f : futures)
+        global_scratch += f.get();
+
+    // stop the clock
+    const double duration = walltime.elapsed();
+
+    if (csv)
+        cout << ( boost::format("%1%,%2%\n")
+                % count
+                % duration)
+              << flush;
+    else
+        cout << ( boost::format("invoked %1% futures (atomic) in %2% seconds\n")
+                % count
+                % duration)
+              << flush;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(
     variables_map& vm
@@ -136,6 +170,7 @@ int hpx_main(
 
         measure_action_futures(count, vm.count("csv") != 0);
         measure_function_futures(count, vm.count("csv") != 0);
+        measure_atomic_futures(count, vm.count("csv") != 0);
     }
 
     finalize();
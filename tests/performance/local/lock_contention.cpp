@@ -0,0 +1,198 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+// This benchmark measures the throughput of the different locks available
+// for HPX threads under contention. Each of the HPX threads performs a number
+// of critical sections, a given percentage of which only read the protected
+// data. The readers acquire the reader-writer locks in shared mode.
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/iostreams.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/util/high_resolution_timer.hpp>
+
+#include <boost/format.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <string>
+#include <vector>
+
+using boost::program_options::variables_map;
+using boost::program_options::options_description;
+using boost::program_options::value;
+
+///////////////////////////////////////////////////////////////////////////////
+// we use globals here to prevent the work from being optimized away
+std::size_t const data_size = 64;
+boost::uint64_t global_data[data_size] = { 0 };
+boost::uint64_t global_scratch = 0;
+
+boost::uint64_t iterations = 0;
+std::size_t read_percentage = 0;
+std::size_t work = 0;
+
+///////////////////////////////////////////////////////////////////////////////
+// exclusive locks are used for readers as well
+template <typename Mutex>
+struct shared_lock_guard
+{
+    explicit shared_lock_guard(Mutex& mtx) : mtx_(mtx) { mtx_.lock(); }
+    ~shared_lock_guard() { mtx_.unlock(); }
+
+    Mutex& mtx_;
+};
+
+template <>
+struct shared_lock_guard<hpx::lcos::local::shared_mutex>
+{
+    typedef hpx::lcos::local::shared_mutex mutex_type;
+
+    explicit shared_lock_guard(mutex_type& mtx) : mtx_(mtx) { mtx_.lock_shared(); }
+    ~shared_lock_guard() { mtx_.unlock_shared(); }
+
+    mutex_type& mtx_;
+};
+
+template <>
+struct shared_lock_guard<hpx::lcos::local::distributed_shared_mutex>
+{
+    typedef hpx::lcos::local::distributed_shared_mutex mutex_type;
+
+    explicit shared_lock_guard(mutex_type& mtx) : mtx_(mtx) { mtx_.lock_shared(); }
+    ~shared_lock_guard() { mtx_.unlock_shared(); }
+
+    mutex_type& mtx_;
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+void worker(Mutex& mtx, std::size_t seed)
+{
+    boost::uint64_t sum = 0;
+    for (boost::uint64_t i = 0; i != iterations; ++i)
+    {
+        if ((i * 37 + seed) % 100 < read_percentage)
+        {
+            shared_lock_guard<Mutex> l(mtx);
+            for (std::size_t j = 0; j != work; ++j)
+                sum += global_data[j % data_size];
+        }
+        else
+        {
+            std::lock_guard<Mutex> l(mtx);
+            for (std::size_t j = 0; j != work; ++j)
+                ++global_data[j % data_size];
+        }
+    }
+    global_scratch += sum;
+}
+
+template <typename Mutex>
+void measure(char const* name, std::size_t num_threads, bool csv)
+{
+    Mutex mtx;
+
+    std::vector<hpx::future<void> > threads;
+    threads.reserve(num_threads);
+
+    hpx::util::high_resolution_timer walltime;
+
+    for (std::size_t i = 0; i != num_threads; ++i)
+        threads.push_back(hpx::async(&worker<Mutex>, std::ref(mtx), i));
+    hpx::wait_all(threads);
+
+    double const duration = walltime.elapsed();
+    double const rate = (num_threads * iterations) / duration;
+
+    if (csv)
+    {
+        hpx::cout << (boost::format("%1%,%2%,%3%,%4%,%5%\n")
+                % name % num_threads % read_percentage % duration % rate)
+            << hpx::flush;
+    }
+    else
+    {
+        hpx::cout << (boost::format("%1%: %2% threads, %3%%% reads, "
+                "%4% s, %5% critical sections/s\n")
+                % name % num_threads % read_percentage % duration % rate)
+            << hpx::flush;
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(variables_map& vm)
+{
+    iterations = vm["iterations"].as<boost::uint64_t>();
+    read_percentage = vm["read-percentage"].as<std::size_t>();
+    work = vm["work"].as<std::size_t>();
+
+    std::size_t num_threads = vm["threads"].as<std::size_t>();
+    if (num_threads == 0)
+        num_threads = 4 * hpx::get_os_thread_count();
+
+    std::string const locks = vm["locks"].as<std::string>();
+    bool const csv = vm.count("csv") != 0;
+
+    if (locks == "all" || locks == "spinlock")
+        measure<hpx::lcos::local::spinlock>("spinlock", num_threads, csv);
+    if (locks == "all" || locks == "mutex")
+        measure<hpx::lcos::local::mutex>("mutex", num_threads, csv);
+    if (locks == "all" || locks == "mcs_lock")
+        measure<hpx::lcos::local::mcs_lock>("mcs_lock", num_threads, csv);
+    if (locks == "all" || locks == "cohort_lock")
+        measure<hpx::lcos::local::cohort_lock>("cohort_lock", num_threads, csv);
+    if (locks == "all" || locks == "shared_mutex")
+    {
+        measure<hpx::lcos::local::shared_mutex>("shared_mutex",
+            num_threads, csv);
+    }
+    if (locks == "all" || locks == "distributed_shared_mutex")
+    {
+        measure<hpx::lcos::local::distributed_shared_mutex>(
+            "distributed_shared_mutex", num_threads, csv);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Configure application-specific options.
+    options_description cmdline("usage: " HPX_APPLICATION_STRING " [options]");
+
+    cmdline.add_options()
+        ( "iterations"
+        , value<boost::uint64_t>()->default_value(10000)
+        , "number of critical sections executed by each thread")
+
+        ( "threads"
+        , value<std::size_t>()->default_value(0)
+        , "number of HPX threads (default: 4 per worker thread)")
+
+        ( "read-percentage"
+        , value<std::size_t>()->default_value(90)
+        , "percentage of critical sections which only read the data")
+
+        ( "work"
+        , value<std::size_t>()->default_value(16)
+        , "number of data elements accessed in each critical section")
+
+        ( "locks"
+        , value<std::string>()->default_value("all")
+        , "the lock to measure (spinlock, mutex, mcs_lock, cohort_lock, "
+          "shared_mutex, distributed_shared_mutex, or all)")
+
+        ( "csv"
+        , "output results as csv (format: lock,threads,reads,duration,rate)")
+        ;
+
+    // Initialize and run HPX.
+    return hpx::init(cmdline, argc, argv);
+}
@@ -23,6 +23,7 @@
 #include <hpx/util/safe_lexical_cast.hpp>
 
 #include <hpx/parallel/util/numa_allocator.hpp>
+#include <hpx/parallel/util/numa_first_touch_allocator.hpp>
 
 #include <boost/format.hpp>
 #include <boost/range/functions.hpp>
@@ -375,6 +376,87 @@ std::pair<std::size_t, std::size_t> get_num_numa_pus(
     return std::make_pair(numa_pus, pus);
 }
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename Vector>
+void print_results(std::size_t iterations, std::size_t vector_size,
+    std::size_t numa_nodes, double time_total,
+    std::vector<std::vector<std::vector<double> > > const& timings_all,
+    Vector& a, Vector& b, Vector& c)
+{
+    /* --- SUMMARY --- */
+    const char *label[4] = {
+        "Copy:      ",
+        "Scale:     ",
+        "Add:       ",
+        "Triad:     "
+    };
+
+    const double bytes[4] = {
+        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
+        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
+        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
+        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size)
+    };
+    std::vector<std::vector<double> > timing(4, std::vector<double>(iterations, 0.0));
+
+    for(auto const & times : timings_all)
+    {
+        for(std::size_t iteration = 0; iteration != iterations; ++iteration)
+        {
+            timing[0][iteration] += times[0][iteration];
+            timing[1][iteration] += times[1][iteration];
+            timing[2][iteration] += times[2][iteration];
+            timing[3][iteration] += times[3][iteration];
+        }
+    }
+    for(std::size_t iteration = 0; iteration != iterations; ++iteration)
+    {
+        timing[0][iteration] /= numa_nodes;
+        timing[1][iteration] /= numa_nodes;
+        timing[2][iteration] /= numa_nodes;
+        timing[3][iteration] /= numa_nodes;
+    }
+    // Note: skip first iteration
+    std::vector<double> avgtime(4, 0.0);
+    std::vector<double> mintime(4, (std::numeric_limits<double>::max)());
+    std::vector<double> maxtime(4, 0.0);
+    for(std::size_t iteration = 1; iteration != iterations; ++iteration)
+    {
+        for (std::size_t j=0; j<4; j++)
+        {
+            avgtime[j] = avgtime[j] + timing[j][iteration];
+            mintime[j] = (std::min)(mintime[j], timing[j][iteration]);
+            maxtime[j] = (std::max)(maxtime[j], timing[j][iteration]);
+        }
+    }
+
+    printf("Function    Best Rate MB/s  Avg time     Min time     Max time\n");
+    for (std::size_t j=0; j<4; j++) {
+        avgtime[j] = avgtime[j]/(double)(iterations-1);
+
+        printf("%s%12.1f  %11.6f  %11.6f  %11.6f\n", label[j],
+           1.0E-06 * bytes[j]/mintime[j],
+           avgtime[j],
+           mintime[j],
+           maxtime[j]);
+    }
+
+    std::cout
+        << "\nTotal time: " << time_total
+        << " (per iteration: " << time_total/iterations << ")\n";
+
+    std::cout
+        << "-------------------------------------------------------------\n"
+        ;
+
+    // Check Results ...
+    check_results(iterations, a, b, c);
+
+    std::cout
+        << "-------------------------------------------------------------\n"
+        ;
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -420,6 +502,37 @@ int hpx_main(boost::program_options::variables_map& vm)
 
     using namespace hpx::parallel;
 
+    if (vm["executor"].as<std::string>() == "numa")
+    {
+        // a single executor spanning all requested NUMA domains, the data is
+        // first touched using the same chunk to domain mapping as is used by
+        // the algorithms later on
+        numa_executor exec(numa_nodes);
+
+        typedef hpx::parallel::util::numa_first_touch_allocator<STREAM_TYPE>
+            allocator_type;
+        allocator_type alloc(exec);
+
+        typedef std::vector<STREAM_TYPE, allocator_type> vector_type;
+        vector_type a(vector_size, STREAM_TYPE(), alloc);
+        vector_type b(vector_size, STREAM_TYPE(), alloc);
+        vector_type c(vector_size, STREAM_TYPE(), alloc);
+
+        // perform benchmark
+        hpx::lcos::local::latch l(1);
+
+        double time_total = mysecond();
+        std::vector<std::vector<std::vector<double> > > timings_all;
+        timings_all.push_back(numa_domain_worker(0, par.on(exec), l,
+            vector_size, 0, iterations, a, b, c));
+        time_total = mysecond() - time_total;
+
+        print_results(iterations, vector_size, 1, time_total,
+            timings_all, a, b, c);
+
+        return hpx::finalize();
+    }
+
     typedef hpx::threads::executors::local_priority_queue_attached_executor
         executor_type;
     typedef std::vector<executor_type> executors_vector;
@@ -503,78 +616,9 @@ int hpx_main(boost::program_options::variables_map& vm)
         timings_all = hpx::util::unwrapped(workers);
     time_total = mysecond() - time_total;
 
-    /* --- SUMMARY --- */
-    const char *label[4] = {
-        "Copy:      ",
-        "Scale:     ",
-        "Add:       ",
-        "Triad:     "
-    };
-
-    const double bytes[4] = {
-        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
-        2 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
-        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size),
-        3 * sizeof(STREAM_TYPE) * static_cast<double>(vector_size)
-    };
-    std::vector<std::vector<double> > timing(4, std::vector<double>(iterations, 0.0));
+    print_results(iterations, vector_size, numa_nodes, time_total,
+        timings_all, a, b, c);
 
-    for(auto const & times : timings_all)
-    {
-        for(std::size_t iteration = 0; iteration != iterations; ++iteration)
-        {
-            timing[0][iteration] += times[0][iteration];
-            timing[1][iteration] += times[1][iteration];
-            timing[2][iteration] += times[2][iteration];
-            timing[3][iteration] += times[3][iteration];
-        }
-    }
-    for(std::size_t iteration = 0; iteration != iterations; ++iteration)
-    {
-        timing[0][iteration] /= numa_nodes;
-        timing[1][iteration] /= numa_nodes;
-        timing[2][iteration] /= numa_nodes;
-        timing[3][iteration] /= numa_nodes;
-    }
-    // Note: skip first iteration
-    std::vector<double> avgtime(4, 0.0);
-    std::vector<double> mintime(4, (std::numeric_limits<double>::max)());
-    std::vector<double> maxtime(4, 0.0);
-    for(std::size_t iteration = 1; iteration != iterations; ++iteration)
-    {
-        for (std::size_t j=0; j<4; j++)
-        {
-            avgtime[j] = avgtime[j] + timing[j][iteration];
-            mintime[j] = (std::min)(mintime[j], timing[j][iteration]);
-            maxtime[j] = (std::max)(maxtime[j], timing[j][iteration]);
-        }
-    }
-
-    printf("Function    Best Rate MB/s  Avg time     Min time     Max time\n");
-    for (std::size_t j=0; j<4; j++) {
-        avgtime[j] = avgtime[j]/(double)(iterations-1);
-
-        printf("%s%12.1f  %11.6f  %11.6f  %11.6f\n", label[j],
-           1.0E-06 * bytes[j]/mintime[j],
-           avgtime[j],
-           mintime[j],
-           maxtime[j]);
-    }
-
-    std::cout
-        << "\nTotal time: " << time_total
-        << " (per iteration: " << time_total/iterations << ")\n";
-
-    std::cout
-        << "-------------------------------------------------------------\n"
-        ;
-
-    // Check Results ...
-    check_results(iterations, a, b, c);
-
-    std::cout
-        << "-------------------------------------------------------------\n"
-        ;
 
     return hpx::finalize();
 }
@@ -612,6 +656,12 @@ int main(int argc, char* argv[])
             boost::program_options::value<std::string>()->default_value("default"),
             "Which chunker to use for the parallel algorithms. "
             "possible values: dynamic, auto, guided. (default: default)")
+        (   "executor",
+            boost::program_options::value<std::string>()->default_value("attached"),
+            "Which executor to use for the parallel algorithms. "
+            "possible values: attached (one executor per NUMA domain), "
+            "numa (a single numa_executor, implies static chunking). "
+            "(default: attached)")
         ;
 
     // parse command line here to extract the necessary settings for HPX
@@ -0,0 +1,219 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct test_server
+  : hpx::components::simple_component_base<test_server>
+{
+    test_server() : value_(0) {}
+    explicit test_server(std::size_t value) : value_(value) {}
+
+    std::size_t get_value() const
+    {
+        return value_;
+    }
+
+    boost::uint64_t get_lva() const
+    {
+        return reinterpret_cast<boost::uint64_t>(this);
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, get_value, get_value_action);
+    HPX_DEFINE_COMPONENT_ACTION(test_server, get_lva, get_lva_action);
+
+    std::size_t value_;
+};
+
+typedef hpx::components::simple_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::get_value_action get_value_action;
+HPX_REGISTER_ACTION_DECLARATION(get_value_action);
+HPX_REGISTER_ACTION(get_value_action);
+
+typedef test_server::get_lva_action get_lva_action;
+HPX_REGISTER_ACTION_DECLARATION(get_lva_action);
+HPX_REGISTER_ACTION(get_lva_action);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_bulk_create(std::size_t count)
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // all objects created on a locality are bound using one request
+    std::vector<hpx::id_type> ids;
+    for (hpx::id_type const& locality : localities)
+    {
+        std::vector<hpx::id_type> objs =
+            hpx::new_<test_server[]>(locality, count, count).get();
+        HPX_TEST_EQ(objs.size(), count);
+
+        ids.insert(ids.end(), objs.begin(), objs.end());
+    }
+
+    for (hpx::id_type const& id : ids)
+        HPX_TEST_EQ(get_value_action()(id), count);
+
+    // resolve all objects at once
+    std::vector<hpx::naming::address> addrs = hpx::agas::resolve(ids).get();
+    HPX_TEST_EQ(addrs.size(), ids.size());
+
+    for (std::size_t i = 0; i != ids.size(); ++i)
+    {
+        HPX_TEST_EQ(addrs[i].locality_,
+            localities[i / count].get_gid());
+        HPX_TEST_EQ(addrs[i].type_,
+            hpx::components::get_component_type<test_server>());
+        HPX_TEST_EQ(addrs[i].address_, get_lva_action()(ids[i]));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// A bulk bind request which fails part way must not leave any of the
+// bindings it created before the failure behind.
+void test_bulk_bind_failure()
+{
+    using hpx::naming::gid_type;
+    using hpx::naming::id_type;
+
+    std::size_t values[3] = { 0, 0, 0 };
+    hpx::components::component_type const type =
+        hpx::components::get_component_type<test_server>();
+
+    gid_type const lower = hpx::detail::get_next_id(3);
+
+    // bind the last two ids as a single range, binding one of them on its
+    // own fails
+    hpx::naming::address range_addr(hpx::get_locality(), type, &values[1]);
+    HPX_TEST(hpx::naming::get_agas_client().bind_range_local(
+        lower + 1, 2, range_addr, sizeof(std::size_t)));
+
+    std::vector<gid_type> gids;
+    std::vector<hpx::naming::address> addrs;
+    for (std::size_t i = 0; i != 3; ++i)
+    {
+        gids.push_back(lower + i);
+        addrs.push_back(
+            hpx::naming::address(hpx::get_locality(), type, &values[i]));
+    }
+
+    std::vector<bool> bound = hpx::agas::bind(gids, addrs).get();
+    HPX_TEST_EQ(bound.size(), std::size_t(3));
+    for (std::size_t i = 0; i != bound.size(); ++i)
+        HPX_TEST(!bound[i]);
+
+    // the first id was bound before the failure and has been unbound again
+    hpx::future<hpx::naming::address> f =
+        hpx::agas::resolve(id_type(lower, id_type::unmanaged));
+    f.wait();
+    HPX_TEST(f.has_exception());
+
+    // the existing range is left untouched
+    HPX_TEST_EQ(
+        hpx::agas::resolve(id_type(lower + 1, id_type::unmanaged))
+            .get().address_,
+        reinterpret_cast<hpx::naming::address::address_type>(&values[1]));
+
+    hpx::agas::unbind(lower + 1, 2).get();
+}
+
+// Ids bound before the bulk request, including the one whose request
+// fails, must not be unbound because of the failure.
+void test_bulk_bind_existing_failure()
+{
+    using hpx::naming::gid_type;
+    using hpx::naming::id_type;
+
+    std::size_t values[4] = { 0, 0, 0, 0 };
+    std::size_t existing[2] = { 0, 0 };
+    hpx::components::component_type const type =
+        hpx::components::get_component_type<test_server>();
+
+    gid_type const lower = hpx::detail::get_next_id(4);
+
+    // the second and the third id are bound already
+    for (std::size_t i = 0; i != 2; ++i)
+    {
+        HPX_TEST(hpx::naming::get_agas_client().bind_local(lower + i + 1,
+            hpx::naming::address(hpx::get_locality(), type, &existing[i])));
+    }
+
+    // updating the binding of the third id with an invalid type fails
+    std::vector<gid_type> gids;
+    std::vector<hpx::naming::address> addrs;
+    for (std::size_t i = 0; i != 4; ++i)
+    {
+        gids.push_back(lower + i);
+        addrs.push_back(hpx::naming::address(hpx::get_locality(),
+            i == 2 ? hpx::components::component_invalid : type,
+            &values[i]));
+    }
+
+    std::vector<bool> bound = hpx::agas::bind(gids, addrs).get();
+    HPX_TEST_EQ(bound.size(), std::size_t(4));
+    HPX_TEST(!bound[0]);
+    HPX_TEST(bound[1]);
+    HPX_TEST(!bound[2]);
+    HPX_TEST(!bound[3]);
+
+    // the new binding of the first id has been removed again
+    hpx::future<hpx::naming::address> f =
+        hpx::agas::resolve(id_type(lower, id_type::unmanaged));
+    f.wait();
+    HPX_TEST(f.has_exception());
+
+    // the existing binding of the second id has been updated
+    HPX_TEST_EQ(
+        hpx::agas::resolve(id_type(lower + 1, id_type::unmanaged))
+            .get().address_,
+        reinterpret_cast<hpx::naming::address::address_type>(&values[1]));
+
+    // the existing binding of the failing id is left untouched
+    HPX_TEST_EQ(
+        hpx::agas::resolve(id_type(lower + 2, id_type::unmanaged))
+            .get().address_,
+        reinterpret_cast<hpx::naming::address::address_type>(&existing[1]));
+
+    // the request following the failing one has not been applied
+    f = hpx::agas::resolve(id_type(lower + 3, id_type::unmanaged));
+    f.wait();
+    HPX_TEST(f.has_exception());
+
+    hpx::agas::unbind(lower + 1, 1).get();
+    hpx::agas::unbind(lower + 2, 1).get();
+}
+
+int hpx_main()
+{
+    test_bulk_create(1);
+    test_bulk_create(100);
+
+    test_bulk_bind_failure();
+    test_bulk_bind_existing_failure();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
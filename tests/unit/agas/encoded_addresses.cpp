@@ -0,0 +1,159 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/components.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> alive_count(0);
+
+struct test_server
+  : hpx::components::simple_component_base<test_server>
+{
+    test_server() { ++alive_count; }
+    ~test_server() { --alive_count; }
+
+    boost::uint64_t get_lva() const
+    {
+        return reinterpret_cast<boost::uint64_t>(this);
+    }
+
+    HPX_DEFINE_COMPONENT_ACTION(test_server, get_lva, get_lva_action);
+};
+
+typedef hpx::components::simple_component<test_server> server_type;
+HPX_REGISTER_COMPONENT(server_type, test_server);
+
+typedef test_server::get_lva_action get_lva_action;
+HPX_REGISTER_ACTION_DECLARATION(get_lva_action);
+HPX_REGISTER_ACTION(get_lva_action);
+
+///////////////////////////////////////////////////////////////////////////////
+std::size_t get_alive_count()
+{
+    return alive_count.load();
+}
+HPX_PLAIN_ACTION(get_alive_count, get_alive_count_action);
+
+bool wait_for_alive_count(hpx::id_type const& locality, std::size_t count)
+{
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        hpx::agas::garbage_collect();
+        if (get_alive_count_action()(locality) == count)
+            return true;
+
+        hpx::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_encoded_address(hpx::id_type const& locality)
+{
+    std::size_t const count = get_alive_count_action()(locality);
+
+    {
+        hpx::id_type id = hpx::new_<test_server>(locality).get();
+
+        // the id of a non-migratable object encodes its address
+        HPX_TEST(hpx::naming::detail::is_encoded_address(id.get_gid()));
+        HPX_TEST_EQ(hpx::naming::get_locality_id_from_id(id),
+            hpx::naming::get_locality_id_from_id(locality));
+
+        // the id is resolved correctly, remote ids are resolved by the
+        // owning locality
+        hpx::naming::address addr = hpx::agas::resolve(id).get();
+        HPX_TEST_EQ(addr.address_, get_lva_action()(id));
+        HPX_TEST_EQ(addr.locality_, locality.get_gid());
+        HPX_TEST_EQ(addr.type_,
+            hpx::components::get_component_type<test_server>());
+
+        HPX_TEST_EQ(get_alive_count_action()(locality), count + 1);
+    }
+
+    // releasing the last reference destroys the object
+    HPX_TEST(wait_for_alive_count(locality, count));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+bool invoke_fails(hpx::id_type const& id)
+{
+    try {
+        get_lva_action()(id);
+    }
+    catch (hpx::exception const&) {
+        return true;
+    }
+    return false;
+}
+
+void test_destroyed_object(hpx::id_type const& locality)
+{
+    std::size_t const count = get_alive_count_action()(locality);
+
+    hpx::id_type unmanaged;
+    {
+        hpx::id_type id = hpx::new_<test_server>(locality).get();
+        HPX_TEST(hpx::naming::detail::is_encoded_address(id.get_gid()));
+
+        unmanaged = hpx::id_type(
+            hpx::naming::detail::get_stripped_gid(id.get_gid()),
+            hpx::id_type::unmanaged);
+        HPX_TEST(!invoke_fails(unmanaged));
+    }
+    HPX_TEST(wait_for_alive_count(locality, count));
+
+    // an id referring to a destroyed object can't be used anymore
+    HPX_TEST(invoke_fails(unmanaged));
+
+    // not even if a new object reuses the memory of the destroyed object
+    std::vector<hpx::id_type> ids;
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        ids.push_back(hpx::new_<test_server>(locality).get());
+        HPX_TEST(ids.back() != unmanaged);
+        HPX_TEST(!invoke_fails(ids.back()));
+    }
+    HPX_TEST(invoke_fails(unmanaged));
+
+    ids.clear();
+    HPX_TEST(wait_for_alive_count(locality, count));
+}
+
+int hpx_main()
+{
+    for (hpx::id_type const& locality : hpx::find_all_localities())
+    {
+        test_encoded_address(locality);
+        test_destroyed_object(locality);
+    }
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.agas.use_address_encoding=1");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
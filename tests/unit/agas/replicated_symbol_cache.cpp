@@ -0,0 +1,97 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/actions.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/runtime.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/chrono.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::id_type resolve_name(std::string const& name)
+{
+    return hpx::agas::resolve_name(name).get();
+}
+HPX_PLAIN_ACTION(resolve_name, resolve_name_action);
+
+// resolve the name on the given locality until it has been invalidated
+bool wait_for_invalidation(hpx::id_type const& locality, std::string const& name)
+{
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        if (!resolve_name_action()(locality, name))
+            return true;
+
+        hpx::this_thread::sleep_for(boost::chrono::milliseconds(10));
+    }
+    return false;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_replicated_symbol(std::string const& name)
+{
+    hpx::id_type here = hpx::find_here();
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    // the name is not registered yet, failed lookups are not replicated
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        for (hpx::id_type const& locality : localities)
+            HPX_TEST(!resolve_name_action()(locality, name));
+    }
+
+    HPX_TEST(hpx::agas::register_name(name, here).get());
+
+    // concurrent lookups on every locality resolve to the same id
+    std::vector<hpx::future<hpx::id_type> > ids;
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        for (hpx::id_type const& locality : localities)
+            ids.push_back(hpx::async<resolve_name_action>(locality, name));
+    }
+
+    for (hpx::future<hpx::id_type>& f : ids)
+        HPX_TEST_EQ(f.get(), here);
+
+    // unregistering the name invalidates the replicas on all localities
+    HPX_TEST_EQ(hpx::agas::unregister_name(name).get(), here);
+
+    for (hpx::id_type const& locality : localities)
+        HPX_TEST(wait_for_invalidation(locality, name));
+
+    // registering the name again is visible everywhere
+    HPX_TEST(hpx::agas::register_name(name, here).get());
+
+    for (hpx::id_type const& locality : localities)
+        HPX_TEST_EQ(resolve_name_action()(locality, name), here);
+
+    HPX_TEST_EQ(hpx::agas::unregister_name(name).get(), here);
+}
+
+int hpx_main()
+{
+    test_replicated_symbol("/replicated_symbol_cache_test/0");
+    test_replicated_symbol("/replicated_symbol_cache_test/1");
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.agas.use_symbol_caching=1");
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
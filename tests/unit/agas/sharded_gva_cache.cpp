@@ -0,0 +1,166 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/async.hpp>
+#include <hpx/lcos/wait_all.hpp>
+#include <hpx/runtime/agas/detail/sharded_gva_cache.hpp>
+#include <hpx/runtime/agas/gva.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <vector>
+
+using hpx::agas::gva;
+using hpx::agas::detail::sharded_gva_cache;
+using hpx::naming::gid_type;
+
+///////////////////////////////////////////////////////////////////////////////
+gid_type make_gid(boost::uint64_t i)
+{
+    return gid_type(hpx::naming::get_gid_from_locality_id(1).get_msb() | 1,
+        i + 1);
+}
+
+gva make_gva(boost::uint64_t i)
+{
+    return gva(hpx::naming::get_gid_from_locality_id(1),
+        hpx::components::component_base_lco_with_value, 1,
+        reinterpret_cast<void*>(static_cast<std::size_t>(i + 1) * 8));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_insert_lookup_erase()
+{
+    sharded_gva_cache cache(1024);
+
+    for (boost::uint64_t i = 0; i != 100; ++i)
+        HPX_TEST(cache.insert(make_gid(i), make_gva(i)));
+    HPX_TEST_EQ(cache.size(), std::size_t(100));
+
+    // existing entries are left unchanged
+    HPX_TEST(!cache.insert(make_gid(0), make_gva(1)));
+
+    // updating replaces existing entries
+    HPX_TEST(!cache.update(make_gid(1), make_gva(2)));
+    HPX_TEST_EQ(cache.updates(false), boost::uint64_t(1));
+    {
+        gva g;
+        HPX_TEST(cache.get_entry(make_gid(1), g));
+        HPX_TEST_EQ(g, make_gva(2));
+    }
+    HPX_TEST(!cache.update(make_gid(1), make_gva(1)));
+
+    for (boost::uint64_t i = 0; i != 100; ++i)
+    {
+        gva g;
+        HPX_TEST(cache.get_entry(make_gid(i), g));
+        HPX_TEST_EQ(g, make_gva(i));
+    }
+
+    // updating inserts missing entries
+    HPX_TEST(cache.update(make_gid(100), make_gva(100)));
+    HPX_TEST(cache.erase(make_gid(100)));
+
+    gva g;
+    HPX_TEST(!cache.get_entry(make_gid(100), g));
+
+    HPX_TEST_EQ(cache.hits(false), boost::uint64_t(101));
+    HPX_TEST_EQ(cache.misses(false), boost::uint64_t(1));
+    HPX_TEST_EQ(cache.lookups(false), boost::uint64_t(102));
+    HPX_TEST_EQ(cache.insertions(false), boost::uint64_t(101));
+
+    // insertions and calls to insert/update are counted separately
+    HPX_TEST_EQ(cache.insert_entry_count(true), boost::uint64_t(104));
+    HPX_TEST_EQ(cache.insert_entry_count(false), boost::uint64_t(0));
+    HPX_TEST_EQ(cache.insertions(false), boost::uint64_t(101));
+
+    // a lookup which is not counted as a miss
+    HPX_TEST(!cache.get_entry(make_gid(100), g, false));
+    HPX_TEST_EQ(cache.misses(false), boost::uint64_t(1));
+
+    HPX_TEST(cache.erase(make_gid(42)));
+    HPX_TEST(!cache.erase(make_gid(42)));
+    HPX_TEST(!cache.get_entry(make_gid(42), g));
+    HPX_TEST_EQ(cache.size(), std::size_t(99));
+    HPX_TEST_EQ(cache.erasures(true), boost::uint64_t(2));
+    HPX_TEST_EQ(cache.erasures(false), boost::uint64_t(0));
+
+    cache.clear();
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+    HPX_TEST(!cache.get_entry(make_gid(0), g));
+}
+
+void test_eviction()
+{
+    sharded_gva_cache cache(64);
+    std::size_t const capacity = cache.capacity();
+
+    std::size_t const count = 4 * capacity;
+    for (boost::uint64_t i = 0; i != count; ++i)
+        HPX_TEST(cache.insert(make_gid(i), make_gva(i)));
+
+    HPX_TEST(cache.size() <= capacity);
+    HPX_TEST_EQ(cache.evictions(false) + cache.size(), count);
+
+    // reserving the current capacity keeps all entries
+    std::size_t const size = cache.size();
+    cache.reserve(capacity);
+    HPX_TEST_EQ(cache.capacity(), capacity);
+    HPX_TEST_EQ(cache.size(), size);
+
+    // resizing drops all entries
+    cache.reserve(2 * capacity);
+    HPX_TEST_EQ(cache.capacity(), 2 * capacity);
+    HPX_TEST_EQ(cache.size(), std::size_t(0));
+}
+
+void test_concurrent_access()
+{
+    sharded_gva_cache cache(256);
+
+    std::size_t const num_tasks = 8;
+    boost::uint64_t const num_entries = 1000;
+
+    std::vector<hpx::future<void> > tasks;
+    tasks.reserve(num_tasks);
+    for (std::size_t t = 0; t != num_tasks; ++t)
+    {
+        tasks.push_back(hpx::async(
+            [&cache, t, num_entries]()
+            {
+                for (boost::uint64_t i = 0; i != num_entries; ++i)
+                {
+                    boost::uint64_t const id = (i * (t + 1)) % num_entries;
+
+                    // a lookup returns either nothing or the correct entry
+                    gva g;
+                    if (cache.get_entry(make_gid(id), g))
+                        HPX_TEST_EQ(g, make_gva(id));
+                    else
+                        cache.insert(make_gid(id), make_gva(id));
+
+                    if (i % 7 == t)
+                        cache.erase(make_gid(id));
+                }
+            }));
+    }
+    hpx::wait_all(tasks);
+
+    HPX_TEST(cache.size() <= cache.capacity());
+    HPX_TEST_EQ(cache.lookups(false), num_tasks * num_entries);
+}
+
+int main()
+{
+    test_insert_lookup_erase();
+    test_eviction();
+    test_concurrent_access();
+
+    return hpx::util::report_errors();
+}
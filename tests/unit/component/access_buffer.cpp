@@ -0,0 +1,161 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/unordered_map.hpp>
+#include <hpx/util/function.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the container types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_UNORDERED_MAP(std::string, double);
+
+///////////////////////////////////////////////////////////////////////////////
+// The update function has to be serializable to be sent to remote partitions.
+struct add_value
+{
+    add_value() : value_(0) {}
+    explicit add_value(double value) : value_(value) {}
+
+    void operator()(double& v) const
+    {
+        v += value_;
+    }
+
+    template <typename Archive>
+    void serialize(Archive& ar, unsigned)
+    {
+        ar & value_;
+    }
+
+    double value_;
+};
+
+HPX_UTIL_REGISTER_FUNCTION_DECLARATION(void(double&), add_value,
+    add_value_function);
+HPX_UTIL_REGISTER_FUNCTION(void(double&), add_value, add_value_function);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename DistPolicy>
+void partitioned_vector_tests(std::size_t size, DistPolicy const& policy)
+{
+    typedef hpx::partitioned_vector<double> vector_type;
+
+    vector_type v(size, policy);
+
+    {
+        hpx::access_buffer<vector_type> buffer(v);
+
+        // writes
+        std::vector<hpx::shared_future<void> > writes;
+        for (std::size_t i = 0; i != size; ++i)
+            writes.push_back(buffer.set(i, double(i)));
+        HPX_TEST_EQ(buffer.pending(), size);
+
+        buffer.flush().get();
+        HPX_TEST_EQ(buffer.pending(), std::size_t(0));
+
+        hpx::wait_all(writes);
+        for (std::size_t i = 0; i != size; ++i)
+            HPX_TEST_EQ(v.get_value_sync(i), double(i));
+
+        // reads are applied after the updates of the same flush
+        std::vector<hpx::future<double> > reads;
+        for (std::size_t i = 0; i != size; ++i)
+        {
+            buffer.update(i, add_value(1.0));
+            buffer.update(i, add_value(1.0));
+            reads.push_back(buffer.get(i));
+        }
+        buffer.flush();
+
+        for (std::size_t i = 0; i != size; ++i)
+            HPX_TEST_EQ(reads[i].get(), double(i + 2));
+    }
+
+    // automatic flushing
+    {
+        hpx::access_buffer<vector_type> buffer(v, 10);
+
+        std::vector<hpx::shared_future<void> > updates;
+        for (std::size_t i = 0; i != size; ++i)
+            updates.push_back(buffer.update(i, add_value(1.0)));
+        HPX_TEST(buffer.pending() < 10);
+
+        buffer.flush();
+        hpx::wait_all(updates);
+    }
+
+    for (std::size_t i = 0; i != size; ++i)
+        HPX_TEST_EQ(v.get_value_sync(i), double(i + 3));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename DistPolicy>
+void unordered_map_tests(DistPolicy const& policy)
+{
+    typedef hpx::unordered_map<std::string, double> map_type;
+
+    map_type m(policy);
+
+    {
+        hpx::access_buffer<map_type> buffer(m);
+
+        // updates insert missing elements
+        for (std::size_t i = 0; i != 1000; ++i)
+            buffer.update(std::to_string(i % 10), add_value(1.0));
+        buffer.set(std::string("42"), 42.0);
+
+        std::vector<hpx::future<double> > reads;
+        for (std::size_t i = 0; i != 10; ++i)
+            reads.push_back(buffer.get(std::to_string(i)));
+        hpx::future<double> f = buffer.get(std::string("42"));
+
+        buffer.flush().get();
+
+        for (std::size_t i = 0; i != 10; ++i)
+            HPX_TEST_EQ(reads[i].get(), 100.0);
+        HPX_TEST_EQ(f.get(), 42.0);
+        HPX_TEST_EQ(m.size(), std::size_t(11));
+
+        // reading a missing element reports an error for this read only
+        hpx::shared_future<void> written = buffer.set(std::string("43"), 43.0);
+        f = buffer.get(std::string("missing"));
+        hpx::future<double> g = buffer.get(std::string("42"));
+        buffer.flush();
+
+        f.wait();
+        HPX_TEST(f.has_exception());
+        HPX_TEST_EQ(g.get(), 42.0);
+
+        written.wait();
+        HPX_TEST(!written.has_exception());
+        HPX_TEST_EQ(m.get_value_sync(std::string("43")), 43.0);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    std::vector<hpx::id_type> localities = hpx::find_all_localities();
+
+    partitioned_vector_tests(107, hpx::container_layout);
+    partitioned_vector_tests(107, hpx::container_layout(3));
+    partitioned_vector_tests(107, hpx::container_layout(3, localities));
+    partitioned_vector_tests(107, hpx::container_layout(localities));
+
+    unordered_map_tests(hpx::container_layout);
+    unordered_map_tests(hpx::container_layout(3, localities));
+    unordered_map_tests(hpx::container_layout(localities));
+
+    return 0;
+}
@@ -0,0 +1,93 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_fill.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v, T const& val)
+{
+    typedef typename hpx::partitioned_vector<T>::const_iterator const_iterator;
+
+    std::size_t size = 0;
+
+    const_iterator end = v.end();
+    for (const_iterator it = v.begin(); it != end; ++it, ++size)
+    {
+        HPX_TEST_EQ(*it, val);
+    }
+
+    HPX_TEST_EQ(size, v.size());
+}
+
+template <typename ExPolicy, typename T>
+void test_fill(ExPolicy && policy, hpx::partitioned_vector<T>& v, T val)
+{
+    hpx::parallel::fill(policy, v.begin(), v.end(), val);
+    verify_values(v, val);
+}
+
+template <typename ExPolicy, typename T>
+void test_fill_async(ExPolicy && policy, hpx::partitioned_vector<T>& v, T val)
+{
+    hpx::parallel::fill(policy, v.begin(), v.end(), val).get();
+    verify_values(v, val);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void fill_tests(hpx::partitioned_vector<T>& v)
+{
+    test_fill(hpx::parallel::seq, v, T(1));
+    test_fill(hpx::parallel::par, v, T(2));
+    test_fill_async(hpx::parallel::seq(hpx::parallel::task), v, T(3));
+    test_fill_async(hpx::parallel::par(hpx::parallel::task), v, T(4));
+}
+
+template <typename T>
+void fill_tests()
+{
+    std::size_t const length = 12;
+
+    {
+        hpx::partitioned_vector<T> v;
+        hpx::parallel::fill(hpx::parallel::seq, v.begin(), v.end(), T(1));
+        hpx::parallel::fill(hpx::parallel::par, v.begin(), v.end(), T(1));
+        hpx::parallel::fill(hpx::parallel::seq(hpx::parallel::task),
+            v.begin(), v.end(), T(1)).get();
+        hpx::parallel::fill(hpx::parallel::par(hpx::parallel::task),
+            v.begin(), v.end(), T(1)).get();
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0));
+        fill_tests(v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0), hpx::container_layout(3));
+        fill_tests(v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    fill_tests<int>();
+    fill_tests<double>();
+
+    return 0;
+}
@@ -0,0 +1,72 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <functional>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void reduce_tests(std::size_t num, hpx::partitioned_vector<T> const& v)
+{
+    using hpx::parallel::reduce;
+    using hpx::parallel::seq;
+    using hpx::parallel::par;
+    using hpx::parallel::task;
+
+    // the initial value has to be taken into account exactly once
+    HPX_TEST_EQ(reduce(seq, v.begin(), v.end(), T(42), std::plus<T>()),
+        T(num + 42));
+    HPX_TEST_EQ(reduce(par, v.begin(), v.end(), T(42), std::plus<T>()),
+        T(num + 42));
+    HPX_TEST_EQ(reduce(seq(task), v.begin(), v.end(), T(42)).get(),
+        T(num + 42));
+    HPX_TEST_EQ(reduce(par(task), v.begin(), v.end(), T(42)).get(),
+        T(num + 42));
+
+    HPX_TEST_EQ(reduce(seq, v.begin(), v.end()), T(num));
+    HPX_TEST_EQ(reduce(par, v.begin(), v.end()), T(num));
+}
+
+template <typename T>
+void reduce_tests()
+{
+    std::size_t const num = 10007;
+
+    {
+        hpx::partitioned_vector<T> v;
+        HPX_TEST_EQ(hpx::parallel::reduce(hpx::parallel::par,
+            v.begin(), v.end(), T(42)), T(42));
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(1));
+        reduce_tests(num, v);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(num, T(1), hpx::container_layout(3));
+        reduce_tests(num, v);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    reduce_tests<int>();
+    reduce_tests<double>();
+
+    return 0;
+}
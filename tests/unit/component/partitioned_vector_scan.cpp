@@ -0,0 +1,160 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_scan.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void fill_vector(hpx::partitioned_vector<T>& v)
+{
+    typename hpx::partitioned_vector<T>::iterator it = v.begin(), end = v.end();
+    for (T val = T(1); it != end; ++it, val += T(1))
+        *it = val;
+}
+
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v,
+    std::vector<T> const& expected)
+{
+    typedef typename hpx::partitioned_vector<T>::const_iterator const_iterator;
+
+    HPX_TEST_EQ(v.size(), expected.size());
+
+    std::size_t i = 0;
+    const_iterator end = v.end();
+    for (const_iterator it = v.begin(); it != end; ++it, ++i)
+    {
+        HPX_TEST_EQ(*it, expected[i]);
+    }
+}
+
+template <typename ExPolicy, typename T>
+void test_inclusive_scan(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& in, hpx::partitioned_vector<T>& out,
+    std::vector<T> const& expected)
+{
+    auto r = hpx::parallel::inclusive_scan(policy, in.begin(), in.end(),
+        out.begin(), T(10), std::plus<T>());
+    HPX_TEST(r == out.end());
+    verify_values(out, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_exclusive_scan(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& in, hpx::partitioned_vector<T>& out,
+    std::vector<T> const& expected)
+{
+    auto r = hpx::parallel::exclusive_scan(policy, in.begin(), in.end(),
+        out.begin(), T(10), std::plus<T>());
+    HPX_TEST(r == out.end());
+    verify_values(out, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_inclusive_scan_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& in, hpx::partitioned_vector<T>& out,
+    std::vector<T> const& expected)
+{
+    auto r = hpx::parallel::inclusive_scan(policy, in.begin(), in.end(),
+        out.begin(), T(10), std::plus<T>()).get();
+    HPX_TEST(r == out.end());
+    verify_values(out, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_exclusive_scan_async(ExPolicy && policy,
+    hpx::partitioned_vector<T> const& in, hpx::partitioned_vector<T>& out,
+    std::vector<T> const& expected)
+{
+    auto r = hpx::parallel::exclusive_scan(policy, in.begin(), in.end(),
+        out.begin(), T(10), std::plus<T>()).get();
+    HPX_TEST(r == out.end());
+    verify_values(out, expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void scan_tests(hpx::partitioned_vector<T>& in,
+    hpx::partitioned_vector<T>& out)
+{
+    using hpx::parallel::seq;
+    using hpx::parallel::par;
+    using hpx::parallel::task;
+
+    fill_vector(in);
+
+    // the expected results, the input is 1, 2, 3, ...
+    std::vector<T> inclusive(in.size()), exclusive(in.size());
+    T sum = T(10);
+    for (std::size_t i = 0; i != in.size(); ++i)
+    {
+        exclusive[i] = sum;
+        sum += T(i + 1);
+        inclusive[i] = sum;
+    }
+
+    test_inclusive_scan(seq, in, out, inclusive);
+    test_inclusive_scan(par, in, out, inclusive);
+    test_inclusive_scan_async(seq(task), in, out, inclusive);
+    test_inclusive_scan_async(par(task), in, out, inclusive);
+
+    test_exclusive_scan(seq, in, out, exclusive);
+    test_exclusive_scan(par, in, out, exclusive);
+    test_exclusive_scan_async(seq(task), in, out, exclusive);
+    test_exclusive_scan_async(par(task), in, out, exclusive);
+}
+
+template <typename T>
+void scan_tests()
+{
+    std::size_t const length = 1007;
+
+    {
+        hpx::partitioned_vector<T> in(length, T(0));
+        hpx::partitioned_vector<T> out(length, T(0));
+        scan_tests(in, out);
+    }
+
+    {
+        hpx::partitioned_vector<T> in(length, T(0), hpx::container_layout(3));
+        hpx::partitioned_vector<T> out(length, T(0), hpx::container_layout(3));
+        scan_tests(in, out);
+    }
+
+    // ranges which are partitioned differently
+    {
+        hpx::partitioned_vector<T> in(length, T(0), hpx::container_layout(3));
+        hpx::partitioned_vector<T> out(length, T(0), hpx::container_layout(5));
+        scan_tests(in, out);
+    }
+
+    {
+        hpx::partitioned_vector<T> in(length, T(0));
+        hpx::partitioned_vector<T> out(length, T(0), hpx::container_layout(4));
+        scan_tests(in, out);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    scan_tests<int>();
+    scan_tests<double>();
+
+    return 0;
+}
@@ -0,0 +1,138 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_sort.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <cstdlib>
+#include <functional>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+std::vector<T> fill_vector(hpx::partitioned_vector<T>& v, int max_value)
+{
+    std::vector<T> values(v.size());
+    for (std::size_t i = 0; i != values.size(); ++i)
+        values[i] = T(std::rand() % max_value);
+
+    typename hpx::partitioned_vector<T>::iterator it = v.begin();
+    for (std::size_t i = 0; i != values.size(); ++i, ++it)
+        *it = values[i];
+
+    return values;
+}
+
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v,
+    std::vector<T> const& expected)
+{
+    typedef typename hpx::partitioned_vector<T>::const_iterator const_iterator;
+
+    HPX_TEST_EQ(v.size(), expected.size());
+
+    std::size_t i = 0;
+    const_iterator end = v.end();
+    for (const_iterator it = v.begin(); it != end; ++it, ++i)
+    {
+        HPX_TEST_EQ(*it, expected[i]);
+    }
+}
+
+// the elements are accessed through proxies, the default comparison can't be
+// deduced from them
+template <typename ExPolicy, typename T>
+void test_sort(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int max_value)
+{
+    std::vector<T> expected = fill_vector(v, max_value);
+    std::sort(expected.begin(), expected.end());
+
+    auto r = hpx::parallel::sort(policy, v.begin(), v.end(), std::less<T>());
+    HPX_TEST(r == v.end());
+    verify_values(v, expected);
+
+    // sort in descending order
+    std::sort(expected.begin(), expected.end(), std::greater<T>());
+
+    hpx::parallel::sort(policy, v.begin(), v.end(), std::greater<T>());
+    verify_values(v, expected);
+}
+
+template <typename ExPolicy, typename T>
+void test_sort_async(ExPolicy && policy, hpx::partitioned_vector<T>& v,
+    int max_value)
+{
+    std::vector<T> expected = fill_vector(v, max_value);
+    std::sort(expected.begin(), expected.end());
+
+    auto r = hpx::parallel::sort(policy, v.begin(), v.end(),
+        std::less<T>()).get();
+    HPX_TEST(r == v.end());
+    verify_values(v, expected);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void sort_tests(hpx::partitioned_vector<T>& v, int max_value)
+{
+    using hpx::parallel::seq;
+    using hpx::parallel::par;
+    using hpx::parallel::task;
+
+    test_sort(seq, v, max_value);
+    test_sort(par, v, max_value);
+    test_sort_async(seq(task), v, max_value);
+    test_sort_async(par(task), v, max_value);
+}
+
+template <typename T>
+void sort_tests()
+{
+    std::size_t const length = 1007;
+
+    {
+        hpx::partitioned_vector<T> v;
+        hpx::parallel::sort(hpx::parallel::seq, v.begin(), v.end(),
+            std::less<T>());
+        hpx::parallel::sort(hpx::parallel::par, v.begin(), v.end(),
+            std::less<T>());
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0));
+        sort_tests(v, 10000);
+    }
+
+    {
+        hpx::partitioned_vector<T> v(length, T(0), hpx::container_layout(3));
+        sort_tests(v, 10000);
+    }
+
+    // many duplicates leave some of the buckets empty
+    {
+        hpx::partitioned_vector<T> v(length, T(0), hpx::container_layout(5));
+        sort_tests(v, 3);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    sort_tests<int>();
+    sort_tests<double>();
+
+    return 0;
+}
@@ -0,0 +1,124 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_main.hpp>
+#include <hpx/include/partitioned_vector.hpp>
+#include <hpx/include/parallel_transform.hpp>
+
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+
+///////////////////////////////////////////////////////////////////////////////
+// Define the vector types to be used.
+HPX_REGISTER_PARTITIONED_VECTOR(double);
+HPX_REGISTER_PARTITIONED_VECTOR(int);
+
+struct add_one
+{
+    template <typename T>
+    T operator()(T const& val) const
+    {
+        return val + T(1);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename T>
+void verify_values(hpx::partitioned_vector<T> const& v, T const& val)
+{
+    typedef typename hpx::partitioned_vector<T>::const_iterator const_iterator;
+
+    const_iterator end = v.end();
+    for (const_iterator it = v.begin(); it != end; ++it)
+    {
+        HPX_TEST_EQ(*it, val);
+    }
+}
+
+template <typename T>
+void transform_tests(hpx::partitioned_vector<T> const& in,
+    hpx::partitioned_vector<T>& out)
+{
+    using hpx::parallel::transform;
+    using hpx::parallel::seq;
+    using hpx::parallel::par;
+    using hpx::parallel::task;
+
+    auto r1 = transform(seq, in.begin(), in.end(), out.begin(), add_one());
+    HPX_TEST(r1.in() == in.end());
+    HPX_TEST(r1.out() == out.end());
+    verify_values(out, T(2));
+
+    auto r2 = transform(par, out.begin(), out.end(), out.begin(), add_one());
+    HPX_TEST(r2.out() == out.end());
+    verify_values(out, T(3));
+
+    auto r3 = transform(seq(task), out.begin(), out.end(), out.begin(),
+        add_one()).get();
+    HPX_TEST(r3.out() == out.end());
+    verify_values(out, T(4));
+
+    auto r4 = transform(par(task), out.begin(), out.end(), out.begin(),
+        add_one()).get();
+    HPX_TEST(r4.out() == out.end());
+    verify_values(out, T(5));
+}
+
+template <typename T>
+void transform_tests()
+{
+    std::size_t const length = 12;
+
+    {
+        hpx::partitioned_vector<T> in(length, T(1));
+        hpx::partitioned_vector<T> out(length, T(0));
+        transform_tests(in, out);
+    }
+
+    {
+        hpx::partitioned_vector<T> in(length, T(1), hpx::container_layout(3));
+        hpx::partitioned_vector<T> out(length, T(0), hpx::container_layout(3));
+        transform_tests(in, out);
+    }
+
+    // ranges which are partitioned differently
+    {
+        hpx::partitioned_vector<T> in(length, T(1), hpx::container_layout(3));
+        hpx::partitioned_vector<T> out(length, T(0), hpx::container_layout(5));
+        transform_tests(in, out);
+    }
+
+    {
+        hpx::partitioned_vector<T> in(length, T(1));
+        hpx::partitioned_vector<T> out(length, T(0), hpx::container_layout(4));
+        transform_tests(in, out);
+    }
+
+    // destination starting at a different offset into its partition
+    {
+        hpx::partitioned_vector<T> in(length, T(1), hpx::container_layout(3));
+        hpx::partitioned_vector<T> out(length + 1, T(0),
+            hpx::container_layout(3));
+
+        auto r = hpx::parallel::transform(hpx::parallel::par,
+            in.begin(), in.end(), out.begin() + 1, add_one());
+        HPX_TEST(r.in() == in.end());
+        HPX_TEST(r.out() == out.end());
+
+        HPX_TEST_EQ(out.get_value_sync(0), T(0));
+        for (std::size_t i = 1; i != length + 1; ++i)
+            HPX_TEST_EQ(out.get_value_sync(i), T(2));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int main()
+{
+    transform_tests<int>();
+    transform_tests<double>();
+
+    return 0;
+}
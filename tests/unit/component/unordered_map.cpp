@@ -4,14 +4,19 @@
 //  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
 
 #include <hpx/hpx_main.hpp>
+#include <hpx/include/lcos.hpp>
 #include <hpx/include/unordered_map.hpp>
 #include <hpx/util/lightweight_test.hpp>
 
+#include <hpx/components/containers/unordered/concurrent_hash_table.hpp>
+
 #include <algorithm>
 #include <functional>
 #include <iostream>
+#include <iterator>
 #include <memory>
 #include <string>
+#include <unordered_map>
 #include <vector>
 
 ///////////////////////////////////////////////////////////////////////////////
@@ -147,9 +152,93 @@ void trivial_tests()
     }
 }
 
+///////////////////////////////////////////////////////////////////////////////
+template <typename Key, typename Value>
+void concurrent_access_tests()
+{
+    hpx::unordered_map<Key, Value> m;
+
+    std::vector<hpx::future<void> > futures;
+    for (std::size_t i = 0; i != 1000; ++i)
+    {
+        futures.push_back(hpx::async(
+            [&m, i]()
+            {
+                std::string idx = std::to_string(i);
+                m.set_value_sync(idx, Value(i));
+                if (i % 2)
+                    HPX_TEST_EQ(m.erase_sync(idx), std::size_t(1));
+            }));
+    }
+    hpx::wait_all(futures);
+
+    HPX_TEST_EQ(m.size(), std::size_t(500));
+    for (std::size_t i = 0; i < 1000; i += 2)
+        HPX_TEST_EQ(m[std::to_string(i)], Value(i));
+}
+
+void hash_table_tests()
+{
+    typedef hpx::server::detail::concurrent_hash_table<
+            std::size_t, std::size_t, std::hash<std::size_t>,
+            std::equal_to<std::size_t>
+        > table_type;
+
+    // large enough to be processed in parallel
+    std::size_t const count = 10000;
+
+    std::vector<std::size_t> keys, values;
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        keys.push_back(i * 7);
+        values.push_back(i);
+    }
+
+    table_type t;
+    t.set_values(keys, values);
+    HPX_TEST_EQ(t.size(), count);
+
+    std::vector<std::size_t> result;
+    HPX_TEST(t.get_values(keys, result));
+    HPX_TEST(result == values);
+
+    // erase every other element, this exercises the backward shift
+    for (std::size_t i = 0; i < count; i += 2)
+        HPX_TEST_EQ(t.erase(keys[i]), std::size_t(1));
+    HPX_TEST_EQ(t.size(), count / 2);
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        std::size_t value = 0;
+        HPX_TEST_EQ(t.get_value(keys[i], value), (i % 2) != 0);
+        if (i % 2)
+            HPX_TEST_EQ(value, i);
+    }
+    HPX_TEST(!t.get_values(keys, result));
+
+    // bulk insert does not overwrite existing elements
+    std::unordered_map<std::size_t, std::size_t> data;
+    for (std::size_t i = 0; i != count; ++i)
+        data[keys[i]] = 0;
+
+    HPX_TEST_EQ(t.insert(data.begin(), data.end()), count / 2);
+    HPX_TEST_EQ(t.size(), count);
+    HPX_TEST_EQ(std::size_t(std::distance(t.begin(), t.end())), count);
+
+    for (std::size_t i = 0; i != count; ++i)
+    {
+        std::size_t value = 0;
+        HPX_TEST(t.get_value(keys[i], value, true));
+        HPX_TEST_EQ(value, (i % 2) ? i : 0);
+    }
+    HPX_TEST(t.empty());
+}
+
 int main()
 {
     trivial_tests<std::string, double>();
+    concurrent_access_tests<std::string, double>();
+    hash_table_tests();
 
     std::vector<hpx::id_type> localities = hpx::find_all_localities();
 
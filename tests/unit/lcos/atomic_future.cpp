@@ -0,0 +1,163 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/local/atomic_future.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <stdexcept>
+#include <vector>
+
+using hpx::lcos::local::atomic_async;
+using hpx::lcos::local::atomic_future;
+using hpx::lcos::local::atomic_promise;
+
+///////////////////////////////////////////////////////////////////////////////
+struct point
+{
+    double x, y;
+};
+
+double square(double d)
+{
+    return d * d;
+}
+
+double throw_error()
+{
+    throw std::runtime_error("test");
+    return 0.;
+}
+
+int to_int(atomic_future<double> f)
+{
+    return static_cast<int>(f.get());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_promise()
+{
+    atomic_promise<point> p;
+    atomic_future<point> f = p.get_future();
+    HPX_TEST(f.valid());
+    HPX_TEST(!f.is_ready());
+
+    point pt = { 1., 2. };
+    p.set_value(pt);
+    HPX_TEST(f.is_ready());
+    HPX_TEST(!f.has_exception());
+
+    point r = f.get();
+    HPX_TEST_EQ(r.x, 1.);
+    HPX_TEST_EQ(r.y, 2.);
+    HPX_TEST(!f.valid());
+
+    bool caught_exception = false;
+    try {
+        p.get_future();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::future_already_retrieved);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_broken_promise()
+{
+    atomic_future<int> f;
+    {
+        atomic_promise<int> p;
+        f = p.get_future();
+    }
+
+    HPX_TEST(f.has_exception());
+
+    bool caught_exception = false;
+    try {
+        f.get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::broken_promise);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_async()
+{
+    std::vector<atomic_future<double> > futures;
+    for (std::size_t i = 0; i != 100; ++i)
+        futures.push_back(atomic_async(&square, double(i)));
+
+    for (std::size_t i = 0; i != futures.size(); ++i)
+        HPX_TEST_EQ(futures[i].get(), double(i * i));
+
+    atomic_future<double> f = atomic_async(&throw_error);
+
+    bool caught_exception = false;
+    try {
+        f.get();
+    }
+    catch (std::runtime_error const&) {
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+void test_then()
+{
+    // continuation attached before the value is set
+    atomic_promise<double> p;
+    atomic_future<int> f = p.get_future().then(&to_int);
+    HPX_TEST(!f.is_ready());
+
+    p.set_value(42.5);
+    HPX_TEST(f.is_ready());
+    HPX_TEST_EQ(f.get(), 42);
+
+    // continuation attached after the value has been set
+    atomic_future<int> g = atomic_async(&square, 3.).then(&to_int);
+    HPX_TEST_EQ(g.get(), 9);
+}
+
+void test_to_future()
+{
+    atomic_promise<double> p;
+    hpx::future<double> f = p.get_future().to_future();
+    HPX_TEST(!f.is_ready());
+
+    p.set_value(1.5);
+    HPX_TEST_EQ(f.get(), 1.5);
+
+    hpx::future<double> g = atomic_async(&square, 4.).to_future();
+    HPX_TEST_EQ(g.get(), 16.);
+
+    hpx::future<double> h = atomic_async(&throw_error).to_future();
+    h.wait();
+    HPX_TEST(h.has_exception());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_promise();
+    test_broken_promise();
+    test_async();
+    test_then();
+    test_to_future();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,62 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_CHANNEL(int, test_channel_int);
+
+///////////////////////////////////////////////////////////////////////////////
+void test_channel(hpx::id_type const& locality)
+{
+    hpx::lcos::channel<int> c(locality);
+
+    hpx::future<int> f = c.get();
+
+    std::vector<hpx::future<void> > sent;
+    for (int i = 0; i != 10; ++i)
+        sent.push_back(c.set(i));
+    hpx::wait_all(sent);
+
+    int sum = f.get();
+    for (int i = 1; i != 10; ++i)
+        sum += c.get().get();
+    HPX_TEST_EQ(sum, 45);
+
+    c.close().get();
+
+    bool caught_exception = false;
+    try {
+        c.get().get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    for (hpx::id_type const& id : hpx::find_all_localities())
+        test_channel(id);
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
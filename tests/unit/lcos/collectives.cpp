@@ -0,0 +1,208 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/cstdint.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+HPX_REGISTER_COLLECTIVES(boost::uint32_t, test_collectives);
+
+///////////////////////////////////////////////////////////////////////////////
+// all sites are run on different localities
+void test_localities()
+{
+    boost::uint32_t const num_localities = hpx::get_num_localities_sync();
+    boost::uint32_t const here = hpx::get_locality_id();
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::future<boost::uint32_t> sum = hpx::lcos::all_reduce(
+            "/test/all_reduce/", here, std::plus<boost::uint32_t>(),
+            num_localities, i);
+        HPX_TEST_EQ(sum.get(), num_localities * (num_localities - 1) / 2);
+    }
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        hpx::future<std::vector<boost::uint32_t> > values =
+            hpx::lcos::all_gather("/test/all_gather/", here,
+                num_localities, i);
+
+        std::vector<boost::uint32_t> v = values.get();
+        HPX_TEST_EQ(v.size(), std::size_t(num_localities));
+        for (boost::uint32_t j = 0; j != v.size(); ++j)
+            HPX_TEST_EQ(v[j], j);
+    }
+
+    for (std::size_t i = 0; i != 10; ++i)
+    {
+        boost::uint32_t const root = boost::uint32_t(i % num_localities);
+        if (here == root)
+        {
+            hpx::lcos::broadcast_to("/test/broadcast/", boost::uint32_t(i),
+                std::size_t(-1), i).get();
+        }
+        else
+        {
+            hpx::future<boost::uint32_t> value =
+                hpx::lcos::broadcast_from<boost::uint32_t>("/test/broadcast/",
+                    std::size_t(-1), i, root);
+            HPX_TEST_EQ(value.get(), boost::uint32_t(i));
+        }
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// all sites are run on this locality
+void all_reduce_site(std::size_t num_sites, std::size_t site)
+{
+    hpx::future<boost::uint32_t> sum = hpx::lcos::all_reduce(
+        "/test/local/all_reduce/", boost::uint32_t(site + 1),
+        std::plus<boost::uint32_t>(), num_sites, num_sites, site);
+    HPX_TEST_EQ(sum.get(), boost::uint32_t(num_sites * (num_sites + 1) / 2));
+}
+
+void all_gather_site(std::size_t num_sites, std::size_t site)
+{
+    hpx::future<std::vector<boost::uint32_t> > values =
+        hpx::lcos::all_gather("/test/local/all_gather/",
+            boost::uint32_t(site), num_sites, num_sites, site);
+
+    std::vector<boost::uint32_t> v = values.get();
+    HPX_TEST_EQ(v.size(), num_sites);
+    for (std::size_t j = 0; j != v.size(); ++j)
+        HPX_TEST_EQ(v[j], boost::uint32_t(j));
+}
+
+void all_to_all_site(std::size_t num_sites, std::size_t site)
+{
+    std::vector<boost::uint32_t> values(num_sites);
+    for (std::size_t j = 0; j != num_sites; ++j)
+        values[j] = boost::uint32_t(site * 100 + j);
+
+    hpx::future<std::vector<boost::uint32_t> > result =
+        hpx::lcos::all_to_all("/test/local/all_to_all/", values,
+            num_sites, num_sites, site);
+
+    std::vector<boost::uint32_t> v = result.get();
+    HPX_TEST_EQ(v.size(), num_sites);
+    for (std::size_t j = 0; j != v.size(); ++j)
+        HPX_TEST_EQ(v[j], boost::uint32_t(j * 100 + site));
+}
+
+void reduce_scatter_site(std::size_t num_sites, std::size_t site)
+{
+    std::vector<boost::uint32_t> values(num_sites, boost::uint32_t(site));
+
+    hpx::future<boost::uint32_t> result = hpx::lcos::reduce_scatter(
+        "/test/local/reduce_scatter/", values, std::plus<boost::uint32_t>(),
+        num_sites, num_sites, site);
+
+    HPX_TEST_EQ(result.get(), boost::uint32_t(num_sites * (num_sites - 1) / 2));
+}
+
+void scan_site(std::size_t num_sites, std::size_t site)
+{
+    hpx::future<boost::uint32_t> inclusive = hpx::lcos::inclusive_scan(
+        "/test/local/inclusive_scan/", boost::uint32_t(site + 1),
+        std::plus<boost::uint32_t>(), num_sites, num_sites, site);
+
+    hpx::future<boost::uint32_t> exclusive = hpx::lcos::exclusive_scan(
+        "/test/local/exclusive_scan/", boost::uint32_t(site + 1),
+        boost::uint32_t(10), std::plus<boost::uint32_t>(), num_sites,
+        num_sites, site);
+
+    HPX_TEST_EQ(inclusive.get(), boost::uint32_t((site + 1) * (site + 2) / 2));
+    HPX_TEST_EQ(exclusive.get(), boost::uint32_t(10 + site * (site + 1) / 2));
+}
+
+void broadcast_site(std::size_t num_sites, std::size_t site)
+{
+    // large vectors are split into several segments
+    std::size_t const sizes[] = { 1, 1000, HPX_BROADCAST_SEGMENT_SIZE };
+    std::size_t const root = num_sites / 2;
+
+    for (std::size_t size : sizes)
+    {
+        std::string name("/test/local/broadcast/" + std::to_string(size));
+        if (site == root)
+        {
+            std::vector<boost::uint32_t> values(size);
+            for (std::size_t j = 0; j != size; ++j)
+                values[j] = boost::uint32_t(j);
+
+            hpx::lcos::broadcast_to(name.c_str(), std::move(values),
+                num_sites, num_sites, site).get();
+        }
+        else
+        {
+            hpx::future<std::vector<boost::uint32_t> > f =
+                hpx::lcos::broadcast_from<std::vector<boost::uint32_t> >(
+                    name.c_str(), num_sites, num_sites, root, site);
+
+            std::vector<boost::uint32_t> v = f.get();
+            HPX_TEST_EQ(v.size(), size);
+            for (std::size_t j = 0; j != v.size(); ++j)
+                HPX_TEST_EQ(v[j], boost::uint32_t(j));
+        }
+    }
+}
+
+void test_sites(std::size_t num_sites, void (*f)(std::size_t, std::size_t))
+{
+    std::vector<hpx::future<void> > sites;
+    sites.reserve(num_sites);
+
+    for (std::size_t site = 0; site != num_sites; ++site)
+        sites.push_back(hpx::async(f, num_sites, site));
+
+    hpx::wait_all(sites);
+}
+
+void test_local()
+{
+    // use numbers of sites which are and are not a power of two
+    std::size_t const num_sites[] = { 1, 2, 3, 4, 5, 7, 8, 13 };
+
+    for (std::size_t n : num_sites)
+    {
+        test_sites(n, &all_reduce_site);
+        test_sites(n, &all_gather_site);
+        test_sites(n, &all_to_all_site);
+        test_sites(n, &reduce_scatter_site);
+        test_sites(n, &scan_site);
+        test_sites(n, &broadcast_site);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_localities();
+
+    if (hpx::get_locality_id() == 0)
+        test_local();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
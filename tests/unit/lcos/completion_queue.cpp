@@ -0,0 +1,112 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <vector>
+
+#define NUM_FUTURES std::size_t(1000)
+
+///////////////////////////////////////////////////////////////////////////////
+void test_completion_order()
+{
+    hpx::lcos::local::completion_queue<std::size_t> q;
+
+    std::vector<hpx::lcos::local::promise<std::size_t> > promises(10);
+    for (std::size_t i = 0; i != promises.size(); ++i)
+        HPX_TEST_EQ(q.add(promises[i].get_future()), i);
+
+    HPX_TEST_EQ(q.size(), promises.size());
+    HPX_TEST_EQ(q.ready_count(), std::size_t(0));
+
+    hpx::lcos::local::completion_queue<std::size_t>::value_type value;
+    HPX_TEST(!q.try_get(value));
+
+    // futures are handed out in the order they become ready
+    for (std::size_t i = promises.size(); i != 0; --i)
+        promises[i - 1].set_value(i * 10);
+
+    HPX_TEST_EQ(q.ready_count(), promises.size());
+
+    for (std::size_t i = promises.size(); i != 0; --i)
+    {
+        HPX_TEST(q.try_get(value));
+        HPX_TEST_EQ(value.first, i - 1);
+        HPX_TEST_EQ(value.second.get(), i * 10);
+    }
+
+    HPX_TEST(q.empty());
+}
+
+void test_waiting_consumer()
+{
+    hpx::lcos::local::completion_queue<void> q;
+
+    // a consumer waiting before any future has become ready
+    hpx::lcos::local::promise<void> p;
+    hpx::future<hpx::lcos::local::completion_queue<void>::value_type> f =
+        q.get_async();
+    HPX_TEST(!f.is_ready());
+
+    q.add(p.get_future());
+    HPX_TEST(!f.is_ready());
+
+    p.set_value();
+    HPX_TEST_EQ(f.get().first, std::size_t(0));
+
+    // ready futures are handed out right away
+    q.add(hpx::make_ready_future());
+    HPX_TEST_EQ(q.get().first, std::size_t(1));
+    HPX_TEST(q.empty());
+}
+
+std::size_t square(std::size_t i)
+{
+    return i * i;
+}
+
+void test_many_futures()
+{
+    hpx::lcos::local::completion_queue<std::size_t> q;
+
+    for (std::size_t i = 0; i != NUM_FUTURES; ++i)
+        q.add(hpx::async(&square, i));
+
+    std::vector<bool> seen(NUM_FUTURES, false);
+    while (!q.empty())
+    {
+        hpx::lcos::local::completion_queue<std::size_t>::value_type r =
+            q.get();
+
+        HPX_TEST(!seen[r.first]);
+        seen[r.first] = true;
+        HPX_TEST_EQ(r.second.get(), r.first * r.first);
+    }
+
+    for (std::size_t i = 0; i != NUM_FUTURES; ++i)
+        HPX_TEST(seen[i]);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_completion_order();
+    test_waiting_consumer();
+    test_many_futures();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,164 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <memory>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+boost::atomic<std::size_t> allocations(0);
+boost::atomic<std::size_t> deallocations(0);
+
+template <typename T>
+struct counting_allocator : std::allocator<T>
+{
+    typedef T value_type;
+
+    template <typename U>
+    struct rebind
+    {
+        typedef counting_allocator<U> other;
+    };
+
+    counting_allocator() {}
+
+    template <typename U>
+    counting_allocator(counting_allocator<U> const&) {}
+
+    T* allocate(std::size_t n)
+    {
+        ++allocations;
+        return std::allocator<T>::allocate(n);
+    }
+
+    void deallocate(T* p, std::size_t n)
+    {
+        ++deallocations;
+        std::allocator<T>::deallocate(p, n);
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+int test_function(int passed_through)
+{
+    return passed_through;
+}
+
+void test_promise()
+{
+    std::size_t const count = allocations;
+    {
+        hpx::lcos::local::promise<int> p(
+            std::allocator_arg, counting_allocator<int>());
+        hpx::future<int> f = p.get_future();
+
+        HPX_TEST_EQ(allocations.load(), count + 1);
+
+        p.set_value(42);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(deallocations.load(), allocations.load());
+
+    {
+        hpx::lcos::local::promise<void> p(
+            std::allocator_arg, counting_allocator<int>());
+        hpx::future<void> f = p.get_future();
+
+        p.set_value();
+        f.get();
+    }
+    HPX_TEST_EQ(allocations.load(), count + 2);
+    HPX_TEST_EQ(deallocations.load(), allocations.load());
+}
+
+void test_packaged_task()
+{
+    std::size_t const count = allocations;
+    {
+        hpx::lcos::local::packaged_task<int(int)> pt(
+            std::allocator_arg, counting_allocator<int>(), &test_function);
+        hpx::future<int> f = pt.get_future();
+
+        HPX_TEST_EQ(allocations.load(), count + 1);
+
+        pt(42);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(deallocations.load(), allocations.load());
+}
+
+void test_async()
+{
+    std::size_t const count = allocations;
+    {
+        hpx::future<int> f = hpx::async(std::allocator_arg,
+            counting_allocator<int>(), &test_function, 42);
+
+        HPX_TEST_EQ(allocations.load(), count + 1);
+        HPX_TEST_EQ(f.get(), 42);
+    }
+    HPX_TEST_EQ(deallocations.load(), allocations.load());
+
+    {
+        std::vector<hpx::future<int> > futures;
+        for (int i = 0; i != 100; ++i)
+        {
+            futures.push_back(hpx::async(std::allocator_arg,
+                counting_allocator<int>(), &test_function, i));
+        }
+
+        for (int i = 0; i != 100; ++i)
+            HPX_TEST_EQ(futures[i].get(), i);
+    }
+    HPX_TEST_EQ(allocations.load(), count + 101);
+    HPX_TEST_EQ(deallocations.load(), allocations.load());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_recycled_shared_state()
+{
+    // shared states not created through an allocator are recycled
+    for (int i = 0; i != 1000; ++i)
+    {
+        hpx::lcos::local::promise<int> p;
+        hpx::future<int> f = p.get_future().then(
+            [](hpx::future<int> f) { return f.get() + 1; });
+
+        p.set_value(i);
+        HPX_TEST_EQ(f.get(), i + 1);
+    }
+}
+
+int hpx_main()
+{
+    test_promise();
+    test_packaged_task();
+    test_async();
+    test_recycled_shared_state();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=" +
+        std::to_string(hpx::threads::hardware_concurrency()));
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
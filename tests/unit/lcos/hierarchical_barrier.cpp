@@ -0,0 +1,153 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/lcos/hierarchical_barrier.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <string>
+#include <vector>
+
+std::size_t const num_phases = 10;
+std::size_t const threads_per_site = 4;
+
+///////////////////////////////////////////////////////////////////////////////
+// all localities take part in the barrier
+void test_localities()
+{
+    hpx::lcos::hierarchical_barrier b("/test/hierarchical_barrier/");
+    for (std::size_t i = 0; i != num_phases; ++i)
+        b.wait();
+
+    // split-phase use of the barrier
+    for (std::size_t i = 0; i != num_phases; ++i)
+    {
+        hpx::shared_future<void> f = b.arrive();
+        f.get();
+        HPX_TEST(f.is_ready());
+    }
+
+    hpx::lcos::hierarchical_latch l("/test/hierarchical_latch/");
+    HPX_TEST(!l.is_ready() || hpx::get_num_localities_sync() == 1);
+    l.count_down_and_wait();
+    HPX_TEST(l.is_ready());
+
+    // make sure nobody destroys its part of the latch while others are
+    // still waiting
+    b.wait();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// all sites are run on this locality, each site using several threads
+void barrier_thread(hpx::lcos::hierarchical_barrier& b,
+    boost::atomic<std::size_t>& arrived, std::size_t participants)
+{
+    for (std::size_t i = 0; i != num_phases; ++i)
+    {
+        ++arrived;
+        hpx::shared_future<void> f = b.arrive();
+        f.get();
+
+        // no participant can have left the barrier before all have arrived
+        HPX_TEST(arrived.load() >= (i + 1) * participants);
+    }
+}
+
+void barrier_site(boost::atomic<std::size_t>& arrived,
+    std::string const& basename, std::size_t num_sites, std::size_t site)
+{
+    hpx::lcos::hierarchical_barrier b(basename, threads_per_site,
+        num_sites, site);
+
+    std::vector<hpx::future<void> > threads;
+    threads.reserve(threads_per_site);
+    for (std::size_t t = 0; t != threads_per_site; ++t)
+    {
+        threads.push_back(hpx::async(&barrier_thread, std::ref(b),
+            std::ref(arrived), num_sites * threads_per_site));
+    }
+    hpx::wait_all(threads);
+}
+
+void latch_site(boost::atomic<std::size_t>& arrived,
+    std::string const& basename, std::size_t num_sites, std::size_t site)
+{
+    hpx::lcos::hierarchical_latch l(basename, threads_per_site,
+        num_sites, site);
+
+    // the latch is counted down by a thread which does not wait
+    hpx::future<void> f = hpx::async(
+        [&]()
+        {
+            ++arrived;
+            l.count_down(threads_per_site);
+        });
+
+    l.wait();
+    HPX_TEST_EQ(arrived.load(), num_sites);
+
+    f.get();
+}
+
+void test_sites(std::size_t num_sites, char const* basename,
+    void (*f)(boost::atomic<std::size_t>&, std::string const&, std::size_t,
+        std::size_t))
+{
+    boost::atomic<std::size_t> arrived(0);
+
+    // the sites of the previous test may not have unregistered their names
+    // yet, use a different base name for each number of sites
+    std::string name = basename + std::to_string(num_sites) + "/";
+
+    std::vector<hpx::future<void> > sites;
+    sites.reserve(num_sites);
+
+    for (std::size_t site = 0; site != num_sites; ++site)
+    {
+        sites.push_back(hpx::async(f, std::ref(arrived), std::cref(name),
+            num_sites, site));
+    }
+
+    hpx::wait_all(sites);
+}
+
+void test_local()
+{
+    // use numbers of sites which are and are not a power of two
+    std::size_t const num_sites[] = { 1, 2, 3, 4, 5, 7, 8, 13 };
+
+    for (std::size_t n : num_sites)
+    {
+        test_sites(n, "/test/local/hierarchical_barrier/", &barrier_site);
+        test_sites(n, "/test/local/hierarchical_latch/", &latch_site);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_localities();
+
+    if (hpx::get_locality_id() == 0)
+        test_local();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.run_hpx_main!=1");
+
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,244 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <string>
+#include <vector>
+
+#define NUM_PRODUCERS std::size_t(10)
+#define NUM_VALUES std::size_t(1000)
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Channel>
+void produce(Channel& c, std::size_t first, std::size_t count)
+{
+    for (std::size_t i = first; i != first + count; ++i)
+        c.set(i);
+}
+
+template <typename Channel>
+std::size_t consume(Channel& c, std::size_t count)
+{
+    std::size_t sum = 0;
+    for (std::size_t i = 0; i != count; ++i)
+        sum += c.get().get();
+    return sum;
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_mpmc(std::size_t capacity)
+{
+    hpx::lcos::local::channel<std::size_t> c(capacity);
+
+    std::vector<hpx::future<void> > producers;
+    std::vector<hpx::future<std::size_t> > consumers;
+    for (std::size_t i = 0; i != NUM_PRODUCERS; ++i)
+    {
+        producers.push_back(hpx::async(&produce<decltype(c)>, std::ref(c),
+            i * NUM_VALUES, NUM_VALUES));
+        consumers.push_back(hpx::async(&consume<decltype(c)>, std::ref(c),
+            NUM_VALUES));
+    }
+
+    hpx::wait_all(producers);
+
+    std::size_t sum = 0;
+    for (hpx::future<std::size_t>& f : consumers)
+        sum += f.get();
+
+    std::size_t const n = NUM_PRODUCERS * NUM_VALUES;
+    HPX_TEST_EQ(sum, n * (n - 1) / 2);
+}
+
+void test_spsc(std::size_t capacity)
+{
+    hpx::lcos::local::spsc_channel<std::size_t> c(capacity);
+
+    hpx::future<void> producer = hpx::async(
+        &produce<decltype(c)>, std::ref(c), 0, NUM_VALUES);
+
+    // values are received in the order they were sent
+    for (std::size_t i = 0; i != NUM_VALUES; ++i)
+        HPX_TEST_EQ(c.get().get(), i);
+
+    producer.get();
+}
+
+void test_close()
+{
+    hpx::lcos::local::channel<int> c;
+
+    hpx::future<int> f1 = c.get();
+    hpx::future<int> f2 = c.get();
+
+    c.set(42);
+    c.close();
+
+    HPX_TEST(c.is_closed());
+    HPX_TEST_EQ(f1.get(), 42);
+
+    bool caught_exception = false;
+    try {
+        f2.get();
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    caught_exception = false;
+    try {
+        c.set(43);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    HPX_TEST(c.get().has_exception());
+}
+
+void test_iterate()
+{
+    hpx::lcos::local::channel<std::string> c;
+
+    c.set("a");
+    c.set("b");
+    c.set("c");
+    c.close();
+
+    // values sent before closing the channel can still be received
+    std::string result;
+    for (std::string const& s : c)
+        result += s;
+
+    HPX_TEST_EQ(result, std::string("abc"));
+}
+
+void test_backpressure()
+{
+    hpx::lcos::local::spsc_channel<std::size_t> c(1);
+    boost::atomic<std::size_t> sent(0);
+
+    hpx::future<void> producer = hpx::async(
+        [&]()
+        {
+            for (std::size_t i = 0; i != 3; ++i)
+            {
+                c.set(i);
+                ++sent;
+            }
+        });
+
+    // the producer is suspended as long as the channel is full
+    while (sent.load() == 0)
+        hpx::this_thread::yield();
+
+    hpx::this_thread::sleep_for(boost::chrono::milliseconds(100));
+    HPX_TEST_EQ(sent.load(), std::size_t(1));
+
+    for (std::size_t i = 0; i != 3; ++i)
+        HPX_TEST_EQ(c.get().get(), i);
+
+    producer.get();
+    HPX_TEST_EQ(sent.load(), std::size_t(3));
+}
+
+// closing a full channel wakes up the blocked senders
+void test_close_full()
+{
+    hpx::lcos::local::channel<std::size_t> c(1);
+    c.set(0);
+
+    hpx::future<void> producer = hpx::async(
+        [&]()
+        {
+            c.set(1);
+        });
+
+    hpx::this_thread::sleep_for(boost::chrono::milliseconds(100));
+    HPX_TEST(!producer.is_ready());
+
+    c.close();
+
+    producer.wait();
+    HPX_TEST(producer.has_exception());
+
+    // senders arriving after the channel has been closed don't block either
+    bool caught_exception = false;
+    try {
+        c.set(2);
+    }
+    catch (hpx::exception const& e) {
+        HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+        caught_exception = true;
+    }
+    HPX_TEST(caught_exception);
+
+    HPX_TEST_EQ(c.get().get(), std::size_t(0));
+}
+
+// the consumer of a spsc_channel may close it while the producer hands a
+// value to the waiting consumer
+void test_spsc_close()
+{
+    for (std::size_t i = 0; i != NUM_VALUES; ++i)
+    {
+        hpx::lcos::local::spsc_channel<std::size_t> c;
+        hpx::future<std::size_t> f = c.get();
+
+        hpx::future<void> producer = hpx::async(
+            [&]()
+            {
+                try {
+                    c.set(i);
+                }
+                catch (hpx::exception const& e) {
+                    HPX_TEST_EQ(e.get_error(), hpx::invalid_status);
+                }
+            });
+
+        c.close();
+        producer.get();
+
+        // the receiver gets either the value or an error
+        f.wait();
+        HPX_TEST(f.has_exception() || f.get() == i);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_mpmc(std::size_t(-1));
+    test_mpmc(16);
+    test_spsc(std::size_t(-1));
+    test_spsc(16);
+    test_close();
+    test_iterate();
+    test_backpressure();
+    test_close_full();
+    test_spsc_close();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
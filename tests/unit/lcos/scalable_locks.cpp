@@ -0,0 +1,142 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/local_lcos.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <vector>
+
+#define NUM_THREADS std::size_t(32)
+#define NUM_ITERATIONS std::size_t(1000)
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Mutex>
+void increment(Mutex& mtx, std::size_t& counter)
+{
+    for (std::size_t i = 0; i != NUM_ITERATIONS; ++i)
+    {
+        std::lock_guard<Mutex> l(mtx);
+        std::size_t value = counter;
+        if (i % 16 == 0)
+            hpx::this_thread::yield();
+        counter = value + 1;
+    }
+}
+
+template <typename Mutex>
+void test_mutual_exclusion()
+{
+    Mutex mtx;
+    std::size_t counter = 0;
+
+    std::vector<hpx::future<void> > threads;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        threads.push_back(hpx::async(&increment<Mutex>, std::ref(mtx),
+            std::ref(counter)));
+    }
+    hpx::wait_all(threads);
+
+    HPX_TEST_EQ(counter, NUM_THREADS * NUM_ITERATIONS);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_mcs_scoped_lock()
+{
+    hpx::lcos::local::mcs_lock mtx;
+    std::size_t counter = 0;
+
+    std::vector<hpx::future<void> > threads;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        threads.push_back(hpx::async(
+            [&]()
+            {
+                for (std::size_t j = 0; j != NUM_ITERATIONS; ++j)
+                {
+                    hpx::lcos::local::mcs_lock::scoped_lock l(mtx);
+                    ++counter;
+                }
+            }));
+    }
+    hpx::wait_all(threads);
+
+    HPX_TEST_EQ(counter, NUM_THREADS * NUM_ITERATIONS);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// writers keep both values equal, readers must never observe a difference
+void test_distributed_shared_mutex()
+{
+    hpx::lcos::local::distributed_shared_mutex mtx;
+    std::size_t values[2] = { 0, 0 };
+    std::size_t inconsistencies = 0;
+
+    std::vector<hpx::future<void> > threads;
+    for (std::size_t i = 0; i != NUM_THREADS; ++i)
+    {
+        threads.push_back(hpx::async(
+            [&, i]()
+            {
+                for (std::size_t j = 0; j != NUM_ITERATIONS; ++j)
+                {
+                    if ((i + j) % 8 == 0)
+                    {
+                        std::lock_guard<
+                            hpx::lcos::local::distributed_shared_mutex
+                        > l(mtx);
+                        ++values[0];
+                        hpx::this_thread::yield();
+                        ++values[1];
+                    }
+                    else
+                    {
+                        mtx.lock_shared();
+                        if (values[0] != values[1])
+                            ++inconsistencies;
+                        mtx.unlock_shared();
+                    }
+                }
+            }));
+    }
+    hpx::wait_all(threads);
+
+    HPX_TEST_EQ(inconsistencies, std::size_t(0));
+    HPX_TEST_EQ(values[0], values[1]);
+
+    // a writer excludes readers and vice versa
+    HPX_TEST(mtx.try_lock_shared());
+    HPX_TEST(!mtx.try_lock());
+    mtx.unlock_shared();
+
+    HPX_TEST(mtx.try_lock());
+    HPX_TEST(!mtx.try_lock_shared());
+    mtx.unlock();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_mutual_exclusion<hpx::lcos::local::mcs_lock>();
+    test_mutual_exclusion<hpx::lcos::local::cohort_lock>();
+    test_mutual_exclusion<hpx::lcos::local::distributed_shared_mutex>();
+    test_mcs_scoped_lock();
+    test_distributed_shared_mutex();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,153 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/lcos.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/chrono.hpp>
+#include <boost/cstdint.hpp>
+
+#include <string>
+#include <vector>
+
+using hpx::lcos::detail::continuation_inlined;
+using hpx::lcos::detail::continuation_spawned;
+using hpx::lcos::detail::get_continuation_count;
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename Executor>
+hpx::future<hpx::thread::id> attach(Executor& exec, hpx::future<int> f,
+    boost::chrono::microseconds work)
+{
+    return f.then(exec,
+        [work](hpx::future<int> f) -> hpx::thread::id
+        {
+            HPX_TEST_EQ(f.get(), 42);
+
+            boost::chrono::steady_clock::time_point end =
+                boost::chrono::steady_clock::now() + work;
+            while (boost::chrono::steady_clock::now() < end)
+                /**/;
+
+            return hpx::this_thread::get_id();
+        });
+}
+
+template <typename Executor>
+hpx::thread::id run_continuation(Executor& exec,
+    boost::chrono::microseconds work = boost::chrono::microseconds(0))
+{
+    hpx::lcos::local::promise<int> p;
+    hpx::future<hpx::thread::id> result = attach(exec, p.get_future(), work);
+
+    p.set_value(42);
+    return result.get();
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_inline_executor()
+{
+    hpx::parallel::inline_executor exec;
+
+    boost::int64_t inlined = get_continuation_count(continuation_inlined, false);
+
+    HPX_TEST(run_continuation(exec) == hpx::this_thread::get_id());
+    HPX_TEST(get_continuation_count(continuation_inlined, false) > inlined);
+
+    // dataflow
+    hpx::lcos::local::promise<int> p1, p2;
+    hpx::future<hpx::thread::id> f = hpx::dataflow(exec,
+        [](hpx::future<int> f1, hpx::future<int> f2) -> hpx::thread::id
+        {
+            HPX_TEST_EQ(f1.get() + f2.get(), 3);
+            return hpx::this_thread::get_id();
+        },
+        p1.get_future(), p2.get_future());
+
+    p1.set_value(1);
+    p2.set_value(2);
+    HPX_TEST(f.is_ready());
+    HPX_TEST(f.get() == hpx::this_thread::get_id());
+}
+
+void test_adaptive_inline_executor()
+{
+    hpx::parallel::adaptive_inline_executor exec(10000);
+
+    // cheap continuations are run inline
+    HPX_TEST(run_continuation(exec) == hpx::this_thread::get_id());
+    HPX_TEST(run_continuation(exec) == hpx::this_thread::get_id());
+
+    // an expensive continuation is run inline as long as the measured cost
+    // of this continuation type is still low, later ones are run on a new
+    // thread
+    boost::chrono::microseconds const work(1000);
+    hpx::parallel::adaptive_inline_executor exec_expensive(10000);
+
+    hpx::lcos::local::promise<int> p;
+    hpx::future<hpx::thread::id> first =
+        attach(exec_expensive, p.get_future(), work);
+    p.set_value(42);
+    HPX_TEST(first.get() == hpx::this_thread::get_id());
+
+    boost::int64_t spawned = get_continuation_count(continuation_spawned, false);
+
+    hpx::lcos::local::promise<int> p2;
+    hpx::future<hpx::thread::id> second =
+        attach(exec_expensive, p2.get_future(), work);
+    p2.set_value(42);
+    HPX_TEST(second.get() != hpx::this_thread::get_id());
+
+    HPX_TEST(get_continuation_count(continuation_spawned, false) > spawned);
+}
+
+void test_producer_executor()
+{
+    hpx::parallel::producer_executor exec;
+
+    hpx::lcos::local::promise<int> p;
+    hpx::future<hpx::thread::id> result =
+        attach(exec, p.get_future(), boost::chrono::microseconds(0));
+
+    hpx::async([&p]() { p.set_value(42); }).get();
+    HPX_TEST(result.get() != hpx::this_thread::get_id());
+}
+
+void test_numa_domain_executor()
+{
+    hpx::parallel::numa_domain_executor exec(0);
+
+    HPX_TEST(run_continuation(exec) != hpx::this_thread::get_id());
+    HPX_TEST(exec.processing_units_count() != 0);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    test_inline_executor();
+    test_adaptive_inline_executor();
+    test_producer_executor();
+    test_numa_domain_executor();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> const cfg = {
+        "hpx.os_threads=" +
+            std::to_string(hpx::threads::hardware_concurrency())
+    };
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
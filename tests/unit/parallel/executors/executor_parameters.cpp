@@ -10,6 +10,8 @@
 #include <hpx/util/lightweight_test.hpp>
 
 #include <algorithm>
+#include <cstddef>
+#include <cstdlib>
 #include <functional>
 #include <iostream>
 #include <iterator>
@@ -114,6 +116,91 @@ void test_persistent_auto_chunk_size()
     }
 }
 
+void test_adaptive_chunk_size()
+{
+    // repeated invocations exercise the learning of the chunk count
+    {
+        hpx::parallel::adaptive_chunk_size acs;
+        for (int i = 0; i != 10; ++i)
+            chunk_size_test(acs);
+    }
+
+    {
+        hpx::parallel::adaptive_chunk_size acs(boost::chrono::milliseconds(1));
+        for (int i = 0; i != 10; ++i)
+            chunk_size_test(acs);
+
+        acs.reset();
+        chunk_size_test(acs);
+    }
+
+    // concurrent invocations using the same object are measured separately
+    {
+        hpx::parallel::adaptive_chunk_size acs;
+
+        std::vector<hpx::future<void> > futures;
+        for (int i = 0; i != 8; ++i)
+        {
+            futures.push_back(hpx::async(
+                [acs]() { chunk_size_test(acs); }));
+        }
+        hpx::wait_all(futures);
+        for (hpx::future<void>& f : futures)
+            HPX_TEST(!f.has_exception());
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void busy_wait(boost::uint64_t nanoseconds)
+{
+    boost::uint64_t const start = hpx::util::high_resolution_clock::now();
+    while (hpx::util::high_resolution_clock::now() - start < nanoseconds)
+        /**/;
+}
+
+void test_adaptive_chunk_size_convergence()
+{
+    using hpx::parallel::adaptive_chunk_size;
+
+    adaptive_chunk_size acs;
+    hpx::parallel::parallel_executor exec;
+
+    std::size_t const cores = hpx::parallel::executor_information_traits<
+            hpx::parallel::parallel_executor
+        >::processing_units_count(exec, acs);
+    std::size_t const count = 1024 * cores;
+
+    // simulate invocations of an algorithm whose execution time is minimal
+    // when creating 8 chunks per core (this skips the initial probe)
+    auto f = []() { return std::size_t(0); };
+
+    std::vector<std::size_t> chosen;
+    for (int i = 0; i != 40; ++i)
+    {
+        // the algorithms mark the execution on a copy of the parameters
+        adaptive_chunk_size scoped(acs);
+        scoped.mark_begin_execution();
+
+        std::size_t const chunk_size = acs.get_chunk_size(exec, f, count);
+        HPX_TEST(chunk_size != 0);
+
+        std::size_t const chunks_per_core = 1024 / chunk_size;
+        chosen.push_back(chunks_per_core);
+
+        int log2_chunks = 0;
+        while ((std::size_t(1) << log2_chunks) < chunks_per_core)
+            ++log2_chunks;
+        busy_wait(200000 * (1 + std::abs(log2_chunks - 3)));
+
+        scoped.mark_end_execution();
+    }
+
+    // the chunk count has moved away from the initial choice and settled on
+    // the optimum, apart from the periodic re-evaluation of its neighbors
+    HPX_TEST_EQ(chosen.front(), std::size_t(1));
+    HPX_TEST(std::count(chosen.end() - 10, chosen.end(), std::size_t(8)) >= 7);
+}
+
 ///////////////////////////////////////////////////////////////////////////////
 int hpx_main(boost::program_options::variables_map& vm)
 {
@@ -129,6 +216,8 @@ int hpx_main(boost::program_options::variables_map& vm)
     test_guided_chunk_size();
     test_auto_chunk_size();
     test_persistent_auto_chunk_size();
+    test_adaptive_chunk_size();
+    test_adaptive_chunk_size_convergence();
 
     return hpx::finalize();
 }
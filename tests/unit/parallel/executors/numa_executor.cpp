@@ -0,0 +1,160 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_executors.hpp>
+#include <hpx/include/parallel_for_each.hpp>
+#include <hpx/include/parallel_reduce.hpp>
+#include <hpx/parallel/util/numa_first_touch_allocator.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <numeric>
+#include <string>
+#include <vector>
+
+#include <boost/range/functions.hpp>
+
+///////////////////////////////////////////////////////////////////////////////
+hpx::thread::id test(int passed_through)
+{
+    HPX_TEST_EQ(passed_through, 42);
+    return hpx::this_thread::get_id();
+}
+
+void test_async()
+{
+    typedef hpx::parallel::numa_executor executor;
+    typedef hpx::parallel::executor_traits<executor> traits;
+
+    executor exec;
+    HPX_TEST(
+        traits::async_execute(exec, &test, 42).get() !=
+        hpx::this_thread::get_id());
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Return the index of the NUMA domain of each worker thread, the domains are
+// numbered in ascending order of their NUMA node numbers.
+std::vector<std::size_t> get_thread_domains()
+{
+    hpx::threads::topology& topo = hpx::threads::create_topology();
+    hpx::threads::threadmanager_base& tm =
+        hpx::get_runtime().get_thread_manager();
+
+    std::size_t const num_threads = hpx::get_os_thread_count();
+    std::vector<std::size_t> nodes(num_threads);
+    for (std::size_t t = 0; t != num_threads; ++t)
+        nodes[t] = topo.get_numa_node_number(tm.get_pu_num(t));
+
+    std::vector<std::size_t> sorted(nodes);
+    std::sort(sorted.begin(), sorted.end());
+    sorted.erase(std::unique(sorted.begin(), sorted.end()), sorted.end());
+
+    std::vector<std::size_t> domains(num_threads);
+    for (std::size_t t = 0; t != num_threads; ++t)
+    {
+        domains[t] = std::lower_bound(sorted.begin(), sorted.end(), nodes[t]) -
+            sorted.begin();
+    }
+    return domains;
+}
+
+std::size_t bulk_test(std::size_t value, int passed_through)
+{
+    HPX_TEST_EQ(passed_through, 42);
+    return hpx::get_worker_thread_num();
+}
+
+void test_bulk_async()
+{
+    typedef hpx::parallel::numa_executor executor;
+    typedef hpx::parallel::executor_traits<executor> traits;
+
+    std::vector<std::size_t> v(107);
+    std::iota(boost::begin(v), boost::end(v), 0);
+
+    executor exec;
+    HPX_TEST(exec.num_domains() != 0);
+    HPX_TEST_EQ(exec.processing_units_count(), hpx::get_os_thread_count());
+
+    // the mapping of shape elements onto NUMA domains does not decrease
+    // from one element to the next
+    for (std::size_t i = 1; i != v.size(); ++i)
+    {
+        HPX_TEST(exec.get_domain(i - 1, v.size()) <=
+            exec.get_domain(i, v.size()));
+    }
+    HPX_TEST_EQ(exec.get_domain(0, v.size()), std::size_t(0));
+    HPX_TEST_EQ(exec.get_domain(v.size() - 1, v.size()),
+        exec.num_domains() - 1);
+
+    std::vector<hpx::future<std::size_t> > results =
+        traits::bulk_async_execute(exec, &bulk_test, v, 42);
+    HPX_TEST_EQ(results.size(), v.size());
+
+    // every element is executed on the NUMA domain it is mapped onto
+    // (stealing across NUMA domains is disabled, see main)
+    std::vector<std::size_t> const domains = get_thread_domains();
+
+    hpx::wait_all(results);
+    for (std::size_t i = 0; i != results.size(); ++i)
+    {
+        std::size_t const thread = results[i].get();
+        HPX_TEST(thread < domains.size());
+        if (thread < domains.size())
+            HPX_TEST_EQ(domains[thread], exec.get_domain(i, v.size()));
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void test_first_touch_allocator()
+{
+    using namespace hpx::parallel;
+
+    typedef util::numa_first_touch_allocator<double> allocator_type;
+
+    numa_executor exec;
+    allocator_type alloc(exec);
+
+    std::vector<double, allocator_type> v(10007, 1.0, alloc);
+    HPX_TEST_EQ(v.size(), std::size_t(10007));
+
+    for_each(par.on(alloc.executor()), boost::begin(v), boost::end(v),
+        [](double& val)
+        {
+            val *= 2.0;
+        });
+
+    HPX_TEST_EQ(
+        reduce(par.on(alloc.executor()), boost::begin(v), boost::end(v), 0.0),
+        2.0 * v.size());
+}
+
+int hpx_main(int argc, char* argv[])
+{
+    test_async();
+    test_bulk_async();
+    test_first_touch_allocator();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=" +
+        std::to_string(hpx::threads::hardware_concurrency()));
+    cfg.push_back("hpx.numa_sensitive=2");  // no-cross NUMA stealing
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
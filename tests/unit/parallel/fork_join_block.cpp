@@ -0,0 +1,172 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_task_block.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <atomic>
+#include <cstdint>
+#include <string>
+#include <vector>
+
+using hpx::parallel::define_fork_join_block;
+using hpx::parallel::fork_join_block;
+using hpx::parallel::par;
+using hpx::parallel::seq;
+using hpx::parallel::sequential_execution_policy;
+
+///////////////////////////////////////////////////////////////////////////////
+std::uint64_t fib(std::uint64_t n)
+{
+    if (n < 2)
+        return n;
+
+    std::uint64_t x = 0, y = 0;
+    define_fork_join_block([&](fork_join_block<>& fj)
+    {
+        fj.run([&]() { x = fib(n - 1); });
+        y = fib(n - 2);
+    });
+    return x + y;
+}
+
+std::uint64_t fib_seq(std::uint64_t n)
+{
+    if (n < 2)
+        return n;
+
+    std::uint64_t x = 0, y = 0;
+    define_fork_join_block(seq,
+        [&](fork_join_block<sequential_execution_policy>& fj)
+        {
+            fj.run([&]() { x = fib_seq(n - 1); });
+            y = fib_seq(n - 2);
+        });
+    return x + y;
+}
+
+void define_fork_join_block_test1()
+{
+    HPX_TEST_EQ(fib(22), std::uint64_t(17711));
+    HPX_TEST_EQ(fib_seq(22), std::uint64_t(17711));
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void define_fork_join_block_test2()
+{
+    std::atomic<int> count(0);
+    bool after_wait_flag = false;
+
+    define_fork_join_block([&](fork_join_block<>& fj)
+    {
+        for (int i = 0; i != 100; ++i)
+        {
+            fj.run([&count](int inc) { count += inc; }, 1);
+        }
+
+        fj.wait();
+        HPX_TEST_EQ(count.load(), 100);
+        after_wait_flag = true;
+
+        fj.run([&count]() { ++count; });
+    });
+
+    HPX_TEST(after_wait_flag);
+    HPX_TEST_EQ(count.load(), 101);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// Joining a block does not wait for its helper threads, which may start
+// running only after the block has been destroyed.
+void define_fork_join_block_test3()
+{
+    std::atomic<int> count(0);
+
+    for (int i = 0; i != 10000; ++i)
+    {
+        define_fork_join_block([&](fork_join_block<>& fj)
+        {
+            fj.run([&count]() { ++count; });
+        });
+    }
+
+    HPX_TEST_EQ(count.load(), 10000);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+void define_fork_join_block_exceptions_test1()
+{
+    try {
+        define_fork_join_block([](fork_join_block<>& fj)
+        {
+            fj.run([]() { throw 1; });
+            fj.run([]() { throw 2; });
+
+            throw 100;
+        });
+
+        HPX_TEST(false);
+    }
+    catch (hpx::parallel::exception_list const& e) {
+        HPX_TEST_EQ(e.size(), 3u);
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+}
+
+void define_fork_join_block_exceptions_test2()
+{
+    try {
+        define_fork_join_block([](fork_join_block<>& fj)
+        {
+            fj.run([]()
+            {
+                define_fork_join_block([](fork_join_block<>& fj)
+                {
+                    fj.run([]() { throw 1; });
+                    fj.run([]() { throw 2; });
+                });
+            });
+        });
+
+        HPX_TEST(false);
+    }
+    catch (hpx::parallel::exception_list const& e) {
+        HPX_TEST_EQ(e.size(), 2u);
+    }
+    catch (...) {
+        HPX_TEST(false);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    define_fork_join_block_test1();
+    define_fork_join_block_test2();
+    define_fork_join_block_test3();
+
+    define_fork_join_block_exceptions_test1();
+    define_fork_join_block_exceptions_test2();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // By default this test should run on all available cores
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=" +
+        std::to_string(hpx::threads::hardware_concurrency()));
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
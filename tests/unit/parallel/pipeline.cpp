@@ -0,0 +1,234 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/hpx.hpp>
+#include <hpx/include/parallel_pipeline.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <boost/atomic.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <functional>
+#include <iterator>
+#include <numeric>
+#include <string>
+#include <vector>
+
+///////////////////////////////////////////////////////////////////////////////
+struct square
+{
+    std::size_t operator()(std::size_t v) const
+    {
+        return v * v;
+    }
+};
+
+struct is_even
+{
+    bool operator()(std::size_t v) const
+    {
+        return (v % 2) == 0;
+    }
+};
+
+///////////////////////////////////////////////////////////////////////////////
+template <typename ExPolicy>
+void test_pipeline_reduce(ExPolicy && policy)
+{
+    namespace pipeline = hpx::parallel::pipeline;
+
+    std::vector<std::size_t> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    std::size_t expected = 0;
+    for (std::size_t v : c)
+    {
+        std::size_t sq = v * v;
+        if (sq % 2 == 0)
+            expected += sq;
+    }
+
+    std::size_t result = pipeline::reduce(policy,
+        pipeline::from(c) | pipeline::transform(square()) |
+            pipeline::filter(is_even()),
+        std::size_t(0), std::plus<std::size_t>());
+
+    HPX_TEST_EQ(result, expected);
+
+    // stages can be composed before being applied to a view
+    auto stages = pipeline::transform(square()) | pipeline::filter(is_even());
+    result = pipeline::reduce(policy, pipeline::from(c) | stages,
+        std::size_t(0), std::plus<std::size_t>());
+
+    HPX_TEST_EQ(result, expected);
+}
+
+template <typename ExPolicy>
+void test_pipeline_reduce_async(ExPolicy && policy)
+{
+    namespace pipeline = hpx::parallel::pipeline;
+
+    std::vector<std::size_t> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    std::size_t expected = 0;
+    for (std::size_t v : c)
+    {
+        if (v % 2 == 0)
+            expected += v * v;
+    }
+
+    hpx::future<std::size_t> f = pipeline::reduce(policy,
+        pipeline::from(c) | pipeline::filter(is_even()) |
+            pipeline::transform(square()),
+        std::size_t(0), std::plus<std::size_t>());
+
+    HPX_TEST_EQ(f.get(), expected);
+}
+
+template <typename ExPolicy>
+void test_pipeline_count(ExPolicy && policy)
+{
+    namespace pipeline = hpx::parallel::pipeline;
+
+    std::vector<std::size_t> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    std::size_t expected = std::count_if(c.begin(), c.end(), is_even());
+
+    std::size_t result = pipeline::count(policy,
+        pipeline::from(c) | pipeline::filter(is_even()));
+
+    HPX_TEST_EQ(result, expected);
+    HPX_TEST_EQ(pipeline::count(policy, pipeline::from(c)), c.size());
+}
+
+template <typename ExPolicy>
+void test_pipeline_for_each(ExPolicy && policy)
+{
+    namespace pipeline = hpx::parallel::pipeline;
+
+    std::vector<std::size_t> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    std::size_t expected = 0;
+    for (std::size_t v : c)
+        expected += v * v;
+
+    boost::atomic<std::size_t> sum(0);
+    std::vector<std::size_t>::iterator it = pipeline::for_each(policy,
+        pipeline::from(c) | pipeline::transform(square()),
+        [&sum](std::size_t v)
+        {
+            sum += v;
+        });
+
+    HPX_TEST(it == c.end());
+    HPX_TEST_EQ(sum.load(), expected);
+}
+
+template <typename ExPolicy>
+void test_pipeline_copy(ExPolicy && policy)
+{
+    namespace pipeline = hpx::parallel::pipeline;
+
+    std::vector<std::size_t> c(10007);
+    std::iota(c.begin(), c.end(), std::rand() % 1000);
+
+    // size preserving pipeline
+    {
+        std::vector<std::size_t> d(c.size());
+        std::vector<std::size_t>::iterator end = pipeline::copy(policy,
+            pipeline::from(c) | pipeline::transform(square()), d.begin());
+
+        HPX_TEST(end == d.end());
+
+        std::vector<std::size_t> expected(c.size());
+        std::transform(c.begin(), c.end(), expected.begin(), square());
+        HPX_TEST(d == expected);
+    }
+
+    // filtering pipeline
+    {
+        std::vector<std::size_t> d(c.size());
+        std::vector<std::size_t>::iterator end = pipeline::copy(policy,
+            pipeline::from(c) | pipeline::filter(is_even()) |
+                pipeline::transform(square()),
+            d.begin());
+
+        std::vector<std::size_t> expected;
+        for (std::size_t v : c)
+        {
+            if (v % 2 == 0)
+                expected.push_back(v * v);
+        }
+
+        HPX_TEST_EQ(std::size_t(std::distance(d.begin(), end)),
+            expected.size());
+        HPX_TEST(std::equal(expected.begin(), expected.end(), d.begin()));
+    }
+}
+
+void test_pipeline()
+{
+    using namespace hpx::parallel;
+
+    test_pipeline_reduce(seq);
+    test_pipeline_reduce(par);
+    test_pipeline_reduce(par_vec);
+
+    test_pipeline_reduce_async(seq(task));
+    test_pipeline_reduce_async(par(task));
+
+    test_pipeline_count(seq);
+    test_pipeline_count(par);
+
+    test_pipeline_for_each(seq);
+    test_pipeline_for_each(par);
+
+    test_pipeline_copy(seq);
+    test_pipeline_copy(par);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main(boost::program_options::variables_map& vm)
+{
+    unsigned int seed = static_cast<unsigned int>(std::time(0));
+    if (vm.count("seed"))
+        seed = vm["seed"].as<unsigned int>();
+
+    std::cout << "using seed: " << seed << std::endl;
+    std::srand(seed);
+
+    test_pipeline();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    // add command line option which controls the random number generator seed
+    using namespace boost::program_options;
+    options_description desc_commandline(
+        "Usage: " HPX_APPLICATION_STRING " [options]");
+
+    desc_commandline.add_options()
+        ("seed,s", value<unsigned int>(),
+        "the random number generator seed to use for this run")
+        ;
+
+    // By default this test should run on all available cores
+    std::vector<std::string> cfg;
+    cfg.push_back("hpx.os_threads=" +
+        std::to_string(hpx::threads::hardware_concurrency()));
+
+    // Initialize and run HPX
+    HPX_TEST_EQ_MSG(hpx::init(desc_commandline, argc, argv, cfg), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}
@@ -0,0 +1,115 @@
+//  Copyright (c) 2016 Hartmut Kaiser
+//
+//  Distributed under the Boost Software License, Version 1.0. (See accompanying
+//  file LICENSE_1_0.txt or copy at http://www.boost.org/LICENSE_1_0.txt)
+
+#include <hpx/hpx_init.hpp>
+#include <hpx/runtime/agas/interface.hpp>
+#include <hpx/runtime/naming/name.hpp>
+#include <hpx/util/generate_unique_ids.hpp>
+#include <hpx/util/lightweight_test.hpp>
+
+#include <algorithm>
+#include <cstddef>
+#include <utility>
+#include <vector>
+
+using hpx::naming::gid_type;
+using hpx::util::unique_id_ranges;
+
+typedef std::vector<std::pair<gid_type, std::size_t> > ranges_type;
+
+///////////////////////////////////////////////////////////////////////////////
+// none of the handed out ranges of ids may overlap
+void test_disjoint(ranges_type ranges)
+{
+    std::sort(ranges.begin(), ranges.end());
+    for (std::size_t i = 1; i < ranges.size(); ++i)
+    {
+        HPX_TEST(ranges[i - 1].first + ranges[i - 1].second <=
+            ranges[i].first);
+    }
+}
+
+///////////////////////////////////////////////////////////////////////////////
+// the ids are handed out from the current range until it is used up, then
+// from the next one (reserved in the background or on demand)
+void test_switch_over()
+{
+    // the range is small enough for the first request to trigger a refill
+    // in the background, destroying 'ids' has to wait for it to finish
+    unique_id_ranges ids;
+
+    std::size_t const size = 16;
+    gid_type const lower = hpx::agas::get_next_id(size);
+    ids.set_range(lower, lower + size);
+
+    ranges_type ranges;
+    for (std::size_t i = 0; i != 100; ++i)
+    {
+        std::size_t const count = i % 7 + 1;
+        gid_type const id = ids.get_id(count);
+        HPX_TEST(id);
+
+        ranges.push_back(std::make_pair(id, count));
+    }
+
+    // the initial range is used first
+    HPX_TEST_EQ(ranges[0].first, lower);
+    HPX_TEST_EQ(ranges[1].first, lower + ranges[0].second);
+
+    // requests which don't fit into the remainder of a range are served
+    // from the next one
+    for (std::pair<gid_type, std::size_t> const& r : ranges)
+    {
+        if (lower <= r.first && r.first < lower + size)
+            HPX_TEST(r.first + r.second <= lower + size);
+    }
+
+    test_disjoint(ranges);
+}
+
+// requests for more ids than are reserved at once (0x100000) bypass the
+// local range
+void test_large_requests()
+{
+    unique_id_ranges ids;
+
+    std::size_t const large = 0x100001;
+
+    ranges_type ranges;
+    for (std::size_t i = 0; i != 3; ++i)
+    {
+        gid_type const id = ids.get_id(1);
+        gid_type const large_id = ids.get_id(large);
+        HPX_TEST(id);
+        HPX_TEST(large_id);
+
+        // the local range continues where it left off
+        gid_type const next_id = ids.get_id(1);
+        HPX_TEST_EQ(next_id, id + 1);
+
+        ranges.push_back(std::make_pair(id, std::size_t(1)));
+        ranges.push_back(std::make_pair(large_id, large));
+        ranges.push_back(std::make_pair(next_id, std::size_t(1)));
+    }
+
+    test_disjoint(ranges);
+}
+
+///////////////////////////////////////////////////////////////////////////////
+int hpx_main()
+{
+    test_switch_over();
+    test_large_requests();
+
+    return hpx::finalize();
+}
+
+int main(int argc, char* argv[])
+{
+    HPX_TEST_EQ_MSG(hpx::init(argc, argv), 0,
+        "HPX main exited with non-zero status");
+
+    return hpx::util::report_errors();
+}